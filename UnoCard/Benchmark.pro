@@ -0,0 +1,83 @@
+################################################################################
+##
+## Uno Card Game 4 PC
+## Author: Hikari Toyama
+## Compile Environment: Qt 5 with Qt Creator
+## COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+##
+################################################################################
+
+# Benchmark program of the headless engine, see src/bench.cpp.
+# Build with "qmake Benchmark.pro && make" in a separate build directory.
+TEMPLATE = app
+TARGET = UnoCardBench
+# Sources of the same file name under src/ and reference/ need separate
+# object files
+CONFIG += c++11 console object_parallel_to_source
+CONFIG -= app_bundle
+DESTDIR = $$PWD
+QT += core gui
+
+HEADERS += \
+    include/AI.h \
+    include/Agent.h \
+    include/Benchmark.h \
+    include/BluffSolver.h \
+    include/BluffStrategy.h \
+    include/Card.h \
+    include/Color.h \
+    include/Content.h \
+    include/Coverage.h \
+    include/Differ.h \
+    include/Distilled.h \
+    include/Distiller.h \
+    include/Latency.h \
+    include/Lockstep.h \
+    include/Player.h \
+    include/Policy.h \
+    include/Scheduler.h \
+    include/Simulator.h \
+    include/Transposition.h \
+    include/Uno.h \
+    reference/AI.h \
+    reference/Player.h \
+    reference/Simulator.h \
+    reference/Uno.h
+
+SOURCES += \
+    src/AI.cpp \
+    src/Benchmark.cpp \
+    src/BluffSolver.cpp \
+    src/Card.cpp \
+    src/Coverage.cpp \
+    src/Differ.cpp \
+    src/Distiller.cpp \
+    src/Latency.cpp \
+    src/Lockstep.cpp \
+    src/Player.cpp \
+    src/Policy.cpp \
+    src/Scheduler.cpp \
+    src/Simulator.cpp \
+    src/Transposition.cpp \
+    src/Uno.cpp \
+    src/bench.cpp \
+    reference/AI.cpp \
+    reference/Player.cpp \
+    reference/Simulator.cpp \
+    reference/Uno.cpp
+
+# Peak memory of the process (see Benchmark::macro(int, std::ostream&))
+win32: LIBS += -lpsapi
+
+msvc {
+    QMAKE_CFLAGS += /utf-8
+    QMAKE_CXXFLAGS += /utf-8
+} # msvc
+
+# Build with "qmake CONFIG+=avx2" to enable AVX2 kernels of Policy class
+avx2 {
+    msvc: QMAKE_CXXFLAGS += /arch:AVX2
+    else: QMAKE_CXXFLAGS += -mavx2 -mfma
+} # avx2
+
+# E.O.F
\ No newline at end of file
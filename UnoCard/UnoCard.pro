@@ -17,20 +17,59 @@ QT += core gui multimedia widgets
 
 HEADERS += \
     include/AI.h \
+    include/Agent.h \
+    include/Arena.h \
+    include/BluffSolver.h \
+    include/BluffStrategy.h \
     include/Card.h \
+    include/Checkpoint.h \
     include/Color.h \
     include/Content.h \
+    include/Coordinator.h \
+    include/Coverage.h \
+    include/Distilled.h \
+    include/Distiller.h \
+    include/Estimator.h \
+    include/Hinter.h \
+    include/Latency.h \
+    include/Lockstep.h \
     include/Player.h \
+    include/Policy.h \
+    include/Scanner.h \
+    include/Scheduler.h \
+    include/Simulator.h \
     include/SoundPool.h \
+    include/Speculator.h \
+    include/Stats.h \
+    include/Transposition.h \
+    include/Tuner.h \
     include/Uno.h \
     include/i18n.h \
     include/main.h
 
 SOURCES += \
     src/AI.cpp \
+    src/Arena.cpp \
+    src/BluffSolver.cpp \
     src/Card.cpp \
+    src/Checkpoint.cpp \
+    src/Coordinator.cpp \
+    src/Coverage.cpp \
+    src/Distiller.cpp \
+    src/Estimator.cpp \
+    src/Hinter.cpp \
+    src/Latency.cpp \
+    src/Lockstep.cpp \
     src/Player.cpp \
+    src/Policy.cpp \
+    src/Scanner.cpp \
+    src/Scheduler.cpp \
+    src/Simulator.cpp \
     src/SoundPool.cpp \
+    src/Speculator.cpp \
+    src/Stats.cpp \
+    src/Transposition.cpp \
+    src/Tuner.cpp \
     src/Uno.cpp \
     src/main.cpp
 
@@ -42,4 +81,10 @@ msvc {
     QMAKE_CXXFLAGS += /utf-8
 } # msvc
 
+# Build with "qmake CONFIG+=avx2" to enable AVX2 kernels of Policy class
+avx2 {
+    msvc: QMAKE_CXXFLAGS += /arch:AVX2
+    else: QMAKE_CXXFLAGS += -mavx2 -mfma
+} # avx2
+
 # E.O.F
\ No newline at end of file
@@ -29,7 +29,122 @@ private:
      */
     AI() = default;
 
+    /**
+     * @param who Get whose AI parameters.
+     * @return AI parameters of the specified player in our Uno runtime.
+     */
+    const int* getParams(int who);
+
+    /**
+     * Decide a pending [wild +4] challenge or 7-0 swap target by rollouts,
+     * when AI has a time budget or a node budget. For each alternative,
+     * simulate the rest of game many times from the decider's view, with
+     * the cards unknown to the decider redealt. All alternatives share the
+     * same redealt cards in each round, and rounds are simulated by the
+     * shared rollout helper threads, or only by the caller when another
+     * decision is using them. An alternative replaces the first one only
+     * when it wins significantly more often in these paired games.
+     *
+     * @param status  Simulator::STAT_DOUBT_WILD4 or STAT_SEVEN_TARGET.
+     * @param who     Who makes the decision.
+     * @param choices Alternatives. 1 / 0 to challenge or not, or the swap
+     *                targets. The first one is the heuristic answer.
+     * @param count   How many alternatives.
+     * @return Index of the best alternative in choices[].
+     */
+    int rolloutDecision(int status, int who, const int choices[], int count);
+
 public:
+    /**
+     * AI parameter: worth of zero / reverse cards in calcBestColor4NowPlayer.
+     */
+    static const int PARAM_ZERO_REV_WORTH = 0;
+
+    /**
+     * AI parameter: worth of non-zero number cards in calcBestColor4NowPlayer.
+     */
+    static const int PARAM_NUM_WORTH = 1;
+
+    /**
+     * AI parameter: worth of skip / draw two cards in calcBestColor4NowPlayer.
+     */
+    static const int PARAM_SKIP_DRAW2_WORTH = 2;
+
+    /**
+     * AI parameter: in needToChallenge, always challenge when holding
+     * (Uno::MAX_HOLD_CARDS - this value) or more cards.
+     */
+    static const int PARAM_CHALLENGE_MARGIN = 3;
+
+    /**
+     * AI parameter: in hard AI, start to attack with +2, skip and wild
+     * cards when next player holds this number of cards or less.
+     */
+    static const int PARAM_ATTACK_SIZE = 4;
+
+    /**
+     * AI parameter: in hard AI, play reverse cards freely when previous
+     * player holds this number of cards or more.
+     */
+    static const int PARAM_REVERSE_SIZE = 5;
+
+    /**
+     * AI parameter: in hard AI, play skip / +2 cards in your best color
+     * only when opposite player holds this number of cards or more.
+     */
+    static const int PARAM_SAVE_SIZE = 6;
+
+    /**
+     * AI parameter: in hard AI's normal strategies, pass 1 to play number
+     * cards before attacking with +2 / skip / reverse cards, or 0 to attack
+     * at first.
+     */
+    static const int PARAM_NUM_FIRST = 7;
+
+    /**
+     * How many AI parameters.
+     */
+    static const int PARAM_COUNT = 8;
+
+    /**
+     * Default AI parameters.
+     */
+    static const int DEFAULT_PARAMS[PARAM_COUNT];
+
+    /**
+     * Names of AI parameters, used in parameter files.
+     */
+    static const char* const PARAM_NAMES[PARAM_COUNT];
+
+    /**
+     * Load AI parameters from a text file. Each line of the file is like
+     * "name value", where name is one of PARAM_NAMES. Parameters that are
+     * not mentioned in the file keep their default values.
+     *
+     * @param path      Path of the parameter file.
+     * @param outParams Out parameter. Pass an int array (length>=PARAM_COUNT)
+     *                  to receive the loaded parameters.
+     * @return Whether the file is loaded successfully.
+     */
+    static bool loadParams(const char* path, int outParams[]);
+
+    /**
+     * Save AI parameters to a text file. See loadParams(const char*, int[]).
+     *
+     * @param path   Path of the parameter file.
+     * @param params AI parameters to save (length == PARAM_COUNT).
+     * @return Whether the file is saved successfully.
+     */
+    static bool saveParams(const char* path, const int params[]);
+
+    /**
+     * Create an AI instance which works on the specified Uno runtime, e.g.
+     * a headless runtime created by Uno::newHeadlessInstance(unsigned).
+     *
+     * @param uno Provide the Uno runtime.
+     */
+    explicit AI(Uno* uno);
+
     /**
      * In main.cpp, get AI instance here.
      *
@@ -40,9 +155,9 @@ public:
     /**
      * Evaluate which color is the best for current player. In our evaluation
      * system, zero cards / reverse cards are worth 2 points, non-zero number
-     * cards are worth 4 points, and skip / draw two cards are worth 5 points.
-     * Finally, the color which contains the worthiest cards becomes the best
-     * color.
+     * cards are worth 4 points, and skip / draw two cards are worth 5 points
+     * by default (see PARAM_*_WORTH). Finally, the color which contains the
+     * worthiest cards becomes the best color.
      *
      * @return Current player's best color.
      */
@@ -51,7 +166,8 @@ public:
     /**
      * In 7-0 rule, when a seven card is put down, the player must swap hand
      * cards with another player immediately. This API returns that swapping
-     * with whom is the best answer for current player.
+     * with whom is the best answer for current player. When AI has a time
+     * budget or a node budget, all targets are compared by rollouts.
      *
      * @return Current player swaps with whom. Must be one of the following:
      *         Player::YOU, Player::COM1, Player::COM2, Player::COM3.
@@ -60,7 +176,8 @@ public:
 
     /**
      * AI strategies of determining if it's necessary to challenge previous
-     * player's [wild +4] card's legality.
+     * player's [wild +4] card's legality. When AI has a time budget or a
+     * node budget, both answers are compared by rollouts.
      *
      * @return True if it's necessary to make a challenge.
      */
@@ -113,6 +230,67 @@ public:
      *         Or a negative number that means no appropriate card to play.
      */
     int sevenZeroAI_bestCardIndex4NowPlayer(Color outColor[]);
+
+    /**
+     * AI Strategies (Difficulty: POLICY). Score current player's legal hand
+     * cards by the learned policy network (see Policy class), and play the
+     * best one. Falls back to the hard AI when no policy
+     * weights are loaded.
+     *
+     * @param outColor This is a out parameter. Pass a Color array (length>=1)
+     *                 in order to let us pass the return value by assigning
+     *                 outColor[0]. When the best card to play becomes a wild
+     *                 card, outColor[0] will become the following legal color
+     *                 to change. When the best card to play becomes an action
+     *                 or a number card, outColor[0] will become the player's
+     *                 best color.
+     * @return Index of the best card to play, in current player's hand.
+     *         Or a negative number that means no appropriate card to play.
+     */
+    int policyAI_bestCardIndex4NowPlayer(Color outColor[]);
+
+    /**
+     * AI Strategies (Distilled). The same cost as the easy AI, but the
+     * priority order of card kinds is looked up from a table distilled from
+     * the anytime search AI's choices (see Distiller class and the
+     * generated include/Distilled.h file).
+     *
+     * @param outColor This is a out parameter. Pass a Color array (length>=1)
+     *                 in order to let us pass the return value by assigning
+     *                 outColor[0]. When the best card to play becomes a wild
+     *                 card, outColor[0] will become the following legal color
+     *                 to change. When the best card to play becomes an action
+     *                 or a number card, outColor[0] will become the player's
+     *                 best color.
+     * @return Index of the best card to play, in current player's hand.
+     *         Or a negative number that means no appropriate card to play.
+     */
+    int distilledAI_bestCardIndex4NowPlayer(Color outColor[]);
+
+    /**
+     * Anytime AI Strategies. Start from the answer of the fixed strategies
+     * (7-0 rule or current difficulty), then try every legal action in many
+     * simulated games, until the time budget or the node budget (see
+     * Uno::setThinkTime(int) and Uno::setThinkNodes(int)) runs out. In each
+     * simulated game, the cards unknown to current player are redealt, and
+     * the rest of game is played by the fixed strategies. All actions are
+     * tried on the same redealt cards in each round, and an action replaces
+     * the answer of the fixed strategies only when it wins significantly more
+     * often than the latter one in these paired games. The time budget is
+     * also checked during each simulated game, so this function returns in
+     * time even under heavy CPU load, with the best answer found so far.
+     *
+     * @param outColor This is a out parameter. Pass a Color array (length>=1)
+     *                 in order to let us pass the return value by assigning
+     *                 outColor[0]. When the best card to play becomes a wild
+     *                 card, outColor[0] will become the following legal color
+     *                 to change. When the best card to play becomes an action
+     *                 or a number card, outColor[0] will become the player's
+     *                 best color.
+     * @return Index of the best card to play, in current player's hand.
+     *         Or a negative number that means no appropriate card to play.
+     */
+    int searchAI_bestCardIndex4NowPlayer(Color outColor[]);
 }; // AI Class
 
 #endif // __AI_H_494649FDFA62B3C015120BCB9BE17613__
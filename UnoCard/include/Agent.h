@@ -0,0 +1,221 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __AGENT_H_494649FDFA62B3C015120BCB9BE17613__
+#define __AGENT_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include "include/Color.h"
+#include "include/Uno.h"
+#include "include/AI.h"
+
+/**
+ * Decision maker of a seat, e.g. an AI strategy, a remote bot or a replay
+ * player. Every decision is made on the Uno runtime passed in, for the
+ * player who needs to make it.
+ *
+ * Agents come in two flavors:
+ * 1. Dynamic agents derive from this class, and can be switched at runtime
+ *    (see Simulator::setAgent(int, Agent*)).
+ * 2. Static agents are any classes with the same four member functions
+ *    (no virtual functions needed, e.g. the built-in agents below). Game
+ *    loops written as templates, such as Simulator::step(A&), call them
+ *    directly, so the compiler can inline the whole agent. Wrap a static
+ *    agent in AgentAdapter<A> to use it as a dynamic one.
+ */
+class Agent {
+public:
+    /**
+     * Choose a card for current player to play.
+     *
+     * @param uno      Provide the Uno runtime.
+     * @param outColor Out parameter, see AI::easyAI_bestCardIndex4NowPlayer.
+     * @return Index of the card to play in current player's hand, or a
+     *         negative number that means to draw a card.
+     */
+    virtual int bestCardIndex(Uno* uno, Color outColor[]) = 0;
+
+    /**
+     * Choose the following legal color, when current player plays a wild
+     * card which has not got a color yet (e.g. a drawn wild card).
+     *
+     * @param uno Provide the Uno runtime.
+     * @return The following legal color.
+     */
+    virtual Color bestColor(Uno* uno) = 0;
+
+    /**
+     * Decide whether to challenge the [wild +4] card which current player
+     * has just played. The decision is made by uno->getNext().
+     *
+     * @param uno Provide the Uno runtime.
+     * @return True to challenge.
+     */
+    virtual bool needToChallenge(Uno* uno) = 0;
+
+    /**
+     * Choose whom current player swaps hand cards with, after playing a
+     * [7] in 7-0 rule.
+     *
+     * @param uno Provide the Uno runtime.
+     * @return Player::YOU, Player::COM1, Player::COM2 or Player::COM3.
+     */
+    virtual int swapTarget(Uno* uno) = 0;
+
+    /**
+     * Destructor.
+     */
+    virtual ~Agent() = default;
+}; // Agent Class
+
+/**
+ * Wrap a static agent as a dynamic agent.
+ */
+template<class A>
+class AgentAdapter : public Agent {
+private:
+    /**
+     * The wrapped static agent.
+     */
+    A agent;
+
+public:
+    /**
+     * Constructor.
+     *
+     * @param agent The static agent to wrap.
+     */
+    explicit AgentAdapter(const A& agent = A()) : agent(agent) {
+    } // AgentAdapter(const A&) (Class Constructor)
+
+    int bestCardIndex(Uno* uno, Color outColor[]) override {
+        return agent.bestCardIndex(uno, outColor);
+    } // bestCardIndex(Uno*, Color[])
+
+    Color bestColor(Uno* uno) override {
+        return agent.bestColor(uno);
+    } // bestColor(Uno*)
+
+    bool needToChallenge(Uno* uno) override {
+        return agent.needToChallenge(uno);
+    } // needToChallenge(Uno*)
+
+    int swapTarget(Uno* uno) override {
+        return agent.swapTarget(uno);
+    } // swapTarget(Uno*)
+}; // AgentAdapter Class
+
+/**
+ * Decisions shared by all built-in agents, other than playing a card.
+ * They are stateless, so one instance can be shared by many threads.
+ */
+class AIAgent {
+public:
+    inline Color bestColor(Uno* uno) {
+        return AI(uno).calcBestColor4NowPlayer();
+    } // bestColor(Uno*)
+
+    inline bool needToChallenge(Uno* uno) {
+        return AI(uno).needToChallenge();
+    } // needToChallenge(Uno*)
+
+    inline int swapTarget(Uno* uno) {
+        return AI(uno).calcBestSwapTarget4NowPlayer();
+    } // swapTarget(Uno*)
+}; // AIAgent Class
+
+/**
+ * Built-in agent, AI strategies (Difficulty: EASY).
+ */
+class EasyAgent : public AIAgent {
+public:
+    inline int bestCardIndex(Uno* uno, Color outColor[]) {
+        return AI(uno).easyAI_bestCardIndex4NowPlayer(outColor);
+    } // bestCardIndex(Uno*, Color[])
+}; // EasyAgent Class
+
+/**
+ * Built-in agent, AI strategies (Difficulty: HARD).
+ */
+class HardAgent : public AIAgent {
+public:
+    inline int bestCardIndex(Uno* uno, Color outColor[]) {
+        return AI(uno).hardAI_bestCardIndex4NowPlayer(outColor);
+    } // bestCardIndex(Uno*, Color[])
+}; // HardAgent Class
+
+/**
+ * Built-in agent, special AI strategies in 7-0 rule.
+ */
+class SevenZeroAgent : public AIAgent {
+public:
+    inline int bestCardIndex(Uno* uno, Color outColor[]) {
+        return AI(uno).sevenZeroAI_bestCardIndex4NowPlayer(outColor);
+    } // bestCardIndex(Uno*, Color[])
+}; // SevenZeroAgent Class
+
+/**
+ * Built-in agent, learned policy AI strategies (Difficulty: POLICY).
+ */
+class PolicyAgent : public AIAgent {
+public:
+    inline int bestCardIndex(Uno* uno, Color outColor[]) {
+        return AI(uno).policyAI_bestCardIndex4NowPlayer(outColor);
+    } // bestCardIndex(Uno*, Color[])
+}; // PolicyAgent Class
+
+/**
+ * Built-in agent, AI strategies distilled from the anytime AI (see
+ * Distiller class).
+ */
+class DistilledAgent : public AIAgent {
+public:
+    inline int bestCardIndex(Uno* uno, Color outColor[]) {
+        return AI(uno).distilledAI_bestCardIndex4NowPlayer(outColor);
+    } // bestCardIndex(Uno*, Color[])
+}; // DistilledAgent Class
+
+/**
+ * Built-in agent, anytime AI strategies by the AI budgets of the Uno
+ * runtime (see AI::searchAI_bestCardIndex4NowPlayer).
+ */
+class SearchAgent : public AIAgent {
+public:
+    inline int bestCardIndex(Uno* uno, Color outColor[]) {
+        return AI(uno).searchAI_bestCardIndex4NowPlayer(outColor);
+    } // bestCardIndex(Uno*, Color[])
+}; // SearchAgent Class
+
+/**
+ * Built-in agent, chooses one of the AI strategies in the same way as the
+ * game UI does (by AI budgets, 7-0 rule and difficulty).
+ */
+class DefaultAgent : public AIAgent {
+public:
+    inline int bestCardIndex(Uno* uno, Color outColor[]) {
+        if (uno->getThinkTime() > 0 || uno->getThinkNodes() > 0) {
+            return SearchAgent().bestCardIndex(uno, outColor);
+        } // if (uno->getThinkTime() > 0 || uno->getThinkNodes() > 0)
+        else if (uno->isSevenZeroRule()) {
+            return SevenZeroAgent().bestCardIndex(uno, outColor);
+        } // else if (uno->isSevenZeroRule())
+        else if (uno->getDifficulty() == Uno::LV_EASY) {
+            return EasyAgent().bestCardIndex(uno, outColor);
+        } // else if (uno->getDifficulty() == Uno::LV_EASY)
+        else if (uno->getDifficulty() == Uno::LV_POLICY) {
+            return PolicyAgent().bestCardIndex(uno, outColor);
+        } // else if (uno->getDifficulty() == Uno::LV_POLICY)
+        else {
+            return HardAgent().bestCardIndex(uno, outColor);
+        } // else
+    } // bestCardIndex(Uno*, Color[])
+}; // DefaultAgent Class
+
+#endif // __AGENT_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __ARENA_H_494649FDFA62B3C015120BCB9BE17613__
+#define __ARENA_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include <string>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include "include/Stats.h"
+#include "include/Uno.h"
+
+/**
+ * Headless AI arena. Let different AI strategies play against each other
+ * on all CPU cores, and report their win rates and Elo ratings (with 95%
+ * confidence intervals), average game length, engine throughput and the
+ * latency histograms of AI entry points (see Latency class) and game
+ * statistics (see Stats class) as JSON.
+ *
+ * Every deal (a fixed seed) is played once for each rotation of the seats,
+ * so that every strategy plays every seat on the same cards, and the deals
+ * are shared among all rule combinations in turn. Each strategy is used
+ * as is under all rules, i.e. "hard" does not turn into "7-0" under 7-0
+ * rule as it does in the game UI. Results do not depend on the number of
+ * threads, unless AI time budgets are used.
+ *
+ * Games can also be played by worker processes instead of threads (see
+ * setProcesses(int) and Coordinator class), in shards of SHARD_GAMES
+ * games. Results do not depend on the number of processes either.
+ *
+ * The numbers of threads and processes, the throughput and the latency
+ * histograms of this process (empty when games are played by worker
+ * processes) are reported in a separate "run" object at the end, so that
+ * the rest of the reports of the same games can be compared byte for
+ * byte, even when one of them is resumed from a checkpoint.
+ *
+ * Long runs can save their progress (finished shards and merged results)
+ * to a checkpoint file from time to time (see setCheckpoint(const
+ * std::string&, int)). A run with the same settings resumes from the
+ * checkpoint, and gets the same results as if it were never stopped.
+ */
+class Arena {
+private:
+    /**
+     * Strategy of a seat.
+     */
+    struct Entrant {
+        std::string name;
+        int kind;
+        int thinkTime;
+    }; // Entrant Struct
+
+    /**
+     * Results of a group of games.
+     */
+    struct Tally {
+        long long games;
+        long long unfinished;
+        long long turns;
+        std::vector<long long> seats;
+        std::vector<long long> wins;
+        std::vector<long long> pairs;
+        std::vector<long long> pairWins;
+    }; // Tally Struct
+
+    /**
+     * How many threads to play games.
+     */
+    int threads;
+
+    /**
+     * Base of random seeds.
+     */
+    unsigned seed;
+
+    /**
+     * All different strategies in game.
+     */
+    std::vector<Entrant> entrants;
+
+    /**
+     * Entrant index of each seat, in the order of YOU, COM1, [COM2,] COM3.
+     */
+    std::vector<int> lineup;
+
+    /**
+     * Rule combinations to play, combined by RULE_* flags.
+     */
+    std::vector<int> rules;
+
+    /**
+     * Whether to play a drawn card at once when it is legal, see
+     * Uno::setForcePlay(bool).
+     */
+    bool forcePlay;
+
+    /**
+     * How many worker processes to play games, or 0 to play games by
+     * threads in this process.
+     */
+    int processes;
+
+    /**
+     * Path of the checkpoint file, or empty if checkpoints are disabled.
+     */
+    std::string checkpoint;
+
+    /**
+     * Save a checkpoint at most once in this number of seconds.
+     */
+    int checkpointSeconds;
+
+    /**
+     * Play a game.
+     *
+     * @param g     Game number.
+     * @param tally Out parameter. Add the result to this tally.
+     * @param stats Out parameter. Record the game in this shard.
+     */
+    void play(int g, std::vector<Tally>& tally, Stats& stats);
+
+    /**
+     * @param rule Rule combination, combined by RULE_* flags.
+     * @return Name of the rule combination.
+     */
+    static const char* ruleName(int rule);
+
+    /**
+     * Add a tally to another tally.
+     *
+     * @param to   Out parameter. Add to this tally.
+     * @param from The tally to add.
+     */
+    static void add(Tally& to, const Tally& from);
+
+    /**
+     * Write a tally as binary data, to be read by load(std::istream&,
+     * Tally&) on the same machine.
+     *
+     * @param out   Output stream.
+     * @param tally The tally to write.
+     */
+    static void save(std::ostream& out, const Tally& tally);
+
+    /**
+     * Read a tally written by save(std::ostream&, const Tally&).
+     *
+     * @param in    Input stream.
+     * @param tally Out parameter. Pass an empty tally of the same size to
+     *              receive the tally.
+     * @return Whether the tally is read successfully.
+     */
+    static bool load(std::istream& in, Tally& tally);
+
+    /**
+     * @param games How many games to play.
+     * @return Settings of a run, which must match when resuming from a
+     *         checkpoint.
+     */
+    std::string describe(int games);
+
+    /**
+     * Save a checkpoint.
+     *
+     * @param games How many games to play.
+     * @param done  How many shards are finished.
+     * @param total Merged tallies of finished shards, one for each rule
+     *              combination.
+     * @param stats Merged statistics of finished shards.
+     */
+    void saveProgress(int games, int done, const std::vector<Tally>& total,
+                      Stats& stats);
+
+    /**
+     * Load the checkpoint saved by a run with the same settings.
+     *
+     * @param games How many games to play.
+     * @param total Out parameter. Pass empty tallies to receive the merged
+     *              tallies of finished shards.
+     * @param stats Out parameter. Pass an empty shard to receive the merged
+     *              statistics of finished shards.
+     * @return How many shards are finished, or 0 if there is no checkpoint
+     *         of the same settings.
+     */
+    int loadProgress(int games, std::vector<Tally>& total, Stats& stats);
+
+    /**
+     * Write a tally as JSON members.
+     *
+     * @param out   Output stream.
+     * @param tally The tally to write.
+     * @param elo   Whether to include Elo ratings.
+     */
+    void write(std::ostream& out, const Tally& tally, bool elo);
+
+public:
+    /**
+     * Rule flag: 7-0 rule.
+     */
+    static const int RULE_SEVEN_ZERO = 1;
+
+    /**
+     * Rule flag: draw two stack rule.
+     */
+    static const int RULE_DRAW2_STACK = 2;
+
+    /**
+     * Unfinished games are stopped after this number of actions.
+     */
+    static const int MAX_TURNS = 1000;
+
+    /**
+     * How many games in a shard played by a worker process.
+     */
+    static const int SHARD_GAMES = 1000;
+
+    /**
+     * Constructor.
+     *
+     * @param threads How many threads to play games. Pass 0 to use all cores.
+     * @param seed    Base of random seeds.
+     */
+    Arena(int threads, unsigned seed);
+
+    /**
+     * Add a seat. Add 3 or 4 seats before run(int, std::ostream&).
+     *
+     * @param spec Strategy of the seat, "easy", "hard", "7-0", "policy" or
+     *             "distilled", optionally followed by ":" and the time budget
+     *             of anytime AI in milli seconds (e.g. "hard:50").
+     * @return Whether the spec is recognized.
+     */
+    bool addSeat(const std::string& spec);
+
+    /**
+     * Add a rule combination to play. When none is added, only the standard
+     * rules are played.
+     *
+     * @param name "std", "7-0", "stack" or "7-0+stack".
+     * @return Whether the name is recognized.
+     */
+    bool addRules(const std::string& name);
+
+    /**
+     * Set whether to play a drawn card at once when it is legal, under all
+     * rule combinations. Enabled by default, as it is in a new game.
+     *
+     * @param enabled Enable/Disable the force play rule.
+     */
+    void setForcePlay(bool enabled);
+
+    /**
+     * Set how many worker processes to play games. Each worker process
+     * plays its games in one thread. Ignored when worker processes are not
+     * supported (see Coordinator::isSupported()).
+     *
+     * @param processes How many worker processes, or 0 to play games by
+     *                  threads in this process (by default).
+     */
+    void setProcesses(int processes);
+
+    /**
+     * Save checkpoints to the specified file, and resume from it if it was
+     * saved by a run with the same settings. The file is removed when the
+     * run is finished.
+     *
+     * @param path    Path of the checkpoint file.
+     * @param seconds Save a checkpoint at most once in this number of
+     *                seconds.
+     */
+    void setCheckpoint(const std::string& path, int seconds = 60);
+
+    /**
+     * Play games and write the report as JSON.
+     *
+     * @param games How many games to play.
+     * @param out   Write the report to this stream.
+     * @return False if the number of seats is not 3 or 4, or a shard keeps
+     *         crashing its worker processes.
+     */
+    bool run(int games, std::ostream& out);
+}; // Arena Class
+
+#endif // __ARENA_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __BENCHMARK_H_494649FDFA62B3C015120BCB9BE17613__
+#define __BENCHMARK_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include <atomic>
+#include <vector>
+#include <ostream>
+#include "include/Color.h"
+#include "include/Uno.h"
+
+/**
+ * Benchmarks of the headless engine, built into the UnoCardBench console
+ * program (see Benchmark.pro).
+ *
+ * Micro benchmarks measure nano seconds per call of engine primitives and
+ * AI entry points. Every primitive is called on the same fixed states,
+ * which are taken from headless AI games of fixed seeds, so that results
+ * of different builds on the same machine are comparable. A primitive that
+ * changes the state is called on a fresh copy of a state each time, and
+ * the cost of copying (measured separately) is subtracted.
+ *
+ * Macro benchmarks play complete AI games with every combination of rules
+ * and difficulties, on one thread and on all cores, and measure games per
+ * second, actions per second, heap allocations per game and the peak
+ * resident memory.
+ *
+ * Heap instrumentation plays complete AI games on one thread, and counts
+ * heap allocations and frees of each game, each action and each engine
+ * entry point. A game should perform zero allocations after setup.
+ */
+class Benchmark {
+public:
+    /**
+     * How many fixed states of each kind.
+     */
+    static const int FIXTURES = 64;
+
+    /**
+     * How many heap allocations have been made. Only counted in the
+     * UnoCardBench program, which replaces the global operator new.
+     */
+    static std::atomic<long long> allocations;
+
+    /**
+     * How many heap blocks have been freed. Only counted in the
+     * UnoCardBench program, which replaces the global operator delete.
+     */
+    static std::atomic<long long> frees;
+
+private:
+    /**
+     * Master seed of fixed states.
+     */
+    unsigned seed;
+
+    /**
+     * Minimum measuring time of each benchmark, in seconds.
+     */
+    double seconds;
+
+    /**
+     * States where the current player is going to play a legal card, and
+     * the index and color of that card.
+     */
+    std::vector<Uno> plays;
+    std::vector<int> playIndexes;
+    std::vector<Color> playColors;
+
+    /**
+     * States where only one card is left in the deck, i.e. the next draw
+     * reshuffles the used cards into the deck.
+     */
+    std::vector<Uno> reshuffles;
+
+    /**
+     * Copies of states, changed by benchmarks.
+     */
+    std::vector<Uno> work;
+
+    /**
+     * Sum of benchmark results, so that calls are never optimized away.
+     */
+    long long sink;
+
+    /**
+     * Generate the fixed states. Do nothing if already generated.
+     */
+    void prepare();
+
+    /**
+     * Call a primitive on each state in turn, until the minimum measuring
+     * time is reached.
+     *
+     * @param states  The states.
+     * @param restore Whether to copy a fresh state before each call.
+     * @param op      The primitive, called as op(Uno& uno, int index),
+     *                where index is the index of the state.
+     * @return Nano seconds per call, including the cost of copying.
+     */
+    template<class F>
+    double measure(const std::vector<Uno>& states, bool restore, F op);
+
+public:
+    /**
+     * Constructor.
+     *
+     * @param seed    Master seed of fixed states.
+     * @param seconds Minimum measuring time of each benchmark, in seconds.
+     */
+    Benchmark(unsigned seed, double seconds);
+
+    /**
+     * Run micro benchmarks, and write nano seconds per call of each
+     * primitive as JSON. The policy network (see Policy class) is also
+     * measured in inferences per second, one by one and in batches.
+     *
+     * @param out Output stream.
+     */
+    void micro(std::ostream& out);
+
+    /**
+     * Run macro benchmarks, and write the results as JSON.
+     *
+     * @param games How many games to play with each combination.
+     * @param out   Output stream.
+     */
+    void macro(int games, std::ostream& out);
+
+    /**
+     * Run heap instrumentation, and write allocations and frees per game
+     * (after setup), per action and per engine entry point as JSON.
+     *
+     * @param games How many games to play with each combination.
+     * @param out   Output stream.
+     * @return Whether every game performs zero allocations after setup.
+     */
+    bool heap(int games, std::ostream& out);
+}; // Benchmark Class
+
+#endif // __BENCHMARK_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,165 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __BLUFFSOLVER_H_494649FDFA62B3C015120BCB9BE17613__
+#define __BLUFFSOLVER_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include "include/Uno.h"
+
+/**
+ * Offline solver of the [wild +4] bluff game. A player holding a [wild +4]
+ * and some cards of the current legal color may still play the [wild +4]
+ * (a bluff), and its next player, who cannot see the hand, decides whether
+ * to challenge. The solver finds a mixed strategy for both sides by CFR+
+ * (counterfactual regret minimization) over an abstraction of this game:
+ *
+ * 1. Public state: the bucket of the [wild +4] player's hand size after
+ *    playing it, the bucket of the next player's hand size, and evidence
+ *    about whether the [wild +4] player holds the previous color (see
+ *    evidenceOf(bool, bool)).
+ * 2. Chance: whether the [wild +4] player holds the previous color. Its
+ *    probability in each public state is measured in hard AI self-play
+ *    games, where AI keeps the fixed rules from before the tables existed
+ *    (see isMeasuring()), so the tables never feed back into their own
+ *    inputs and can be regenerated exactly.
+ * 3. Payoff: how much the hand sizes grow, ln((size + drawn) / size) for
+ *    the player who draws, counting the MAX_HOLD_CARDS limit.
+ *
+ * Public states are solved by all CPU cores. The result is written as a
+ * C++ header of constexpr tables (include/BluffStrategy.h), holding the
+ * probabilities (in 1/255) to bluff and to challenge in each public
+ * state. The hard AI samples from them at runtime in O(1) (see
+ * sample(int, Uno*, int)).
+ */
+class BluffSolver {
+public:
+    /**
+     * How many hand size buckets, see bucketOf(int).
+     */
+    static const int SIZE_BUCKETS = 6;
+
+    /**
+     * Evidence kinds, see evidenceOf(bool, bool).
+     */
+    static const int EVIDENCE_NONE = 0;
+    static const int EVIDENCE_WEAK = 1;
+    static const int EVIDENCE_STRONG = 2;
+    static const int EVIDENCE_COUNT = 3;
+
+private:
+    /**
+     * How many public states.
+     */
+    static const int STATE_COUNT = SIZE_BUCKETS * SIZE_BUCKETS
+        * EVIDENCE_COUNT;
+
+    /**
+     * How many threads to play games and to solve public states.
+     */
+    int threads;
+
+    /**
+     * Base of random seeds.
+     */
+    unsigned seed;
+
+    /**
+     * Measured chances. seen[s] counts how many times public state s
+     * happened, and holding[s] counts how many times of them the [wild +4]
+     * player held the previous color.
+     */
+    long long seen[STATE_COUNT], holding[STATE_COUNT];
+
+    /**
+     * Solved strategies, probabilities to bluff and to challenge.
+     */
+    double bluff[STATE_COUNT], challenge[STATE_COUNT];
+
+    /**
+     * How much the [wild +4] player gains in the equilibrium of each
+     * public state, and how much more a best response would gain.
+     */
+    double value[STATE_COUNT], exploit[STATE_COUNT];
+
+    /**
+     * Measure the chances in hard AI self-play games, with the fixed rules
+     * (see isMeasuring()).
+     *
+     * @param games How many games to play.
+     */
+    void measure(int games);
+
+    /**
+     * Solve a public state by CFR+.
+     *
+     * @param state      Solve which public state.
+     * @param iterations How many CFR+ iterations.
+     */
+    void solve(int state, int iterations);
+
+public:
+    /**
+     * @param size Hand size.
+     * @return Bucket of the hand size (0 ~ SIZE_BUCKETS - 1): 1, 2, 3,
+     *         4-5, 6-8, 9+ cards.
+     */
+    static int bucketOf(int size);
+
+    /**
+     * @param sameColor True when the [wild +4] player changes the legal
+     *                  color to the same color, which shows that it holds
+     *                  this color.
+     * @param weakColor True when the previous color is the weak color of
+     *                  the [wild +4] player, i.e. it had to draw a card in
+     *                  this color before.
+     * @return EVIDENCE_STRONG, EVIDENCE_WEAK or EVIDENCE_NONE.
+     */
+    static int evidenceOf(bool sameColor, bool weakColor);
+
+    /**
+     * Sample a mixed strategy in O(1), without changing the Uno runtime.
+     * The same decision in the same game state gets the same answer, so
+     * simulated games stay reproducible.
+     *
+     * @param chance Probability of true, in 1/255.
+     * @param uno    Provide the Uno runtime.
+     * @param salt   Tell different decisions in the same game state.
+     * @return True with the specified probability.
+     */
+    static bool sample(int chance, Uno* uno, int salt);
+
+    /**
+     * @return True when the calling thread is measuring the chances. AI
+     *         then never bluffs, and challenges by the fixed rules of the
+     *         easy level, instead of using the solved tables.
+     */
+    static bool isMeasuring();
+
+    /**
+     * Constructor.
+     *
+     * @param threads How many threads. Pass 0 to use all cores.
+     * @param seed    Base of random seeds.
+     */
+    BluffSolver(int threads, unsigned seed);
+
+    /**
+     * Run the solver.
+     *
+     * @param games      How many self-play games to measure the chances.
+     * @param iterations How many CFR+ iterations in each public state.
+     * @param path       Write the generated header to this file.
+     * @return Whether the header is written successfully.
+     */
+    bool run(int games, int iterations, const char* path);
+}; // BluffSolver Class
+
+#endif // __BLUFFSOLVER_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// Generated by "UnoCard --bluff" (see BluffSolver class).
+// Do not edit by hand. The chances are measured with the fixed
+// rules (see BluffSolver::isMeasuring()), so the same command
+// reproduces this file exactly, with any number of threads:
+// UnoCard --bluff 200000 100000 0 1 include/BluffStrategy.h
+// Games: 200000, iterations: 100000, seed: 1.
+// Worst exploitability: 0.000589975.
+
+#ifndef __BLUFFSTRATEGY_H_494649FDFA62B3C015120BCB9BE17613__
+#define __BLUFFSTRATEGY_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include "include/BluffSolver.h"
+
+/**
+ * Probability (in 1/255) to play a [wild +4] while holding the
+ * current legal color, by [your hand size after playing it]
+ * [next player's hand size] [evidence], see BluffSolver.
+ */
+static constexpr unsigned char BLUFF_PLAY[BluffSolver::SIZE_BUCKETS]
+    [BluffSolver::SIZE_BUCKETS][BluffSolver::EVIDENCE_COUNT] = {
+    {
+        { 82, 255, 55 }, // 0, 0: none 3620, weak 565, strong 1585 seen
+        { 255, 255, 5 }, // 0, 1: none 6353, weak 1241, strong 2902 seen
+        { 255, 255, 5 }, // 0, 2: none 8466, weak 1596, strong 4025 seen
+        { 255, 255, 5 }, // 0, 3: none 15024, weak 3230, strong 7023 seen
+        { 255, 255, 4 }, // 0, 4: none 9291, weak 2082, strong 5318 seen
+        { 0, 0, 0 }  // 0, 5: none 1354, weak 342, strong 818 seen
+    },
+    {
+        { 41, 161, 41 }, // 1, 0: none 7218, weak 1211, strong 3092 seen
+        { 98, 255, 2 }, // 1, 1: none 12833, weak 3135, strong 5730 seen
+        { 97, 255, 1 }, // 1, 2: none 20635, weak 3950, strong 9076 seen
+        { 88, 255, 1 }, // 1, 3: none 36863, weak 10406, strong 15969 seen
+        { 78, 255, 1 }, // 1, 4: none 20349, weak 6838, strong 10285 seen
+        { 0, 0, 0 }  // 1, 5: none 2444, weak 990, strong 1459 seen
+    },
+    {
+        { 26, 102, 34 }, // 2, 0: none 6739, weak 1024, strong 3155 seen
+        { 47, 252, 1 }, // 2, 1: none 18451, weak 4677, strong 8208 seen
+        { 48, 255, 1 }, // 2, 2: none 28966, weak 7161, strong 12775 seen
+        { 45, 255, 1 }, // 2, 3: none 68428, weak 21058, strong 28690 seen
+        { 40, 255, 1 }, // 2, 4: none 35925, weak 12506, strong 16500 seen
+        { 0, 0, 0 }  // 2, 5: none 3190, weak 1493, strong 2138 seen
+    },
+    {
+        { 16, 59, 25 }, // 3, 0: none 10824, weak 1762, strong 5021 seen
+        { 27, 108, 1 }, // 3, 1: none 30683, weak 7484, strong 13175 seen
+        { 27, 130, 1 }, // 3, 2: none 52942, weak 12473, strong 23930 seen
+        { 26, 166, 0 }, // 3, 3: none 198841, weak 56304, strong 81564 seen
+        { 23, 159, 0 }, // 3, 4: none 170814, weak 34782, strong 64775 seen
+        { 0, 0, 0 }  // 3, 5: none 9002, weak 3728, strong 6797 seen
+    },
+    {
+        { 7, 28, 17 }, // 4, 0: none 7141, weak 1427, strong 3194 seen
+        { 13, 50, 1 }, // 4, 1: none 16935, weak 5038, strong 7323 seen
+        { 14, 61, 1 }, // 4, 2: none 24601, weak 7281, strong 10774 seen
+        { 12, 103, 1 }, // 4, 3: none 77535, weak 41052, strong 35455 seen
+        { 15, 114, 0 }, // 4, 4: none 171682, weak 38231, strong 61314 seen
+        { 0, 0, 0 }  // 4, 5: none 5881, weak 3529, strong 4042 seen
+    },
+    {
+        { 3, 17, 10 }, // 5, 0: none 1289, weak 219, strong 638 seen
+        { 6, 30, 1 }, // 5, 1: none 2898, weak 800, strong 1179 seen
+        { 6, 44, 1 }, // 5, 2: none 3368, weak 1023, strong 1467 seen
+        { 6, 58, 1 }, // 5, 3: none 8339, weak 2951, strong 3688 seen
+        { 6, 71, 1 }, // 5, 4: none 5266, weak 2140, strong 2253 seen
+        { 0, 0, 0 }  // 5, 5: none 535, weak 409, strong 282 seen
+    }
+}; // BLUFF_PLAY[][][]
+
+/**
+ * Probability (in 1/255) to challenge a [wild +4], by [hand size of
+ * who played it] [your hand size] [evidence], see BluffSolver.
+ */
+static constexpr unsigned char BLUFF_CHALLENGE[BluffSolver::SIZE_BUCKETS]
+    [BluffSolver::SIZE_BUCKETS][BluffSolver::EVIDENCE_COUNT] = {
+    {
+        { 128, 0, 128 }, // 0, 0: none 3620, weak 565, strong 1585 seen
+        { 0, 0, 104 }, // 0, 1: none 6353, weak 1241, strong 2902 seen
+        { 0, 0, 88 }, // 0, 2: none 8466, weak 1596, strong 4025 seen
+        { 0, 0, 73 }, // 0, 3: none 15024, weak 3230, strong 7023 seen
+        { 0, 0, 56 }, // 0, 4: none 9291, weak 2082, strong 5318 seen
+        { 255, 255, 255 }  // 0, 5: none 1354, weak 342, strong 818 seen
+    },
+    {
+        { 152, 151, 152 }, // 1, 0: none 7218, weak 1211, strong 3092 seen
+        { 128, 0, 128 }, // 1, 1: none 12833, weak 3135, strong 5730 seen
+        { 111, 0, 112 }, // 1, 2: none 20635, weak 3950, strong 9076 seen
+        { 94, 0, 94 }, // 1, 3: none 36863, weak 10406, strong 15969 seen
+        { 74, 0, 75 }, // 1, 4: none 20349, weak 6838, strong 10285 seen
+        { 255, 255, 255 }  // 1, 5: none 2444, weak 990, strong 1459 seen
+    },
+    {
+        { 167, 167, 167 }, // 2, 0: none 6739, weak 1024, strong 3155 seen
+        { 144, 144, 145 }, // 2, 1: none 18451, weak 4677, strong 8208 seen
+        { 128, 0, 128 }, // 2, 2: none 28966, weak 7161, strong 12775 seen
+        { 110, 0, 110 }, // 2, 3: none 68428, weak 21058, strong 28690 seen
+        { 89, 0, 89 }, // 2, 4: none 35925, weak 12506, strong 16500 seen
+        { 255, 255, 255 }  // 2, 5: none 3190, weak 1493, strong 2138 seen
+    },
+    {
+        { 183, 183, 183 }, // 3, 0: none 10824, weak 1762, strong 5021 seen
+        { 162, 161, 162 }, // 3, 1: none 30683, weak 7484, strong 13175 seen
+        { 146, 146, 146 }, // 3, 2: none 52942, weak 12473, strong 23930 seen
+        { 128, 127, 128 }, // 3, 3: none 198841, weak 56304, strong 81564 seen
+        { 106, 105, 107 }, // 3, 4: none 170814, weak 34782, strong 64775 seen
+        { 255, 255, 255 }  // 3, 5: none 9002, weak 3728, strong 6797 seen
+    },
+    {
+        { 200, 200, 200 }, // 4, 0: none 7141, weak 1427, strong 3194 seen
+        { 181, 181, 181 }, // 4, 1: none 16935, weak 5038, strong 7323 seen
+        { 167, 167, 167 }, // 4, 2: none 24601, weak 7281, strong 10774 seen
+        { 149, 149, 150 }, // 4, 3: none 77535, weak 41052, strong 35455 seen
+        { 128, 128, 128 }, // 4, 4: none 171682, weak 38231, strong 61314 seen
+        { 255, 255, 255 }  // 4, 5: none 5881, weak 3529, strong 4042 seen
+    },
+    {
+        { 222, 222, 222 }, // 5, 0: none 1289, weak 219, strong 638 seen
+        { 210, 210, 210 }, // 5, 1: none 2898, weak 800, strong 1179 seen
+        { 199, 199, 199 }, // 5, 2: none 3368, weak 1023, strong 1467 seen
+        { 185, 185, 186 }, // 5, 3: none 8339, weak 2951, strong 3688 seen
+        { 167, 167, 167 }, // 5, 4: none 5266, weak 2140, strong 2253 seen
+        { 255, 255, 255 }  // 5, 5: none 535, weak 409, strong 282 seen
+    }
+}; // BLUFF_CHALLENGE[][][]
+
+#endif // __BLUFFSTRATEGY_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
@@ -15,6 +15,10 @@
 #include "include/Color.h"
 #include "include/Content.h"
 
+namespace reference {
+class Uno;
+} // namespace reference
+
 /**
  * Uno Card Class.
  */
@@ -115,6 +119,12 @@ private:
      * our private fields (to change the wild color when necessary).
      */
     friend class Uno;
+
+    /**
+     * Grant the reference copy of Uno class (see reference/Uno.h) to read
+     * our private fields.
+     */
+    friend class reference::Uno;
 }; // Card Class
 
 #endif // __CARD_H_494649FDFA62B3C015120BCB9BE17613__
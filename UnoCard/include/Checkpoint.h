@@ -0,0 +1,55 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CHECKPOINT_H_494649FDFA62B3C015120BCB9BE17613__
+#define __CHECKPOINT_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include <string>
+
+/**
+ * Crash-safe checkpoint files of long batch runs (see Arena and Tuner
+ * classes). A checkpoint is written to a temporary file, flushed to disk,
+ * and then renamed over the old checkpoint, so that a crash or a reboot
+ * at any time leaves either the old or the new checkpoint. A checksum is
+ * stored with the data, so that a damaged file is never loaded.
+ *
+ * The data is binary, and can only be loaded on the same kind of machine
+ * by the same build.
+ */
+class Checkpoint {
+public:
+    /**
+     * Save a checkpoint.
+     *
+     * @param path Path of the checkpoint file.
+     * @param data Data of the checkpoint.
+     * @return Whether the checkpoint is saved successfully.
+     */
+    static bool save(const std::string& path, const std::string& data);
+
+    /**
+     * Load a checkpoint.
+     *
+     * @param path    Path of the checkpoint file.
+     * @param outData Out parameter. Receive the data of the checkpoint.
+     * @return False if there is no checkpoint, or it is damaged.
+     */
+    static bool load(const std::string& path, std::string& outData);
+
+    /**
+     * Remove a checkpoint, after the run is finished.
+     *
+     * @param path Path of the checkpoint file.
+     */
+    static void remove(const std::string& path);
+}; // Checkpoint Class
+
+#endif // __CHECKPOINT_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
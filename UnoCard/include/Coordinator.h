@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __COORDINATOR_H_494649FDFA62B3C015120BCB9BE17613__
+#define __COORDINATOR_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include <string>
+#include <functional>
+
+/**
+ * Multi-process coordinator of batch jobs. A big job is split into shards
+ * (e.g. seed ranges), which are run by local worker processes, forked from
+ * this process and connected to it by Unix domain sockets. A worker runs
+ * one shard at a time, and streams its result back as compact binary data.
+ *
+ * Workers are isolated from each other and from this process: when a
+ * worker crashes, its shard is given to a new worker. Results are merged
+ * in this process strictly in the order of shards, so the merged result
+ * does not depend on the number of workers, or on which shard finishes
+ * first.
+ *
+ * Only supported on POSIX systems, see isSupported().
+ */
+class Coordinator {
+private:
+    /**
+     * How many worker processes.
+     */
+    int processes;
+
+    /**
+     * How many times workers have been replaced after a crash.
+     */
+    int restarts;
+
+public:
+    /**
+     * A shard is given up after failing this number of times.
+     */
+    static const int MAX_FAILURES = 3;
+
+    /**
+     * @return Whether worker processes are supported on this system.
+     */
+    static bool isSupported();
+
+    /**
+     * Constructor.
+     *
+     * @param processes How many worker processes. Pass 0 to use all cores.
+     */
+    Coordinator(int processes);
+
+    /**
+     * @return How many times workers have been replaced after a crash.
+     */
+    int getRestarts();
+
+    /**
+     * Run shards 0 ~ shards - 1 in worker processes, and return when all of
+     * them are merged. Must be called when no other threads are running in
+     * this process, since workers are forked from it.
+     *
+     * @param shards How many shards.
+     * @param work   Run a shard in a worker process. Called with the shard
+     *               number, and returns the result as binary data.
+     * @param merge  Merge the result of a shard in this process. Called with
+     *               the shard number and its result, in the order of
+     *               shards.
+     * @return False if a shard fails MAX_FAILURES times, or worker
+     *         processes are not supported.
+     */
+    bool run(int shards, const std::function<std::string(int)>& work,
+             const std::function<void(int, const std::string&)>& merge);
+}; // Coordinator Class
+
+#endif // __COORDINATOR_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
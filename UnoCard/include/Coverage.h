@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __COVERAGE_H_494649FDFA62B3C015120BCB9BE17613__
+#define __COVERAGE_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include <ostream>
+
+// Branch coverage is only counted in debug builds
+#if !defined(QT_NO_DEBUG) && !defined(NDEBUG)
+#define UNO_COVERAGE 1
+#endif // !defined(QT_NO_DEBUG) && !defined(NDEBUG)
+
+/**
+ * Branch coverage counters of AI decision trees. Each branch (a site marked
+ * by AI_BRANCH) counts how many times it is taken, and, for the decisions
+ * made in a game driven by Simulator, how many of these games are finished
+ * and won by the player who took it. Counters are kept per thread, and are
+ * merged when the thread exits or when report(std::ostream&) is called.
+ *
+ * Only available when UNO_COVERAGE is defined, i.e. in debug builds. In
+ * release builds, AI_BRANCH(tag, value) is just (value), and the report
+ * says that nothing is counted.
+ */
+class Coverage {
+public:
+    /**
+     * Register a branch. Called once for each AI_BRANCH site.
+     *
+     * @param tag  Which decision tree, e.g. "hard".
+     * @param line Source line of the branch.
+     * @param expr Source text of the branch's answer.
+     * @return Branch ID.
+     */
+    static int site(const char* tag, int line, const char* expr);
+
+    /**
+     * Count a taken branch.
+     *
+     * @param site  Branch ID.
+     * @param who   Who took the branch.
+     * @param value Answer of the branch.
+     * @return value.
+     */
+    static int hit(int site, int who, int value);
+
+    /**
+     * Start to record the taken branches of a game in the calling thread.
+     * Games can be nested (e.g. simulated games inside AI's thinking).
+     *
+     * @return A mark to pass to endGame(int, int).
+     */
+    static int beginGame();
+
+    /**
+     * Stop recording a game, and count the outcome of all branches taken
+     * since the matching beginGame().
+     *
+     * @param mark   Return value of the matching beginGame().
+     * @param winner Who won the game, or -1 when not finished.
+     */
+    static void endGame(int mark, int winner);
+
+    /**
+     * Write a report of all threads' counters, ranked by frequency and by
+     * win contribution (wins more than the average win rate of all taken
+     * branches would expect).
+     *
+     * @param out Output stream.
+     */
+    static void report(std::ostream& out);
+
+    /**
+     * Clear the merged counters and the calling thread's counters.
+     */
+    static void reset();
+}; // Coverage Class
+
+#ifdef UNO_COVERAGE
+#define AI_BRANCH(tag, value) Coverage::hit([] {                           \
+        static const int site = Coverage::site(tag, __LINE__, #value);     \
+        return site;                                                       \
+    }(), uno->getNow(), (value))
+#else
+#define AI_BRANCH(tag, value) (value)
+#endif // UNO_COVERAGE
+
+#endif // __COVERAGE_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __DIFFER_H_494649FDFA62B3C015120BCB9BE17613__
+#define __DIFFER_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include <vector>
+#include <ostream>
+#include "include/Color.h"
+
+/**
+ * Differential equivalence checker between the real headless engine (Uno,
+ * AI and Simulator classes) and its frozen reference copy (see
+ * reference/Uno.h), built into the UnoCardBench console program.
+ *
+ * Both engines play the same seeds side by side. Before every action, the
+ * state hashes (see Uno::getStateHash()) and the pending decisions of both
+ * engines must be equal, and the decision is applied to both engines.
+ * Seeds are checked by all CPU cores. When a divergence is found, the
+ * action sequence of that game is minimized (by delta debugging) to the
+ * shortest sequence that still makes the engines diverge, when replayed on
+ * the same seed with the same rules.
+ *
+ * The batched easy AI (see Lockstep class) is checked in the same way
+ * against the real headless engine driven by EasyAgent, since it claims to
+ * make exactly the same decisions.
+ */
+class Differ {
+public:
+    /**
+     * A decision, which can be replayed on both engines.
+     */
+    struct Action {
+        /**
+         * Who plays or draws (Player::YOU ~ Player::COM3), or one of
+         * Simulator::STAT_WILD_COLOR, STAT_DOUBT_WILD4 and
+         * STAT_SEVEN_TARGET.
+         */
+        int status;
+
+        /**
+         * Color and content of the played card. Content is -1 to draw.
+         */
+        Color color;
+        int content;
+
+        /**
+         * The selected color (for a wild card or in STAT_WILD_COLOR),
+         * 1 / 0 to challenge or not, or the swap target.
+         */
+        int value;
+    }; // Action Struct
+
+    /**
+     * Stop comparing a game when this number of turns is reached.
+     */
+    static const int MAX_TURNS = 1000;
+
+private:
+    /**
+     * How many threads.
+     */
+    int threads;
+
+    /**
+     * Rules of checked games.
+     */
+    int players, difficulty;
+    bool forcePlay, sevenZeroRule, draw2StackRule;
+
+    /**
+     * Play a game on both engines, and find the first divergence.
+     *
+     * @param seed    Seed of the game.
+     * @param actions Decisions to replay. When record is true, it is
+     *                cleared and receives the decisions made by AI.
+     * @param record  Let AI make all decisions instead of replaying.
+     * @return How many actions are applied before the engines diverge, or
+     *         -1 if they never diverge (or a replayed action cannot be
+     *         applied).
+     */
+    int compare(unsigned seed, std::vector<Action>& actions, bool record);
+
+    /**
+     * Minimize a diverging action sequence by delta debugging.
+     *
+     * @param seed    Seed of the game.
+     * @param actions Provide a diverging action sequence, and receive the
+     *                minimized one.
+     */
+    void minimize(unsigned seed, std::vector<Action>& actions);
+
+public:
+    /**
+     * Constructor.
+     *
+     * @param threads How many threads. Pass 0 to use all cores.
+     */
+    Differ(int threads);
+
+    /**
+     * Set the rules of checked games. By default, 4 players, hard level,
+     * force play, and no 7-0 or +2 stack rules. Only the easy and hard
+     * levels can be checked, since the reference copy has no other AI.
+     */
+    void setRules(int players, int difficulty, bool forcePlay,
+                  bool sevenZeroRule, bool draw2StackRule);
+
+    /**
+     * Check seeds firstSeed ~ firstSeed + count - 1, and write the result
+     * as JSON, with the minimized action sequence of the first divergence.
+     * Stop checking soon after a divergence is found.
+     *
+     * @param firstSeed The first seed to check.
+     * @param count     How many seeds to check.
+     * @param out       Output stream.
+     * @return Whether both engines are equivalent in all checked seeds.
+     */
+    bool run(unsigned firstSeed, int count, std::ostream& out);
+
+    /**
+     * Check seeds firstSeed ~ firstSeed + count - 1 on the batched easy AI
+     * (see Lockstep class) against Simulator with EasyAgent, and write the
+     * result as JSON. After every decision, the status, the number of turns
+     * and the hand sizes of each lane must equal those of the simulator
+     * playing the same seed. Only the current rules without 7-0 rule are
+     * checked, always in easy level.
+     *
+     * @param firstSeed The first seed to check.
+     * @param count     How many seeds to check.
+     * @param out       Output stream.
+     * @return Whether both engines are equivalent in all checked seeds.
+     */
+    bool lockstep(unsigned firstSeed, int count, std::ostream& out);
+}; // Differ Class
+
+#endif // __DIFFER_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
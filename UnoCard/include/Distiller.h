@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __DISTILLER_H_494649FDFA62B3C015120BCB9BE17613__
+#define __DISTILLER_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include "include/Color.h"
+#include "include/Card.h"
+#include "include/Uno.h"
+
+/**
+ * Offline distillation of the anytime search AI into a lookup table (see
+ * AI::distilledAI_bestCardIndex4NowPlayer). The table has the same shape
+ * as the decision tree of the easy AI: positions are sorted into a few
+ * cells by hand sizes and colors (see cellOf(Uno*, Color)), and each cell
+ * holds a priority order of card kinds (see kindOf(Card*)). The first
+ * legal kind in the order is played, in the player's best color if any.
+ *
+ * The distiller samples positions from hard AI self-play games, lets the
+ * search AI choose a card in each of them (by all CPU cores), and fits
+ * the priority order of each cell to the search AI's choices. The result
+ * is written as a C++ header of constexpr tables (include/Distilled.h),
+ * which is compiled into the game.
+ */
+class Distiller {
+public:
+    /**
+     * Card kinds.
+     */
+    static const int KIND_NUM = 0;
+    static const int KIND_REV = 1;
+    static const int KIND_SKIP = 2;
+    static const int KIND_DRAW2 = 3;
+    static const int KIND_WILD = 4;
+    static const int KIND_WD4 = 5;
+    static const int KIND_COUNT = 6;
+
+    /**
+     * How many cells.
+     */
+    static const int CELL_COUNT = 64;
+
+private:
+    /**
+     * How many threads to run the search AI.
+     */
+    int threads;
+
+    /**
+     * Node budget of the search AI, see Uno::setThinkNodes(int).
+     */
+    int nodes;
+
+    /**
+     * Base of random seeds.
+     */
+    unsigned seed;
+
+    /**
+     * Search AI's choices. hist[cell][legal][kind] counts how many times
+     * the search AI played a card of the kind, in the positions of the
+     * cell, where the legal kinds are the bits of legal.
+     */
+    long long hist[CELL_COUNT][1 << KIND_COUNT][KIND_COUNT];
+
+    /**
+     * Fitted priority order of card kinds in each cell.
+     */
+    int order[CELL_COUNT][KIND_COUNT];
+
+    /**
+     * Sample a position, and let the search AI make its choice.
+     *
+     * @param index     Index of the position. Position i uses seed + i.
+     * @param outCell   Out parameter. Cell of the position.
+     * @param outLegal  Out parameter. Legal card kinds, as bits.
+     * @param outKind   Out parameter. Kind of the chosen card.
+     * @return Whether the position is useful, i.e. the player has at least
+     *         two legal kinds, and the search AI plays one of them.
+     */
+    bool sample(int index, int outCell[], int outLegal[], int outKind[]);
+
+    /**
+     * Fit the priority order of a cell to the search AI's choices.
+     *
+     * @param cell Fit which cell.
+     */
+    void fit(int cell);
+
+    /**
+     * Count how many choices of the search AI are the same as the choices
+     * of the specified priority orders.
+     *
+     * @param orders Priority orders of card kinds in each cell.
+     * @return How many choices are the same.
+     */
+    long long agree(const int orders[][KIND_COUNT]);
+
+public:
+    /**
+     * @param card Provide a card.
+     * @return Kind of the card, one of the KIND_* constants.
+     */
+    static int kindOf(Card* card);
+
+    /**
+     * @param uno       Provide the Uno runtime.
+     * @param bestColor Best color of current player.
+     * @return Cell of the position of current player (0 ~ CELL_COUNT - 1).
+     */
+    static int cellOf(Uno* uno, Color bestColor);
+
+    /**
+     * Priority order of card kinds used by the easy AI in a cell. Used in
+     * cells where the search AI has made no choices, and to break ties.
+     *
+     * @param cell     Provide a cell.
+     * @param outOrder Out parameter. Pass an int array (length>=KIND_COUNT)
+     *                 to receive the order.
+     */
+    static void defaultOrder(int cell, int outOrder[]);
+
+    /**
+     * Constructor.
+     *
+     * @param threads How many threads to run the search AI. Pass 0 to use
+     *                all cores.
+     * @param nodes   Node budget of the search AI in each position.
+     * @param seed    Base of random seeds.
+     */
+    Distiller(int threads, int nodes, unsigned seed);
+
+    /**
+     * Run the distiller.
+     *
+     * @param positions How many positions to sample.
+     * @param path      Write the generated header to this file.
+     * @return Whether the header is written successfully.
+     */
+    bool run(int positions, const char* path);
+}; // Distiller Class
+
+#endif // __DISTILLER_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __ESTIMATOR_H_494649FDFA62B3C015120BCB9BE17613__
+#define __ESTIMATOR_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <ostream>
+#include <unordered_map>
+#include "include/Uno.h"
+
+/**
+ * Win probability estimator. Estimates everyone's win chance in the
+ * current game state, in two steps:
+ *
+ * 1. A lookup table over (hand sizes, whose turn, direction), built when
+ *    constructed. The table is solved from a simple race model, where a
+ *    player plays a card with a probability that grows with the hand size,
+ *    and the played card is an action card as often as in the deck. It
+ *    knows nothing about colors, 7-0 rule or draw two stack rule.
+ * 2. Simulated games in a sub thread, played from a player's view (the
+ *    cards unknown to the player are redealt) by the fixed AI strategies.
+ *    The table value is used as a prior worth PRIOR_GAMES games, so the
+ *    estimate moves from the table value to the simulated win rates as
+ *    more games are simulated.
+ *
+ * Estimates are cached by state hash, so calling estimate(Uno*, int,
+ * double[]) again with the same game state costs a single hash lookup.
+ */
+class Estimator {
+private:
+    /**
+     * Estimate of a game state.
+     */
+    struct Entry {
+        double prior[4];
+        long long wins[4];
+        long long games;
+    }; // Entry Struct
+
+    /**
+     * Lookup tables for 3-player and 4-player games. See lookup(Uno*,
+     * double[]) for the layout.
+     */
+    std::vector<float> table[2];
+
+    /**
+     * Worker thread.
+     */
+    std::thread thread;
+
+    /**
+     * Set to true to stop the worker thread.
+     */
+    std::atomic<bool> cancelled;
+
+    /**
+     * Increased each time an estimate changes.
+     */
+    std::atomic<int> version;
+
+    /**
+     * Guards [cache].
+     */
+    std::mutex mutex;
+
+    /**
+     * Cached estimates. Key is the state hash mixed with the view.
+     */
+    std::unordered_map<unsigned long long, Entry> cache;
+
+    /**
+     * Cache key of the game state being simulated, or 0 if none.
+     */
+    unsigned long long root;
+
+    /**
+     * Solve the lookup table of the specified number of players.
+     *
+     * @param players How many players in game, 3 or 4.
+     */
+    void solve(int players);
+
+    /**
+     * Worker thread entry.
+     *
+     * @param game A copy of the Uno runtime.
+     * @param view Simulate games from whose view.
+     * @param key  Cache key of the game state.
+     */
+    void run(Uno game, int view, unsigned long long key);
+
+    /**
+     * Publish the results so far.
+     *
+     * @param key   Cache key of the game state.
+     * @param wins  How many games each player won.
+     * @param games How many games have a winner.
+     * @return False if the cache entry has been thrown away, so the worker
+     *         thread should stop.
+     */
+    bool publish(unsigned long long key, const long long wins[],
+                 long long games);
+
+public:
+    /**
+     * Hand sizes are capped to this value in the lookup table.
+     */
+    static const int MAX_SIZE = 8;
+
+    /**
+     * The table value is worth this number of simulated games.
+     */
+    static const int PRIOR_GAMES = 32;
+
+    /**
+     * Stop simulating a game state after this number of games.
+     */
+    static const int MAX_GAMES = 1024;
+
+    /**
+     * Unfinished simulated games are given up after this number of actions.
+     */
+    static const int MAX_TURNS = 200;
+
+    /**
+     * Clear the cache when it holds more estimates than this.
+     */
+    static const int MAX_CACHE = 4096;
+
+    /**
+     * Constructor. Solves the lookup tables.
+     */
+    Estimator();
+
+    /**
+     * Look up the table value of the current game state, without cache or
+     * simulation.
+     *
+     * @param uno Provide the Uno runtime.
+     * @param out Out parameter. Win probabilities, indexed by Player::YOU,
+     *            Player::COM1, Player::COM2, Player::COM3. The value of the
+     *            absent player in 3-player games is 0.
+     */
+    void lookup(Uno* uno, double out[]);
+
+    /**
+     * Estimate everyone's win probability in the current game state. When
+     * the state is new, its simulation starts in background, and the
+     * simulation of the previous state stops.
+     *
+     * @param uno  Provide the Uno runtime.
+     * @param view Simulate games from whose view. Must be one of the
+     *             following: Player::YOU, Player::COM1, Player::COM2,
+     *             Player::COM3.
+     * @param out  Out parameter. See lookup(Uno*, double[]).
+     * @return How many simulated games are included in the estimate.
+     */
+    long long estimate(Uno* uno, int view, double out[]);
+
+    /**
+     * Write everyone's win probability from your view as a line of log.
+     *
+     * @param uno Provide the Uno runtime.
+     * @param out Output stream.
+     */
+    void log(Uno* uno, std::ostream& out);
+
+    /**
+     * @return A number that changes each time an estimate changes. Compare
+     *         it with the value got last time to know when to repaint.
+     */
+    int getVersion();
+
+    /**
+     * Stop the background simulation.
+     */
+    void cancel();
+
+    /**
+     * Destructor.
+     */
+    ~Estimator();
+}; // Estimator Class
+
+#endif // __ESTIMATOR_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __HINTER_H_494649FDFA62B3C015120BCB9BE17613__
+#define __HINTER_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include <atomic>
+#include <thread>
+#include "include/Uno.h"
+#include "include/Color.h"
+
+/**
+ * Move hints for you. While you are thinking in your turn, evaluate all of
+ * your legal actions (every legal card, every following color of a wild
+ * card, and drawing a card) by simulated games in a sub thread. The hint
+ * starts with the answer of the fixed AI strategies, and is replaced by
+ * the action that wins significantly more often in the simulated games,
+ * so it keeps improving while the search goes on.
+ *
+ * The search checks its cancel flag every few turns of a simulated game,
+ * so cancel() returns within a fraction of a milli second. The current
+ * hint is published as a single atomic value, so reading it never waits
+ * for the search.
+ */
+class Hinter {
+private:
+    /**
+     * Worker thread.
+     */
+    std::thread thread;
+
+    /**
+     * Set to true to stop the worker thread.
+     */
+    std::atomic<bool> cancelled;
+
+    /**
+     * Current hint, packed as (index + 1) * 8 + color, where index -1
+     * means to draw a card. Or -1 if no hint is available yet.
+     */
+    std::atomic<int> hint;
+
+    /**
+     * Increased each time the hint changes.
+     */
+    std::atomic<int> version;
+
+    /**
+     * State hash of the Uno runtime being searched, or 0 if none.
+     */
+    unsigned long long root;
+
+    /**
+     * Publish a new hint.
+     *
+     * @param index Play which card, or -1 to draw a card.
+     * @param color Following legal color when playing a wild card.
+     */
+    void publish(int index, Color color);
+
+    /**
+     * Worker thread entry.
+     *
+     * @param game A copy of the Uno runtime in your turn.
+     */
+    void run(Uno game);
+
+public:
+    /**
+     * Unfinished simulated games are given up after this number of actions.
+     */
+    static const int MAX_TURNS = 200;
+
+    /**
+     * Stop searching after this number of rounds (one simulated game for
+     * each legal action per round).
+     */
+    static const int MAX_ROUNDS = 5000;
+
+    /**
+     * Constructor.
+     */
+    Hinter();
+
+    /**
+     * Start to search in background. Call this function when you are
+     * thinking in your turn. Calling it again with the same game state
+     * does nothing.
+     *
+     * @param uno Provide the Uno runtime.
+     */
+    void start(Uno* uno);
+
+    /**
+     * Stop the background search and throw away the hint.
+     */
+    void cancel();
+
+    /**
+     * Get the current hint. Never blocks.
+     *
+     * @param uno      Provide the Uno runtime.
+     * @param outIndex Out parameter. Index of the hinted card to play, or a
+     *                 negative number that means to draw a card.
+     * @param outColor Out parameter. When the hinted card is a wild card,
+     *                 outColor[0] becomes the following legal color to
+     *                 change. Otherwise it becomes NONE.
+     * @return Whether a hint for the current game state is available.
+     */
+    bool getHint(Uno* uno, int* outIndex, Color outColor[]);
+
+    /**
+     * @return A number that changes each time the hint changes. Compare it
+     *         with the value got last time to know when to repaint.
+     */
+    int getVersion();
+
+    /**
+     * Destructor.
+     */
+    ~Hinter();
+}; // Hinter Class
+
+#endif // __HINTER_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
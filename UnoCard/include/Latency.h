@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LATENCY_H_494649FDFA62B3C015120BCB9BE17613__
+#define __LATENCY_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include <chrono>
+#include <ostream>
+
+/**
+ * Latency histograms of AI entry points, one for each entry point and each
+ * difficulty. Like HdrHistogram, values are counted in log-linear buckets
+ * (16 buckets per power of 2, i.e. 1/16 relative precision), so that both
+ * sub-microsecond and multi-second latencies fit in a fixed amount of
+ * memory.
+ *
+ * Only top-level decisions are timed, i.e. decisions at a table. Calls
+ * nested in another timed call (e.g. AI decisions in the simulated games
+ * of search and rollouts), or made in a Mute scope (e.g. by background
+ * helpers), are neither timed nor recorded. Each thread counts in its own
+ * histograms without synchronization, which are merged when the thread
+ * exits, or into the calling thread's view when dump(std::ostream&) is
+ * called.
+ */
+class Latency {
+public:
+    /**
+     * AI entry points.
+     */
+    static const int BEST_COLOR = 0;
+    static const int SWAP_TARGET = 1;
+    static const int CHALLENGE = 2;
+    static const int EASY_AI = 3;
+    static const int HARD_AI = 4;
+    static const int SEVEN_ZERO_AI = 5;
+    static const int POLICY_AI = 6;
+    static const int SEARCH_AI = 7;
+    static const int DISTILLED_AI = 8;
+    static const int ENTRY_COUNT = 9;
+
+    /**
+     * How many difficulties (see Uno::LV_*).
+     */
+    static const int LEVEL_COUNT = 3;
+
+    /**
+     * How many buckets in a histogram.
+     */
+    static const int BUCKET_COUNT = 16 * 61;
+
+    /**
+     * Measure the latency of a scope, and record it when leaving the scope.
+     * Does nothing when nested in another Timer or Mute scope.
+     */
+    class Timer {
+    private:
+        int entry, level;
+        bool top;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param entry AI entry point.
+         * @param level Current difficulty.
+         */
+        Timer(int entry, int level);
+
+        /**
+         * Destructor.
+         */
+        ~Timer();
+    }; // Timer Class
+
+    /**
+     * Do not time or record any call in a scope, on the calling thread.
+     * Used by the threads that play simulated games in background.
+     */
+    class Mute {
+    public:
+        /**
+         * Constructor.
+         */
+        Mute();
+
+        /**
+         * Destructor.
+         */
+        ~Mute();
+    }; // Mute Class
+
+    /**
+     * Record a latency in the calling thread's histograms.
+     *
+     * @param entry AI entry point.
+     * @param level Current difficulty.
+     * @param nanos Latency in nano seconds.
+     */
+    static void record(int entry, int level, long long nanos);
+
+    /**
+     * @param entry AI entry point.
+     * @param level Difficulty.
+     * @return How many latencies are recorded, by the exited threads and
+     *         by the calling thread.
+     */
+    static long long getCount(int entry, int level);
+
+    /**
+     * @param entry AI entry point.
+     * @param level Difficulty.
+     * @param q     Quantile, in range [0, 1], e.g. 0.99 for p99.
+     * @return The latency (in nano seconds) that q of all recorded
+     *         latencies do not exceed, rounded up to its bucket's bound.
+     *         Or 0 if nothing is recorded.
+     */
+    static long long getPercentile(int entry, int level, double q);
+
+    /**
+     * @param entry AI entry point.
+     * @param level Difficulty.
+     * @return The max latency in nano seconds, or 0 if nothing is recorded.
+     */
+    static long long getMax(int entry, int level);
+
+    /**
+     * Write p50, p99 and max of all non-empty histograms as a JSON array,
+     * recorded by the exited threads and by the calling thread.
+     *
+     * @param out Output stream.
+     */
+    static void dump(std::ostream& out);
+
+    /**
+     * Clear the merged histograms and the calling thread's histograms.
+     */
+    static void reset();
+}; // Latency Class
+
+#endif // __LATENCY_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
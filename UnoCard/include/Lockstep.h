@@ -0,0 +1,230 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LOCKSTEP_H_494649FDFA62B3C015120BCB9BE17613__
+#define __LOCKSTEP_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include "include/Uno.h"
+#include "include/Color.h"
+
+/**
+ * Lockstep multi-game engine for bulk rollouts. Plays LANES independent
+ * games at once, where everyone is driven by the EASY AI strategies. Each
+ * call of step() lets every unfinished game (lane) make its pending
+ * decision. Games are stored in a compact structure-of-arrays layout
+ * (plain card IDs, no Card pointers or std::vector), and the per-hand
+ * work of each step (legal cards, color and content masks, and the hand
+ * popcounts of the best color calculation) is done for all lanes in one
+ * pass. When compiled with AVX2 (qmake CONFIG+=avx2), this pass handles
+ * two lanes per instruction, otherwise a scalar fallback is used.
+ *
+ * The results are exactly the same as driving each game by a Simulator
+ * with EasyAgent (see Simulator::run(int, A&)), including the random
+ * numbers drawn, so a lane can replace a Simulator in any rollout with
+ * the same seeds. Games in 7-0 rule, with AI budgets, or in other
+ * difficulties (where challenges follow BluffSolver) are not supported,
+ * since they need other AI strategies.
+ */
+class Lockstep {
+public:
+    /**
+     * How many games are played at once.
+     */
+    static const int LANES = 16;
+
+private:
+    /**
+     * Masks over the hand cards of each lane's current player. Bit i
+     * stands for the card at index i.
+     */
+    struct Masks {
+        unsigned legal;
+        unsigned color[5];
+        unsigned num, zeroRev, skipDraw2;
+        unsigned draw2, skip, rev, wild, wd4;
+    }; // Masks Struct
+
+    // Game states of all lanes, see the same members in Uno and Player
+    // classes. Hand cards of each player are padded to 16 bytes, with
+    // color and content stored beside each card ID.
+    alignas(32) unsigned char hand[LANES][4][16];
+    alignas(32) unsigned char handColor[LANES][4][16];
+    alignas(32) unsigned char handContent[LANES][4][16];
+    unsigned char deck[LANES][108];
+    unsigned char used[LANES][108];
+    unsigned char recent[LANES][6];
+    unsigned char recentColor[LANES][6];
+    unsigned long long legality[LANES];
+    unsigned long long randState[LANES];
+    const int* params[LANES][4];
+    int handSize[LANES][4];
+    int strongCount[LANES][4];
+    Color strongColor[LANES][4];
+    Color weakColor[LANES][4];
+    int deckSize[LANES];
+    int usedSize[LANES];
+    int recentSize[LANES];
+    int now[LANES];
+    int players[LANES];
+    int direction[LANES];
+    int draw2StackCount[LANES];
+    bool forcePlay[LANES];
+    bool draw2StackRule[LANES];
+
+    // Game flow of all lanes, see the same members in Simulator class
+    int status[LANES];
+    int winner[LANES];
+    int turns[LANES];
+    int selectedIdx[LANES];
+
+    /**
+     * Compute the masks of all lanes.
+     *
+     * @param out Out parameter. Masks of each lane.
+     */
+    void scan(Masks out[]);
+
+    /**
+     * Our own random number generator, see Uno::rand().
+     */
+    int rand(int lane);
+
+    /**
+     * See Uno::getNext().
+     */
+    int getNext(int lane);
+
+    /**
+     * See Uno::getOppo().
+     */
+    int getOppo(int lane);
+
+    /**
+     * See Uno::getPrev().
+     */
+    int getPrev(int lane);
+
+    /**
+     * Update the legality binary from the last played card, see Uno::play().
+     */
+    void updateLegality(int lane);
+
+    /**
+     * See AI::calcBestColor4NowPlayer().
+     */
+    Color calcBestColor(int lane, const Masks& m);
+
+    /**
+     * See AI::easyAI_bestCardIndex4NowPlayer(Color[]).
+     */
+    int easyAI(int lane, const Masks& m, Color outColor[]);
+
+    /**
+     * See AI::needToChallenge().
+     */
+    bool needToChallenge(int lane);
+
+    /**
+     * See Uno::draw(int, bool).
+     */
+    int unoDraw(int lane, int who, bool force);
+
+    /**
+     * See Simulator::draw(int, bool).
+     */
+    void draw(int lane, int count, bool force);
+
+    /**
+     * See Simulator::play(int, Color) and Uno::play(int, int, Color).
+     */
+    void play(int lane, int index, Color color);
+
+    /**
+     * See Simulator::decideChallenge(bool) and Uno::challenge(int).
+     */
+    void decideChallenge(int lane, bool challenge, const Masks& m);
+
+public:
+    /**
+     * Constructor. All lanes are empty (game over).
+     */
+    Lockstep();
+
+    /**
+     * @param uno Provide the Uno runtime.
+     * @return Whether the game in the provided Uno runtime can be played
+     *         by us, i.e. easy difficulty, not in 7-0 rule, and AI has no
+     *         budgets.
+     */
+    static bool isSupported(Uno* uno);
+
+    /**
+     * Load a game in process into a lane. The lane takes over the game
+     * from the turn of uno->getNow(), in the same way as the constructor
+     * Simulator(Uno*) does. The Uno runtime is not changed.
+     *
+     * @param lane Load into which lane (0 ~ LANES - 1).
+     * @param uno  Provide the Uno runtime. Must be supported, see
+     *             isSupported(Uno*).
+     */
+    void load(int lane, Uno* uno);
+
+    /**
+     * Empty a lane, so that it makes no more decisions.
+     *
+     * @param lane Empty which lane (0 ~ LANES - 1).
+     */
+    void clear(int lane);
+
+    /**
+     * Let every lane make its pending decision, unless its game is over or
+     * the specified number of actions happened in its game.
+     *
+     * @param maxTurns Lanes stop when getTurns(int) reaches this value.
+     * @return How many lanes are still running.
+     */
+    int step(int maxTurns);
+
+    /**
+     * Step all lanes until every lane stops.
+     *
+     * @param maxTurns Lanes stop when getTurns(int) reaches this value.
+     */
+    void run(int maxTurns);
+
+    /**
+     * @param lane Which lane.
+     * @return Current status of the lane, see Simulator::getStatus().
+     */
+    int getStatus(int lane);
+
+    /**
+     * @param lane Which lane.
+     * @return Who won the game in the lane, or -1 when game is not over.
+     */
+    int getWinner(int lane);
+
+    /**
+     * @param lane Which lane.
+     * @return How many actions (plays and passes) happened in the lane.
+     */
+    int getTurns(int lane);
+
+    /**
+     * @param lane Which lane.
+     * @param who  Whose hand. Must be one of the following: Player::YOU,
+     *             Player::COM1, Player::COM2, Player::COM3.
+     * @return How many cards in the specified player's hand.
+     */
+    int getHandSize(int lane, int who);
+}; // Lockstep Class
+
+#endif // __LOCKSTEP_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
@@ -66,6 +66,11 @@ private:
      */
     friend class Uno;
 
+    /**
+     * Grant Lockstep class to read our private fields.
+     */
+    friend class Lockstep;
+
 public:
     /**
      * Your player ID.
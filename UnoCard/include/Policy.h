@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __POLICY_H_494649FDFA62B3C015120BCB9BE17613__
+#define __POLICY_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include <vector>
+#include "include/Uno.h"
+
+/**
+ * Learned policy. A small dense network (one hidden layer with ReLU)
+ * scores every card ID and every color, from a fixed-size feature vector
+ * of current player's view. Weights are loaded from a flat binary file.
+ * When compiled with AVX2 and FMA (qmake CONFIG+=avx2), the network is
+ * evaluated by AVX2 kernels, otherwise by a scalar fallback. Both give the
+ * same results, except for rounding errors.
+ *
+ * Weight file layout (little-endian):
+ *     int32   MAGIC, FEATURE_COUNT, hidden size, OUTPUT_COUNT
+ *     float32 W1[FEATURE_COUNT][hidden], b1[hidden]
+ *     float32 W2[hidden][OUTPUT_COUNT],  b2[OUTPUT_COUNT]
+ * The hidden size must be a positive multiple of 8.
+ */
+class Policy {
+private:
+    /**
+     * Hidden layer size, or 0 if no weights are loaded.
+     */
+    int hidden;
+
+    /**
+     * Network weights. Stored input-major, so that each input adds a
+     * multiple of a contiguous row to the next layer.
+     */
+    std::vector<float> w1, b1, w2, b2;
+
+public:
+    /**
+     * Constructor. Create a network without weights. The game shares the
+     * network of getInstance(), other instances are for benchmarks.
+     */
+    Policy();
+
+    /**
+     * How many feature vectors share each pass over the weight rows, see
+     * evaluate(const float*, int, float*).
+     */
+    static const int TILE = 8;
+
+    /**
+     * Magic number of weight files ("UNOP").
+     */
+    static const int MAGIC = 0x504F4E55;
+
+    /**
+     * Length of a feature vector.
+     *
+     *   [0, 54)    How many cards of each card ID in current player's hand.
+     *   [54, 57)   Hand sizes of next, opposite and previous players.
+     *   57         Hand size of current player.
+     *   [58, 74)   One-hot strong / weak colors of next / previous players.
+     *   [74, 78)   One-hot color of the last played card.
+     *   [78, 93)   One-hot content of the last played card.
+     *   93         +1 in DIR_LEFT, -1 in DIR_RIGHT.
+     *   94         Stacked draw count in draw two stack rule.
+     *   95, 96     Whether 7-0 rule / draw two stack rule is enabled.
+     *   97         Whether 4 players are in game.
+     *   [98, 112)  Reserved, always 0.
+     */
+    static const int FEATURE_COUNT = 112;
+
+    /**
+     * Length of an output vector.
+     *
+     *   [0, 54)    Score of playing each card ID.
+     *   54         Reserved.
+     *   [55, 59)   Score of each color, RED, BLUE, GREEN, YELLOW.
+     *   [59, 64)   Reserved.
+     */
+    static const int OUTPUT_COUNT = 64;
+
+    /**
+     * Output index of RED. Index of other colors is OUT_COLOR + color - 1.
+     */
+    static const int OUT_COLOR = 55;
+
+    /**
+     * Default path of weight file.
+     */
+    static const char* const DEFAULT_PATH;
+
+    /**
+     * Get the shared instance. Weights are loaded from DEFAULT_PATH when
+     * this function is called for the first time.
+     *
+     * @return Reference of our singleton.
+     */
+    static Policy* getInstance();
+
+    /**
+     * @param card Provide a card.
+     * @return Card ID of the specified card, in range [0, 54).
+     */
+    static int idOf(Card* card);
+
+    /**
+     * Extract the feature vector of current player's view.
+     *
+     * @param uno Provide the Uno runtime.
+     * @param out Out parameter. Pass a float array (length>=FEATURE_COUNT)
+     *            to receive the feature vector.
+     */
+    static void extract(Uno* uno, float out[]);
+
+    /**
+     * Load weights from file. On failure, the current weights are kept.
+     *
+     * @param path Path of the weight file.
+     * @return Whether the file is loaded successfully.
+     */
+    bool load(const char* path);
+
+    /**
+     * Replace the weights by small pseudo-random ones, for benchmarks.
+     *
+     * @param hidden Hidden layer size. Must be a positive multiple of 8.
+     * @param seed   Random seed. The same seed gives the same weights.
+     */
+    void randomize(int hidden, unsigned seed);
+
+    /**
+     * @return Whether any weights are loaded.
+     */
+    bool isLoaded();
+
+    /**
+     * Evaluate a batch of feature vectors, TILE vectors in each pass over
+     * the weights, so a batch costs much less than evaluating its vectors
+     * one by one. The results are the same in both ways. Must not be
+     * called before any weights are loaded. Thread-safe as long as no one
+     * loads new weights at the same time. Each thread reuses its own
+     * buffer of hidden layer outputs, so no allocation happens after the
+     * first call.
+     *
+     * @param features Feature vectors, count * FEATURE_COUNT floats.
+     * @param count    How many feature vectors.
+     * @param out      Out parameter. Receives count * OUTPUT_COUNT floats.
+     */
+    void evaluate(const float* features, int count, float* out);
+}; // Policy Class
+
+#endif // __POLICY_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __SCANNER_H_494649FDFA62B3C015120BCB9BE17613__
+#define __SCANNER_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+/**
+ * Parallel seed scanner. Find the seeds whose games produce a specific
+ * situation, e.g. to reproduce a bug or to build a benchmark fixture.
+ *
+ * Each seed is played as a headless AI game (see Simulator class), and
+ * every action is appended to a game log (see Event struct). A predicate
+ * looks at the log after each action, and decides whether the game
+ * matches, can never match, or needs more actions. Games are stopped as
+ * soon as the predicate decides, and seeds are scanned by all CPU cores.
+ */
+class Scanner {
+public:
+    /**
+     * A record of the game log.
+     */
+    struct Event {
+        /**
+         * How many actions happened before this one. The first record
+         * (turn 0) is the start of the game.
+         */
+        int turn;
+
+        /**
+         * Who acted, or -1 for the start of the game.
+         */
+        int who;
+
+        /**
+         * Content of the played card (the start card in the first record),
+         * or -1 if no card is played.
+         */
+        int content;
+
+        /**
+         * Whether the played card makes players swap hand cards (a [7] or
+         * a [0] in 7-0 rule).
+         */
+        bool swap;
+
+        /**
+         * How many cards need to be drawn for the stacked +2 cards, see
+         * Uno::getDraw2StackCount().
+         */
+        int stack;
+
+        /**
+         * The biggest hand size after the action.
+         */
+        int maxHand;
+    }; // Event Struct
+
+    /**
+     * Results of predicates.
+     */
+    static const int PENDING = 0;
+    static const int MATCH = 1;
+    static const int MISS = -1;
+
+    /**
+     * Predicate over the game log.
+     *
+     * @param log The game log so far.
+     * @return MATCH, MISS or PENDING.
+     */
+    typedef int (*Predicate)(const std::vector<Event>& log);
+
+private:
+    /**
+     * How many threads.
+     */
+    int threads;
+
+    /**
+     * Rules of scanned games.
+     */
+    int players, difficulty;
+    bool forcePlay, sevenZeroRule, draw2StackRule;
+
+    /**
+     * How many seeds are actually played by the last scan.
+     */
+    long long scanned;
+
+    /**
+     * Play a game until the predicate decides.
+     *
+     * @param predicate The predicate.
+     * @param seed      Seed of the game.
+     * @param log       Provide a buffer for the game log.
+     * @return Whether the game matches.
+     */
+    bool test(Predicate predicate, unsigned seed, std::vector<Event>& log);
+
+public:
+    /**
+     * Get a built-in predicate by name:
+     * "start-draw2": the start card is a [+2].
+     * "swap3":       a hand swap (7-0 rule) happens within 3 actions.
+     * "max-hold":    someone holds Uno::MAX_HOLD_CARDS cards.
+     * "stack4":      4 stacked [+2] cards (+2 stack rule).
+     *
+     * @param name Name of the predicate.
+     * @return The predicate, or nullptr if the name is unknown.
+     */
+    static Predicate predicateOf(const std::string& name);
+
+    /**
+     * Constructor.
+     *
+     * @param threads How many threads. Pass 0 to use all cores.
+     */
+    Scanner(int threads);
+
+    /**
+     * Set the rules of scanned games. By default, 4 players, hard level,
+     * force play, and no 7-0 or +2 stack rules.
+     */
+    void setRules(int players, int difficulty, bool forcePlay,
+                  bool sevenZeroRule, bool draw2StackRule);
+
+    /**
+     * Scan seeds firstSeed ~ firstSeed + count - 1.
+     *
+     * @param predicate The predicate.
+     * @param firstSeed The first seed to scan.
+     * @param count     How many seeds to scan.
+     * @param limit     Stop scanning after this number of matches.
+     * @return Matching seeds, in ascending order. When the scan is stopped
+     *         by the limit, they may not be the smallest matching seeds.
+     */
+    std::vector<unsigned> run(Predicate predicate, unsigned firstSeed,
+                              int count, int limit);
+
+    /**
+     * Scan seeds, and write the matching seeds and the scanning speed as
+     * JSON.
+     *
+     * @param name      Name of a built-in predicate, see predicateOf(const
+     *                  std::string&).
+     * @param firstSeed The first seed to scan.
+     * @param count     How many seeds to scan.
+     * @param limit     Stop scanning after this number of matches.
+     * @param out       Output stream.
+     * @return False if the predicate name is unknown.
+     */
+    bool run(const std::string& name, unsigned firstSeed, int count,
+             int limit, std::ostream& out);
+}; // Scanner Class
+
+#endif // __SCANNER_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
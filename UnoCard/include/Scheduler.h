@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __SCHEDULER_H_494649FDFA62B3C015120BCB9BE17613__
+#define __SCHEDULER_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include <mutex>
+#include <atomic>
+#include <functional>
+
+/**
+ * Work-stealing scheduler of batch jobs (games, positions, ...), shared by
+ * all batch runners (see Arena, Tuner, Distiller and BluffSolver classes).
+ *
+ * Jobs are numbered 0 ~ count - 1. Each thread owns a deque of job numbers,
+ * initially an equal contiguous range, and takes chunks of jobs from its
+ * front. A thread whose deque is empty steals the back half of another
+ * thread's deque, so that all threads keep busy until the last job is
+ * done, no matter how long each job takes. Threads only touch each other's
+ * deques when stealing, instead of all threads taking jobs from one shared
+ * counter.
+ */
+class Scheduler {
+private:
+    /**
+     * Deque of a thread, holding job numbers begin ~ end - 1.
+     */
+    struct Deque {
+        std::mutex mutex;
+        int begin;
+        int end;
+
+        // Padded so that deques of different threads do not share a cache
+        // line
+        char padding[64];
+    }; // Deque Struct
+
+    /**
+     * How many threads.
+     */
+    int threads;
+
+    /**
+     * How many times jobs have been stolen.
+     */
+    std::atomic<long long> steals;
+
+    /**
+     * Deques of all threads in the current run.
+     */
+    Deque* deques;
+
+    /**
+     * How many threads take part in the current run.
+     */
+    int workers;
+
+    /**
+     * Take a chunk of jobs for a thread, from its own deque, or stolen from
+     * another thread's deque.
+     *
+     * @param worker   Take jobs for which thread.
+     * @param chunk    Take at most how many jobs.
+     * @param outFirst Out parameter. Pass an int array (length>=1) to
+     *                 receive the first job number taken.
+     * @param outLast  Out parameter. Pass an int array (length>=1) to
+     *                 receive the last job number taken plus 1.
+     * @return False if there are no jobs left.
+     */
+    bool take(int worker, int chunk, int outFirst[], int outLast[]);
+
+public:
+    /**
+     * Constructor.
+     *
+     * @param threads How many threads. Pass 0 to use all cores.
+     */
+    Scheduler(int threads);
+
+    /**
+     * @return How many threads.
+     */
+    int getThreads();
+
+    /**
+     * @return How many times jobs have been stolen in all runs.
+     */
+    long long getSteals();
+
+    /**
+     * Run jobs 0 ~ count - 1 on all threads, and return when all of them
+     * are done. The calling thread is thread 0. Not re-entrant.
+     *
+     * @param count How many jobs.
+     * @param chunk Take at most how many jobs at a time. Pass 0 to choose
+     *              automatically.
+     * @param job   Run a job. Called with the thread number (0 ~
+     *              getThreads() - 1) and the job number, so that each
+     *              thread can keep its own results without locking.
+     */
+    void run(int count, int chunk, const std::function<void(int, int)>& job);
+}; // Scheduler Class
+
+#endif // __SCHEDULER_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __SPECULATOR_H_494649FDFA62B3C015120BCB9BE17613__
+#define __SPECULATOR_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include "include/Uno.h"
+#include "include/Color.h"
+
+/**
+ * Speculative AI replies. While you are thinking in your turn, list all of
+ * your legal actions in a sub thread, and calculate the reply of the AI
+ * player who acts after each of them. When the AI player's turn comes, the
+ * matching reply can be fetched instantly, and the others are thrown away.
+ */
+class Speculator {
+private:
+    /**
+     * A precomputed AI reply.
+     */
+    struct Reply {
+        int index;
+        Color color;
+        unsigned long long randState;
+    }; // Reply Struct
+
+    /**
+     * Worker thread.
+     */
+    std::thread thread;
+
+    /**
+     * Set to true to stop the worker thread.
+     */
+    std::atomic<bool> cancelled;
+
+    /**
+     * Guards [replies].
+     */
+    std::mutex mutex;
+
+    /**
+     * Precomputed replies. Key is the state hash of the Uno runtime when
+     * the AI player needs to reply.
+     */
+    std::map<unsigned long long, Reply> replies;
+
+    /**
+     * State hash of the Uno runtime being speculated, or 0 if none.
+     */
+    unsigned long long root;
+
+    /**
+     * Worker thread entry.
+     *
+     * @param game A copy of the Uno runtime in your turn.
+     */
+    void run(Uno game);
+
+    /**
+     * Apply one of your actions to a copy of the game, resolve it until an
+     * AI player's turn, then calculate and store that AI player's reply.
+     *
+     * @param game   A copy of the Uno runtime in your turn.
+     * @param index  Play which card, or -1 to draw a card.
+     * @param color  Following legal color when playing a wild card.
+     * @param target Swap target when playing a seven card in 7-0 rule.
+     */
+    void branch(Uno game, int index, Color color, int target);
+
+public:
+    /**
+     * Constructor.
+     */
+    Speculator();
+
+    /**
+     * Start to speculate in background. Call this function when you are
+     * thinking in your turn. Calling it again with the same game state
+     * does nothing.
+     *
+     * @param uno Provide the Uno runtime.
+     */
+    void start(Uno* uno);
+
+    /**
+     * Stop the background speculation and throw away all results.
+     */
+    void cancel();
+
+    /**
+     * Fetch the precomputed reply for current player, if any. On success,
+     * the random number generator of the Uno runtime is also moved forward,
+     * as if the reply was calculated just now, and all other replies are
+     * thrown away.
+     *
+     * @param uno      Provide the Uno runtime.
+     * @param outIndex Out parameter. Index of the best card to play, or a
+     *                 negative number that means to draw a card.
+     * @param outColor Out parameter. See AI::easyAI_bestCardIndex4NowPlayer.
+     * @return Whether a precomputed reply is found.
+     */
+    bool fetch(Uno* uno, int* outIndex, Color outColor[]);
+
+    /**
+     * Destructor.
+     */
+    ~Speculator();
+}; // Speculator Class
+
+#endif // __SPECULATOR_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __STATS_H_494649FDFA62B3C015120BCB9BE17613__
+#define __STATS_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include <istream>
+#include <ostream>
+#include "include/Uno.h"
+
+/**
+ * Statistics of headless games: wins of each seat, hand score distribution
+ * of the losers (see Player::getHandScore()), game length histogram, how
+ * many times each card is played, and how many times the used cards are
+ * reshuffled into the deck.
+ *
+ * A Stats object is a shard owned by one thread, which records its own
+ * games without any synchronization. Shards of different threads are
+ * merged by merge(const Stats&) at the end of a run, or whenever a
+ * checkpoint is needed. The result does not depend on how games are split
+ * among shards.
+ */
+class Stats {
+public:
+    /**
+     * Hand scores are counted in buckets of this width.
+     */
+    static const int SCORE_STEP = 10;
+
+    /**
+     * How many hand score buckets. The last bucket holds the max hand score
+     * (MAX_HOLD_CARDS wild cards) and above.
+     */
+    static const int SCORE_BUCKETS = Uno::MAX_HOLD_CARDS * 50 / SCORE_STEP + 1;
+
+    /**
+     * Game lengths (in actions) are counted in buckets of this width.
+     */
+    static const int LENGTH_STEP = 10;
+
+    /**
+     * How many game length buckets. The last bucket holds 1000 actions and
+     * above.
+     */
+    static const int LENGTH_BUCKETS = 1000 / LENGTH_STEP + 1;
+
+private:
+    /**
+     * How many games are recorded, and how many of them are unfinished.
+     */
+    long long games, unfinished;
+
+    /**
+     * How many times the used cards are reshuffled into the deck.
+     */
+    long long reshuffles;
+
+    /**
+     * How many games each seat took part in and won, indexed by Player::YOU,
+     * Player::COM1, Player::COM2 and Player::COM3.
+     */
+    long long seats[4], wins[4];
+
+    /**
+     * Hand score histogram of the losers at the end of finished games.
+     */
+    long long scores[SCORE_BUCKETS];
+
+    /**
+     * Game length histogram.
+     */
+    long long lengths[LENGTH_BUCKETS];
+
+    /**
+     * How many times each card is played, indexed by color and content.
+     */
+    long long plays[5][15];
+
+    /**
+     * Reshuffle count seen by the last observe(Uno*, int, int) call.
+     */
+    int reshuffleCount;
+
+    /**
+     * Played card count seen by the last observe(Uno*, int, int) call.
+     */
+    int playCount;
+
+public:
+    /**
+     * Constructor. Create an empty shard.
+     */
+    Stats();
+
+    /**
+     * Start recording a game. Call it after the game is started.
+     *
+     * @param uno Provide the Uno runtime.
+     */
+    void begin(Uno* uno);
+
+    /**
+     * Record what happened in the last action. Call it after every action.
+     *
+     * @param uno        Provide the Uno runtime.
+     * @param played     How many cards are played in the game so far, see
+     *                   Simulator::getPlays().
+     * @param reshuffled How many times the used cards are reshuffled into
+     *                   the deck in the game so far, see
+     *                   Uno::getReshuffleCount().
+     */
+    void observe(Uno* uno, int played, int reshuffled);
+
+    /**
+     * Finish recording a game.
+     *
+     * @param uno    Provide the Uno runtime.
+     * @param winner Who won the game, or -1 if the game is unfinished.
+     * @param turns  How many actions happened in the game.
+     */
+    void end(Uno* uno, int winner, int turns);
+
+    /**
+     * Add another shard's records to this shard.
+     *
+     * @param that The shard to merge.
+     */
+    void merge(const Stats& that);
+
+    /**
+     * Write the records as binary data, to be read by load(std::istream&)
+     * on the same machine.
+     *
+     * @param out Output stream.
+     */
+    void save(std::ostream& out);
+
+    /**
+     * Read the records written by save(std::ostream&), replacing current
+     * records.
+     *
+     * @param in Input stream.
+     * @return Whether the records are read successfully.
+     */
+    bool load(std::istream& in);
+
+    /**
+     * Write the records as a JSON object.
+     *
+     * @param out Output stream.
+     */
+    void write(std::ostream& out);
+}; // Stats Class
+
+#endif // __STATS_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
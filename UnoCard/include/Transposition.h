@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __TRANSPOSITION_H_494649FDFA62B3C015120BCB9BE17613__
+#define __TRANSPOSITION_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include <atomic>
+#include "include/Uno.h"
+
+/**
+ * Transposition table shared by the search AIs. Every simulated game of
+ * the search AIs is a pure function of the game state where it starts
+ * (the random number generator is part of the state), so its winner can
+ * be stored under the state hash, and looked up again when any search
+ * reaches the same state, e.g. the AI thinking about a state that your
+ * move hint or the reply speculator has already searched.
+ *
+ * The table has a fixed size. Each bucket fills exactly one cache line
+ * and holds SLOTS entries. An entry is two 64-bit atomic words, the data
+ * and the key XOR the data, so a torn entry written by two threads at
+ * the same time fails the key check and reads as a miss. No locks are
+ * needed. When a bucket is full, the entry which took the fewest turns
+ * to compute is replaced (replace-by-depth). Since a hit returns exactly
+ * what the simulation would return, results never depend on how the
+ * threads interleave.
+ */
+class Transposition {
+private:
+    /**
+     * How many entries in a bucket.
+     */
+    static const int SLOTS = 4;
+
+    /**
+     * A bucket of entries, one cache line.
+     */
+    struct alignas(64) Bucket {
+        std::atomic<unsigned long long> check[SLOTS];
+        std::atomic<unsigned long long> data[SLOTS];
+    }; // Bucket Struct
+
+    /**
+     * Size of the shared table in mega bytes, see getInstance().
+     */
+    static std::atomic<int> sharedSize;
+
+    /**
+     * Memory block holding the buckets.
+     */
+    char* memory;
+
+    /**
+     * The buckets, aligned to cache lines.
+     */
+    Bucket* buckets;
+
+    /**
+     * Number of buckets - 1. The number of buckets is a power of 2.
+     */
+    unsigned long long mask;
+
+    /**
+     * Singleton, hide default constructors.
+     */
+    Transposition(const Transposition&) = delete;
+    Transposition& operator=(const Transposition&) = delete;
+
+public:
+    /**
+     * Default size of the shared table in mega bytes.
+     */
+    static const int DEFAULT_SIZE = 16;
+
+    /**
+     * Configure the size of the shared table. Must be called before the
+     * first call of getInstance(), otherwise it takes no effect.
+     *
+     * @param megaBytes Size in mega bytes, at least 1.
+     */
+    static void setSharedSize(int megaBytes);
+
+    /**
+     * Load the size of the shared table from a config file. Each line of
+     * the file is like "name value". The line "transpositionSize n" sets
+     * the size to n mega bytes, see setSharedSize(int). Other lines are
+     * ignored.
+     *
+     * @param path Path of the config file.
+     * @return Whether the size is loaded successfully.
+     */
+    static bool loadSharedSize(const char* path);
+
+    /**
+     * The first call allocates and clears the table, so the program calls
+     * it at startup, before any timed search.
+     *
+     * @return Reference of the table shared by all search AIs.
+     */
+    static Transposition* getInstance();
+
+    /**
+     * Compute the key of a simulated game.
+     *
+     * @param uno    The Uno runtime where the simulated game starts.
+     * @param status Current status of its Simulator.
+     * @param turns  How many actions already happened in its Simulator.
+     * @return Key of the simulated game, never 0.
+     */
+    static unsigned long long keyOf(Uno* uno, int status, int turns);
+
+    /**
+     * Constructor. Create an empty table.
+     *
+     * @param megaBytes Size in mega bytes, at least 1. Rounded down to a
+     *                  power of 2.
+     */
+    explicit Transposition(int megaBytes);
+
+    /**
+     * Look up a simulated game.
+     *
+     * @param key       Key of the simulated game, see keyOf(Uno*, int, int).
+     * @param outWinner Out parameter. Pass an int array (length>=1) to
+     *                  receive the stored winner (-1 means no winner in
+     *                  time).
+     * @return Whether the simulated game is found.
+     */
+    bool probe(unsigned long long key, int outWinner[]);
+
+    /**
+     * Store the result of a simulated game.
+     *
+     * @param key    Key of the simulated game, see keyOf(Uno*, int, int).
+     * @param winner Who won the simulated game, or -1 if no one.
+     * @param depth  How many actions the simulated game took.
+     */
+    void store(unsigned long long key, int winner, int depth);
+
+    /**
+     * Remove all entries. Not safe when other threads are using the table.
+     */
+    void clear();
+
+    /**
+     * @return How many entries the table can hold.
+     */
+    long long getCapacity();
+
+    /**
+     * Destructor.
+     */
+    ~Transposition();
+}; // Transposition Class
+
+#endif // __TRANSPOSITION_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __TUNER_H_494649FDFA62B3C015120BCB9BE17613__
+#define __TUNER_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include <string>
+#include "include/AI.h"
+
+/**
+ * Self-play tuner of AI parameters (see AI::PARAM_COUNT). Optimize the
+ * parameters by SPSA (Simultaneous Perturbation Stochastic Approximation):
+ * in each iteration, all parameters are perturbed at the same time in two
+ * opposite directions, and both candidates play the same headless games
+ * (same seeds, same seats) against the default AI parameters, so that most
+ * of the luck is cancelled out. Games are played by all CPU cores.
+ *
+ * The optimizer state can be saved to a checkpoint file after every
+ * iteration (see setCheckpoint(const std::string&)), so that a stopped run
+ * resumes from its last iteration, and gets the same results as if it
+ * were never stopped.
+ */
+class Tuner {
+private:
+    /**
+     * How many threads to play games.
+     */
+    int threads;
+
+    /**
+     * How many games to play for each candidate in each iteration.
+     */
+    int games;
+
+    /**
+     * Base of random seeds.
+     */
+    unsigned seed;
+
+    /**
+     * Game rules, see Uno::setPlayers(int), Uno::setDifficulty(int),
+     * Uno::setSevenZeroRule(bool) and Uno::setDraw2StackRule(bool).
+     */
+    int players, difficulty;
+    bool sevenZeroRule, draw2StackRule;
+
+    /**
+     * Current parameters, normalized into [0, 1] by PARAM_MIN and PARAM_MAX.
+     */
+    double theta[AI::PARAM_COUNT];
+
+    /**
+     * The best parameters found so far, and its winning rate in validation.
+     */
+    int best[AI::PARAM_COUNT];
+    double bestRate;
+
+    /**
+     * Path of the checkpoint file, or empty if checkpoints are disabled.
+     */
+    std::string checkpoint;
+
+    /**
+     * Let the specified parameters play against the default parameters.
+     *
+     * @param params    AI parameters to evaluate.
+     * @param firstSeed Seed of the first game. Game i uses firstSeed + i.
+     * @param count     How many games to play.
+     * @return Winning rate of the specified parameters.
+     */
+    double evaluate(const int params[], unsigned firstSeed, int count);
+
+    /**
+     * Convert normalized parameters to AI parameters.
+     *
+     * @param u         Normalized parameters.
+     * @param outParams Out parameter, receives the AI parameters.
+     */
+    static void denormalize(const double u[], int outParams[]);
+
+    /**
+     * @param iterations How many SPSA iterations.
+     * @return Settings of a run, which must match when resuming from a
+     *         checkpoint.
+     */
+    std::string describe(int iterations);
+
+    /**
+     * Save the optimizer state to the checkpoint file.
+     *
+     * @param iterations How many SPSA iterations.
+     * @param done       How many iterations are finished.
+     * @param bits       State of the perturbation random generator.
+     */
+    void saveProgress(int iterations, int done, unsigned bits);
+
+    /**
+     * Load the optimizer state saved by a run with the same settings.
+     *
+     * @param iterations How many SPSA iterations.
+     * @param outBits    Out parameter. Pass an unsigned array (length>=1)
+     *                   to receive the state of the perturbation random
+     *                   generator.
+     * @return How many iterations are finished, or 0 if there is no
+     *         checkpoint of the same settings.
+     */
+    int loadProgress(int iterations, unsigned outBits[]);
+
+public:
+    /**
+     * Lower bounds of AI parameters.
+     */
+    static const int PARAM_MIN[AI::PARAM_COUNT];
+
+    /**
+     * Upper bounds of AI parameters.
+     */
+    static const int PARAM_MAX[AI::PARAM_COUNT];
+
+    /**
+     * Constructor.
+     *
+     * @param threads How many threads to play games. Pass 0 to use all cores.
+     * @param games   How many games to play for each candidate in each
+     *                iteration. The validation of the best parameters plays
+     *                4 times as many games.
+     * @param seed    Base of random seeds.
+     */
+    Tuner(int threads, int games, unsigned seed);
+
+    /**
+     * Set the game rules to tune for. By default, 3 players, hard level,
+     * and no special rules.
+     */
+    void setRules(int players, int difficulty,
+                  bool sevenZeroRule, bool draw2StackRule);
+
+    /**
+     * Start tuning from the specified parameters, instead of the default ones.
+     *
+     * @param params AI parameters (length == AI::PARAM_COUNT).
+     */
+    void setStartParams(const int params[]);
+
+    /**
+     * Save the optimizer state to the specified file after every iteration,
+     * and resume from it if it was saved by a run with the same settings.
+     * The file is removed when the run is finished.
+     *
+     * @param path Path of the checkpoint file.
+     */
+    void setCheckpoint(const std::string& path);
+
+    /**
+     * Run the tuner.
+     *
+     * @param iterations How many SPSA iterations.
+     * @param path       When not nullptr, save the best parameters found so
+     *                   far to this file whenever they are improved.
+     */
+    void run(int iterations, const char* path = nullptr);
+
+    /**
+     * @return The best parameters found so far.
+     */
+    const int* getBestParams();
+
+    /**
+     * @return Winning rate of the best parameters found so far, against the
+     *         default parameters, in validation games.
+     */
+    double getBestRate();
+}; // Tuner Class
+
+#endif // __TUNER_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
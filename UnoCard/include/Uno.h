@@ -18,7 +18,10 @@
 #include "include/Content.h"
 
 /**
- * Uno Runtime Class (Singleton).
+ * Uno Runtime Class (Singleton). Besides the singleton used by the game UI,
+ * any number of headless runtimes can be created for background works, see
+ * newHeadlessInstance(unsigned). Runtimes can also be copied, and a copy
+ * shares the card table with its original.
  */
 class Uno {
 private:
@@ -79,10 +82,25 @@ private:
     int direction;
 
     /**
-     * Current difficulty (LV_EASY / LV_HARD).
+     * Current difficulty (LV_EASY / LV_HARD / LV_POLICY).
      */
     int difficulty;
 
+    /**
+     * Time budget of anytime AI in milli seconds, or 0 for no time budget.
+     */
+    int thinkTime;
+
+    /**
+     * Node budget of anytime AI, or 0 for no node budget.
+     */
+    int thinkNodes;
+
+    /**
+     * AI parameters of each player, or nullptr to use the default ones.
+     */
+    const int* aiParams[4];
+
     /**
      * Whether the force play rule is enabled.
      */
@@ -108,6 +126,12 @@ private:
      */
     int draw2StackCount;
 
+    /**
+     * How many times the used cards are reshuffled into the deck in the
+     * current game.
+     */
+    int reshuffles;
+
     /**
      * This binary value shows that which cards are legal to play. When
      * 0x01LL == ((legality >> i) & 0x01LL), the card with id number i
@@ -132,9 +156,9 @@ private:
     std::vector<Card*> used;
 
     /**
-     * Card map. table[i] stores the card instance of id number i.
+     * Card map. table->at(i) stores the card instance of id number i.
      */
-    std::vector<Card> table;
+    std::vector<Card>* table;
 
     /**
      * Recent played cards.
@@ -146,11 +170,33 @@ private:
      */
     std::vector<Color> recentColors;
 
+    /**
+     * State of our own random number generator.
+     */
+    unsigned long long randState;
+
     /**
      * Singleton, hide default constructor.
      */
     Uno(unsigned seed);
 
+    /**
+     * Headless constructor. Load no resources, and use the shared headless
+     * card table.
+     */
+    Uno(std::vector<Card>* table, unsigned seed);
+
+    /**
+     * Initialize members, except resources and card table.
+     */
+    void init(unsigned seed);
+
+    /**
+     * Grant Lockstep class to read our private fields (to load a game in
+     * process into its own compact layout).
+     */
+    friend class Lockstep;
+
 public:
     /**
      * Easy level ID.
@@ -162,6 +208,12 @@ public:
      */
     static const int LV_HARD = 1;
 
+    /**
+     * Learned policy level ID. See Policy class. Falls back to LV_HARD
+     * when no policy weights are loaded.
+     */
+    static const int LV_POLICY = 2;
+
     /**
      * Direction value (clockwise).
      */
@@ -182,6 +234,50 @@ public:
      */
     static Uno* getInstance(unsigned seed = 0U);
 
+    /**
+     * @return The card table shared by all headless runtimes.
+     */
+    static std::vector<Card>* getHeadlessTable();
+
+    /**
+     * Create a headless runtime. A headless runtime loads no image resources
+     * and prints no messages, so it can be created without a QApplication.
+     * Every runtime owns its random number generator, so runtimes can run in
+     * different threads, and each game is reproducible from its seed.
+     *
+     * @param seed Random seed. Pass 0 to generate one from current time.
+     * @return The new runtime.
+     */
+    static Uno newHeadlessInstance(unsigned seed = 0U);
+
+    /**
+     * Our own random number generator, works like std::rand().
+     *
+     * @return A pseudo-random integer between 0 and 0x7fffffff.
+     */
+    int rand();
+
+    /**
+     * @return Current state of our random number generator.
+     */
+    unsigned long long getRandState();
+
+    /**
+     * Restore the state of our random number generator.
+     *
+     * @param state Value got from getRandState().
+     */
+    void setRandState(unsigned long long state);
+
+    /**
+     * Calculate a 64-bit hash value of the whole game state, including card
+     * deck, everyone's hand cards, and our random number generator. Two
+     * runtimes with equal hash values behave the same from now on.
+     *
+     * @return Hash value of current game state.
+     */
+    unsigned long long getStateHash();
+
     /**
      * @return Card back image resource.
      */
@@ -299,7 +395,12 @@ public:
     void switchDirection();
 
     /**
-     * @return Current difficulty (LV_EASY / LV_HARD).
+     * @return Current action sequence (DIR_LEFT / DIR_RIGHT).
+     */
+    int getDirection();
+
+    /**
+     * @return Current difficulty (LV_EASY / LV_HARD / LV_POLICY).
      */
     int getDifficulty();
 
@@ -307,10 +408,59 @@ public:
      * Set game difficulty.
      *
      * @param difficulty Pass target difficulty value.
-     *                   Only LV_EASY and LV_HARD are available.
+     *                   Only LV_EASY, LV_HARD and LV_POLICY are available.
      */
     void setDifficulty(int difficulty);
 
+    /**
+     * @return Time budget of anytime AI in milli seconds, or 0 if none.
+     */
+    int getThinkTime();
+
+    /**
+     * Set the time budget of anytime AI. When either the time budget or the
+     * node budget is set, AI players search for the best card to play until
+     * the budget runs out, instead of using the fixed difficulty strategies.
+     * See AI::searchAI_bestCardIndex4NowPlayer(Color[]).
+     *
+     * @param millis Time budget per action, or 0 to disable it.
+     */
+    void setThinkTime(int millis);
+
+    /**
+     * @return Node budget of anytime AI, or 0 if none.
+     */
+    int getThinkNodes();
+
+    /**
+     * Set the node budget of anytime AI, i.e. how many simulated games at
+     * most AI can play in one action. Unlike time budget, the result of a
+     * node budget is reproducible, and does not depend on CPU load.
+     *
+     * @param nodes Node budget per action, or 0 to disable it.
+     */
+    void setThinkNodes(int nodes);
+
+    /**
+     * @param who Get whose AI parameters. Must be one of the following:
+     *            Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     * @return AI parameters of the specified player, or nullptr if the
+     *         player uses the default ones. See AI::PARAM_COUNT.
+     */
+    const int* getAIParams(int who);
+
+    /**
+     * Let the specified player's AI use the provided parameters, instead of
+     * the default ones. The array is NOT copied, so keep it alive as long as
+     * this runtime and its copies are still working.
+     *
+     * @param who    Set whose AI parameters. Must be one of the following:
+     *               Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     * @param params AI parameters (length == AI::PARAM_COUNT), or nullptr
+     *               to use the default ones.
+     */
+    void setAIParams(int who, const int params[]);
+
     /**
      * @return This value tells that what's the next step
      *         after you drew a playable card in your action.
@@ -381,6 +531,12 @@ public:
      */
     int getUsedCount();
 
+    /**
+     * @return How many times the used cards are reshuffled into the deck
+     *         in the current game.
+     */
+    int getReshuffleCount();
+
     /**
      * @return Recent played cards.
      */
@@ -487,6 +643,19 @@ public:
      * cards to the next player.
      */
     void cycle();
+
+    /**
+     * Shuffle all cards unknown to the specified player, i.e. the card deck
+     * and the other players' hand cards, then deal them again. Everyone keeps
+     * the same amount of hand cards. Call this function on a copy of runtime
+     * before simulating the rest of game, so that the simulation does not
+     * peek at the others' hand cards. When the specified player is you, the
+     * cards you have seen (see Player::isOpen(int)) are kept in place.
+     *
+     * @param who Redeal from whose view. Must be one of the following:
+     *            Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     */
+    void redeal(int who);
 }; // Uno Class
 
 #endif // __UNO_H_494649FDFA62B3C015120BCB9BE17613__
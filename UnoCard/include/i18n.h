@@ -31,11 +31,13 @@ public:
     virtual QString ask_color() = 0;
     virtual QString ask_target() = 0;
     virtual QString btn_auto() = 0;
+    virtual QString btn_hint() = 0;
     virtual QString btn_keep() = 0;
     virtual QString btn_off() = 0;
     virtual QString btn_on() = 0;
     virtual QString btn_play() = 0;
     virtual QString btn_settings() = 0;
+    virtual QString btn_thinkTime(int) = 0;
     virtual QString info_0_rotate() = 0;
     virtual QString info_7_swap(int, int) = 0;
     virtual QString info_cannotDraw(int, int) = 0;
@@ -62,6 +64,8 @@ public:
     virtual QString label_remain_used(int, int) = 0;
     virtual QString label_score() = 0;
     virtual QString label_snd() = 0;
+    virtual QString label_thinkTime() = 0;
+    virtual QString label_winChance(int, int) = 0;
     virtual QString label_yes() = 0;
 }; // I18N class
 
@@ -142,6 +146,10 @@ public:
         return "<AUTO>";
     } // btn_auto()
 
+    inline QString btn_hint() {
+        return "<HINT>";
+    } // btn_hint()
+
     inline QString btn_keep() {
         return "<KEEP>";
     } // btn_keep()
@@ -162,6 +170,12 @@ public:
         return "<SETTINGS>";
     } // btn_settings()
 
+    inline QString btn_thinkTime(int i) {
+        return i < 1000
+            ? "<" + QString::number(i) + "ms>"
+            : "<" + QString::number(i / 1000) + "s>";
+    } // btn_thinkTime(int)
+
     inline QString info_0_rotate() {
         return "Hand cards transferred to next";
     } // info_0_rotate()
@@ -276,6 +290,14 @@ public:
         return "SND";
     } // label_snd()
 
+    inline QString label_thinkTime() {
+        return "AI think time per move:";
+    } // label_thinkTime()
+
+    inline QString label_winChance(int i1, int i2) {
+        return p(i1) + " " + QString::number(i2) + "%";
+    } // label_winChance(int, int)
+
     inline QString label_yes() {
         return "YES";
     } // label_yes()
@@ -353,6 +375,10 @@ public:
         return "<托管>";
     } // btn_auto()
 
+    inline QString btn_hint() {
+        return "<提示>";
+    } // btn_hint()
+
     inline QString btn_keep() {
         return "<保留>";
     } // btn_keep()
@@ -373,6 +399,12 @@ public:
         return "<设置>";
     } // btn_options()
 
+    inline QString btn_thinkTime(int i) {
+        return i < 1000
+            ? "<" + QString::number(i) + "毫秒>"
+            : "<" + QString::number(i / 1000) + "秒>";
+    } // btn_thinkTime(int)
+
     inline QString info_0_rotate() {
         return "所有人将牌传给下家";
     } // info_0_rotate()
@@ -478,6 +510,14 @@ public:
         return "音效";
     } // label_snd()
 
+    inline QString label_thinkTime() {
+        return "电脑每步思考时间:";
+    } // label_thinkTime()
+
+    inline QString label_winChance(int i1, int i2) {
+        return p(i1) + " " + QString::number(i2) + "%";
+    } // label_winChance(int, int)
+
     inline QString label_yes() {
         return "是";
     } // label_yes()
@@ -15,12 +15,18 @@
 #include <QString>
 #include <QWidget>
 #include <QPainter>
+#include <functional>
 #include <QCloseEvent>
 #include <QMouseEvent>
 #include <QPaintEvent>
+#include <QTimerEvent>
 #include <QMediaPlayer>
 #include <QMediaPlaylist>
 #include "include/SoundPool.h"
+#include "include/Speculator.h"
+#include "include/Hinter.h"
+#include "include/Estimator.h"
+#include "include/Agent.h"
 #include "include/Color.h"
 #include "include/i18n.h"
 #include "include/Uno.h"
@@ -50,10 +56,11 @@ class Main : public QWidget {
 
 private:
     // Global Variables
-    AI* sAI;
     Uno* sUno;
     I18N* i18n;
+    Agent* sAgent;
     bool sAuto;
+    bool sHint;
     int sScore;
     int sStatus;
     int sWinner;
@@ -61,26 +68,31 @@ private:
     Ui::Main* ui;
     int sHideFlag;
     QImage sScreen;
+    Hinter* sHinter;
     bool sAIRunning;
     int sSelectedIdx;
+    int sHintVersion;
     QImage sBackup[4];
     QPainter* sPainter;
     bool sAdjustOptions;
+    int sEstimateVersion;
+    Estimator* sEstimator;
     SoundPool* sSoundPool;
+    Speculator* sSpeculator;
     QPainter* sBkPainter[4];
     QMediaPlayer* sMediaPlay;
     QMediaPlaylist* sMediaList;
+    int sAIParams[AI::PARAM_COUNT];
 
     // Functions
     void cycle();
-    void easyAI();
-    void hardAI();
-    void sevenZeroAI();
+    void agentAI();
     void onChallenge();
     void swapWith(int whom);
     void setStatus(int status);
     void threadWait(int millis);
     void play(int index, Color color = NONE);
+    int decideAI(std::function<int()> decide);
     void draw(int count = 1, bool force = false);
     void refreshScreen(const QString& message = "");
     void animate(int layerCount, AnimateLayer layer[]);
@@ -89,6 +101,7 @@ protected:
     // Implemented Listeners
     void closeEvent(QCloseEvent* event);
     void paintEvent(QPaintEvent* event);
+    void timerEvent(QTimerEvent* event);
     void mousePressEvent(QMouseEvent* event);
 
 public:
@@ -0,0 +1,1151 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "reference/AI.h"
+#include "include/BluffStrategy.h"
+#include "include/BluffSolver.h"
+#include "reference/Uno.h"
+#include "include/Card.h"
+#include "include/Color.h"
+#include "reference/Player.h"
+#include "include/Content.h"
+
+// No branch coverage in the reference copy
+#define AI_BRANCH(tag, value) (value)
+
+namespace reference {
+
+/**
+ * Reference copy of BluffSolver::sample(int, Uno*, int).
+ */
+static bool sample(int chance, Uno* uno, int salt) {
+    unsigned long long x;
+
+    // SplitMix64 finalizer over our random number generator
+    x = uno->getRandState() + (salt + 1) * 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return int((x >> 32) % 255ULL) < chance;
+} // sample(int, Uno*, int)
+
+/**
+ * Default AI parameters.
+ */
+const int AI::DEFAULT_PARAMS[AI::PARAM_COUNT] = {
+    2, // PARAM_ZERO_REV_WORTH
+    4, // PARAM_NUM_WORTH
+    5, // PARAM_SKIP_DRAW2_WORTH
+    4, // PARAM_CHALLENGE_MARGIN
+    4, // PARAM_ATTACK_SIZE
+    4, // PARAM_REVERSE_SIZE
+    3, // PARAM_SAVE_SIZE
+    0  // PARAM_NUM_FIRST
+}; // DEFAULT_PARAMS[]
+
+/**
+ * Create an AI instance which works on the specified Uno runtime, e.g.
+ * a headless runtime created by Uno::newHeadlessInstance(unsigned).
+ *
+ * @param uno Provide the Uno runtime.
+ */
+AI::AI(Uno* uno) : uno(uno) {
+} // AI(Uno*) (Class Constructor)
+
+/**
+ * @param who Get whose AI parameters.
+ * @return AI parameters of the specified player in our Uno runtime.
+ */
+const int* AI::getParams(int who) {
+    const int* params = uno->getAIParams(who);
+    return params != nullptr ? params : DEFAULT_PARAMS;
+} // getParams(int)
+
+/**
+ * Evaluate which color is the best for current player. In our evaluation
+ * system, zero cards / reverse cards are worth 2 points, non-zero number
+ * cards are worth 4 points, and skip / draw two cards are worth 5 points
+ * by default (see PARAM_*_WORTH). Finally, the color which contains the
+ * worthiest cards becomes the best color.
+ *
+ * @return Current player's best color.
+ */
+Color AI::calcBestColor4NowPlayer() {
+    Color bestColor;
+    Player *next, *oppo, *prev;
+    Color nextWeak, nextStrong;
+    Color oppoWeak, oppoStrong;
+    Color prevWeak, prevStrong;
+    bool nextIsUno, oppoIsUno, prevIsUno;
+
+    // When defensing UNO dash, use others' weak color as your best color
+    next = uno->getNextPlayer();
+    oppo = uno->getOppoPlayer();
+    prev = uno->getPrevPlayer();
+    nextIsUno = next->getHandSize() == 1;
+    oppoIsUno = oppo->getHandSize() == 1;
+    prevIsUno = prev->getHandSize() == 1;
+    nextWeak = next->getWeakColor();
+    oppoWeak = oppo->getWeakColor();
+    prevWeak = prev->getWeakColor();
+    if (nextIsUno && nextWeak != NONE) {
+        bestColor = nextWeak;
+    } // if (nextIsUno && nextWeak != NONE)
+    else if (oppoIsUno && oppoWeak != NONE) {
+        bestColor = oppoWeak;
+    } // else if (oppoIsUno && oppoWeak != NONE)
+    else if (prevIsUno && prevWeak != NONE) {
+        bestColor = prevWeak;
+    } // else if (prevIsUno && prevWeak != NONE)
+    else {
+        int score[] = { 0, 0, 0, 0, 0 };
+        Player *curr = uno->getCurrPlayer();
+        const int* param = getParams(uno->getNow());
+
+        for (Card* card : curr->getHandCards()) {
+            switch (card->content) {
+            case WILD:
+            case WILD_DRAW4:
+                break; // case WILD, WILD_DRAW4
+
+            case REV:
+            case NUM0:
+                score[card->color] += param[PARAM_ZERO_REV_WORTH];
+                break; // case REV, NUM0
+
+            case SKIP:
+            case DRAW2:
+                score[card->color] += param[PARAM_SKIP_DRAW2_WORTH];
+                break; // case SKIP, DRAW2
+
+            default:
+                score[card->color] += param[PARAM_NUM_WORTH];
+                break; // default
+            } // switch (card->content)
+        } // for (Card* card : curr->getHandCards())
+
+        // Calculate the best color
+        bestColor = NONE;
+        if (score[RED] > score[bestColor]) {
+            bestColor = RED;
+        } // if (score[RED] > score[bestColor])
+
+        if (score[BLUE] > score[bestColor]) {
+            bestColor = BLUE;
+        } // if (score[BLUE] > score[bestColor]
+
+        if (score[GREEN] > score[bestColor]) {
+            bestColor = GREEN;
+        } // if (score[GREEN] > score[bestColor])
+
+        if (score[YELLOW] > score[bestColor]) {
+            bestColor = YELLOW;
+        } // if (score[YELLOW] > score[bestColor])
+
+        if (bestColor == NONE) {
+            // Only wild cards in hand
+            // Use others' weak color as your best color
+            bestColor
+                = prevWeak != NONE ? prevWeak
+                : oppoWeak != NONE ? oppoWeak
+                : nextWeak != NONE ? nextWeak : RED;
+        } // if (bestColor == NONE)
+    } // else
+
+    // Determine your best color in dangerous cases. Be careful of the
+    // conflict with other opponents' strong colors.
+    nextStrong = next->getStrongColor();
+    oppoStrong = oppo->getStrongColor();
+    prevStrong = prev->getStrongColor();
+    if ((nextIsUno && bestColor == nextStrong)
+        || (oppoIsUno && bestColor == oppoStrong)
+        || (prevIsUno && bestColor == prevStrong)) {
+        // Pick one of the colors without conflict at random. At most 3
+        // colors are in conflict, so there is always one left.
+        Color allowed[4];
+        int count = 0;
+
+        for (int c = RED; c <= YELLOW; ++c) {
+            if ((!nextIsUno || c != nextStrong)
+                && (!oppoIsUno || c != oppoStrong)
+                && (!prevIsUno || c != prevStrong)) {
+                allowed[count++] = Color(c);
+            } // if ((!nextIsUno || c != nextStrong) && ...)
+        } // for (int c = RED; c <= YELLOW; ++c)
+
+        bestColor = allowed[uno->rand() % count];
+    } // if (nextIsUno && bestColor == nextStrong || ...)
+
+    return bestColor;
+} // calcBestColor4NowPlayer()
+
+/**
+ * In 7-0 rule, when a seven card is put down, the player must swap hand
+ * cards with another player immediately. This API returns that swapping
+ * with whom is the best answer for current player.
+ *
+ * @return Current player swaps with whom. Must be one of the following:
+ *         Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+ */
+int AI::calcBestSwapTarget4NowPlayer() {
+    int target;
+    Player *next, *oppo, *prev;
+
+    next = uno->getNextPlayer();
+    oppo = uno->getOppoPlayer();
+    prev = uno->getPrevPlayer();
+    if (prev->getHandSize() == 1) {
+        target = uno->getPrev();
+    } // if (prev->getHandSize() == 1)
+    else if (oppo->getHandSize() == 1) {
+        target = uno->getOppo();
+    } // else if (oppo->getHandSize() == 1)
+    else if (next->getHandSize() == 1) {
+        target = uno->getNext();
+    } // else if (next->getHandSize() == 1)
+    else if (prev->getStrongColor() == uno->lastColor()) {
+        target = uno->getPrev();
+    } // else if (prev->getStrongColor() == uno->lastColor())
+    else if (oppo->getStrongColor() == uno->lastColor()) {
+        target = uno->getOppo();
+    } // else if (oppo->getStrongColor() == uno->lastColor())
+    else if (next->getStrongColor() == uno->lastColor()) {
+        target = uno->getNext();
+    } // else if (next->getStrongColor() == uno->lastColor())
+    else {
+        target = uno->getPrev();
+    } // else
+
+    return target;
+} // calcBestSwapTarget4NowPlayer()
+
+/**
+ * AI strategies of determining if it's necessary to challenge previous
+ * player's [wild +4] card's legality. Easy AI follows fixed rules, and
+ * other levels sample the mixed strategy solved by BluffSolver.
+ *
+ * @return True if it's necessary to make a challenge.
+ */
+bool AI::needToChallenge() {
+    bool challenge;
+    int chance;
+    Player* curr = uno->getCurrPlayer();
+    int size = uno->getNextPlayer()->getHandSize();
+    const int* param = getParams(uno->getNext());
+
+    if (uno->getDifficulty() == Uno::LV_EASY) {
+        // Challenge when defending my UNO dash
+        // Challenge when I have 10 or more cards already
+        // Challenge when legal color has not been changed
+        challenge = size == 1
+            || size >= Uno::MAX_HOLD_CARDS - param[PARAM_CHALLENGE_MARGIN]
+            || uno->lastColor() == uno->next2lastColor();
+    } // if (uno->getDifficulty() == Uno::LV_EASY)
+    else {
+        // Challenge when I have 10 or more cards already
+        // Otherwise sample the mixed strategy solved by BluffSolver
+        chance = BLUFF_CHALLENGE
+            [BluffSolver::bucketOf(curr->getHandSize())]
+            [BluffSolver::bucketOf(size)]
+            [BluffSolver::evidenceOf(
+                uno->lastColor() == uno->next2lastColor(),
+                curr->getWeakColor() == uno->next2lastColor())];
+        challenge = size >= Uno::MAX_HOLD_CARDS
+            - param[PARAM_CHALLENGE_MARGIN]
+            || sample(chance, uno, uno->getNext());
+    } // else
+
+    return challenge;
+} // needToChallenge()
+
+/**
+ * AI Strategies (Difficulty: EASY). Analyze current player's hand cards,
+ * and calculate which is the best card to play out.
+ *
+ * @param outColor This is a out parameter. Pass a Color array (length>=1)
+ *                 in order to let us pass the return value by assigning
+ *                 outColor[0]. When the best card to play becomes a wild
+ *                 card, outColor[0] will become the following legal color
+ *                 to change. When the best card to play becomes an action
+ *                 or a number card, outColor[0] will become the player's
+ *                 best color.
+ * @return Index of the best card to play, in current player's hand.
+ *         Or a negative number that means no appropriate card to play.
+ */
+int AI::easyAI_bestCardIndex4NowPlayer(Color outColor[]) {
+    Card* card;
+    int i, idxBest;
+    std::vector<Card*> hand;
+    Color bestColor, lastColor;
+    int yourSize, nextSize, prevSize;
+    int idxNum, idxRev, idxSkip, idxDraw2, idxWild, idxWD4;
+    bool hasNum, hasRev, hasSkip, hasDraw2, hasWild, hasWD4;
+
+    if (outColor == nullptr) {
+        throw "outColor[] cannot be nullptr";
+    } // if (outColor == nullptr)
+
+    hand = uno->getCurrPlayer()->getHandCards();
+    yourSize = int(hand.size());
+    if (yourSize == 1) {
+        // Only one card remained. Play it when it's legal.
+        card = hand.at(0);
+        outColor[0] = card->color;
+        return uno->isLegalToPlay(card) ? 0 : -1;
+    } // if (yourSize == 1)
+
+    idxBest = -1;
+    lastColor = uno->lastColor();
+    bestColor = calcBestColor4NowPlayer();
+    idxNum = idxRev = idxSkip = idxDraw2 = idxWild = idxWD4 = -1;
+    hasNum = hasRev = hasSkip = hasDraw2 = hasWild = hasWD4 = false;
+    for (i = 0; i < yourSize; ++i) {
+        // Index of any kind
+        card = hand.at(i);
+        if (uno->isLegalToPlay(card)) {
+            switch (card->content) {
+            case DRAW2:
+                if (!hasDraw2 || card->color == bestColor) {
+                    idxDraw2 = i;
+                    hasDraw2 = true;
+                } // if (!hasDraw2 || card->color == bestColor)
+                break; // case DRAW2
+
+            case SKIP:
+                if (!hasSkip || card->color == bestColor) {
+                    idxSkip = i;
+                    hasSkip = true;
+                } // if (!hasSkip || card->color == bestColor)
+                break; // case SKIP
+
+            case REV:
+                if (!hasRev || card->color == bestColor) {
+                    idxRev = i;
+                    hasRev = true;
+                } // if (!hasRev || card->color == bestColor)
+                break; // case REV
+
+            case WILD:
+                idxWild = i;
+                hasWild = true;
+                break; // case WILD
+
+            case WILD_DRAW4:
+                idxWD4 = i;
+                hasWD4 = true;
+                break; // case WILD_DRAW4
+
+            default: // number cards
+                if (!hasNum || card->color == bestColor) {
+                    idxNum = i;
+                    hasNum = true;
+                } // if (!hasNum || card->color == bestColor)
+                break; // default
+            } // switch (card->content)
+        } // if (uno->isLegalToPlay(card))
+    } // for (i = 0; i < yourSize; ++i)
+
+    // Decision tree
+    nextSize = uno->getNextPlayer()->getHandSize();
+    if (nextSize == 1) {
+        // Strategies when your next player remains only one card.
+        // Limit your next player's action as well as you can.
+        if (hasDraw2)
+            idxBest = idxDraw2;
+        else if (hasSkip)
+            idxBest = idxSkip;
+        else if (hasRev)
+            idxBest = idxRev;
+        else if (hasWD4 && lastColor != bestColor)
+            idxBest = idxWD4;
+        else if (hasWild && lastColor != bestColor)
+            idxBest = idxWild;
+        else if (hasNum)
+            idxBest = idxNum;
+    } // if (nextSize == 1)
+    else {
+        // Normal strategies
+        prevSize = uno->getPrevPlayer()->getHandSize();
+        if (hasRev && prevSize > nextSize)
+            idxBest = idxRev;
+        else if (hasNum)
+            idxBest = idxNum;
+        else if (hasSkip)
+            idxBest = idxSkip;
+        else if (hasDraw2)
+            idxBest = idxDraw2;
+        else if (hasRev && prevSize > 1)
+            idxBest = idxRev;
+        else if (hasWild)
+            idxBest = idxWild;
+        else if (hasWD4)
+            idxBest = idxWD4;
+    } // else
+
+    outColor[0] = bestColor;
+    return idxBest;
+} // easyAI_bestCardIndex4NowPlayer(Color[])
+
+/**
+ * AI Strategies (Difficulty: HARD). Analyze current player's hand cards,
+ * and calculate which is the best card to play.
+ *
+ * @param outColor This is a out parameter. Pass a Color array (length>=1)
+ *                 in order to let us pass the return value by assigning
+ *                 outColor[0]. When the best card to play becomes a wild
+ *                 card, outColor[0] will become the following legal color
+ *                 to change. When the best card to play becomes an action
+ *                 or a number card, outColor[0] will become the player's
+ *                 best color.
+ * @return Index of the best card to play, in current player's hand.
+ *         Or a negative number that means no appropriate card to play.
+ */
+int AI::hardAI_bestCardIndex4NowPlayer(Color outColor[]) {
+    Card* card;
+    const int* param;
+    bool allWild, numFirst, hasLast;
+    int attackSize, reverseSize, saveSize;
+    int i, idxBest, chance;
+    std::vector<Card*> hand;
+    Player *next, *oppo, *prev;
+    Color bestColor, lastColor;
+    int yourSize, nextSize, oppoSize, prevSize;
+    Color nextWeak, nextStrong, oppoStrong, prevStrong;
+    int idxNumIn[5], idxRev, idxSkip, idxDraw2, idxWild, idxWD4;
+    bool hasNumIn[5], hasRev, hasSkip, hasDraw2, hasWild, hasWD4;
+
+    if (outColor == nullptr) {
+        throw "outColor[] cannot be nullptr";
+    } // if (outColor == nullptr)
+
+    hand = uno->getCurrPlayer()->getHandCards();
+    yourSize = int(hand.size());
+    if (yourSize == 1) {
+        // Only one card remained. Play it when it's legal.
+        card = hand.at(0);
+        outColor[0] = card->color;
+        return AI_BRANCH("hard", uno->isLegalToPlay(card) ? 0 : -1);
+    } // if (yourSize == 1)
+
+    idxBest = -1;
+    allWild = true;
+    hasLast = false;
+    param = getParams(uno->getNow());
+    attackSize = param[PARAM_ATTACK_SIZE];
+    reverseSize = param[PARAM_REVERSE_SIZE];
+    saveSize = param[PARAM_SAVE_SIZE];
+    numFirst = param[PARAM_NUM_FIRST] != 0;
+    lastColor = uno->lastColor();
+    bestColor = calcBestColor4NowPlayer();
+    idxRev = idxSkip = idxDraw2 = idxWild = idxWD4 = -1;
+    hasRev = hasSkip = hasDraw2 = hasWild = hasWD4 = false;
+    idxNumIn[0] = idxNumIn[1] = idxNumIn[2] = idxNumIn[3] = idxNumIn[4] = -1;
+    hasNumIn[0] = hasNumIn[1] = hasNumIn[2] = hasNumIn[3] = hasNumIn[4] = false;
+    for (i = 0; i < yourSize; ++i) {
+        // Index of any kind
+        card = hand.at(i);
+        allWild = allWild && card->isWild();
+        hasLast = hasLast || (!card->isWild() && card->color == lastColor);
+        if (uno->isLegalToPlay(card)) {
+            switch (card->content) {
+            case DRAW2:
+                if (!hasDraw2 || card->color == bestColor) {
+                    idxDraw2 = i;
+                    hasDraw2 = true;
+                } // if (!hasDraw2 || card->color == bestColor)
+                break; // case DRAW2
+
+            case SKIP:
+                if (!hasSkip || card->color == bestColor) {
+                    idxSkip = i;
+                    hasSkip = true;
+                } // if (!hasSkip || card->color == bestColor)
+                break; // case SKIP
+
+            case REV:
+                if (!hasRev || card->color == bestColor) {
+                    idxRev = i;
+                    hasRev = true;
+                } // if (!hasRev || card->color == bestColor)
+                break; // case REV
+
+            case WILD:
+                idxWild = i;
+                hasWild = true;
+                break; // case WILD
+
+            case WILD_DRAW4:
+                idxWD4 = i;
+                hasWD4 = true;
+                break; // case WILD_DRAW4
+
+            default: // number cards
+                idxNumIn[card->color] = i;
+                hasNumIn[card->color] = true;
+                break; // default
+            } // switch (card->content)
+        } // if (uno->isLegalToPlay(card))
+    } // for (i = 0; i < yourSize; ++i)
+
+    if (hasWD4 && hasLast) {
+        // Playing [wild +4] now is a bluff. Keep it or not by the mixed
+        // strategy solved by BluffSolver.
+        chance = BLUFF_PLAY
+            [BluffSolver::bucketOf(yourSize - 1)]
+            [BluffSolver::bucketOf(uno->getNextPlayer()->getHandSize())]
+            [BluffSolver::evidenceOf(
+                bestColor == lastColor,
+                uno->getCurrPlayer()->getWeakColor() == lastColor)];
+        if (!sample(chance, uno, uno->getNow() + 4)) {
+            idxWD4 = -1;
+            hasWD4 = false;
+        } // if (!sample(chance, uno, uno->getNow() + 4))
+    } // if (hasWD4 && hasLast)
+
+    // Decision tree
+    next = uno->getNextPlayer();
+    nextSize = next->getHandSize();
+    nextWeak = next->getWeakColor();
+    nextStrong = next->getStrongColor();
+    oppo = uno->getOppoPlayer();
+    oppoSize = oppo->getHandSize();
+    oppoStrong = oppo->getStrongColor();
+    prev = uno->getPrevPlayer();
+    prevSize = prev->getHandSize();
+    prevStrong = prev->getStrongColor();
+    if (nextSize == 1) {
+        // Strategies when your next player remains only one card.
+        // Limit your next player's action as well as you can.
+        if (hasDraw2)
+            idxBest = AI_BRANCH("hard", idxDraw2);
+        else if (lastColor == nextStrong) {
+            // Priority when next called Uno & lastColor == nextStrong:
+            // 0: Number cards, NOT in color of nextStrong
+            // 1: Skip cards, in any color
+            // 2: Wild cards, switch to your best color
+            // 3: Wild +4 cards, switch to your best color
+            // 4: Reverse cards, in any color
+            // 5: Draw one, and pray to get one of the above...
+            if (hasNumIn[bestColor])
+                idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
+            else if (hasNumIn[RED] && nextStrong != RED
+                && (prevSize > 1 || prevStrong != RED)
+                && (oppoSize > 1 || oppoStrong != RED))
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
+            else if (hasNumIn[BLUE] && nextStrong != BLUE
+                && (prevSize > 1 || prevStrong != BLUE)
+                && (oppoSize > 1 || oppoStrong != BLUE))
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
+            else if (hasNumIn[GREEN] && nextStrong != GREEN
+                && (prevSize > 1 || prevStrong != GREEN)
+                && (oppoSize > 1 || oppoStrong != GREEN))
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
+            else if (hasNumIn[YELLOW] && nextStrong != YELLOW
+                && (prevSize > 1 || prevStrong != YELLOW)
+                && (oppoSize > 1 || oppoStrong != YELLOW))
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
+            else if (hasSkip)
+                idxBest = AI_BRANCH("hard", idxSkip);
+            else if (hasWild)
+                idxBest = AI_BRANCH("hard", idxWild);
+            else if (hasWD4)
+                idxBest = AI_BRANCH("hard", idxWD4);
+            else if (hasRev)
+                idxBest = AI_BRANCH("hard", idxRev);
+        } // else if (lastColor == nextStrong)
+        else if (nextStrong != NONE) {
+            // Priority when next called Uno & lastColor != nextStrong:
+            // (nextStrong is known)
+            // 0: Number cards, NOT in color of nextStrong
+            // 1: Reverse cards, NOT in color of nextStrong
+            // 2: Skip cards, NOT in color of nextStrong
+            // 3: Draw one because it's not necessary to use wild cards
+            if (hasNumIn[bestColor])
+                idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
+            else if (hasNumIn[RED] && nextStrong != RED
+                && (prevSize > 1 || prevStrong != RED)
+                && (oppoSize > 1 || oppoStrong != RED))
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
+            else if (hasNumIn[BLUE] && nextStrong != BLUE
+                && (prevSize > 1 || prevStrong != BLUE)
+                && (oppoSize > 1 || oppoStrong != BLUE))
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
+            else if (hasNumIn[GREEN] && nextStrong != GREEN
+                && (prevSize > 1 || prevStrong != GREEN)
+                && (oppoSize > 1 || oppoStrong != GREEN))
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
+            else if (hasNumIn[YELLOW] && nextStrong != YELLOW
+                && (prevSize > 1 || prevStrong != YELLOW)
+                && (oppoSize > 1 || oppoStrong != YELLOW))
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
+            else if (hasRev && prevSize >= reverseSize
+                && hand.at(idxRev)->color != nextStrong)
+                idxBest = AI_BRANCH("hard", idxRev);
+            else if (hasSkip && hand.at(idxSkip)->color != nextStrong)
+                idxBest = AI_BRANCH("hard", idxSkip);
+        } // else if (nextStrong != NONE)
+        else {
+            // Priority when next called Uno & nextStrong is unknown:
+            // 0: Skip cards, in any color
+            // 1: Reverse cards, in any color
+            // 2: Wild +4 cards, if no cards matching last color
+            // 3: Number cards, in your best color
+            // 4: Wild cards, switch to your best color
+            // 5: Wild +4 cards, switch to your best color
+            // 6: Number cards, in any color
+            if (hasSkip)
+                idxBest = AI_BRANCH("hard", idxSkip);
+            else if (hasRev)
+                idxBest = AI_BRANCH("hard", idxRev);
+            else if (hasWD4 && !hasNumIn[lastColor])
+                idxBest = AI_BRANCH("hard", idxWD4);
+            else if (hasNumIn[bestColor])
+                idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
+            else if (hasWild)
+                idxBest = AI_BRANCH("hard", idxWild);
+            else if (hasWD4)
+                idxBest = AI_BRANCH("hard", idxWD4);
+            else if (hasNumIn[RED]
+                && (prevSize > 1 || prevStrong != RED)
+                && (oppoSize > 1 || oppoStrong != RED))
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
+            else if (hasNumIn[BLUE]
+                && (prevSize > 1 || prevStrong != BLUE)
+                && (oppoSize > 1 || oppoStrong != BLUE))
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
+            else if (hasNumIn[GREEN]
+                && (prevSize > 1 || prevStrong != GREEN)
+                && (oppoSize > 1 || oppoStrong != GREEN))
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
+            else if (hasNumIn[YELLOW]
+                && (prevSize > 1 || prevStrong != YELLOW)
+                && (oppoSize > 1 || oppoStrong != YELLOW))
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
+        } // else
+    } // if (nextSize == 1)
+    else if (prevSize == 1) {
+        // Strategies when your previous player remains only one card.
+        // Save your action cards as much as you can, because once a reverse
+        // card is put down, you can use these cards to limit your previous
+        // player's action.
+        if (lastColor == prevStrong) {
+            // Priority when prev called Uno & lastColor == prevStrong:
+            // 0: Skip cards, NOT in color of prevStrong
+            // 1: Wild cards, switch to your best color
+            // 2: Wild +4 cards, switch to your best color
+            // 3: Number cards, in any color, but firstly your best color
+            // 4: Draw one because it's not necessary to use other cards
+            if (hasSkip && hand.at(idxSkip)->color != prevStrong)
+                idxBest = AI_BRANCH("hard", idxSkip);
+            else if (hasWild)
+                idxBest = AI_BRANCH("hard", idxWild);
+            else if (hasWD4)
+                idxBest = AI_BRANCH("hard", idxWD4);
+            else if (hasNumIn[bestColor])
+                idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
+            else if (hasNumIn[RED])
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
+            else if (hasNumIn[BLUE])
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
+            else if (hasNumIn[GREEN])
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
+            else if (hasNumIn[YELLOW])
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
+        } // if (lastColor == prevStrong)
+        else if (prevStrong != NONE) {
+            // Priority when prev called Uno & lastColor != prevStrong:
+            // (prevStrong is known)
+            // 0: Reverse cards, NOT in color of prevStrong
+            // 1: Number cards, NOT in color of prevStrong
+            // 2: Draw one because it's not necessary to use other cards
+            if (hasRev && hand.at(idxRev)->color != prevStrong)
+                idxBest = AI_BRANCH("hard", idxRev);
+            else if (hasNumIn[bestColor])
+                idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
+            else if (hasNumIn[RED] && prevStrong != RED
+                && (oppoSize > 1 || oppoStrong != RED))
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
+            else if (hasNumIn[BLUE] && prevStrong != BLUE
+                && (oppoSize > 1 || oppoStrong != BLUE))
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
+            else if (hasNumIn[GREEN] && prevStrong != GREEN
+                && (oppoSize > 1 || oppoStrong != GREEN))
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
+            else if (hasNumIn[YELLOW] && prevStrong != YELLOW
+                && (oppoSize > 1 || oppoStrong != YELLOW))
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
+        } // else if (prevStrong != NONE)
+        else {
+            // Priority when prev called Uno & prevStrong is unknown:
+            // 0: Number cards, in your best color
+            // 1: Wild cards, switch to your best color
+            // 2: Wild +4 cards, switch to your best color
+            // 3: Number cards, in any color
+            // 4: Draw one. DO NOT PLAY REVERSE CARDS!
+            if (hasNumIn[bestColor])
+                idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
+            else if (hasWild && lastColor != bestColor)
+                idxBest = AI_BRANCH("hard", idxWild);
+            else if (hasWD4 && lastColor != bestColor)
+                idxBest = AI_BRANCH("hard", idxWD4);
+            else if (hasNumIn[RED])
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
+            else if (hasNumIn[BLUE])
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
+            else if (hasNumIn[GREEN])
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
+            else if (hasNumIn[YELLOW])
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
+        } // else
+    } // else if (prevSize == 1)
+    else if (oppoSize == 1) {
+        // Strategies when your opposite player remains only one card.
+        // Give more freedom to your next player, the only one that can
+        // directly limit your opposite player's action.
+        if (lastColor == oppoStrong) {
+            // Priority when oppo called Uno & lastColor == oppoStrong:
+            // 0: Number cards, NOT in color of oppoStrong
+            // 1: Reverse cards, NOT in color of oppoStrong
+            // 2: Skip cards, NOT in color of oppoStrong
+            // 3: +2 cards, NOT in color of oppoStrong
+            // 4: Wild cards, switch to your best color
+            // 5: Wild +4 cards, switch to your best color
+            // 6: Reverse cards, in color of oppoStrong
+            //    (only when prevSize > nextSize)
+            //    (pray that prev can limit oppo!)
+            // 7: Number cards, in color of oppoStrong
+            //    (pray that next can limit oppo!)
+            if (hasNumIn[bestColor])
+                idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
+            else if (hasNumIn[RED] && oppoStrong != RED)
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
+            else if (hasNumIn[BLUE] && oppoStrong != BLUE)
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
+            else if (hasNumIn[GREEN] && oppoStrong != GREEN)
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
+            else if (hasNumIn[YELLOW] && oppoStrong != YELLOW)
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
+            else if (hasRev && hand.at(idxRev)->color != oppoStrong)
+                idxBest = AI_BRANCH("hard", idxRev);
+            else if (hasSkip && hand.at(idxSkip)->color != oppoStrong)
+                idxBest = AI_BRANCH("hard", idxSkip);
+            else if (hasDraw2 && hand.at(idxDraw2)->color != oppoStrong)
+                idxBest = AI_BRANCH("hard", idxDraw2);
+            else if (hasWild)
+                idxBest = AI_BRANCH("hard", idxWild);
+            else if (hasWD4)
+                idxBest = AI_BRANCH("hard", idxWD4);
+            else if (hasRev && prevSize > nextSize)
+                idxBest = AI_BRANCH("hard", idxRev);
+            else if (hasNumIn[RED])
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
+            else if (hasNumIn[BLUE])
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
+            else if (hasNumIn[GREEN])
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
+            else if (hasNumIn[YELLOW])
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
+        } // if (lastColor == oppoStrong)
+        else if (oppoStrong != NONE) {
+            // Priority when oppo called Uno & lastColor != oppoStrong:
+            // (oppoStrong is known)
+            // 0: Number cards, NOT in color of oppoStrong
+            // 1: Reverse cards, NOT in color of oppoStrong
+            // 2: Skip cards, NOT in color of oppoStrong
+            // 3: +2 cards, NOT in color of oppoStrong
+            // 4: Draw one because it's not necessary to use other cards
+            if (hasNumIn[bestColor])
+                idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
+            else if (hasNumIn[RED] && oppoStrong != RED)
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
+            else if (hasNumIn[BLUE] && oppoStrong != BLUE)
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
+            else if (hasNumIn[GREEN] && oppoStrong != GREEN)
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
+            else if (hasNumIn[YELLOW] && oppoStrong != YELLOW)
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
+            else if (hasRev && hand.at(idxRev)->color != oppoStrong)
+                idxBest = AI_BRANCH("hard", idxRev);
+            else if (hasSkip && nextSize <= attackSize
+                && hand.at(idxSkip)->color != oppoStrong)
+                idxBest = AI_BRANCH("hard", idxSkip);
+            else if (hasDraw2 && nextSize <= attackSize
+                && hand.at(idxDraw2)->color != oppoStrong)
+                idxBest = AI_BRANCH("hard", idxDraw2);
+        } // else if (oppoStrong != NONE)
+        else {
+            // Priority when oppo called Uno & oppoStrong is unknown:
+            // 0: Reverse cards, in any color
+            //    (only when prevSize > nextSize)
+            // 1: Number cards, in any color, but firstly your best color
+            // 2: Wild cards, switch to your best color
+            // 3: Wild +4 cards, switch to your best color
+            // 4: Draw one because it's not necessary to use other cards
+            if (hasRev && prevSize > nextSize)
+                idxBest = AI_BRANCH("hard", idxRev);
+            else if (hasNumIn[bestColor])
+                idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
+            else if (hasNumIn[RED])
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
+            else if (hasNumIn[BLUE])
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
+            else if (hasNumIn[GREEN])
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
+            else if (hasNumIn[YELLOW])
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
+            else if (hasWild && lastColor != bestColor)
+                idxBest = AI_BRANCH("hard", idxWild);
+            else if (hasWD4 && lastColor != bestColor && nextSize <= attackSize)
+                idxBest = AI_BRANCH("hard", idxWD4);
+        } // else
+    } // else if (oppoSize == 1)
+    else if (allWild) {
+        // Strategies when you remain only wild cards.
+        // When your next player remains only a few cards, use [Wild +4]
+        // cards at first. Otherwise, use [Wild] cards at first.
+        if (nextSize <= attackSize)
+            idxBest = AI_BRANCH("hard", hasWD4 ? idxWD4 : idxWild);
+        else
+            idxBest = AI_BRANCH("hard", hasWild ? idxWild : idxWD4);
+    } // else if (allWild)
+    else if (lastColor == nextWeak && yourSize > 2) {
+        // Strategies when your next player drew a card in its last action.
+        // Unless keeping or changing to your best color, you do not need to
+        // play your limitation/wild cards. Use them in more dangerous cases.
+        // Priority:
+        // 0: Reverse cards, in any color
+        //    (only when prevSize > nextSize)
+        // 1: Number cards, in (nextWeak > bestColor > others)
+        // 2: Reverse cards, in any color
+        // 3: Skip cards, in your best color
+        // 4: +2 cards, in your best color
+        if (hasRev && prevSize > nextSize)
+            idxBest = AI_BRANCH("hard", idxRev);
+        else if (hasNumIn[nextWeak])
+            idxBest = AI_BRANCH("hard", idxNumIn[nextWeak]);
+        else if (hasNumIn[bestColor])
+            idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
+        else if (hasNumIn[RED])
+            idxBest = AI_BRANCH("hard", idxNumIn[RED]);
+        else if (hasNumIn[BLUE])
+            idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
+        else if (hasNumIn[GREEN])
+            idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
+        else if (hasNumIn[YELLOW])
+            idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
+        else if (hasRev
+            && (prevSize >= reverseSize || prev->getRecent() == nullptr))
+            idxBest = AI_BRANCH("hard", idxRev);
+        else if (hasSkip && oppoSize >= saveSize
+            && hand.at(idxSkip)->color == bestColor)
+            idxBest = AI_BRANCH("hard", idxSkip);
+        else if (hasDraw2 && oppoSize >= saveSize
+            && hand.at(idxDraw2)->color == bestColor)
+            idxBest = AI_BRANCH("hard", idxDraw2);
+    } // else if (lastColor == nextWeak && yourSize > 2)
+    else {
+        // Normal strategies
+        // Priority:
+        // 0: +2 cards, in any color, when nextSize <= 4
+        // 1: Skip cards, in any color, when nextSize <= 4
+        // 2: Reverse cards, in any color, when prevSize > nextSize,
+        //    or prev drew a card in its last action
+        // 3: Number cards, in any color, but firstly your best color
+        // 4: Skip cards, in your best color
+        // 5: +2 cards, in your best color
+        // 6: Wild cards, switch to your best color, when nextSize <= 4
+        // 7: Wild +4 cards, switch to your best color, when nextSize <= 4
+        // 8: Wild +4 cards, when yourSize == 2 && prevSize <= 3 (UNO dash!)
+        // 9: Wild cards, when yourSize == 2 && prevSize <= 3 (UNO dash!)
+        // When PARAM_NUM_FIRST is set, 0~2 are skipped if any number card
+        // is legal to play.
+        numFirst = numFirst && (hasNumIn[RED] || hasNumIn[BLUE]
+            || hasNumIn[GREEN] || hasNumIn[YELLOW]);
+        if (!numFirst && hasDraw2
+            && nextSize <= attackSize && nextSize - oppoSize <= 1)
+            idxBest = AI_BRANCH("hard", idxDraw2);
+        else if (!numFirst && hasSkip
+            && nextSize <= attackSize && nextSize - oppoSize <= 1)
+            idxBest = AI_BRANCH("hard", idxSkip);
+        else if (!numFirst && hasRev &&
+            (prevSize > nextSize || prev->getRecent() == nullptr))
+            idxBest = AI_BRANCH("hard", idxRev);
+        else if (hasNumIn[bestColor])
+            idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
+        else if (hasNumIn[RED])
+            idxBest = AI_BRANCH("hard", idxNumIn[RED]);
+        else if (hasNumIn[BLUE])
+            idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
+        else if (hasNumIn[GREEN])
+            idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
+        else if (hasNumIn[YELLOW])
+            idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
+        else if (hasRev && prevSize >= reverseSize)
+            idxBest = AI_BRANCH("hard", idxRev);
+        else if (hasSkip && oppoSize >= saveSize
+            && hand.at(idxSkip)->color == bestColor)
+            idxBest = AI_BRANCH("hard", idxSkip);
+        else if (hasDraw2 && oppoSize >= saveSize
+            && hand.at(idxDraw2)->color == bestColor)
+            idxBest = AI_BRANCH("hard", idxDraw2);
+        else if (hasWild && nextSize <= attackSize)
+            idxBest = AI_BRANCH("hard", idxWild);
+        else if (hasWD4 && nextSize <= attackSize)
+            idxBest = AI_BRANCH("hard", idxWD4);
+        else if (hasWD4 && yourSize == 2 && prevSize <= 3)
+            idxBest = AI_BRANCH("hard", idxWD4);
+        else if (hasWild && yourSize == 2 && prevSize <= 3)
+            idxBest = AI_BRANCH("hard", idxWild);
+        else if (yourSize == Uno::MAX_HOLD_CARDS) {
+            // When you are holding 14 cards, which means you cannot hold
+            // more cards, you need to play your action/wild cards to keep
+            // game running, even if it's not worth enough to use them.
+            if (hasSkip)
+                idxBest = AI_BRANCH("hard", idxSkip);
+            else if (hasDraw2)
+                idxBest = AI_BRANCH("hard", idxDraw2);
+            else if (hasRev)
+                idxBest = AI_BRANCH("hard", idxRev);
+            else if (hasWild)
+                idxBest = AI_BRANCH("hard", idxWild);
+            else if (hasWD4)
+                idxBest = AI_BRANCH("hard", idxWD4);
+        } // else if (yourSize == Uno::MAX_HOLD_CARDS)
+    } // else
+
+    outColor[0] = bestColor;
+    return idxBest;
+} // hardAI_bestCardIndex4NowPlayer(Color[])
+
+/**
+ * AI Strategies in 7-0 special rule. Analyze current player's hand cards,
+ * and calculate which is the best card to play out.
+ *
+ * @param outColor This is a out parameter. Pass a Color array (length>=1)
+ *                 in order to let us pass the return value by assigning
+ *                 outColor[0]. When the best card to play becomes a wild
+ *                 card, outColor[0] will become the following legal color
+ *                 to change. When the best card to play becomes an action
+ *                 or a number card, outColor[0] will become the player's
+ *                 best color.
+ * @return Index of the best card to play, in current player's hand.
+ *         Or a negative number that means no appropriate card to play.
+ */
+int AI::sevenZeroAI_bestCardIndex4NowPlayer(Color outColor[]) {
+    Card* card;
+    int i, idxBest;
+    std::vector<Card*> hand;
+    Player *next, *oppo, *prev;
+    Color bestColor, lastColor;
+    int idx0, idxNum, idxWild, idxWD4;
+    bool has0, hasNum, hasWild, hasWD4;
+    int idx7, idxRev, idxSkip, idxDraw2;
+    bool has7, hasRev, hasSkip, hasDraw2;
+    Color nextStrong, oppoStrong, prevStrong;
+    int yourSize, nextSize, oppoSize, prevSize;
+
+    if (outColor == nullptr) {
+        throw "outColor[] cannot be nullptr";
+    } // if (outColor == nullptr)
+
+    hand = uno->getCurrPlayer()->getHandCards();
+    yourSize = int(hand.size());
+    if (yourSize == 1) {
+        // Only one card remained. Play it when it's legal.
+        card = hand.at(0);
+        outColor[0] = card->color;
+        return AI_BRANCH("7-0", uno->isLegalToPlay(card) ? 0 : -1);
+    } // if (yourSize == 1)
+
+    idxBest = -1;
+    lastColor = uno->lastColor();
+    bestColor = calcBestColor4NowPlayer();
+    idx0 = idxNum = idxWild = idxWD4 = -1;
+    has0 = hasNum = hasWild = hasWD4 = false;
+    idx7 = idxRev = idxSkip = idxDraw2 = -1;
+    has7 = hasRev = hasSkip = hasDraw2 = false;
+    for (i = 0; i < yourSize; ++i) {
+        // Index of any kind
+        card = hand.at(i);
+        if (uno->isLegalToPlay(card)) {
+            switch (card->content) {
+            case DRAW2:
+                if (!hasDraw2 || card->color == bestColor) {
+                    idxDraw2 = i;
+                    hasDraw2 = true;
+                } // if (!hasDraw2 || card->color == bestColor)
+                break; // case DRAW2
+
+            case SKIP:
+                if (!hasSkip || card->color == bestColor) {
+                    idxSkip = i;
+                    hasSkip = true;
+                } // if (!hasSkip || card->color == bestColor)
+                break; // case SKIP
+
+            case REV:
+                if (!hasRev || card->color == bestColor) {
+                    idxRev = i;
+                    hasRev = true;
+                } // if (!hasRev || card->color == bestColor)
+                break; // case REV
+
+            case WILD:
+                idxWild = i;
+                hasWild = true;
+                break; // case WILD
+
+            case WILD_DRAW4:
+                idxWD4 = i;
+                hasWD4 = true;
+                break; // case WILD_DRAW4
+
+            case NUM7:
+                if (!has7 || card->color == bestColor) {
+                    idx7 = i;
+                    has7 = true;
+                } // if (!has7 || card->color == bestColor)
+                break; // case NUM7
+
+            case NUM0:
+                if (!has0 || card->color == bestColor) {
+                    idx0 = i;
+                    has0 = true;
+                } // if (!has0 || card->color == bestColor)
+                break; // case NUM0
+
+            default: // number cards
+                if (!hasNum || card->color == bestColor) {
+                    idxNum = i;
+                    hasNum = true;
+                } // if (!hasNum || card->color == bestColor)
+                break; // default
+            } // switch (card->content)
+        } // if (uno->isLegalToPlay(card))
+    } // for (i = 0; i < yourSize; ++i)
+
+    // Decision tree
+    next = uno->getNextPlayer();
+    nextSize = next->getHandSize();
+    nextStrong = next->getStrongColor();
+    oppo = uno->getOppoPlayer();
+    oppoSize = oppo->getHandSize();
+    oppoStrong = oppo->getStrongColor();
+    prev = uno->getPrevPlayer();
+    prevSize = prev->getHandSize();
+    prevStrong = prev->getStrongColor();
+    if (nextSize == 1) {
+        // Strategies when your next player remains only one card.
+        // Firstly consider to use a 7 to steal the UNO, if can't,
+        // limit your next player's action as well as you can.
+        if (has7 && (yourSize > 2
+            || (hand.at(1 - idx7)->content != NUM7
+                && hand.at(1 - idx7)->content != WILD
+                && hand.at(1 - idx7)->content != WILD_DRAW4
+                && hand.at(1 - idx7)->color != hand.at(idx7)->color)))
+            idxBest = AI_BRANCH("7-0", idx7);
+        else if (has0 && (yourSize > 2
+            || (hand.at(1 - idx0)->content != NUM0
+                && hand.at(1 - idx0)->content != WILD
+                && hand.at(1 - idx0)->content != WILD_DRAW4
+                && hand.at(1 - idx0)->color != hand.at(idx0)->color)))
+            idxBest = AI_BRANCH("7-0", idx0);
+        else if (hasDraw2)
+            idxBest = AI_BRANCH("7-0", idxDraw2);
+        else if (hasSkip)
+            idxBest = AI_BRANCH("7-0", idxSkip);
+        else if (hasRev)
+            idxBest = AI_BRANCH("7-0", idxRev);
+        else if (hasWD4 && lastColor != bestColor)
+            idxBest = AI_BRANCH("7-0", idxWD4);
+        else if (hasWild && lastColor != bestColor)
+            idxBest = AI_BRANCH("7-0", idxWild);
+        else if (hasNum && hand.at(idxNum)->color != nextStrong)
+            idxBest = AI_BRANCH("7-0", idxNum);
+        else if (hasWild && (has7 || has0))
+            idxBest = AI_BRANCH("7-0", idxWild);
+    } // if (nextSize == 1)
+    else if (prevSize == 1) {
+        // Strategies when your previous player remains only one card.
+        // Consider to use a 0 or 7 to steal the UNO.
+        if (has0)
+            idxBest = AI_BRANCH("7-0", idx0);
+        else if (has7)
+            idxBest = AI_BRANCH("7-0", idx7);
+        else if (hasNum)
+            idxBest = AI_BRANCH("7-0", idxNum);
+        else if (hasSkip && hand.at(idxSkip)->color != prevStrong)
+            idxBest = AI_BRANCH("7-0", idxSkip);
+        else if (hasDraw2 && hand.at(idxDraw2)->color != prevStrong)
+            idxBest = AI_BRANCH("7-0", idxDraw2);
+        else if (hasWild && lastColor != bestColor)
+            idxBest = AI_BRANCH("7-0", idxWild);
+        else if (hasWD4 && lastColor != bestColor)
+            idxBest = AI_BRANCH("7-0", idxWD4);
+    } // else if (prevSize == 1)
+    else if (oppoSize == 1) {
+        // Strategies when your opposite player remains only one card.
+        // Consider to use a 7 to steal the UNO.
+        if (has7)
+            idxBest = AI_BRANCH("7-0", idx7);
+        else if (has0)
+            idxBest = AI_BRANCH("7-0", idx0);
+        else if (hasNum)
+            idxBest = AI_BRANCH("7-0", idxNum);
+        else if (hasRev && prevSize > nextSize)
+            idxBest = AI_BRANCH("7-0", idxRev);
+        else if (hasSkip && hand.at(idxSkip)->color != oppoStrong)
+            idxBest = AI_BRANCH("7-0", idxSkip);
+        else if (hasDraw2 && hand.at(idxDraw2)->color != oppoStrong)
+            idxBest = AI_BRANCH("7-0", idxDraw2);
+        else if (hasWild && lastColor != bestColor)
+            idxBest = AI_BRANCH("7-0", idxWild);
+        else if (hasWD4 && lastColor != bestColor)
+            idxBest = AI_BRANCH("7-0", idxWD4);
+    } // else if (oppoSize == 1)
+    else {
+        // Normal strategies
+        if (has0 && hand.at(idx0)->color == prevStrong)
+            idxBest = AI_BRANCH("7-0", idx0);
+        else if (has7 && (hand.at(idx7)->color == prevStrong
+            || hand.at(idx7)->color == oppoStrong
+            || hand.at(idx7)->color == nextStrong))
+            idxBest = AI_BRANCH("7-0", idx7);
+        else if (hasRev && prevSize > nextSize)
+            idxBest = AI_BRANCH("7-0", idxRev);
+        else if (hasNum)
+            idxBest = AI_BRANCH("7-0", idxNum);
+        else if (hasSkip)
+            idxBest = AI_BRANCH("7-0", idxSkip);
+        else if (hasDraw2)
+            idxBest = AI_BRANCH("7-0", idxDraw2);
+        else if (hasRev)
+            idxBest = AI_BRANCH("7-0", idxRev);
+        else if (hasWild)
+            idxBest = AI_BRANCH("7-0", idxWild);
+        else if (hasWD4)
+            idxBest = AI_BRANCH("7-0", idxWD4);
+        else if (has0 && (yourSize > 2
+            || (hand.at(1 - idx0)->content != NUM0
+                && hand.at(1 - idx0)->content != WILD
+                && hand.at(1 - idx0)->content != WILD_DRAW4
+                && hand.at(1 - idx0)->color != hand.at(idx0)->color)))
+            idxBest = AI_BRANCH("7-0", idx0);
+        else if (has7)
+            idxBest = AI_BRANCH("7-0", idx7);
+    } // else
+
+    outColor[0] = bestColor;
+    return idxBest;
+} // sevenZeroAI_bestCardIndex4NowPlayer(Color[])
+
+} // namespace reference
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __REFERENCE_AI_H_494649FDFA62B3C015120BCB9BE17613__
+#define __REFERENCE_AI_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include "reference/Uno.h"
+#include "include/Card.h"
+#include "include/Color.h"
+
+namespace reference {
+
+/**
+ * Reference copy of the AI strategies without AI budgets, see
+ * reference/Uno.h.
+ */
+class AI {
+private:
+    /**
+     * Uno runtime.
+     */
+    Uno* uno;
+
+    /**
+     * @param who Get whose AI parameters.
+     * @return AI parameters of the specified player in our Uno runtime.
+     */
+    const int* getParams(int who);
+
+public:
+    /**
+     * AI parameter: worth of zero / reverse cards in calcBestColor4NowPlayer.
+     */
+    static const int PARAM_ZERO_REV_WORTH = 0;
+
+    /**
+     * AI parameter: worth of non-zero number cards in calcBestColor4NowPlayer.
+     */
+    static const int PARAM_NUM_WORTH = 1;
+
+    /**
+     * AI parameter: worth of skip / draw two cards in calcBestColor4NowPlayer.
+     */
+    static const int PARAM_SKIP_DRAW2_WORTH = 2;
+
+    /**
+     * AI parameter: in needToChallenge, always challenge when holding
+     * (Uno::MAX_HOLD_CARDS - this value) or more cards.
+     */
+    static const int PARAM_CHALLENGE_MARGIN = 3;
+
+    /**
+     * AI parameter: in hard AI, start to attack with +2, skip and wild
+     * cards when next player holds this number of cards or less.
+     */
+    static const int PARAM_ATTACK_SIZE = 4;
+
+    /**
+     * AI parameter: in hard AI, play reverse cards freely when previous
+     * player holds this number of cards or more.
+     */
+    static const int PARAM_REVERSE_SIZE = 5;
+
+    /**
+     * AI parameter: in hard AI, play skip / +2 cards in your best color
+     * only when opposite player holds this number of cards or more.
+     */
+    static const int PARAM_SAVE_SIZE = 6;
+
+    /**
+     * AI parameter: in hard AI's normal strategies, pass 1 to play number
+     * cards before attacking with +2 / skip / reverse cards, or 0 to attack
+     * at first.
+     */
+    static const int PARAM_NUM_FIRST = 7;
+
+    /**
+     * How many AI parameters.
+     */
+    static const int PARAM_COUNT = 8;
+
+    /**
+     * Default AI parameters.
+     */
+    static const int DEFAULT_PARAMS[PARAM_COUNT];
+
+    /**
+     * Create an AI instance which works on the specified Uno runtime, e.g.
+     * a headless runtime created by Uno::newHeadlessInstance(unsigned).
+     *
+     * @param uno Provide the Uno runtime.
+     */
+    explicit AI(Uno* uno);
+
+    /**
+     * Evaluate which color is the best for current player. In our evaluation
+     * system, zero cards / reverse cards are worth 2 points, non-zero number
+     * cards are worth 4 points, and skip / draw two cards are worth 5 points
+     * by default (see PARAM_*_WORTH). Finally, the color which contains the
+     * worthiest cards becomes the best color.
+     *
+     * @return Current player's best color.
+     */
+    Color calcBestColor4NowPlayer();
+
+    /**
+     * In 7-0 rule, when a seven card is put down, the player must swap hand
+     * cards with another player immediately. This API returns that swapping
+     * with whom is the best answer for current player.
+     *
+     * @return Current player swaps with whom. Must be one of the following:
+     *         Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     */
+    int calcBestSwapTarget4NowPlayer();
+
+    /**
+     * AI strategies of determining if it's necessary to challenge previous
+     * player's [wild +4] card's legality.
+     *
+     * @return True if it's necessary to make a challenge.
+     */
+    bool needToChallenge();
+
+    /**
+     * AI Strategies (Difficulty: EASY). Analyze current player's hand cards,
+     * and calculate which is the best card to play out.
+     *
+     * @param outColor This is a out parameter. Pass a Color array (length>=1)
+     *                 in order to let us pass the return value by assigning
+     *                 outColor[0]. When the best card to play becomes a wild
+     *                 card, outColor[0] will become the following legal color
+     *                 to change. When the best card to play becomes an action
+     *                 or a number card, outColor[0] will become the player's
+     *                 best color.
+     * @return Index of the best card to play, in current player's hand.
+     *         Or a negative number that means no appropriate card to play.
+     */
+    int easyAI_bestCardIndex4NowPlayer(Color outColor[]);
+
+    /**
+     * AI Strategies (Difficulty: HARD). Analyze current player's hand cards,
+     * and calculate which is the best card to play.
+     *
+     * @param outColor This is a out parameter. Pass a Color array (length>=1)
+     *                 in order to let us pass the return value by assigning
+     *                 outColor[0]. When the best card to play becomes a wild
+     *                 card, outColor[0] will become the following legal color
+     *                 to change. When the best card to play becomes an action
+     *                 or a number card, outColor[0] will become the player's
+     *                 best color.
+     * @return Index of the best card to play, in current player's hand.
+     *         Or a negative number that means no appropriate card to play.
+     */
+    int hardAI_bestCardIndex4NowPlayer(Color outColor[]);
+
+    /**
+     * AI Strategies in 7-0 special rule. Analyze current player's hand cards,
+     * and calculate which is the best card to play out.
+     *
+     * @param outColor This is a out parameter. Pass a Color array (length>=1)
+     *                 in order to let us pass the return value by assigning
+     *                 outColor[0]. When the best card to play becomes a wild
+     *                 card, outColor[0] will become the following legal color
+     *                 to change. When the best card to play becomes an action
+     *                 or a number card, outColor[0] will become the player's
+     *                 best color.
+     * @return Index of the best card to play, in current player's hand.
+     *         Or a negative number that means no appropriate card to play.
+     */
+    int sevenZeroAI_bestCardIndex4NowPlayer(Color outColor[]);
+}; // AI Class
+
+} // namespace reference
+
+#endif // __REFERENCE_AI_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
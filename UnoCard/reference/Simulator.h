@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __REFERENCE_SIMULATOR_H_494649FDFA62B3C015120BCB9BE17613__
+#define __REFERENCE_SIMULATOR_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include "reference/Uno.h"
+#include "include/Color.h"
+
+namespace reference {
+
+/**
+ * Reference copy of the Simulator class, where all decisions are made by
+ * the reference AI, see reference/Uno.h.
+ */
+class Simulator {
+private:
+    /**
+     * Uno runtime.
+     */
+    Uno* uno;
+
+    /**
+     * Current status. Player::YOU, Player::COM1, Player::COM2, Player::COM3
+     * mean that it's the specified player's turn. Otherwise, one of the
+     * STAT_* constants.
+     */
+    int status;
+
+    /**
+     * Who won the game, or -1 when game is not over yet.
+     */
+    int winner;
+
+    /**
+     * How many actions (plays and passes) happened in this game.
+     */
+    int turns;
+
+    /**
+     * Index of the wild card waiting for a color in STAT_WILD_COLOR.
+     */
+    int selectedIdx;
+
+    /**
+     * The player in action draws one or more cards.
+     */
+    void draw(int count, bool force);
+
+public:
+    /**
+     * Status: the player in action needs to select a color for a wild card.
+     */
+    static const int STAT_WILD_COLOR = 0x5555;
+
+    /**
+     * Status: the next player needs to decide whether to challenge.
+     */
+    static const int STAT_DOUBT_WILD4 = 0x6666;
+
+    /**
+     * Status: the player in action needs to select a swap target.
+     */
+    static const int STAT_SEVEN_TARGET = 0x7777;
+
+    /**
+     * Status: game over.
+     */
+    static const int STAT_GAME_OVER = 0x4444;
+
+    /**
+     * Constructor. When a game is already in process in the provided Uno
+     * runtime, we take over it from the turn of uno->getNow().
+     *
+     * @param uno Provide the Uno runtime.
+     */
+    explicit Simulator(Uno* uno);
+
+    /**
+     * Constructor. Take over a game in process in the provided Uno runtime,
+     * from a pending decision other than playing a card, i.e. right after
+     * the player uno->getNow() played a [wild +4] or a [7].
+     *
+     * @param uno    Provide the Uno runtime.
+     * @param status STAT_DOUBT_WILD4 or STAT_SEVEN_TARGET.
+     */
+    Simulator(Uno* uno, int status);
+
+    /**
+     * Start a new game in our Uno runtime, and resolve the start card.
+     */
+    void start();
+
+    /**
+     * @return Current status. Player::YOU, Player::COM1, Player::COM2,
+     *         Player::COM3, or one of the STAT_* constants.
+     */
+    int getStatus();
+
+    /**
+     * @return Who needs to make the pending decision, or -1 when game over.
+     */
+    int getDecider();
+
+    /**
+     * @return Who won the game, or -1 when game is not over yet.
+     */
+    int getWinner();
+
+    /**
+     * @return How many actions (plays and passes) happened in this game.
+     */
+    int getTurns();
+
+    /**
+     * Let AI calculate the best card to play for current player, in the
+     * same way as the built-in DefaultAgent does without AI budgets (by 7-0
+     * rule and difficulty).
+     *
+     * @param outColor Out parameter, see AI::easyAI_bestCardIndex4NowPlayer.
+     * @return Index of the best card to play, or a negative number that
+     *         means to draw a card.
+     */
+    int bestCardIndex4NowPlayer(Color outColor[]);
+
+    /**
+     * Let AI make the pending decision.
+     */
+    void step();
+
+    /**
+     * Let AI make all decisions until game over, or until the specified
+     * number of actions happened in this game.
+     *
+     * @param maxTurns Stop when getTurns() reaches this value.
+     * @return Who won the game, or -1 when stopped by maxTurns.
+     */
+    int run(int maxTurns);
+
+    /**
+     * The player in action plays a card.
+     *
+     * @param index Play which card. Pass the corresponding card's index of the
+     *              player's hand cards.
+     * @param color Available when the card to play is a wild card. Pass the
+     *              specified following legal color, or NONE to turn into the
+     *              STAT_WILD_COLOR status.
+     */
+    void play(int index, Color color = NONE);
+
+    /**
+     * The player in action draws a card by itself (or draws all stacked
+     * cards in +2 stack rule).
+     */
+    void draw();
+
+    /**
+     * In STAT_WILD_COLOR status, specify the following legal color.
+     *
+     * @param color Specify the following legal color.
+     */
+    void selectColor(Color color);
+
+    /**
+     * In STAT_DOUBT_WILD4 status, decide whether to challenge.
+     *
+     * @param challenge Pass true to challenge the [wild +4] card.
+     */
+    void decideChallenge(bool challenge);
+
+    /**
+     * In STAT_SEVEN_TARGET status, swap hand cards with another player.
+     *
+     * @param whom Swap with whom. Must be one of the following:
+     *             Player::YOU, Player::COM1, Player::COM2, Player::COM3
+     */
+    void swapWith(int whom);
+}; // Simulator Class
+
+} // namespace reference
+
+#endif // __REFERENCE_SIMULATOR_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
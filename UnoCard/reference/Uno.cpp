@@ -0,0 +1,912 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <ctime>
+#include <vector>
+#include <cstdlib>
+#include "reference/Uno.h"
+#include "include/Card.h"
+#include "include/Color.h"
+#include "reference/Player.h"
+#include "include/Content.h"
+#include "reference/AI.h"
+#include "include/Uno.h"
+
+#define MASK_I_TO_END(i) (0xffffffffU << (i))
+#define MASK_BEGIN_TO_I(i) (~(0xffffffffU << (i)))
+#define MASK_ALL(u, p) MASK_BEGIN_TO_I((u)->getPlayer(p)->getHandSize())
+#define HASH_MIX(h, v) (((h) ^ (unsigned long long)(v)) * 0x100000001b3ULL)
+
+namespace reference {
+
+/**
+ * Headless constructor. Load no resources, and use the shared headless
+ * card table.
+ */
+Uno::Uno(std::vector<Card>* table, unsigned seed) {
+    if (seed == 0U) {
+        seed = unsigned(time(nullptr));
+    } // if (seed == 0U)
+
+    this->table = table;
+    init(seed);
+} // Uno(std::vector<Card>*, unsigned) (Class Constructor)
+
+/**
+ * Initialize members, except resources and card table.
+ */
+void Uno::init(unsigned seed) {
+    randState = seed;
+    players = 3;
+    legality = 0;
+    now = rand() % 4;
+    forcePlay = true;
+    difficulty = LV_EASY;
+    thinkTime = thinkNodes = 0;
+    draw2StackCount = direction = 0;
+    draw2StackRule = sevenZeroRule = false;
+    aiParams[0] = aiParams[1] = aiParams[2] = aiParams[3] = nullptr;
+} // init(unsigned)
+
+/**
+ * Create a headless runtime. A headless runtime loads no image resources
+ * and prints no messages, so it can be created without a QApplication.
+ * Every runtime owns its random number generator, so runtimes can run in
+ * different threads, and each game is reproducible from its seed.
+ *
+ * @param seed Random seed. Pass 0 to generate one from current time.
+ * @return The new runtime.
+ */
+Uno Uno::newHeadlessInstance(unsigned seed) {
+    return Uno(::Uno::getHeadlessTable(), seed);
+} // newHeadlessInstance(unsigned)
+
+/**
+ * Our own random number generator, works like std::rand().
+ *
+ * @return A pseudo-random integer between 0 and 0x7fffffff.
+ */
+int Uno::rand() {
+    randState = randState * 6364136223846793005ULL + 1442695040888963407ULL;
+    return int(randState >> 33);
+} // rand()
+
+/**
+ * @return Current state of our random number generator.
+ */
+unsigned long long Uno::getRandState() {
+    return randState;
+} // getRandState()
+
+/**
+ * Restore the state of our random number generator.
+ *
+ * @param state Value got from getRandState().
+ */
+void Uno::setRandState(unsigned long long state) {
+    randState = state;
+} // setRandState(unsigned long long)
+
+/**
+ * Calculate a 64-bit hash value of the whole game state, including card
+ * deck, everyone's hand cards, and our random number generator. Two
+ * runtimes with equal hash values behave the same from now on.
+ *
+ * @return Hash value of current game state.
+ */
+unsigned long long Uno::getStateHash() {
+    int i, j;
+    unsigned long long h = 0xcbf29ce484222325ULL;
+
+    h = HASH_MIX(h, randState);
+    h = HASH_MIX(h, now);
+    h = HASH_MIX(h, players);
+    h = HASH_MIX(h, direction);
+    h = HASH_MIX(h, difficulty);
+    h = HASH_MIX(h, thinkTime);
+    h = HASH_MIX(h, thinkNodes);
+    for (i = Player::YOU; i <= Player::COM3; ++i) {
+        h = HASH_MIX(h, -1);
+        for (j = 0; aiParams[i] != nullptr && j < AI::PARAM_COUNT; ++j) {
+            h = HASH_MIX(h, aiParams[i][j]);
+        } // for (j = 0; aiParams[i] != nullptr && j < AI::PARAM_COUNT; ++j)
+    } // for (i = Player::YOU; i <= Player::COM3; ++i)
+
+    h = HASH_MIX(h, forcePlay);
+    h = HASH_MIX(h, sevenZeroRule);
+    h = HASH_MIX(h, draw2StackRule);
+    h = HASH_MIX(h, draw2StackCount);
+    h = HASH_MIX(h, legality);
+    for (Card* card : deck) h = HASH_MIX(h, card->id);
+    h = HASH_MIX(h, -1);
+    for (Card* card : used) h = HASH_MIX(h, card->id);
+    h = HASH_MIX(h, -1);
+    for (Card* card : recent) h = HASH_MIX(h, card->id);
+    h = HASH_MIX(h, -1);
+    for (Color color : recentColors) h = HASH_MIX(h, color);
+    for (i = Player::YOU; i <= Player::COM3; ++i) {
+        Player& p = player[i];
+        h = HASH_MIX(h, -1);
+        for (Card* card : p.handCards) h = HASH_MIX(h, card->id);
+        h = HASH_MIX(h, p.strongColor);
+        h = HASH_MIX(h, p.weakColor);
+        h = HASH_MIX(h, p.strongCount);
+        h = HASH_MIX(h, p.open);
+        h = HASH_MIX(h, p.recent == nullptr ? -1 : p.recent->id);
+    } // for (i = Player::YOU; i <= Player::COM3; ++i)
+
+    return h;
+} // getStateHash()
+
+/**
+ * @return Player in turn. Must be one of the following:
+ *         Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+ */
+int Uno::getNow() {
+    return now;
+} // getNow()
+
+/**
+ * Switch to next player's turn.
+ *
+ * @return Player in turn after switched. Must be one of the following:
+ *         Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+ */
+int Uno::switchNow() {
+    return (now = getNext());
+} // switchNow()
+
+/**
+ * @return Current player's next player. Must be one of the following:
+ *         Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+ */
+int Uno::getNext() {
+    int next = (now + direction) % 4;
+    if (players == 3 && next == Player::COM2) {
+        next = (next + direction) % 4;
+    } // if (players == 3 && next == Player::COM2)
+
+    return next;
+} // getNext()
+
+/**
+ * @return Current player's opposite player. Must be one of the following:
+ *         Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+ *         NOTE: When only 3 players in game, getOppo() == getPrev().
+ */
+int Uno::getOppo() {
+    int oppo = (getNext() + direction) % 4;
+    if (players == 3 && oppo == Player::COM2) {
+        oppo = (oppo + direction) % 4;
+    } // if (players == 3 && oppo == Player::COM2)
+
+    return oppo;
+} // getOppo()
+
+/**
+ * @return Current player's previous player. Must be one of the following:
+ *         Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+ */
+int Uno::getPrev() {
+    int prev = (4 + now - direction) % 4;
+    if (players == 3 && prev == Player::COM2) {
+        prev = (4 + prev - direction) % 4;
+    } // if (players == 3 && prev == Player::COM2)
+
+    return prev;
+} // getPrev()
+
+/**
+ * @param who Get which player's instance. Must be one of the following:
+ *            Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+ * @return Specified player's instance.
+ */
+Player* Uno::getPlayer(int who) {
+    return who < Player::YOU || who > Player::COM3 ? nullptr : &player[who];
+} // getPlayer(int)
+
+/**
+ * @return &this->player[this->getNow()].
+ */
+Player* Uno::getCurrPlayer() {
+    return &player[getNow()];
+} // getCurrPlayer()
+
+/**
+ * @return &this->player[this->getNext()].
+ */
+Player* Uno::getNextPlayer() {
+    return &player[getNext()];
+} // getNextPlayer()
+
+/**
+ * @return &this->player[this->getOppo()].
+ */
+Player* Uno::getOppoPlayer() {
+    return &player[getOppo()];
+} // getOppoPlayer()
+
+/**
+ * @return &this->player[this->getPrev()].
+ */
+Player* Uno::getPrevPlayer() {
+    return &player[getPrev()];
+} // getPrevPlayer()
+
+/**
+ * @return How many players in game (3 or 4).
+ */
+int Uno::getPlayers() {
+    return players;
+} // getPlayers()
+
+/**
+ * Set the amount of players in game.
+ *
+ * @param players Supports 3 and 4.
+ */
+void Uno::setPlayers(int players) {
+    if (players == 3 || players == 4) {
+        this->players = players;
+    } // if (players == 3 || players == 4)
+} // setPlayers(int)
+
+/**
+ * Switch current action sequence. The value of [direction] will be
+ * switched between DIR_LEFT and DIR_RIGHT.
+ */
+void Uno::switchDirection() {
+    direction = 4 - direction;
+} // switchDirection()
+
+/**
+ * @return Current action sequence (DIR_LEFT / DIR_RIGHT).
+ */
+int Uno::getDirection() {
+    return direction;
+} // getDirection()
+
+/**
+ * @return Current difficulty (LV_EASY / LV_HARD / LV_POLICY).
+ */
+int Uno::getDifficulty() {
+    return difficulty;
+} // getDifficulty()
+
+/**
+ * Set game difficulty.
+ *
+ * @param difficulty Pass target difficulty value.
+ *                   Only LV_EASY, LV_HARD and LV_POLICY are available.
+ */
+void Uno::setDifficulty(int difficulty) {
+    if (difficulty == LV_EASY || difficulty == LV_HARD
+        || difficulty == LV_POLICY) {
+        this->difficulty = difficulty;
+    } // if (difficulty == LV_EASY || ...)
+} // setDifficulty(int)
+
+/**
+ * @return Time budget of anytime AI in milli seconds, or 0 if none.
+ */
+int Uno::getThinkTime() {
+    return thinkTime;
+} // getThinkTime()
+
+/**
+ * Set the time budget of anytime AI. When either the time budget or the
+ * node budget is set, AI players search for the best card to play until
+ * the budget runs out, instead of using the fixed difficulty strategies.
+ * See AI::searchAI_bestCardIndex4NowPlayer(Color[]).
+ *
+ * @param millis Time budget per action, or 0 to disable it.
+ */
+void Uno::setThinkTime(int millis) {
+    thinkTime = millis > 0 ? millis : 0;
+} // setThinkTime(int)
+
+/**
+ * @return Node budget of anytime AI, or 0 if none.
+ */
+int Uno::getThinkNodes() {
+    return thinkNodes;
+} // getThinkNodes()
+
+/**
+ * Set the node budget of anytime AI, i.e. how many simulated games at
+ * most AI can play in one action. Unlike time budget, the result of a
+ * node budget is reproducible, and does not depend on CPU load.
+ *
+ * @param nodes Node budget per action, or 0 to disable it.
+ */
+void Uno::setThinkNodes(int nodes) {
+    thinkNodes = nodes > 0 ? nodes : 0;
+} // setThinkNodes(int)
+
+/**
+ * @param who Get whose AI parameters. Must be one of the following:
+ *            Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+ * @return AI parameters of the specified player, or nullptr if the
+ *         player uses the default ones. See AI::PARAM_COUNT.
+ */
+const int* Uno::getAIParams(int who) {
+    return who >= Player::YOU && who <= Player::COM3 ? aiParams[who] : nullptr;
+} // getAIParams(int)
+
+/**
+ * Let the specified player's AI use the provided parameters, instead of
+ * the default ones. The array is NOT copied, so keep it alive as long as
+ * this runtime and its copies are still working.
+ *
+ * @param who    Set whose AI parameters. Must be one of the following:
+ *               Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+ * @param params AI parameters (length == AI::PARAM_COUNT), or nullptr
+ *               to use the default ones.
+ */
+void Uno::setAIParams(int who, const int params[]) {
+    if (who >= Player::YOU && who <= Player::COM3) {
+        aiParams[who] = params;
+    } // if (who >= Player::YOU && who <= Player::COM3)
+} // setAIParams(int, const int[])
+
+/**
+ * @return This value tells that what's the next step
+ *         after you drew a playable card in your action.
+ *         When force play is enabled, play the card immediately.
+ *         When force play is disabled, keep the card in your hand.
+ */
+bool Uno::isForcePlay() {
+    return forcePlay;
+} // isForcePlay()
+
+/**
+ * @param enabled Enable/Disable the force play rule.
+ */
+void Uno::setForcePlay(bool enabled) {
+    forcePlay = enabled;
+} // setForcePlay(bool)
+
+/**
+ * @return Whether the 7-0 rule is enabled. In 7-0 rule, when a seven card
+ *         is put down, the player must swap hand cards with another player
+ *         immediately. When a zero card is put down, everyone need to pass
+ *         the hand cards to the next player.
+ */
+bool Uno::isSevenZeroRule() {
+    return sevenZeroRule;
+} // isSevenZeroRule()
+
+/**
+ * @param enabled Enable/Disable the 7-0 rule.
+ */
+void Uno::setSevenZeroRule(bool enabled) {
+    sevenZeroRule = enabled;
+} // setSevenZeroRule(bool)
+
+/**
+ * @return Can or cannot stack +2 cards. If can, when you put down a +2
+ *         card, the next player may transfer the punishment to its next
+ *         player by stacking another +2 card. Finally the first one who
+ *         does not stack a +2 card must draw all of the required cards.
+ */
+bool Uno::isDraw2StackRule() {
+    return draw2StackRule;
+} // isDraw2StackRule()
+
+/**
+ * @param enabled Enable/Disable the +2 stacking rule.
+ */
+void Uno::setDraw2StackRule(bool enabled) {
+    draw2StackRule = enabled;
+} // setDraw2StackRule(bool)
+
+/**
+ * Only available in +2 stack rule. In this rule, when a +2 card is put
+ * down, the next player may transfer the punishment to its next player
+ * by stacking another +2 card. Finally the first one who does not stack
+ * a +2 card must draw all of the required cards.
+ *
+ * @return This counter records that how many required cards need to be
+ *         drawn by the final player. When this value is not zero, only
+ *         +2 cards are legal to play.
+ */
+int Uno::getDraw2StackCount() {
+    return draw2StackCount;
+} // getDraw2StackCount()
+
+/**
+ * Find a card instance in card table.
+ *
+ * @param color   Color of the card you want to get.
+ * @param content Content of the card you want to get.
+ * @return Corresponding card instance.
+ */
+Card* Uno::findCard(Color color, Content content) {
+    return color == NONE && content == WILD
+        ? &table->at(39 + WILD)
+        : color == NONE && content == WILD_DRAW4
+        ? &table->at(39 + WILD_DRAW4)
+        : color != NONE && content != WILD && content != WILD_DRAW4
+        ? &table->at(13 * (color - 1) + content)
+        : nullptr;
+} // findCard(Color, Content)
+
+/**
+ * @return How many cards in deck (haven't been used yet).
+ */
+int Uno::getDeckCount() {
+    return int(deck.size());
+} // getDeckCount()
+
+/**
+ * @return How many cards have been used.
+ */
+int Uno::getUsedCount() {
+    return int((used.size() + recent.size()));
+} // getUsedCount()
+
+/**
+ * @return Recent played cards.
+ */
+const std::vector<Card*>& Uno::getRecent() {
+    return recent;
+} // getRecent()
+
+/**
+ * @return Colors of recent played cards.
+ */
+const std::vector<Color>& Uno::getRecentColors() {
+    return recentColors;
+} // getRecentColors()
+
+/**
+ * @return Color of the last played card.
+ */
+Color Uno::lastColor() {
+    return recentColors.back();
+} // lastColor()
+
+/**
+ * @return Color of the next-to-last played card.
+ */
+Color Uno::next2lastColor() {
+    return recentColors.at(recentColors.size() - 2);
+} // next2lastColor()
+
+/**
+ * Start a new Uno game. Shuffle cards, let everyone draw 7 cards,
+ * then determine our start card.
+ */
+void Uno::start() {
+    Card* card;
+    int i, size;
+
+    // Reset direction
+    direction = DIR_LEFT;
+
+    // In +2 stack rule, reset the stack counter
+    draw2StackCount = 0;
+
+    // Clear card deck, used card deck, recent played cards,
+    // everyone's hand cards, and everyone's strong/weak colors
+    deck.clear();
+    used.clear();
+    recent.clear();
+    recentColors.clear();
+    for (i = Player::YOU; i <= Player::COM3; ++i) {
+        player[i].open = 0x00;
+        player[i].handCards.clear();
+        player[i].weakColor = NONE;
+        player[i].strongColor = NONE;
+    } // for (i = Player::YOU; i <= Player::COM3; ++i)
+
+    // Generate a temporary sequenced card deck
+    for (i = 0; i < 54; ++i) {
+        card = &table->at(i);
+        switch (card->content) {
+        case WILD:
+        case WILD_DRAW4:
+            deck.push_back(card);
+            deck.push_back(card);
+            // fall through
+
+        default:
+            deck.push_back(card);
+            // fall through
+
+        case NUM0:
+            deck.push_back(card);
+        } // switch (card->content)
+    } // for (i = 0; i < 54; ++i)
+
+    // Shuffle cards
+    size = int(deck.size());
+    while (size > 0) {
+        i = rand() % size--;
+        card = deck[i]; deck[i] = deck[size]; deck[size] = card;
+    } // while (size > 0)
+
+    // Determine a start card as the previous played card
+    do {
+        card = deck.back();
+        deck.pop_back();
+        if (card->isWild()) {
+            // Start card cannot be a wild card, so return it
+            // to the bottom of card deck and pick another card
+            deck.insert(deck.begin(), card);
+        } // if (card->isWild())
+        else {
+            // Any non-wild card can be start card
+            // Start card determined
+            recent.push_back(card);
+            recentColors.push_back(card->color);
+        } // else
+    } while (recent.empty());
+
+    // Let everyone draw 7 cards
+    if (players == 3) {
+        for (i = 0; i < 7; ++i) {
+            draw(Player::YOU,  /* force */ true);
+            draw(Player::COM1, /* force */ true);
+            draw(Player::COM3, /* force */ true);
+        } // for (i = 0; i < 7; ++i)
+    } // if (players == 3)
+    else {
+        for (i = 0; i < 7; ++i) {
+            draw(Player::YOU,  /* force */ true);
+            draw(Player::COM1, /* force */ true);
+            draw(Player::COM2, /* force */ true);
+            draw(Player::COM3, /* force */ true);
+        } // for (i = 0; i < 7; ++i)
+    } // else
+
+    // Update the legality binary
+    legality = 0x30000000000000LL
+        | (0x1fffLL << 13 * (card->color - 1))
+        | (0x8004002001LL << card->content);
+
+    // In the case of (last winner = NORTH) & (game mode = 3 player mode)
+    // Re-specify the dealer randomly
+    if (players == 3 && now == Player::COM2) {
+        now = (3 + rand() % 3) % 4;
+    } // if (players == 3 && now == Player::COM2)
+} // start()
+
+/**
+ * Call this function when someone needs to draw a card.
+ * <p>
+ * NOTE: Everyone can hold 14 cards at most in this program, so even if this
+ * function is called, the specified player may not draw a card as a result.
+ *
+ * @param who   Who draws a card. Must be one of the following values:
+ *              Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+ * @param force Pass true if the specified player is required to draw cards,
+ *              i.e. previous player played a [+2] or [wild +4] to let this
+ *              player draw cards. Or false if the specified player draws a
+ *              card by itself in its action.
+ * @return Index of the drawn card in hand, or -1 if the specified player
+ *         didn't draw a card because of the limitation.
+ */
+int Uno::draw(int who, bool force) {
+    Card* card;
+    int i, index, size;
+    std::vector<Card*>* hand;
+
+    i = -1;
+    if (who >= Player::YOU && who <= Player::COM3) {
+        if (draw2StackCount > 0) {
+            --draw2StackCount;
+        } // if (draw2StackCount > 0)
+        else if (!force) {
+            // Draw a card by player itself, register weak color
+            player[who].weakColor = lastColor();
+            if (player[who].weakColor == player[who].strongColor) {
+                // Weak color cannot also be strong color
+                player[who].strongColor = NONE;
+            } // if (player[who].weakColor == player[who].strongColor)
+        } // else if (!force)
+
+        hand = &(player[who].handCards);
+        if (hand->size() < MAX_HOLD_CARDS) {
+            // Draw a card from card deck, and put it to an appropriate position
+            card = deck.back();
+            deck.pop_back();
+            if (who == Player::YOU) {
+                auto it = std::upper_bound(hand->begin(), hand->end(), card);
+                i = int(it - hand->begin());
+                hand->insert(it, card);
+                player[who].open = (player[who].open << 1) | 0x01;
+            } // if (who == Player::YOU)
+            else {
+                i = int(hand->size());
+                hand->push_back(card);
+            } // else
+
+            player[who].recent = nullptr;
+            if (deck.empty()) {
+                // Re-use the used cards when there are no more cards in deck
+                size = int(used.size());
+                while (size > 0) {
+                    index = rand() % size--;
+                    deck.push_back(used.at(index));
+                    used.erase(used.begin() + index);
+                } // while (size > 0)
+            } // if (deck.empty())
+        } // if (hand->size() < MAX_HOLD_CARDS)
+        else {
+            // In +2 stack rule, if someone cannot draw all of the required
+            // cards because of the max-hold-card limitation, force reset
+            // the counter to zero.
+            draw2StackCount = 0;
+        } // else
+
+        if (draw2StackCount == 0) {
+            // Update the legality binary when necessary
+            card = recent.back();
+            legality = card->isWild()
+                ? 0x30000000000000LL
+                | (0x1fffLL << 13 * (lastColor() - 1))
+                : 0x30000000000000LL
+                | (0x1fffLL << 13 * (lastColor() - 1))
+                | (0x8004002001LL << card->content);
+        } // if (draw2StackCount == 0)
+    } // if (who >= Player::YOU && who <= Player::COM3)
+
+    return i;
+} // draw(int, bool)
+
+/**
+ * Check whether the specified card is legal to play. It's legal only when
+ * it's wild, or it has the same color/content to the previous played card.
+ *
+ * @param card Check which card's legality.
+ * @return Whether the specified card is legal to play.
+ */
+bool Uno::isLegalToPlay(Card* card) {
+    return ((legality >> card->id) & 0x01LL) == 0x01LL;
+} // isLegalToPlay(Card*)
+
+/**
+ * @return How many legal cards (the cards that can be played legally)
+ *         in now player's hand.
+ */
+int Uno::legalCardsCount4NowPlayer() {
+    int count = 0;
+
+    for (Card* card : player[now].handCards) {
+        if (isLegalToPlay(card)) {
+            ++count;
+        } // if (isLegalToPlay(card))
+    } // for (Card* card : player[now].handCards)
+
+    return count;
+} // legalCardsCount4NowPlayer()
+
+/**
+ * Call this function when someone needs to play a card. The played card
+ * replaces the "previous played card", and the original "previous played
+ * card" becomes a used card at the same time.
+ * <p>
+ * NOTE: Before calling this function, you must call isLegalToPlay(Card*)
+ * function at first to check whether the specified card is legal to play.
+ * This function will play the card directly without checking the legality.
+ *
+ * @param who   Who plays a card. Must be one of the following values:
+ *              Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+ * @param index Play which card. Pass the corresponding card's index of the
+ *              specified player's hand cards.
+ * @param color Optional, available when the card to play is a wild card.
+ *              Pass the specified following legal color.
+ * @return Reference of the played card.
+ */
+Card* Uno::play(int who, int index, Color color) {
+    int size;
+    Card* card;
+    std::vector<Card*>* hand;
+
+    card = nullptr;
+    if (who >= Player::YOU && who <= Player::COM3) {
+        hand = &(player[who].handCards);
+        size = int(hand->size());
+        if (index < size) {
+            card = hand->at(index);
+            hand->erase(hand->begin() + index);
+            if (card->isWild()) {
+                // When a wild card is played, register the specified
+                // following legal color as the player's strong color
+                player[who].strongColor = color;
+                player[who].strongCount = 1 + size / 3;
+                if (color == player[who].weakColor) {
+                    // Strong color cannot also be weak color
+                    player[who].weakColor = NONE;
+                } // if (color == player[who].weakColor)
+            } // if (card->isWild())
+            else if (card->color == player[who].strongColor) {
+                // Played a card that matches the registered
+                // strong color, strong counter counts down
+                --player[who].strongCount;
+                if (player[who].strongCount == 0) {
+                    player[who].strongColor = NONE;
+                } // if (player[who].strongCount == 0)
+            } // else if (card->color == player[who].strongColor)
+            else if (player[who].strongCount > size - 1) {
+                // Correct the value of strong counter when necessary
+                player[who].strongCount = size - 1;
+            } // else if (player[who].strongCount > size - 1)
+
+            if (card->content == DRAW2 && draw2StackRule) {
+                draw2StackCount += 2;
+            } // if (card->content == DRAW2 && draw2StackRule)
+
+            player[who].open = who == Player::YOU
+                ? (player[who].open >> 1)
+                : (player[who].open & MASK_BEGIN_TO_I(index))
+                | (player[who].open & MASK_I_TO_END(index + 1)) >> 1;
+            player[who].recent = card;
+            recent.push_back(card);
+            recentColors.push_back(card->isWild() ? color : card->color);
+            if (recent.size() > 5) {
+                used.push_back(recent.front());
+                recent.erase(recent.begin());
+                recentColors.erase(recentColors.begin());
+            } // if (recent.size() > 5)
+
+            // Update the legality binary
+            legality = draw2StackCount > 0
+                ? (0x8004002001LL << DRAW2)
+                : card->isWild()
+                ? 0x30000000000000LL
+                | (0x1fffLL << 13 * (lastColor() - 1))
+                : 0x30000000000000LL
+                | (0x1fffLL << 13 * (lastColor() - 1))
+                | (0x8004002001LL << card->content);
+            if (hand->size() == 0) {
+                // Game over, change background & show everyone's hand cards
+                direction = 0;
+                for (int i = Player::COM1; i <= Player::COM3; ++i) {
+                    player[i].sort();
+                    player[i].open = MASK_ALL(this, i);
+                } // for (int i = Player::COM1; i <= Player::COM3; ++i)
+            } // if (hand->size() == 0)
+        } // if (index < size)
+    } // if (who >= Player::YOU && who <= Player::COM3)
+
+    return card;
+} // play(int, int, Color)
+
+/**
+ * When you think your previous player used a [wild +4] card illegally,
+ * i.e. it holds at least one card matching the next-to-last color,
+ * call this function to make a challenge.
+ *
+ * @param whom Challenge whom. Must be one of the following:
+ *             Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+ * @return Tell the challenge result, true if challenge success,
+ *         or false if challenge failure.
+ */
+bool Uno::challenge(int whom) {
+    bool result = false;
+
+    if (whom >= Player::YOU && whom <= Player::COM3) {
+        if (whom != Player::YOU) {
+            player[whom].sort();
+            player[whom].open = MASK_ALL(this, whom);
+        } // if (whom != Player::YOU)
+
+        for (Card* card : player[whom].handCards) {
+            if (card->color == next2lastColor()) {
+                result = true;
+                break;
+            } // if (card->color == next2lastColor())
+        } // for (Card* card : player[whom].handCards)
+    } // if (whom >= Player::YOU && whom <= Player::COM3)
+
+    return result;
+} // challenge(int)
+
+/**
+ * In 7-0 rule, when someone put down a seven card, then the player must
+ * swap hand cards with another player immediately.
+ *
+ * @param a Who put down the seven card. Must be one of the following:
+ *          Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+ * @param b Exchange with whom. Must be one of the following:
+ *          Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+ *          Cannot exchange with yourself.
+ */
+void Uno::swap(int a, int b) {
+    Player store = player[a];
+    player[a] = player[b];
+    player[b] = store;
+    if (a == Player::YOU || b == Player::YOU) {
+        player[Player::YOU].sort();
+        player[Player::YOU].open = MASK_ALL(this, Player::YOU);
+    } // if (a == Player::YOU || b == Player::YOU)
+} // swap(int, int)
+
+/**
+ * In 7-0 rule, when a zero card is put down, everyone need to pass the hand
+ * cards to the next player.
+ */
+void Uno::cycle() {
+    int curr = now, next = getNext(), oppo = getOppo(), prev = getPrev();
+    Player store = player[curr];
+    player[curr] = player[prev];
+    player[prev] = player[oppo];
+    player[oppo] = player[next];
+    player[next] = store;
+    player[Player::YOU].sort();
+    player[Player::YOU].open = MASK_ALL(this, Player::YOU);
+} // cycle()
+
+/**
+ * Shuffle all cards unknown to the specified player, i.e. the card deck
+ * and the other players' hand cards, then deal them again. Everyone keeps
+ * the same amount of hand cards. Call this function on a copy of runtime
+ * before simulating the rest of game, so that the simulation does not
+ * peek at the others' hand cards. When the specified player is you, the
+ * cards you have seen (see Player::isOpen(int)) are kept in place.
+ *
+ * @param who Redeal from whose view. Must be one of the following:
+ *            Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+ */
+void Uno::redeal(int who) {
+    Card* card;
+    int i, j, size, count[4];
+    std::vector<Card*> pool(deck);
+
+    // Collect unknown cards
+    for (i = Player::YOU; i <= Player::COM3; ++i) {
+        Player& p = player[i];
+        count[i] = int(p.handCards.size());
+        if (i == who) {
+            continue;
+        } // if (i == who)
+
+        std::vector<Card*> kept;
+        for (j = 0; j < count[i]; ++j) {
+            if (who == Player::YOU && p.isOpen(j)) {
+                kept.push_back(p.handCards[j]);
+            } // if (who == Player::YOU && p.isOpen(j))
+            else {
+                pool.push_back(p.handCards[j]);
+            } // else
+        } // for (j = 0; j < count[i]; ++j)
+
+        p.handCards = kept;
+        p.open = MASK_BEGIN_TO_I(kept.size());
+    } // for (i = Player::YOU; i <= Player::COM3; ++i)
+
+    // Shuffle them
+    size = int(pool.size());
+    while (size > 0) {
+        i = rand() % size--;
+        card = pool[i]; pool[i] = pool[size]; pool[size] = card;
+    } // while (size > 0)
+
+    // Deal them again, and the rest becomes the new card deck
+    for (i = Player::YOU; i <= Player::COM3; ++i) {
+        Player& p = player[i];
+        while (int(p.handCards.size()) < count[i]) {
+            p.handCards.push_back(pool.back());
+            pool.pop_back();
+        } // while (int(p.handCards.size()) < count[i])
+    } // for (i = Player::YOU; i <= Player::COM3; ++i)
+
+    if (who != Player::YOU) {
+        player[Player::YOU].sort();
+        player[Player::YOU].open = MASK_ALL(this, Player::YOU);
+    } // if (who != Player::YOU)
+
+    deck = pool;
+} // redeal(int)
+
+} // namespace reference
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,560 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __REFERENCE_UNO_H_494649FDFA62B3C015120BCB9BE17613__
+#define __REFERENCE_UNO_H_494649FDFA62B3C015120BCB9BE17613__
+
+#include <vector>
+#include "include/Card.h"
+#include "include/Color.h"
+#include "reference/Player.h"
+#include "include/Content.h"
+
+namespace reference {
+
+/**
+ * Reference copy of the headless Uno runtime, frozen from include/Uno.h and
+ * src/Uno.cpp (with Player, AI and Simulator classes in the same directory),
+ * without image resources. Optimizations of the real engine must not change
+ * any game results, which is checked by comparing the real engine with this
+ * copy (see Differ class). So do not change the logic here, unless the game
+ * rules are changed on purpose.
+ *
+ * Runtimes share the headless card table of the real engine (see
+ * ::Uno::getHeadlessTable()), so that cards are in the same order.
+ */
+class Uno {
+private:
+    /**
+     * Player in turn. Must be one of the following:
+     * Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     */
+    int now;
+
+    /**
+     * How many players in game. Supports 3 or 4.
+     */
+    int players;
+
+    /**
+     * Current action sequence (DIR_LEFT / DIR_RIGHT).
+     */
+    int direction;
+
+    /**
+     * Current difficulty (LV_EASY / LV_HARD / LV_POLICY).
+     */
+    int difficulty;
+
+    /**
+     * Time budget of anytime AI in milli seconds, or 0 for no time budget.
+     */
+    int thinkTime;
+
+    /**
+     * Node budget of anytime AI, or 0 for no node budget.
+     */
+    int thinkNodes;
+
+    /**
+     * AI parameters of each player, or nullptr to use the default ones.
+     */
+    const int* aiParams[4];
+
+    /**
+     * Whether the force play rule is enabled.
+     */
+    bool forcePlay;
+
+    /**
+     * Whether the 7-0 rule is enabled.
+     */
+    bool sevenZeroRule;
+
+    /**
+     * Can or cannot stack +2 cards.
+     */
+    bool draw2StackRule;
+
+    /**
+     * Only available in +2 stack rule. In this rule, when a +2 card is put
+     * down, the next player may transfer the punishment to its next player
+     * by stacking another +2 card. Finally the first one who does not stack
+     * a +2 card must draw all of the required cards. This counter records
+     * that how many required cards need to be drawn by the final player.
+     * When this value is not zero, only +2 cards are legal to play.
+     */
+    int draw2StackCount;
+
+    /**
+     * This binary value shows that which cards are legal to play. When
+     * 0x01LL == ((legality >> i) & 0x01LL), the card with id number i
+     * is legal to play. When the recent-played-card queue changes,
+     * this value will be updated automatically.
+     */
+    long long legality;
+
+    /**
+     * Game players.
+     */
+    Player player[4];
+
+    /**
+     * Card deck (ready to use).
+     */
+    std::vector<Card*> deck;
+
+    /**
+     * Used cards.
+     */
+    std::vector<Card*> used;
+
+    /**
+     * Card map. table->at(i) stores the card instance of id number i.
+     */
+    std::vector<Card>* table;
+
+    /**
+     * Recent played cards.
+     */
+    std::vector<Card*> recent;
+
+    /**
+     * Colors of recent played cards.
+     */
+    std::vector<Color> recentColors;
+
+    /**
+     * State of our own random number generator.
+     */
+    unsigned long long randState;
+
+    /**
+     * Headless constructor. Load no resources, and use the shared headless
+     * card table.
+     */
+    Uno(std::vector<Card>* table, unsigned seed);
+
+    /**
+     * Initialize members, except resources and card table.
+     */
+    void init(unsigned seed);
+
+public:
+    /**
+     * Easy level ID.
+     */
+    static const int LV_EASY = 0;
+
+    /**
+     * Hard level ID.
+     */
+    static const int LV_HARD = 1;
+
+    /**
+     * Learned policy level ID. See Policy class. Falls back to LV_HARD
+     * when no policy weights are loaded.
+     */
+    static const int LV_POLICY = 2;
+
+    /**
+     * Direction value (clockwise).
+     */
+    static const int DIR_LEFT = 1;
+
+    /**
+     * Direction value (counter-clockwise).
+     */
+    static const int DIR_RIGHT = 3;
+
+    /**
+     * In this application, everyone can hold 14 cards at most.
+     */
+    static const int MAX_HOLD_CARDS = 14;
+
+    /**
+     * Create a headless runtime. A headless runtime loads no image resources
+     * and prints no messages, so it can be created without a QApplication.
+     * Every runtime owns its random number generator, so runtimes can run in
+     * different threads, and each game is reproducible from its seed.
+     *
+     * @param seed Random seed. Pass 0 to generate one from current time.
+     * @return The new runtime.
+     */
+    static Uno newHeadlessInstance(unsigned seed = 0U);
+
+    /**
+     * Our own random number generator, works like std::rand().
+     *
+     * @return A pseudo-random integer between 0 and 0x7fffffff.
+     */
+    int rand();
+
+    /**
+     * @return Current state of our random number generator.
+     */
+    unsigned long long getRandState();
+
+    /**
+     * Restore the state of our random number generator.
+     *
+     * @param state Value got from getRandState().
+     */
+    void setRandState(unsigned long long state);
+
+    /**
+     * Calculate a 64-bit hash value of the whole game state, including card
+     * deck, everyone's hand cards, and our random number generator. Two
+     * runtimes with equal hash values behave the same from now on.
+     *
+     * @return Hash value of current game state.
+     */
+    unsigned long long getStateHash();
+
+    /**
+     * @return Player in turn. Must be one of the following:
+     *         Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     */
+    int getNow();
+
+    /**
+     * Switch to next player's turn.
+     *
+     * @return Player in turn after switched. Must be one of the following:
+     *         Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     */
+    int switchNow();
+
+    /**
+     * @return Current player's next player. Must be one of the following:
+     *         Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     */
+    int getNext();
+
+    /**
+     * @return Current player's opposite player. Must be one of the following:
+     *         Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     *         NOTE: When only 3 players in game, getOppo() == getPrev().
+     */
+    int getOppo();
+
+    /**
+     * @return Current player's previous player. Must be one of the following:
+     *         Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     */
+    int getPrev();
+
+    /**
+     * @param who Get which player's instance. Must be one of the following:
+     *            Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     * @return Specified player's instance.
+     */
+    Player* getPlayer(int who);
+
+    /**
+     * @return &this->player[this->getNow()].
+     */
+    Player* getCurrPlayer();
+
+    /**
+     * @return &this->player[this->getNext()].
+     */
+    Player* getNextPlayer();
+
+    /**
+     * @return &this->player[this->getOppo()].
+     */
+    Player* getOppoPlayer();
+
+    /**
+     * @return &this->player[this->getPrev()].
+     */
+    Player* getPrevPlayer();
+
+    /**
+     * @return How many players in game (3 or 4).
+     */
+    int getPlayers();
+
+    /**
+     * Set the amount of players in game.
+     *
+     * @param players Supports 3 and 4.
+     */
+    void setPlayers(int players);
+
+    /**
+     * Switch current action sequence. The value of [direction] will be
+     * switched between DIR_LEFT and DIR_RIGHT.
+     */
+    void switchDirection();
+
+    /**
+     * @return Current action sequence (DIR_LEFT / DIR_RIGHT).
+     */
+    int getDirection();
+
+    /**
+     * @return Current difficulty (LV_EASY / LV_HARD / LV_POLICY).
+     */
+    int getDifficulty();
+
+    /**
+     * Set game difficulty.
+     *
+     * @param difficulty Pass target difficulty value.
+     *                   Only LV_EASY, LV_HARD and LV_POLICY are available.
+     */
+    void setDifficulty(int difficulty);
+
+    /**
+     * @return Time budget of anytime AI in milli seconds, or 0 if none.
+     */
+    int getThinkTime();
+
+    /**
+     * Set the time budget of anytime AI. When either the time budget or the
+     * node budget is set, AI players search for the best card to play until
+     * the budget runs out, instead of using the fixed difficulty strategies.
+     * See AI::searchAI_bestCardIndex4NowPlayer(Color[]).
+     *
+     * @param millis Time budget per action, or 0 to disable it.
+     */
+    void setThinkTime(int millis);
+
+    /**
+     * @return Node budget of anytime AI, or 0 if none.
+     */
+    int getThinkNodes();
+
+    /**
+     * Set the node budget of anytime AI, i.e. how many simulated games at
+     * most AI can play in one action. Unlike time budget, the result of a
+     * node budget is reproducible, and does not depend on CPU load.
+     *
+     * @param nodes Node budget per action, or 0 to disable it.
+     */
+    void setThinkNodes(int nodes);
+
+    /**
+     * @param who Get whose AI parameters. Must be one of the following:
+     *            Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     * @return AI parameters of the specified player, or nullptr if the
+     *         player uses the default ones. See AI::PARAM_COUNT.
+     */
+    const int* getAIParams(int who);
+
+    /**
+     * Let the specified player's AI use the provided parameters, instead of
+     * the default ones. The array is NOT copied, so keep it alive as long as
+     * this runtime and its copies are still working.
+     *
+     * @param who    Set whose AI parameters. Must be one of the following:
+     *               Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     * @param params AI parameters (length == AI::PARAM_COUNT), or nullptr
+     *               to use the default ones.
+     */
+    void setAIParams(int who, const int params[]);
+
+    /**
+     * @return This value tells that what's the next step
+     *         after you drew a playable card in your action.
+     *         When force play is enabled, play the card immediately.
+     *         When force play is disabled, keep the card in your hand.
+     */
+    bool isForcePlay();
+
+    /**
+     * @param enabled Enable/Disable the force play rule.
+     */
+    void setForcePlay(bool enabled);
+
+    /**
+     * @return Whether the 7-0 rule is enabled. In 7-0 rule, when a seven card
+     *         is put down, the player must swap hand cards with another player
+     *         immediately. When a zero card is put down, everyone need to pass
+     *         the hand cards to the next player.
+     */
+    bool isSevenZeroRule();
+
+    /**
+     * @param enabled Enable/Disable the 7-0 rule.
+     */
+    void setSevenZeroRule(bool enabled);
+
+    /**
+     * @return Can or cannot stack +2 cards. If can, when you put down a +2
+     *         card, the next player may transfer the punishment to its next
+     *         player by stacking another +2 card. Finally the first one who
+     *         does not stack a +2 card must draw all of the required cards.
+     */
+    bool isDraw2StackRule();
+
+    /**
+     * @param enabled Enable/Disable the +2 stacking rule.
+     */
+    void setDraw2StackRule(bool enabled);
+
+    /**
+     * Only available in +2 stack rule. In this rule, when a +2 card is put
+     * down, the next player may transfer the punishment to its next player
+     * by stacking another +2 card. Finally the first one who does not stack
+     * a +2 card must draw all of the required cards.
+     *
+     * @return This counter records that how many required cards need to be
+     *         drawn by the final player. When this value is not zero, only
+     *         +2 cards are legal to play.
+     */
+    int getDraw2StackCount();
+
+    /**
+     * Find a card instance in card table.
+     *
+     * @param color   Color of the card you want to get.
+     * @param content Content of the card you want to get.
+     * @return Corresponding card instance.
+     */
+    Card* findCard(Color color, Content content);
+
+    /**
+     * @return How many cards in deck (haven't been used yet).
+     */
+    int getDeckCount();
+
+    /**
+     * @return How many cards have been used.
+     */
+    int getUsedCount();
+
+    /**
+     * @return Recent played cards.
+     */
+    const std::vector<Card*>& getRecent();
+
+    /**
+     * @return Colors of recent played cards.
+     */
+    const std::vector<Color>& getRecentColors();
+
+    /**
+     * @return Color of the last played card.
+     */
+    Color lastColor();
+
+    /**
+     * @return Color of the next-to-last played card.
+     */
+    Color next2lastColor();
+
+    /**
+     * Start a new Uno game. Shuffle cards, let everyone draw 7 cards,
+     * then determine our start card.
+     */
+    void start();
+
+    /**
+     * Call this function when someone needs to draw a card.
+     * <p>
+     * NOTE: Everyone can hold 14 cards at most in this program, so even if this
+     * function is called, the specified player may not draw a card as a result.
+     *
+     * @param who   Who draws a card. Must be one of the following values:
+     *              Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     * @param force Pass true if the specified player is required to draw cards,
+     *              i.e. previous player played a [+2] or [wild +4] to let this
+     *              player draw cards. Or false if the specified player draws a
+     *              card by itself in its action.
+     * @return Index of the drawn card in hand, or -1 if the specified player
+     *         didn't draw a card because of the limitation.
+     */
+    int draw(int who, bool force);
+
+    /**
+     * Check whether the specified card is legal to play. It's legal only when
+     * it's wild, or it has the same color/content to the previous played card.
+     *
+     * @param card Check which card's legality.
+     * @return Whether the specified card is legal to play.
+     */
+    bool isLegalToPlay(Card* card);
+
+    /**
+     * @return How many legal cards (the cards that can be played legally)
+     *         in now player's hand.
+     */
+    int legalCardsCount4NowPlayer();
+
+    /**
+     * Call this function when someone needs to play a card. The played card
+     * replaces the "previous played card", and the original "previous played
+     * card" becomes a used card at the same time.
+     * <p>
+     * NOTE: Before calling this function, you must call isLegalToPlay(Card*)
+     * function at first to check whether the specified card is legal to play.
+     * This function will play the card directly without checking the legality.
+     *
+     * @param who   Who plays a card. Must be one of the following values:
+     *              Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     * @param index Play which card. Pass the corresponding card's index of the
+     *              specified player's hand cards.
+     * @param color Optional, available when the card to play is a wild card.
+     *              Pass the specified following legal color.
+     * @return Reference of the played card.
+     */
+    Card* play(int who, int index, Color color);
+
+    /**
+     * When you think your previous player used a [wild +4] card illegally,
+     * i.e. it holds at least one card matching the next-to-last color,
+     * call this function to make a challenge.
+     *
+     * @param whom Challenge whom. Must be one of the following:
+     *             Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     * @return Tell the challenge result, true if challenge success,
+     *         or false if challenge failure.
+     */
+    bool challenge(int whom);
+
+    /**
+     * In 7-0 rule, when someone put down a seven card, then the player must
+     * swap hand cards with another player immediately.
+     *
+     * @param a Who put down the seven card. Must be one of the following:
+     *          Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     * @param b Exchange with whom. Must be one of the following:
+     *          Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     *          Cannot exchange with yourself.
+     */
+    void swap(int a, int b);
+
+    /**
+     * In 7-0 rule, when a zero card is put down, everyone need to pass the hand
+     * cards to the next player.
+     */
+    void cycle();
+
+    /**
+     * Shuffle all cards unknown to the specified player, i.e. the card deck
+     * and the other players' hand cards, then deal them again. Everyone keeps
+     * the same amount of hand cards. Call this function on a copy of runtime
+     * before simulating the rest of game, so that the simulation does not
+     * peek at the others' hand cards. When the specified player is you, the
+     * cards you have seen (see Player::isOpen(int)) are kept in place.
+     *
+     * @param who Redeal from whose view. Must be one of the following:
+     *            Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+     */
+    void redeal(int who);
+}; // Uno Class
+
+} // namespace reference
+
+#endif // __REFERENCE_UNO_H_494649FDFA62B3C015120BCB9BE17613__
+
+// E.O.F
\ No newline at end of file
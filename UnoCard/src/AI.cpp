@@ -7,15 +7,62 @@
 //
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <cmath>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <vector>
+#include <functional>
+#include <condition_variable>
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include "include/AI.h"
+#include "include/Transposition.h"
+#include "include/BluffStrategy.h"
+#include "include/BluffSolver.h"
+#include "include/Simulator.h"
+#include "include/Distilled.h"
+#include "include/Distiller.h"
+#include "include/Coverage.h"
+#include "include/Latency.h"
+#include "include/Policy.h"
 #include "include/Uno.h"
 #include "include/Card.h"
 #include "include/Color.h"
 #include "include/Player.h"
 #include "include/Content.h"
 
+/**
+ * Default AI parameters.
+ */
+const int AI::DEFAULT_PARAMS[AI::PARAM_COUNT] = {
+    2, // PARAM_ZERO_REV_WORTH
+    4, // PARAM_NUM_WORTH
+    5, // PARAM_SKIP_DRAW2_WORTH
+    4, // PARAM_CHALLENGE_MARGIN
+    4, // PARAM_ATTACK_SIZE
+    4, // PARAM_REVERSE_SIZE
+    3, // PARAM_SAVE_SIZE
+    0  // PARAM_NUM_FIRST
+}; // DEFAULT_PARAMS[]
+
+/**
+ * Names of AI parameters, used in parameter files.
+ */
+const char* const AI::PARAM_NAMES[AI::PARAM_COUNT] = {
+    "zeroRevWorth",
+    "numWorth",
+    "skipDraw2Worth",
+    "challengeMargin",
+    "attackSize",
+    "reverseSize",
+    "saveSize",
+    "numFirst"
+}; // PARAM_NAMES[]
+
 /**
  * In main.cpp, get AI instance here.
  *
@@ -26,12 +73,287 @@ AI* AI::getInstance() {
     return &instance;
 } // getInstance()
 
+/**
+ * Create an AI instance which works on the specified Uno runtime, e.g.
+ * a headless runtime created by Uno::newHeadlessInstance(unsigned).
+ *
+ * @param uno Provide the Uno runtime.
+ */
+AI::AI(Uno* uno) : uno(uno) {
+} // AI(Uno*) (Class Constructor)
+
+/**
+ * @param who Get whose AI parameters.
+ * @return AI parameters of the specified player in our Uno runtime.
+ */
+const int* AI::getParams(int who) {
+    const int* params = uno->getAIParams(who);
+    return params != nullptr ? params : DEFAULT_PARAMS;
+} // getParams(int)
+
+/**
+ * Persistent helper threads shared by all rollout decisions, i.e.
+ * hardware_concurrency() - 1 threads started once and never stopped.
+ * Only one decision uses the helpers at a time. A decision made while
+ * they are busy (e.g. by another arena, scheduler or hinter thread) runs
+ * on its caller's thread only, so that rollouts never start threads per
+ * decision, nor oversubscribe the CPU cores.
+ */
+class RolloutPool {
+private:
+    std::mutex owner, mutex;
+    std::condition_variable wake, done;
+    const std::function<void()>* job;
+    unsigned long long generation;
+    int helpers, busy;
+
+    RolloutPool() {
+        int i, threads = int(std::thread::hardware_concurrency());
+
+        job = nullptr;
+        generation = 0ULL;
+        busy = 0;
+        helpers = threads > 1 ? threads - 1 : 0;
+        for (i = 0; i < helpers; ++i) {
+            std::thread([this] { loop(); }).detach();
+        } // for (i = 0; i < helpers; ++i)
+    } // RolloutPool() (Class Constructor)
+
+    /**
+     * Body of a helper thread. Run each posted job once.
+     */
+    void loop() {
+        unsigned long long seen = 0ULL;
+        std::unique_lock<std::mutex> lock(mutex);
+
+        for (;;) {
+            wake.wait(lock, [&] { return generation != seen; });
+            seen = generation;
+            lock.unlock();
+            (*job)();
+            lock.lock();
+            if (--busy == 0) {
+                done.notify_all();
+            } // if (--busy == 0)
+        } // for (;;)
+    } // loop()
+
+public:
+    /**
+     * @return The shared pool. Never destroyed, since the helpers never
+     *         exit.
+     */
+    static RolloutPool& getInstance() {
+        static RolloutPool* instance = new RolloutPool();
+        return *instance;
+    } // getInstance()
+
+    /**
+     * Run a job on the caller's thread and on all helpers, and return when
+     * all of them have finished. When the helpers are busy, run the job on
+     * the caller's thread only.
+     *
+     * @param f The job. Runs concurrently, and must share work by itself.
+     */
+    void run(const std::function<void()>& f) {
+        std::unique_lock<std::mutex> use(owner, std::try_to_lock);
+
+        if (!use.owns_lock() || helpers == 0) {
+            f();
+            return;
+        } // if (!use.owns_lock() || helpers == 0)
+
+        std::unique_lock<std::mutex> lock(mutex);
+        job = &f;
+        busy = helpers;
+        ++generation;
+        lock.unlock();
+        wake.notify_all();
+        f();
+        lock.lock();
+        done.wait(lock, [&] { return busy == 0; });
+    } // run(const std::function<void()>&)
+}; // RolloutPool Class
+
+/**
+ * Decide a pending [wild +4] challenge or 7-0 swap target by rollouts,
+ * when AI has a time budget or a node budget. For each alternative,
+ * simulate the rest of game many times from the decider's view, with
+ * the cards unknown to the decider redealt. All alternatives share the
+ * same redealt cards in each round, and rounds are simulated by the
+ * shared rollout helper threads, or only by the caller when another
+ * decision is using them. An alternative replaces the first one only
+ * when it wins significantly more often in these paired games.
+ *
+ * @param status  Simulator::STAT_DOUBT_WILD4 or STAT_SEVEN_TARGET.
+ * @param who     Who makes the decision.
+ * @param choices Alternatives. 1 / 0 to challenge or not, or the swap
+ *                targets. The first one is the heuristic answer.
+ * @param count   How many alternatives.
+ * @return Index of the best alternative in choices[].
+ */
+int AI::rolloutDecision(int status, int who, const int choices[], int count) {
+    typedef std::chrono::steady_clock Clock;
+    static const int MAX_TURNS = 200;
+    int k, best, rounds, timeLimit;
+    double score, bestScore;
+    std::mutex mutex;
+    std::atomic<int> next(0);
+    std::vector<int> better(count, 0), worse(count, 0);
+    Transposition* table = Transposition::getInstance();
+    Clock::time_point deadline;
+    unsigned long long seed;
+
+    deadline = Clock::now();
+    seed = uno->getStateHash();
+    timeLimit = uno->getThinkTime();
+    deadline += std::chrono::microseconds(timeLimit * 1000LL * 15 / 16);
+    rounds = uno->getThinkNodes() > 0 ? uno->getThinkNodes() / count : -1;
+    rounds = rounds == 0 ? 1 : rounds;
+    Uno root = *uno;
+    root.setThinkTime(0);
+    root.setThinkNodes(0);
+
+    std::function<void()> work = [&] {
+        int n, c, winner[1];
+        unsigned long long key;
+        std::vector<bool> won(count);
+        std::vector<int> myBetter(count, 0), myWorse(count, 0);
+        Latency::Mute mute; // Simulated games are not decisions at a table
+
+        for (n = next++; rounds < 0 || n < rounds; n = next++) {
+            // Simulate all alternatives on the same redealt cards, and give
+            // up the whole round when the deadline has come
+            for (c = 0; c < count; ++c) {
+                Uno game = root;
+                game.setRandState(seed + n * 0x9e3779b97f4a7c15ULL);
+                game.redeal(who);
+                Simulator sim(&game, status);
+                if (status == Simulator::STAT_DOUBT_WILD4) {
+                    sim.decideChallenge(choices[c] != 0);
+                } // if (status == Simulator::STAT_DOUBT_WILD4)
+                else {
+                    sim.swapWith(choices[c]);
+                } // else
+
+                key = Transposition::keyOf(
+                    &game, sim.getStatus(), sim.getTurns());
+                if (!table->probe(key, winner)) {
+                    do {
+                        sim.run(sim.getTurns() + 8);
+                    } while (sim.getStatus() != Simulator::STAT_GAME_OVER
+                        && sim.getTurns() < MAX_TURNS
+                        && (timeLimit <= 0 || Clock::now() < deadline));
+                    if (sim.getStatus() != Simulator::STAT_GAME_OVER
+                        && sim.getTurns() < MAX_TURNS) {
+                        break;
+                    } // if (sim.getStatus() != ... && ...)
+
+                    winner[0] = sim.getWinner();
+                    table->store(key, winner[0], sim.getTurns());
+                } // if (!table->probe(key, winner))
+
+                won[c] = winner[0] == who;
+            } // for (c = 0; c < count; ++c)
+
+            if (c < count) {
+                break;
+            } // if (c < count)
+
+            for (c = 1; c < count; ++c) {
+                myBetter[c] += won[c] && !won[0];
+                myWorse[c] += !won[c] && won[0];
+            } // for (c = 1; c < count; ++c)
+        } // for (n = next++; rounds < 0 || n < rounds; n = next++)
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (c = 1; c < count; ++c) {
+            better[c] += myBetter[c];
+            worse[c] += myWorse[c];
+        } // for (c = 1; c < count; ++c)
+    }; // work
+
+    RolloutPool::getInstance().run(work);
+
+    // The same two-sigma sign test as searchAI_bestCardIndex4NowPlayer
+    best = 0;
+    bestScore = 0.0;
+    for (k = 1; k < count; ++k) {
+        score = better[k] - worse[k];
+        if (score > bestScore
+            && score > 2.0 * std::sqrt(double(better[k] + worse[k]))) {
+            bestScore = score;
+            best = k;
+        } // if (score > bestScore && ...)
+    } // for (k = 1; k < count; ++k)
+
+    return best;
+} // rolloutDecision(int, int, const int[], int)
+
+/**
+ * Load AI parameters from a text file. Each line of the file is like
+ * "name value", where name is one of PARAM_NAMES. Parameters that are
+ * not mentioned in the file keep their default values.
+ *
+ * @param path      Path of the parameter file.
+ * @param outParams Out parameter. Pass an int array (length>=PARAM_COUNT)
+ *                  to receive the loaded parameters.
+ * @return Whether the file is loaded successfully.
+ */
+bool AI::loadParams(const char* path, int outParams[]) {
+    int i, value;
+    std::string name;
+    std::ifstream reader;
+
+    reader.open(path);
+    if (reader.fail()) {
+        return false;
+    } // if (reader.fail())
+
+    for (i = 0; i < PARAM_COUNT; ++i) {
+        outParams[i] = DEFAULT_PARAMS[i];
+    } // for (i = 0; i < PARAM_COUNT; ++i)
+
+    while (reader >> name >> value) {
+        for (i = 0; i < PARAM_COUNT; ++i) {
+            if (name == PARAM_NAMES[i]) {
+                outParams[i] = value;
+                break;
+            } // if (name == PARAM_NAMES[i])
+        } // for (i = 0; i < PARAM_COUNT; ++i)
+    } // while (reader >> name >> value)
+
+    return reader.eof();
+} // loadParams(const char*, int[])
+
+/**
+ * Save AI parameters to a text file. See loadParams(const char*, int[]).
+ *
+ * @param path   Path of the parameter file.
+ * @param params AI parameters to save (length == PARAM_COUNT).
+ * @return Whether the file is saved successfully.
+ */
+bool AI::saveParams(const char* path, const int params[]) {
+    std::ofstream writer;
+
+    writer.open(path);
+    if (writer.fail()) {
+        return false;
+    } // if (writer.fail())
+
+    for (int i = 0; i < PARAM_COUNT; ++i) {
+        writer << PARAM_NAMES[i] << ' ' << params[i] << std::endl;
+    } // for (int i = 0; i < PARAM_COUNT; ++i)
+
+    return !writer.fail();
+} // saveParams(const char*, const int[])
+
 /**
  * Evaluate which color is the best for current player. In our evaluation
  * system, zero cards / reverse cards are worth 2 points, non-zero number
- * cards are worth 4 points, and skip / draw two cards are worth 5 points.
- * Finally, the color which contains the worthiest cards becomes the best
- * color.
+ * cards are worth 4 points, and skip / draw two cards are worth 5 points
+ * by default (see PARAM_*_WORTH). Finally, the color which contains the
+ * worthiest cards becomes the best color.
  *
  * @return Current player's best color.
  */
@@ -42,6 +364,7 @@ Color AI::calcBestColor4NowPlayer() {
     Color oppoWeak, oppoStrong;
     Color prevWeak, prevStrong;
     bool nextIsUno, oppoIsUno, prevIsUno;
+    Latency::Timer timer(Latency::BEST_COLOR, uno->getDifficulty());
 
     // When defensing UNO dash, use others' weak color as your best color
     next = uno->getNextPlayer();
@@ -65,6 +388,7 @@ Color AI::calcBestColor4NowPlayer() {
     else {
         int score[] = { 0, 0, 0, 0, 0 };
         Player *curr = uno->getCurrPlayer();
+        const int* param = getParams(uno->getNow());
 
         for (Card* card : curr->getHandCards()) {
             switch (card->content) {
@@ -74,16 +398,16 @@ Color AI::calcBestColor4NowPlayer() {
 
             case REV:
             case NUM0:
-                score[card->color] += 2;
+                score[card->color] += param[PARAM_ZERO_REV_WORTH];
                 break; // case REV, NUM0
 
             case SKIP:
             case DRAW2:
-                score[card->color] += 5;
+                score[card->color] += param[PARAM_SKIP_DRAW2_WORTH];
                 break; // case SKIP, DRAW2
 
             default:
-                score[card->color] += 4;
+                score[card->color] += param[PARAM_NUM_WORTH];
                 break; // default
             } // switch (card->content)
         } // for (Card* card : curr->getHandCards())
@@ -121,11 +445,24 @@ Color AI::calcBestColor4NowPlayer() {
     nextStrong = next->getStrongColor();
     oppoStrong = oppo->getStrongColor();
     prevStrong = prev->getStrongColor();
-    while ((nextIsUno && bestColor == nextStrong)
+    if ((nextIsUno && bestColor == nextStrong)
         || (oppoIsUno && bestColor == oppoStrong)
         || (prevIsUno && bestColor == prevStrong)) {
-        bestColor = Color(rand() % 4 + 1);
-    } // while (nextIsUno && bestColor == nextStrong || ...)
+        // Pick one of the colors without conflict at random. At most 3
+        // colors are in conflict, so there is always one left.
+        Color allowed[4];
+        int count = 0;
+
+        for (int c = RED; c <= YELLOW; ++c) {
+            if ((!nextIsUno || c != nextStrong)
+                && (!oppoIsUno || c != oppoStrong)
+                && (!prevIsUno || c != prevStrong)) {
+                allowed[count++] = Color(c);
+            } // if ((!nextIsUno || c != nextStrong) && ...)
+        } // for (int c = RED; c <= YELLOW; ++c)
+
+        bestColor = allowed[uno->rand() % count];
+    } // if (nextIsUno && bestColor == nextStrong || ...)
 
     return bestColor;
 } // calcBestColor4NowPlayer()
@@ -133,14 +470,17 @@ Color AI::calcBestColor4NowPlayer() {
 /**
  * In 7-0 rule, when a seven card is put down, the player must swap hand
  * cards with another player immediately. This API returns that swapping
- * with whom is the best answer for current player.
+ * with whom is the best answer for current player. When AI has a time
+ * budget or a node budget, all targets are compared by rollouts.
  *
  * @return Current player swaps with whom. Must be one of the following:
  *         Player::YOU, Player::COM1, Player::COM2, Player::COM3.
  */
 int AI::calcBestSwapTarget4NowPlayer() {
-    int target;
+    int i, count, target;
     Player *next, *oppo, *prev;
+    int choices[3];
+    Latency::Timer timer(Latency::SWAP_TARGET, uno->getDifficulty());
 
     next = uno->getNextPlayer();
     oppo = uno->getOppoPlayer();
@@ -167,24 +507,71 @@ int AI::calcBestSwapTarget4NowPlayer() {
         target = uno->getPrev();
     } // else
 
+    if (uno->getThinkTime() > 0 || uno->getThinkNodes() > 0) {
+        count = 0;
+        choices[count++] = target;
+        for (i = Player::YOU; i <= Player::COM3; ++i) {
+            if (i != target && i != uno->getNow()
+                && (uno->getPlayers() == 4 || i != Player::COM2)) {
+                choices[count++] = i;
+            } // if (i != target && i != uno->getNow() && ...)
+        } // for (i = Player::YOU; i <= Player::COM3; ++i)
+
+        target = choices[rolloutDecision(Simulator::STAT_SEVEN_TARGET,
+                                         uno->getNow(), choices, count)];
+    } // if (uno->getThinkTime() > 0 || uno->getThinkNodes() > 0)
+
     return target;
 } // calcBestSwapTarget4NowPlayer()
 
 /**
  * AI strategies of determining if it's necessary to challenge previous
- * player's [wild +4] card's legality.
+ * player's [wild +4] card's legality. Easy AI follows fixed rules, and
+ * other levels sample the mixed strategy solved by BluffSolver. When AI
+ * has a time budget or a node budget, both answers are compared by
+ * rollouts.
  *
  * @return True if it's necessary to make a challenge.
  */
 bool AI::needToChallenge() {
+    bool challenge;
+    int choices[2], chance;
+    Player* curr = uno->getCurrPlayer();
     int size = uno->getNextPlayer()->getHandSize();
+    const int* param = getParams(uno->getNext());
+    Latency::Timer timer(Latency::CHALLENGE, uno->getDifficulty());
+
+    if (uno->getDifficulty() == Uno::LV_EASY
+        || BluffSolver::isMeasuring()) {
+        // Challenge when defending my UNO dash
+        // Challenge when I have 10 or more cards already
+        // Challenge when legal color has not been changed
+        challenge = size == 1
+            || size >= Uno::MAX_HOLD_CARDS - param[PARAM_CHALLENGE_MARGIN]
+            || uno->lastColor() == uno->next2lastColor();
+    } // if (uno->getDifficulty() == Uno::LV_EASY || ...)
+    else {
+        // Challenge when I have 10 or more cards already
+        // Otherwise sample the mixed strategy solved by BluffSolver
+        chance = BLUFF_CHALLENGE
+            [BluffSolver::bucketOf(curr->getHandSize())]
+            [BluffSolver::bucketOf(size)]
+            [BluffSolver::evidenceOf(
+                uno->lastColor() == uno->next2lastColor(),
+                curr->getWeakColor() == uno->next2lastColor())];
+        challenge = size >= Uno::MAX_HOLD_CARDS
+            - param[PARAM_CHALLENGE_MARGIN]
+            || BluffSolver::sample(chance, uno, uno->getNext());
+    } // else
+
+    if (uno->getThinkTime() > 0 || uno->getThinkNodes() > 0) {
+        choices[0] = challenge ? 1 : 0;
+        choices[1] = challenge ? 0 : 1;
+        challenge = choices[rolloutDecision(Simulator::STAT_DOUBT_WILD4,
+                                            uno->getNext(), choices, 2)] != 0;
+    } // if (uno->getThinkTime() > 0 || uno->getThinkNodes() > 0)
 
-    // Challenge when defending my UNO dash
-    // Challenge when I have 10 or more cards already
-    // Challenge when legal color has not been changed
-    return size == 1
-        || size >= Uno::MAX_HOLD_CARDS - 4
-        || uno->lastColor() == uno->next2lastColor();
+    return challenge;
 } // needToChallenge()
 
 /**
@@ -204,17 +591,17 @@ bool AI::needToChallenge() {
 int AI::easyAI_bestCardIndex4NowPlayer(Color outColor[]) {
     Card* card;
     int i, idxBest;
-    std::vector<Card*> hand;
     Color bestColor, lastColor;
     int yourSize, nextSize, prevSize;
     int idxNum, idxRev, idxSkip, idxDraw2, idxWild, idxWD4;
     bool hasNum, hasRev, hasSkip, hasDraw2, hasWild, hasWD4;
+    Latency::Timer timer(Latency::EASY_AI, uno->getDifficulty());
 
     if (outColor == nullptr) {
         throw "outColor[] cannot be nullptr";
     } // if (outColor == nullptr)
 
-    hand = uno->getCurrPlayer()->getHandCards();
+    const std::vector<Card*>& hand = uno->getCurrPlayer()->getHandCards();
     yourSize = int(hand.size());
     if (yourSize == 1) {
         // Only one card remained. Play it when it's legal.
@@ -331,31 +718,39 @@ int AI::easyAI_bestCardIndex4NowPlayer(Color outColor[]) {
  */
 int AI::hardAI_bestCardIndex4NowPlayer(Color outColor[]) {
     Card* card;
-    bool allWild;
-    int i, idxBest;
-    std::vector<Card*> hand;
+    const int* param;
+    bool allWild, numFirst, hasLast;
+    int attackSize, reverseSize, saveSize;
+    int i, idxBest, chance;
     Player *next, *oppo, *prev;
     Color bestColor, lastColor;
     int yourSize, nextSize, oppoSize, prevSize;
     Color nextWeak, nextStrong, oppoStrong, prevStrong;
     int idxNumIn[5], idxRev, idxSkip, idxDraw2, idxWild, idxWD4;
     bool hasNumIn[5], hasRev, hasSkip, hasDraw2, hasWild, hasWD4;
+    Latency::Timer timer(Latency::HARD_AI, uno->getDifficulty());
 
     if (outColor == nullptr) {
         throw "outColor[] cannot be nullptr";
     } // if (outColor == nullptr)
 
-    hand = uno->getCurrPlayer()->getHandCards();
+    const std::vector<Card*>& hand = uno->getCurrPlayer()->getHandCards();
     yourSize = int(hand.size());
     if (yourSize == 1) {
         // Only one card remained. Play it when it's legal.
         card = hand.at(0);
         outColor[0] = card->color;
-        return uno->isLegalToPlay(card) ? 0 : -1;
+        return AI_BRANCH("hard", uno->isLegalToPlay(card) ? 0 : -1);
     } // if (yourSize == 1)
 
     idxBest = -1;
     allWild = true;
+    hasLast = false;
+    param = getParams(uno->getNow());
+    attackSize = param[PARAM_ATTACK_SIZE];
+    reverseSize = param[PARAM_REVERSE_SIZE];
+    saveSize = param[PARAM_SAVE_SIZE];
+    numFirst = param[PARAM_NUM_FIRST] != 0;
     lastColor = uno->lastColor();
     bestColor = calcBestColor4NowPlayer();
     idxRev = idxSkip = idxDraw2 = idxWild = idxWD4 = -1;
@@ -366,6 +761,7 @@ int AI::hardAI_bestCardIndex4NowPlayer(Color outColor[]) {
         // Index of any kind
         card = hand.at(i);
         allWild = allWild && card->isWild();
+        hasLast = hasLast || (!card->isWild() && card->color == lastColor);
         if (uno->isLegalToPlay(card)) {
             switch (card->content) {
             case DRAW2:
@@ -407,6 +803,21 @@ int AI::hardAI_bestCardIndex4NowPlayer(Color outColor[]) {
         } // if (uno->isLegalToPlay(card))
     } // for (i = 0; i < yourSize; ++i)
 
+    if (hasWD4 && hasLast && !BluffSolver::isMeasuring()) {
+        // Playing [wild +4] now is a bluff. Keep it or not by the mixed
+        // strategy solved by BluffSolver.
+        chance = BLUFF_PLAY
+            [BluffSolver::bucketOf(yourSize - 1)]
+            [BluffSolver::bucketOf(uno->getNextPlayer()->getHandSize())]
+            [BluffSolver::evidenceOf(
+                bestColor == lastColor,
+                uno->getCurrPlayer()->getWeakColor() == lastColor)];
+        if (!BluffSolver::sample(chance, uno, uno->getNow() + 4)) {
+            idxWD4 = -1;
+            hasWD4 = false;
+        } // if (!BluffSolver::sample(chance, uno, uno->getNow() + 4))
+    } // if (hasWD4 && hasLast && !BluffSolver::isMeasuring())
+
     // Decision tree
     next = uno->getNextPlayer();
     nextSize = next->getHandSize();
@@ -422,7 +833,7 @@ int AI::hardAI_bestCardIndex4NowPlayer(Color outColor[]) {
         // Strategies when your next player remains only one card.
         // Limit your next player's action as well as you can.
         if (hasDraw2)
-            idxBest = idxDraw2;
+            idxBest = AI_BRANCH("hard", idxDraw2);
         else if (lastColor == nextStrong) {
             // Priority when next called Uno & lastColor == nextStrong:
             // 0: Number cards, NOT in color of nextStrong
@@ -432,31 +843,31 @@ int AI::hardAI_bestCardIndex4NowPlayer(Color outColor[]) {
             // 4: Reverse cards, in any color
             // 5: Draw one, and pray to get one of the above...
             if (hasNumIn[bestColor])
-                idxBest = idxNumIn[bestColor];
+                idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
             else if (hasNumIn[RED] && nextStrong != RED
                 && (prevSize > 1 || prevStrong != RED)
                 && (oppoSize > 1 || oppoStrong != RED))
-                idxBest = idxNumIn[RED];
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
             else if (hasNumIn[BLUE] && nextStrong != BLUE
                 && (prevSize > 1 || prevStrong != BLUE)
                 && (oppoSize > 1 || oppoStrong != BLUE))
-                idxBest = idxNumIn[BLUE];
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
             else if (hasNumIn[GREEN] && nextStrong != GREEN
                 && (prevSize > 1 || prevStrong != GREEN)
                 && (oppoSize > 1 || oppoStrong != GREEN))
-                idxBest = idxNumIn[GREEN];
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
             else if (hasNumIn[YELLOW] && nextStrong != YELLOW
                 && (prevSize > 1 || prevStrong != YELLOW)
                 && (oppoSize > 1 || oppoStrong != YELLOW))
-                idxBest = idxNumIn[YELLOW];
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
             else if (hasSkip)
-                idxBest = idxSkip;
+                idxBest = AI_BRANCH("hard", idxSkip);
             else if (hasWild)
-                idxBest = idxWild;
+                idxBest = AI_BRANCH("hard", idxWild);
             else if (hasWD4)
-                idxBest = idxWD4;
+                idxBest = AI_BRANCH("hard", idxWD4);
             else if (hasRev)
-                idxBest = idxRev;
+                idxBest = AI_BRANCH("hard", idxRev);
         } // else if (lastColor == nextStrong)
         else if (nextStrong != NONE) {
             // Priority when next called Uno & lastColor != nextStrong:
@@ -466,28 +877,28 @@ int AI::hardAI_bestCardIndex4NowPlayer(Color outColor[]) {
             // 2: Skip cards, NOT in color of nextStrong
             // 3: Draw one because it's not necessary to use wild cards
             if (hasNumIn[bestColor])
-                idxBest = idxNumIn[bestColor];
+                idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
             else if (hasNumIn[RED] && nextStrong != RED
                 && (prevSize > 1 || prevStrong != RED)
                 && (oppoSize > 1 || oppoStrong != RED))
-                idxBest = idxNumIn[RED];
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
             else if (hasNumIn[BLUE] && nextStrong != BLUE
                 && (prevSize > 1 || prevStrong != BLUE)
                 && (oppoSize > 1 || oppoStrong != BLUE))
-                idxBest = idxNumIn[BLUE];
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
             else if (hasNumIn[GREEN] && nextStrong != GREEN
                 && (prevSize > 1 || prevStrong != GREEN)
                 && (oppoSize > 1 || oppoStrong != GREEN))
-                idxBest = idxNumIn[GREEN];
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
             else if (hasNumIn[YELLOW] && nextStrong != YELLOW
                 && (prevSize > 1 || prevStrong != YELLOW)
                 && (oppoSize > 1 || oppoStrong != YELLOW))
-                idxBest = idxNumIn[YELLOW];
-            else if (hasRev && prevSize >= 4
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
+            else if (hasRev && prevSize >= reverseSize
                 && hand.at(idxRev)->color != nextStrong)
-                idxBest = idxRev;
+                idxBest = AI_BRANCH("hard", idxRev);
             else if (hasSkip && hand.at(idxSkip)->color != nextStrong)
-                idxBest = idxSkip;
+                idxBest = AI_BRANCH("hard", idxSkip);
         } // else if (nextStrong != NONE)
         else {
             // Priority when next called Uno & nextStrong is unknown:
@@ -499,33 +910,33 @@ int AI::hardAI_bestCardIndex4NowPlayer(Color outColor[]) {
             // 5: Wild +4 cards, switch to your best color
             // 6: Number cards, in any color
             if (hasSkip)
-                idxBest = idxSkip;
+                idxBest = AI_BRANCH("hard", idxSkip);
             else if (hasRev)
-                idxBest = idxRev;
+                idxBest = AI_BRANCH("hard", idxRev);
             else if (hasWD4 && !hasNumIn[lastColor])
-                idxBest = idxWD4;
+                idxBest = AI_BRANCH("hard", idxWD4);
             else if (hasNumIn[bestColor])
-                idxBest = idxNumIn[bestColor];
+                idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
             else if (hasWild)
-                idxBest = idxWild;
+                idxBest = AI_BRANCH("hard", idxWild);
             else if (hasWD4)
-                idxBest = idxWD4;
+                idxBest = AI_BRANCH("hard", idxWD4);
             else if (hasNumIn[RED]
                 && (prevSize > 1 || prevStrong != RED)
                 && (oppoSize > 1 || oppoStrong != RED))
-                idxBest = idxNumIn[RED];
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
             else if (hasNumIn[BLUE]
                 && (prevSize > 1 || prevStrong != BLUE)
                 && (oppoSize > 1 || oppoStrong != BLUE))
-                idxBest = idxNumIn[BLUE];
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
             else if (hasNumIn[GREEN]
                 && (prevSize > 1 || prevStrong != GREEN)
                 && (oppoSize > 1 || oppoStrong != GREEN))
-                idxBest = idxNumIn[GREEN];
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
             else if (hasNumIn[YELLOW]
                 && (prevSize > 1 || prevStrong != YELLOW)
                 && (oppoSize > 1 || oppoStrong != YELLOW))
-                idxBest = idxNumIn[YELLOW];
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
         } // else
     } // if (nextSize == 1)
     else if (prevSize == 1) {
@@ -541,21 +952,21 @@ int AI::hardAI_bestCardIndex4NowPlayer(Color outColor[]) {
             // 3: Number cards, in any color, but firstly your best color
             // 4: Draw one because it's not necessary to use other cards
             if (hasSkip && hand.at(idxSkip)->color != prevStrong)
-                idxBest = idxSkip;
+                idxBest = AI_BRANCH("hard", idxSkip);
             else if (hasWild)
-                idxBest = idxWild;
+                idxBest = AI_BRANCH("hard", idxWild);
             else if (hasWD4)
-                idxBest = idxWD4;
+                idxBest = AI_BRANCH("hard", idxWD4);
             else if (hasNumIn[bestColor])
-                idxBest = idxNumIn[bestColor];
+                idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
             else if (hasNumIn[RED])
-                idxBest = idxNumIn[RED];
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
             else if (hasNumIn[BLUE])
-                idxBest = idxNumIn[BLUE];
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
             else if (hasNumIn[GREEN])
-                idxBest = idxNumIn[GREEN];
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
             else if (hasNumIn[YELLOW])
-                idxBest = idxNumIn[YELLOW];
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
         } // if (lastColor == prevStrong)
         else if (prevStrong != NONE) {
             // Priority when prev called Uno & lastColor != prevStrong:
@@ -564,21 +975,21 @@ int AI::hardAI_bestCardIndex4NowPlayer(Color outColor[]) {
             // 1: Number cards, NOT in color of prevStrong
             // 2: Draw one because it's not necessary to use other cards
             if (hasRev && hand.at(idxRev)->color != prevStrong)
-                idxBest = idxRev;
+                idxBest = AI_BRANCH("hard", idxRev);
             else if (hasNumIn[bestColor])
-                idxBest = idxNumIn[bestColor];
+                idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
             else if (hasNumIn[RED] && prevStrong != RED
                 && (oppoSize > 1 || oppoStrong != RED))
-                idxBest = idxNumIn[RED];
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
             else if (hasNumIn[BLUE] && prevStrong != BLUE
                 && (oppoSize > 1 || oppoStrong != BLUE))
-                idxBest = idxNumIn[BLUE];
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
             else if (hasNumIn[GREEN] && prevStrong != GREEN
                 && (oppoSize > 1 || oppoStrong != GREEN))
-                idxBest = idxNumIn[GREEN];
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
             else if (hasNumIn[YELLOW] && prevStrong != YELLOW
                 && (oppoSize > 1 || oppoStrong != YELLOW))
-                idxBest = idxNumIn[YELLOW];
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
         } // else if (prevStrong != NONE)
         else {
             // Priority when prev called Uno & prevStrong is unknown:
@@ -588,19 +999,19 @@ int AI::hardAI_bestCardIndex4NowPlayer(Color outColor[]) {
             // 3: Number cards, in any color
             // 4: Draw one. DO NOT PLAY REVERSE CARDS!
             if (hasNumIn[bestColor])
-                idxBest = idxNumIn[bestColor];
+                idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
             else if (hasWild && lastColor != bestColor)
-                idxBest = idxWild;
+                idxBest = AI_BRANCH("hard", idxWild);
             else if (hasWD4 && lastColor != bestColor)
-                idxBest = idxWD4;
+                idxBest = AI_BRANCH("hard", idxWD4);
             else if (hasNumIn[RED])
-                idxBest = idxNumIn[RED];
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
             else if (hasNumIn[BLUE])
-                idxBest = idxNumIn[BLUE];
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
             else if (hasNumIn[GREEN])
-                idxBest = idxNumIn[GREEN];
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
             else if (hasNumIn[YELLOW])
-                idxBest = idxNumIn[YELLOW];
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
         } // else
     } // else if (prevSize == 1)
     else if (oppoSize == 1) {
@@ -621,35 +1032,35 @@ int AI::hardAI_bestCardIndex4NowPlayer(Color outColor[]) {
             // 7: Number cards, in color of oppoStrong
             //    (pray that next can limit oppo!)
             if (hasNumIn[bestColor])
-                idxBest = idxNumIn[bestColor];
+                idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
             else if (hasNumIn[RED] && oppoStrong != RED)
-                idxBest = idxNumIn[RED];
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
             else if (hasNumIn[BLUE] && oppoStrong != BLUE)
-                idxBest = idxNumIn[BLUE];
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
             else if (hasNumIn[GREEN] && oppoStrong != GREEN)
-                idxBest = idxNumIn[GREEN];
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
             else if (hasNumIn[YELLOW] && oppoStrong != YELLOW)
-                idxBest = idxNumIn[YELLOW];
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
             else if (hasRev && hand.at(idxRev)->color != oppoStrong)
-                idxBest = idxRev;
+                idxBest = AI_BRANCH("hard", idxRev);
             else if (hasSkip && hand.at(idxSkip)->color != oppoStrong)
-                idxBest = idxSkip;
+                idxBest = AI_BRANCH("hard", idxSkip);
             else if (hasDraw2 && hand.at(idxDraw2)->color != oppoStrong)
-                idxBest = idxDraw2;
+                idxBest = AI_BRANCH("hard", idxDraw2);
             else if (hasWild)
-                idxBest = idxWild;
+                idxBest = AI_BRANCH("hard", idxWild);
             else if (hasWD4)
-                idxBest = idxWD4;
+                idxBest = AI_BRANCH("hard", idxWD4);
             else if (hasRev && prevSize > nextSize)
-                idxBest = idxRev;
+                idxBest = AI_BRANCH("hard", idxRev);
             else if (hasNumIn[RED])
-                idxBest = idxNumIn[RED];
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
             else if (hasNumIn[BLUE])
-                idxBest = idxNumIn[BLUE];
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
             else if (hasNumIn[GREEN])
-                idxBest = idxNumIn[GREEN];
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
             else if (hasNumIn[YELLOW])
-                idxBest = idxNumIn[YELLOW];
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
         } // if (lastColor == oppoStrong)
         else if (oppoStrong != NONE) {
             // Priority when oppo called Uno & lastColor != oppoStrong:
@@ -660,23 +1071,23 @@ int AI::hardAI_bestCardIndex4NowPlayer(Color outColor[]) {
             // 3: +2 cards, NOT in color of oppoStrong
             // 4: Draw one because it's not necessary to use other cards
             if (hasNumIn[bestColor])
-                idxBest = idxNumIn[bestColor];
+                idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
             else if (hasNumIn[RED] && oppoStrong != RED)
-                idxBest = idxNumIn[RED];
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
             else if (hasNumIn[BLUE] && oppoStrong != BLUE)
-                idxBest = idxNumIn[BLUE];
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
             else if (hasNumIn[GREEN] && oppoStrong != GREEN)
-                idxBest = idxNumIn[GREEN];
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
             else if (hasNumIn[YELLOW] && oppoStrong != YELLOW)
-                idxBest = idxNumIn[YELLOW];
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
             else if (hasRev && hand.at(idxRev)->color != oppoStrong)
-                idxBest = idxRev;
-            else if (hasSkip && nextSize <= 4
+                idxBest = AI_BRANCH("hard", idxRev);
+            else if (hasSkip && nextSize <= attackSize
                 && hand.at(idxSkip)->color != oppoStrong)
-                idxBest = idxSkip;
-            else if (hasDraw2 && nextSize <= 4
+                idxBest = AI_BRANCH("hard", idxSkip);
+            else if (hasDraw2 && nextSize <= attackSize
                 && hand.at(idxDraw2)->color != oppoStrong)
-                idxBest = idxDraw2;
+                idxBest = AI_BRANCH("hard", idxDraw2);
         } // else if (oppoStrong != NONE)
         else {
             // Priority when oppo called Uno & oppoStrong is unknown:
@@ -687,31 +1098,31 @@ int AI::hardAI_bestCardIndex4NowPlayer(Color outColor[]) {
             // 3: Wild +4 cards, switch to your best color
             // 4: Draw one because it's not necessary to use other cards
             if (hasRev && prevSize > nextSize)
-                idxBest = idxRev;
+                idxBest = AI_BRANCH("hard", idxRev);
             else if (hasNumIn[bestColor])
-                idxBest = idxNumIn[bestColor];
+                idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
             else if (hasNumIn[RED])
-                idxBest = idxNumIn[RED];
+                idxBest = AI_BRANCH("hard", idxNumIn[RED]);
             else if (hasNumIn[BLUE])
-                idxBest = idxNumIn[BLUE];
+                idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
             else if (hasNumIn[GREEN])
-                idxBest = idxNumIn[GREEN];
+                idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
             else if (hasNumIn[YELLOW])
-                idxBest = idxNumIn[YELLOW];
+                idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
             else if (hasWild && lastColor != bestColor)
-                idxBest = idxWild;
-            else if (hasWD4 && lastColor != bestColor && nextSize <= 4)
-                idxBest = idxWD4;
+                idxBest = AI_BRANCH("hard", idxWild);
+            else if (hasWD4 && lastColor != bestColor && nextSize <= attackSize)
+                idxBest = AI_BRANCH("hard", idxWD4);
         } // else
     } // else if (oppoSize == 1)
     else if (allWild) {
         // Strategies when you remain only wild cards.
         // When your next player remains only a few cards, use [Wild +4]
         // cards at first. Otherwise, use [Wild] cards at first.
-        if (nextSize <= 4)
-            idxBest = hasWD4 ? idxWD4 : idxWild;
+        if (nextSize <= attackSize)
+            idxBest = AI_BRANCH("hard", hasWD4 ? idxWD4 : idxWild);
         else
-            idxBest = hasWild ? idxWild : idxWD4;
+            idxBest = AI_BRANCH("hard", hasWild ? idxWild : idxWD4);
     } // else if (allWild)
     else if (lastColor == nextWeak && yourSize > 2) {
         // Strategies when your next player drew a card in its last action.
@@ -725,27 +1136,28 @@ int AI::hardAI_bestCardIndex4NowPlayer(Color outColor[]) {
         // 3: Skip cards, in your best color
         // 4: +2 cards, in your best color
         if (hasRev && prevSize > nextSize)
-            idxBest = idxRev;
+            idxBest = AI_BRANCH("hard", idxRev);
         else if (hasNumIn[nextWeak])
-            idxBest = idxNumIn[nextWeak];
+            idxBest = AI_BRANCH("hard", idxNumIn[nextWeak]);
         else if (hasNumIn[bestColor])
-            idxBest = idxNumIn[bestColor];
+            idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
         else if (hasNumIn[RED])
-            idxBest = idxNumIn[RED];
+            idxBest = AI_BRANCH("hard", idxNumIn[RED]);
         else if (hasNumIn[BLUE])
-            idxBest = idxNumIn[BLUE];
+            idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
         else if (hasNumIn[GREEN])
-            idxBest = idxNumIn[GREEN];
+            idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
         else if (hasNumIn[YELLOW])
-            idxBest = idxNumIn[YELLOW];
-        else if (hasRev && (prevSize >= 4 || prev->getRecent() == nullptr))
-            idxBest = idxRev;
-        else if (hasSkip && oppoSize >= 3
+            idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
+        else if (hasRev
+            && (prevSize >= reverseSize || prev->getRecent() == nullptr))
+            idxBest = AI_BRANCH("hard", idxRev);
+        else if (hasSkip && oppoSize >= saveSize
             && hand.at(idxSkip)->color == bestColor)
-            idxBest = idxSkip;
-        else if (hasDraw2 && oppoSize >= 3
+            idxBest = AI_BRANCH("hard", idxSkip);
+        else if (hasDraw2 && oppoSize >= saveSize
             && hand.at(idxDraw2)->color == bestColor)
-            idxBest = idxDraw2;
+            idxBest = AI_BRANCH("hard", idxDraw2);
     } // else if (lastColor == nextWeak && yourSize > 2)
     else {
         // Normal strategies
@@ -761,53 +1173,59 @@ int AI::hardAI_bestCardIndex4NowPlayer(Color outColor[]) {
         // 7: Wild +4 cards, switch to your best color, when nextSize <= 4
         // 8: Wild +4 cards, when yourSize == 2 && prevSize <= 3 (UNO dash!)
         // 9: Wild cards, when yourSize == 2 && prevSize <= 3 (UNO dash!)
-        if (hasDraw2 && nextSize <= 4 && nextSize - oppoSize <= 1)
-            idxBest = idxDraw2;
-        else if (hasSkip && nextSize <= 4 && nextSize - oppoSize <= 1)
-            idxBest = idxSkip;
-        else if (hasRev &&
+        // When PARAM_NUM_FIRST is set, 0~2 are skipped if any number card
+        // is legal to play.
+        numFirst = numFirst && (hasNumIn[RED] || hasNumIn[BLUE]
+            || hasNumIn[GREEN] || hasNumIn[YELLOW]);
+        if (!numFirst && hasDraw2
+            && nextSize <= attackSize && nextSize - oppoSize <= 1)
+            idxBest = AI_BRANCH("hard", idxDraw2);
+        else if (!numFirst && hasSkip
+            && nextSize <= attackSize && nextSize - oppoSize <= 1)
+            idxBest = AI_BRANCH("hard", idxSkip);
+        else if (!numFirst && hasRev &&
             (prevSize > nextSize || prev->getRecent() == nullptr))
-            idxBest = idxRev;
+            idxBest = AI_BRANCH("hard", idxRev);
         else if (hasNumIn[bestColor])
-            idxBest = idxNumIn[bestColor];
+            idxBest = AI_BRANCH("hard", idxNumIn[bestColor]);
         else if (hasNumIn[RED])
-            idxBest = idxNumIn[RED];
+            idxBest = AI_BRANCH("hard", idxNumIn[RED]);
         else if (hasNumIn[BLUE])
-            idxBest = idxNumIn[BLUE];
+            idxBest = AI_BRANCH("hard", idxNumIn[BLUE]);
         else if (hasNumIn[GREEN])
-            idxBest = idxNumIn[GREEN];
+            idxBest = AI_BRANCH("hard", idxNumIn[GREEN]);
         else if (hasNumIn[YELLOW])
-            idxBest = idxNumIn[YELLOW];
-        else if (hasRev && prevSize >= 4)
-            idxBest = idxRev;
-        else if (hasSkip && oppoSize >= 3
+            idxBest = AI_BRANCH("hard", idxNumIn[YELLOW]);
+        else if (hasRev && prevSize >= reverseSize)
+            idxBest = AI_BRANCH("hard", idxRev);
+        else if (hasSkip && oppoSize >= saveSize
             && hand.at(idxSkip)->color == bestColor)
-            idxBest = idxSkip;
-        else if (hasDraw2 && oppoSize >= 3
+            idxBest = AI_BRANCH("hard", idxSkip);
+        else if (hasDraw2 && oppoSize >= saveSize
             && hand.at(idxDraw2)->color == bestColor)
-            idxBest = idxDraw2;
-        else if (hasWild && nextSize <= 4)
-            idxBest = idxWild;
-        else if (hasWD4 && nextSize <= 4)
-            idxBest = idxWD4;
+            idxBest = AI_BRANCH("hard", idxDraw2);
+        else if (hasWild && nextSize <= attackSize)
+            idxBest = AI_BRANCH("hard", idxWild);
+        else if (hasWD4 && nextSize <= attackSize)
+            idxBest = AI_BRANCH("hard", idxWD4);
         else if (hasWD4 && yourSize == 2 && prevSize <= 3)
-            idxBest = idxWD4;
+            idxBest = AI_BRANCH("hard", idxWD4);
         else if (hasWild && yourSize == 2 && prevSize <= 3)
-            idxBest = idxWild;
+            idxBest = AI_BRANCH("hard", idxWild);
         else if (yourSize == Uno::MAX_HOLD_CARDS) {
             // When you are holding 14 cards, which means you cannot hold
             // more cards, you need to play your action/wild cards to keep
             // game running, even if it's not worth enough to use them.
             if (hasSkip)
-                idxBest = idxSkip;
+                idxBest = AI_BRANCH("hard", idxSkip);
             else if (hasDraw2)
-                idxBest = idxDraw2;
+                idxBest = AI_BRANCH("hard", idxDraw2);
             else if (hasRev)
-                idxBest = idxRev;
+                idxBest = AI_BRANCH("hard", idxRev);
             else if (hasWild)
-                idxBest = idxWild;
+                idxBest = AI_BRANCH("hard", idxWild);
             else if (hasWD4)
-                idxBest = idxWD4;
+                idxBest = AI_BRANCH("hard", idxWD4);
         } // else if (yourSize == Uno::MAX_HOLD_CARDS)
     } // else
 
@@ -832,7 +1250,6 @@ int AI::hardAI_bestCardIndex4NowPlayer(Color outColor[]) {
 int AI::sevenZeroAI_bestCardIndex4NowPlayer(Color outColor[]) {
     Card* card;
     int i, idxBest;
-    std::vector<Card*> hand;
     Player *next, *oppo, *prev;
     Color bestColor, lastColor;
     int idx0, idxNum, idxWild, idxWD4;
@@ -841,18 +1258,19 @@ int AI::sevenZeroAI_bestCardIndex4NowPlayer(Color outColor[]) {
     bool has7, hasRev, hasSkip, hasDraw2;
     Color nextStrong, oppoStrong, prevStrong;
     int yourSize, nextSize, oppoSize, prevSize;
+    Latency::Timer timer(Latency::SEVEN_ZERO_AI, uno->getDifficulty());
 
     if (outColor == nullptr) {
         throw "outColor[] cannot be nullptr";
     } // if (outColor == nullptr)
 
-    hand = uno->getCurrPlayer()->getHandCards();
+    const std::vector<Card*>& hand = uno->getCurrPlayer()->getHandCards();
     yourSize = int(hand.size());
     if (yourSize == 1) {
         // Only one card remained. Play it when it's legal.
         card = hand.at(0);
         outColor[0] = card->color;
-        return uno->isLegalToPlay(card) ? 0 : -1;
+        return AI_BRANCH("7-0", uno->isLegalToPlay(card) ? 0 : -1);
     } // if (yourSize == 1)
 
     idxBest = -1;
@@ -941,100 +1359,401 @@ int AI::sevenZeroAI_bestCardIndex4NowPlayer(Color outColor[]) {
                 && hand.at(1 - idx7)->content != WILD
                 && hand.at(1 - idx7)->content != WILD_DRAW4
                 && hand.at(1 - idx7)->color != hand.at(idx7)->color)))
-            idxBest = idx7;
+            idxBest = AI_BRANCH("7-0", idx7);
         else if (has0 && (yourSize > 2
             || (hand.at(1 - idx0)->content != NUM0
                 && hand.at(1 - idx0)->content != WILD
                 && hand.at(1 - idx0)->content != WILD_DRAW4
                 && hand.at(1 - idx0)->color != hand.at(idx0)->color)))
-            idxBest = idx0;
+            idxBest = AI_BRANCH("7-0", idx0);
         else if (hasDraw2)
-            idxBest = idxDraw2;
+            idxBest = AI_BRANCH("7-0", idxDraw2);
         else if (hasSkip)
-            idxBest = idxSkip;
+            idxBest = AI_BRANCH("7-0", idxSkip);
         else if (hasRev)
-            idxBest = idxRev;
+            idxBest = AI_BRANCH("7-0", idxRev);
         else if (hasWD4 && lastColor != bestColor)
-            idxBest = idxWD4;
+            idxBest = AI_BRANCH("7-0", idxWD4);
         else if (hasWild && lastColor != bestColor)
-            idxBest = idxWild;
+            idxBest = AI_BRANCH("7-0", idxWild);
         else if (hasNum && hand.at(idxNum)->color != nextStrong)
-            idxBest = idxNum;
+            idxBest = AI_BRANCH("7-0", idxNum);
         else if (hasWild && (has7 || has0))
-            idxBest = idxWild;
+            idxBest = AI_BRANCH("7-0", idxWild);
     } // if (nextSize == 1)
     else if (prevSize == 1) {
         // Strategies when your previous player remains only one card.
         // Consider to use a 0 or 7 to steal the UNO.
         if (has0)
-            idxBest = idx0;
+            idxBest = AI_BRANCH("7-0", idx0);
         else if (has7)
-            idxBest = idx7;
+            idxBest = AI_BRANCH("7-0", idx7);
         else if (hasNum)
-            idxBest = idxNum;
+            idxBest = AI_BRANCH("7-0", idxNum);
         else if (hasSkip && hand.at(idxSkip)->color != prevStrong)
-            idxBest = idxSkip;
+            idxBest = AI_BRANCH("7-0", idxSkip);
         else if (hasDraw2 && hand.at(idxDraw2)->color != prevStrong)
-            idxBest = idxDraw2;
+            idxBest = AI_BRANCH("7-0", idxDraw2);
         else if (hasWild && lastColor != bestColor)
-            idxBest = idxWild;
+            idxBest = AI_BRANCH("7-0", idxWild);
         else if (hasWD4 && lastColor != bestColor)
-            idxBest = idxWD4;
+            idxBest = AI_BRANCH("7-0", idxWD4);
     } // else if (prevSize == 1)
     else if (oppoSize == 1) {
         // Strategies when your opposite player remains only one card.
         // Consider to use a 7 to steal the UNO.
         if (has7)
-            idxBest = idx7;
+            idxBest = AI_BRANCH("7-0", idx7);
         else if (has0)
-            idxBest = idx0;
+            idxBest = AI_BRANCH("7-0", idx0);
         else if (hasNum)
-            idxBest = idxNum;
+            idxBest = AI_BRANCH("7-0", idxNum);
         else if (hasRev && prevSize > nextSize)
-            idxBest = idxRev;
+            idxBest = AI_BRANCH("7-0", idxRev);
         else if (hasSkip && hand.at(idxSkip)->color != oppoStrong)
-            idxBest = idxSkip;
+            idxBest = AI_BRANCH("7-0", idxSkip);
         else if (hasDraw2 && hand.at(idxDraw2)->color != oppoStrong)
-            idxBest = idxDraw2;
+            idxBest = AI_BRANCH("7-0", idxDraw2);
         else if (hasWild && lastColor != bestColor)
-            idxBest = idxWild;
+            idxBest = AI_BRANCH("7-0", idxWild);
         else if (hasWD4 && lastColor != bestColor)
-            idxBest = idxWD4;
+            idxBest = AI_BRANCH("7-0", idxWD4);
     } // else if (oppoSize == 1)
     else {
         // Normal strategies
         if (has0 && hand.at(idx0)->color == prevStrong)
-            idxBest = idx0;
+            idxBest = AI_BRANCH("7-0", idx0);
         else if (has7 && (hand.at(idx7)->color == prevStrong
             || hand.at(idx7)->color == oppoStrong
             || hand.at(idx7)->color == nextStrong))
-            idxBest = idx7;
+            idxBest = AI_BRANCH("7-0", idx7);
         else if (hasRev && prevSize > nextSize)
-            idxBest = idxRev;
+            idxBest = AI_BRANCH("7-0", idxRev);
         else if (hasNum)
-            idxBest = idxNum;
+            idxBest = AI_BRANCH("7-0", idxNum);
         else if (hasSkip)
-            idxBest = idxSkip;
+            idxBest = AI_BRANCH("7-0", idxSkip);
         else if (hasDraw2)
-            idxBest = idxDraw2;
+            idxBest = AI_BRANCH("7-0", idxDraw2);
         else if (hasRev)
-            idxBest = idxRev;
+            idxBest = AI_BRANCH("7-0", idxRev);
         else if (hasWild)
-            idxBest = idxWild;
+            idxBest = AI_BRANCH("7-0", idxWild);
         else if (hasWD4)
-            idxBest = idxWD4;
+            idxBest = AI_BRANCH("7-0", idxWD4);
         else if (has0 && (yourSize > 2
             || (hand.at(1 - idx0)->content != NUM0
                 && hand.at(1 - idx0)->content != WILD
                 && hand.at(1 - idx0)->content != WILD_DRAW4
                 && hand.at(1 - idx0)->color != hand.at(idx0)->color)))
-            idxBest = idx0;
+            idxBest = AI_BRANCH("7-0", idx0);
         else if (has7)
-            idxBest = idx7;
+            idxBest = AI_BRANCH("7-0", idx7);
     } // else
 
     outColor[0] = bestColor;
     return idxBest;
 } // sevenZeroAI_bestCardIndex4NowPlayer(Color[])
 
+/**
+ * AI Strategies (Difficulty: POLICY). Score current player's legal hand
+ * cards by the learned policy network (see Policy class), and play the
+ * best one. Falls back to the hard AI when no policy
+ * weights are loaded.
+ *
+ * @param outColor This is a out parameter. Pass a Color array (length>=1)
+ *                 in order to let us pass the return value by assigning
+ *                 outColor[0]. When the best card to play becomes a wild
+ *                 card, outColor[0] will become the following legal color
+ *                 to change. When the best card to play becomes an action
+ *                 or a number card, outColor[0] will become the player's
+ *                 best color.
+ * @return Index of the best card to play, in current player's hand.
+ *         Or a negative number that means no appropriate card to play.
+ */
+int AI::policyAI_bestCardIndex4NowPlayer(Color outColor[]) {
+    int i, size, idxBest;
+    float bestScore, score;
+    Color bestColor;
+    float features[Policy::FEATURE_COUNT];
+    float scores[Policy::OUTPUT_COUNT];
+    Policy* policy = Policy::getInstance();
+    Latency::Timer timer(Latency::POLICY_AI, uno->getDifficulty());
+
+    if (!policy->isLoaded()) {
+        return hardAI_bestCardIndex4NowPlayer(outColor);
+    } // if (!policy->isLoaded())
+
+    Policy::extract(uno, features);
+    policy->evaluate(features, 1, scores);
+    bestColor = RED;
+    for (i = BLUE; i <= YELLOW; ++i) {
+        if (scores[Policy::OUT_COLOR + i - 1]
+            > scores[Policy::OUT_COLOR + bestColor - 1]) {
+            bestColor = Color(i);
+        } // if (scores[Policy::OUT_COLOR + i - 1] > ...)
+    } // for (i = BLUE; i <= YELLOW; ++i)
+
+    idxBest = -1;
+    bestScore = 0.0f;
+    const std::vector<Card*>& hand = uno->getCurrPlayer()->getHandCards();
+    size = int(hand.size());
+    for (i = 0; i < size; ++i) {
+        if (uno->isLegalToPlay(hand.at(i))) {
+            score = scores[Policy::idOf(hand.at(i))];
+            if (idxBest < 0 || score > bestScore) {
+                idxBest = i;
+                bestScore = score;
+            } // if (idxBest < 0 || score > bestScore)
+        } // if (uno->isLegalToPlay(hand.at(i)))
+    } // for (i = 0; i < size; ++i)
+
+    outColor[0] = bestColor;
+    return idxBest;
+} // policyAI_bestCardIndex4NowPlayer(Color[])
+
+/**
+ * AI Strategies (Distilled). The same cost as the easy AI, but the
+ * priority order of card kinds is looked up from a table distilled from
+ * the anytime search AI's choices (see Distiller class and the
+ * generated include/Distilled.h file).
+ *
+ * @param outColor This is a out parameter. Pass a Color array (length>=1)
+ *                 in order to let us pass the return value by assigning
+ *                 outColor[0]. When the best card to play becomes a wild
+ *                 card, outColor[0] will become the following legal color
+ *                 to change. When the best card to play becomes an action
+ *                 or a number card, outColor[0] will become the player's
+ *                 best color.
+ * @return Index of the best card to play, in current player's hand.
+ *         Or a negative number that means no appropriate card to play.
+ */
+int AI::distilledAI_bestCardIndex4NowPlayer(Color outColor[]) {
+    Card* card;
+    Color bestColor;
+    int i, k, kind, cell, size, idxBest;
+    int idx[Distiller::KIND_COUNT];
+    Latency::Timer timer(Latency::DISTILLED_AI, uno->getDifficulty());
+
+    if (outColor == nullptr) {
+        throw "outColor[] cannot be nullptr";
+    } // if (outColor == nullptr)
+
+    const std::vector<Card*>& hand = uno->getCurrPlayer()->getHandCards();
+    size = int(hand.size());
+    if (size == 1) {
+        // Only one card remained. Play it when it's legal.
+        card = hand.at(0);
+        outColor[0] = card->color;
+        return uno->isLegalToPlay(card) ? 0 : -1;
+    } // if (size == 1)
+
+    // Index of any kind, in your best color if possible
+    bestColor = calcBestColor4NowPlayer();
+    for (k = 0; k < Distiller::KIND_COUNT; ++k) {
+        idx[k] = -1;
+    } // for (k = 0; k < Distiller::KIND_COUNT; ++k)
+
+    for (i = 0; i < size; ++i) {
+        card = hand.at(i);
+        if (uno->isLegalToPlay(card)) {
+            kind = Distiller::kindOf(card);
+            if (idx[kind] < 0 || card->color == bestColor) {
+                idx[kind] = i;
+            } // if (idx[kind] < 0 || card->color == bestColor)
+        } // if (uno->isLegalToPlay(card))
+    } // for (i = 0; i < size; ++i)
+
+    // Play the first legal kind in the distilled order
+    idxBest = -1;
+    cell = Distiller::cellOf(uno, bestColor);
+    for (k = 0; k < Distiller::KIND_COUNT && idxBest < 0; ++k) {
+        idxBest = idx[DISTILLED_ORDER[cell][k]];
+    } // for (k = 0; k < Distiller::KIND_COUNT && idxBest < 0; ++k)
+
+    outColor[0] = bestColor;
+    return idxBest;
+} // distilledAI_bestCardIndex4NowPlayer(Color[])
+
+/**
+ * Anytime AI Strategies. Start from the answer of the fixed strategies
+ * (7-0 rule or current difficulty), then try every legal action in many
+ * simulated games, until the time budget or the node budget (see
+ * Uno::setThinkTime(int) and Uno::setThinkNodes(int)) runs out. In each
+ * simulated game, the cards unknown to current player are redealt, and
+ * the rest of game is played by the fixed strategies. All actions are
+ * tried on the same redealt cards in each round, and an action replaces
+ * the answer of the fixed strategies only when it wins significantly more
+ * often than the latter one in these paired games. The time budget is
+ * also checked during each simulated game, so this function returns in
+ * time even under heavy CPU load, with the best answer found so far.
+ *
+ * @param outColor This is a out parameter. Pass a Color array (length>=1)
+ *                 in order to let us pass the return value by assigning
+ *                 outColor[0]. When the best card to play becomes a wild
+ *                 card, outColor[0] will become the following legal color
+ *                 to change. When the best card to play becomes an action
+ *                 or a number card, outColor[0] will become the player's
+ *                 best color.
+ * @return Index of the best card to play, in current player's hand.
+ *         Or a negative number that means no appropriate card to play.
+ */
+int AI::searchAI_bestCardIndex4NowPlayer(Color outColor[]) {
+    typedef std::chrono::steady_clock Clock;
+    struct Branch {
+        int index;
+        Color color;
+        int better, worse;
+    }; // Branch Struct
+
+    static const int MAX_TURNS = 200;
+    static const Color COLORS[] = { RED, BLUE, GREEN, YELLOW };
+    Card* card;
+    bool won, won0;
+    double score, bestScore;
+    Clock::time_point deadline;
+    unsigned long long key, seed;
+    std::vector<Branch> branches;
+    int i, k, n, me, size, best, idxBest, timeLimit, nodeLimit, winner[1];
+    Latency::Timer timer(Latency::SEARCH_AI, uno->getDifficulty());
+    Transposition* table = Transposition::getInstance();
+
+    deadline = Clock::now();
+    me = uno->getNow();
+    seed = uno->getStateHash();
+    timeLimit = uno->getThinkTime();
+    nodeLimit = uno->getThinkNodes();
+    deadline += std::chrono::microseconds(timeLimit * 1000LL * 15 / 16);
+    Uno root = *uno;
+    root.setThinkTime(0);
+    root.setThinkNodes(0);
+
+    // Answer of the fixed strategies
+    if (uno->isSevenZeroRule()) {
+        idxBest = sevenZeroAI_bestCardIndex4NowPlayer(outColor);
+    } // if (uno->isSevenZeroRule())
+    else if (uno->getDifficulty() == Uno::LV_EASY) {
+        idxBest = easyAI_bestCardIndex4NowPlayer(outColor);
+    } // else if (uno->getDifficulty() == Uno::LV_EASY)
+    else if (uno->getDifficulty() == Uno::LV_POLICY) {
+        idxBest = policyAI_bestCardIndex4NowPlayer(outColor);
+    } // else if (uno->getDifficulty() == Uno::LV_POLICY)
+    else {
+        idxBest = hardAI_bestCardIndex4NowPlayer(outColor);
+    } // else
+
+    // List all legal actions, the same cards only once
+    const std::vector<Card*>& hand = uno->getCurrPlayer()->getHandCards();
+    size = int(hand.size());
+    for (i = 0; i < size; ++i) {
+        card = hand.at(i);
+        if (!uno->isLegalToPlay(card) ||
+            std::find(hand.begin(), hand.begin() + i, card)
+            != hand.begin() + i) {
+            continue;
+        } // if (!uno->isLegalToPlay(card) || ...)
+
+        if (card->isWild() && size > 1) {
+            for (Color color : COLORS) {
+                branches.push_back(Branch{ i, color, 0, 0 });
+            } // for (Color color : COLORS)
+        } // if (card->isWild() && size > 1)
+        else {
+            branches.push_back(Branch{ i, NONE, 0, 0 });
+        } // else
+    } // for (i = 0; i < size; ++i)
+
+    branches.push_back(Branch{ -1, NONE, 0, 0 });
+    if ((timeLimit <= 0 && nodeLimit <= 0)
+        || branches.size() == 1 || (size == 1 && idxBest >= 0)) {
+        // No budget, nothing to choose, or we can win right now
+        return idxBest;
+    } // if ((timeLimit <= 0 && nodeLimit <= 0) || ...)
+
+    // Move the answer of the fixed strategies to the front
+    for (k = 0; k < int(branches.size()); ++k) {
+        Branch& b = branches[k];
+        if (idxBest < 0
+            ? b.index < 0
+            : b.index >= 0
+            && hand.at(b.index) == hand.at(idxBest)
+            && (b.color == NONE || b.color == outColor[0])) {
+            std::swap(branches[0], branches[k]);
+            break;
+        } // if (idxBest < 0 ? ... : ...)
+    } // for (k = 0; k < int(branches.size()); ++k)
+
+    // Simulate games branch by branch. In each round, all branches share
+    // the same redealt cards and the same random numbers, so every branch
+    // can be compared with the first one in pairs.
+    won0 = false;
+    for (n = 0; nodeLimit <= 0 || n < nodeLimit; ++n) {
+        if (timeLimit > 0 && Clock::now() >= deadline) {
+            break;
+        } // if (timeLimit > 0 && Clock::now() >= deadline)
+
+        k = n % int(branches.size());
+        Branch& b = branches[k];
+        Uno game = root;
+        game.setRandState(seed + n / branches.size() * 0x9e3779b97f4a7c15ULL);
+        game.redeal(me);
+        Simulator sim(&game);
+        if (b.index >= 0) {
+            sim.play(b.index, b.color);
+        } // if (b.index >= 0)
+        else {
+            sim.draw();
+        } // else
+
+        // Other searches may have played this game already
+        key = Transposition::keyOf(&game, sim.getStatus(), sim.getTurns());
+        if (!table->probe(key, winner)) {
+            // Play the rest of game by several turns at a time, and give up
+            // this game when the deadline has come
+            do {
+                sim.run(sim.getTurns() + 8);
+            } while (sim.getStatus() != Simulator::STAT_GAME_OVER
+                && sim.getTurns() < MAX_TURNS
+                && (timeLimit <= 0 || Clock::now() < deadline));
+            if (sim.getStatus() != Simulator::STAT_GAME_OVER
+                && sim.getTurns() < MAX_TURNS) {
+                break;
+            } // if (sim.getStatus() != Simulator::STAT_GAME_OVER && ...)
+
+            winner[0] = sim.getWinner();
+            table->store(key, winner[0], sim.getTurns());
+        } // if (!table->probe(key, winner))
+
+        won = winner[0] == me;
+        if (k == 0) {
+            won0 = won;
+        } // if (k == 0)
+        else if (won && !won0) {
+            ++b.better;
+        } // else if (won && !won0)
+        else if (!won && won0) {
+            ++b.worse;
+        } // else if (!won && won0)
+    } // for (n = 0; nodeLimit <= 0 || n < nodeLimit; ++n)
+
+    // Pick the branch which beats the first one most often. To avoid being
+    // fooled by luck, the lead must be significant (two-sigma sign test).
+    best = 0;
+    bestScore = 0.0;
+    for (k = 1; k < int(branches.size()); ++k) {
+        Branch& b = branches[k];
+        score = b.better - b.worse;
+        if (score > bestScore && score > 2.0 * std::sqrt(b.better + b.worse)) {
+            bestScore = score;
+            best = k;
+        } // if (score > bestScore && ...)
+    } // for (k = 1; k < int(branches.size()); ++k)
+
+    if (branches[best].color != NONE) {
+        outColor[0] = branches[best].color;
+    } // if (branches[best].color != NONE)
+
+    return branches[best].index;
+} // searchAI_bestCardIndex4NowPlayer(Color[])
+
 // E.O.F
\ No newline at end of file
@@ -0,0 +1,722 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include <sstream>
+#include <iostream>
+#include "include/Coordinator.h"
+#include "include/Checkpoint.h"
+#include "include/Simulator.h"
+#include "include/Scheduler.h"
+#include "include/Latency.h"
+#include "include/Player.h"
+#include "include/Arena.h"
+#include "include/Agent.h"
+#include "include/Stats.h"
+#include "include/Color.h"
+#include "include/Uno.h"
+
+/**
+ * Entrant kinds of the 7-0 AI and the distilled AI. Other kinds are
+ * Uno::LV_* values.
+ */
+static const int KIND_SEVEN_ZERO = -1;
+static const int KIND_DISTILLED = -2;
+
+/**
+ * Seats in 3-player and 4-player games.
+ */
+static const int SEATS[2][4] = {
+    { Player::YOU, Player::COM1, Player::COM3, -1 },
+    { Player::YOU, Player::COM1, Player::COM2, Player::COM3 }
+}; // SEATS[][]
+
+/**
+ * Get the agent of an entrant. Built-in agents are stateless, so all
+ * threads share the same instances.
+ *
+ * @param kind      Entrant kind, KIND_SEVEN_ZERO, KIND_DISTILLED or one of
+ *                  Uno::LV_*.
+ * @param thinkTime Time budget of anytime AI, or 0 if none.
+ * @return The agent of the entrant.
+ */
+static Agent* agentOf(int kind, int thinkTime) {
+    static AgentAdapter<SearchAgent> search;
+    static AgentAdapter<SevenZeroAgent> sevenZero;
+    static AgentAdapter<DistilledAgent> distilled;
+    static AgentAdapter<EasyAgent> easy;
+    static AgentAdapter<PolicyAgent> policy;
+    static AgentAdapter<HardAgent> hard;
+
+    if (thinkTime > 0) {
+        return &search;
+    } // if (thinkTime > 0)
+    else if (kind == KIND_SEVEN_ZERO) {
+        return &sevenZero;
+    } // else if (kind == KIND_SEVEN_ZERO)
+    else if (kind == KIND_DISTILLED) {
+        return &distilled;
+    } // else if (kind == KIND_DISTILLED)
+    else if (kind == Uno::LV_EASY) {
+        return &easy;
+    } // else if (kind == Uno::LV_EASY)
+    else if (kind == Uno::LV_POLICY) {
+        return &policy;
+    } // else if (kind == Uno::LV_POLICY)
+    else {
+        return &hard;
+    } // else
+} // agentOf(int, int)
+
+/**
+ * Constructor.
+ *
+ * @param threads How many threads to play games. Pass 0 to use all cores.
+ * @param seed    Base of random seeds.
+ */
+Arena::Arena(int threads, unsigned seed) {
+    if (threads <= 0) {
+        threads = int(std::thread::hardware_concurrency());
+    } // if (threads <= 0)
+
+    this->threads = threads > 0 ? threads : 1;
+    this->seed = seed;
+    forcePlay = true;
+    processes = 0;
+    checkpointSeconds = 60;
+} // Arena(int, unsigned) (Class Constructor)
+
+/**
+ * Add a seat. Add 3 or 4 seats before run(int, std::ostream&).
+ *
+ * @param spec Strategy of the seat, "easy", "hard", "7-0", "policy" or
+ *             "distilled", optionally followed by ":" and the time budget
+ *             of anytime AI in milli seconds (e.g. "hard:50").
+ * @return Whether the spec is recognized.
+ */
+bool Arena::addSeat(const std::string& spec) {
+    int i;
+    Entrant e;
+    std::string kind;
+    size_t colon = spec.find(':');
+
+    kind = spec.substr(0, colon);
+    e.name = spec;
+    e.thinkTime = colon == std::string::npos ? 0
+        : atoi(spec.c_str() + colon + 1);
+    if (kind == "easy") {
+        e.kind = Uno::LV_EASY;
+    } // if (kind == "easy")
+    else if (kind == "hard") {
+        e.kind = Uno::LV_HARD;
+    } // else if (kind == "hard")
+    else if (kind == "policy") {
+        e.kind = Uno::LV_POLICY;
+    } // else if (kind == "policy")
+    else if (kind == "7-0") {
+        e.kind = KIND_SEVEN_ZERO;
+    } // else if (kind == "7-0")
+    else if (kind == "distilled") {
+        e.kind = KIND_DISTILLED;
+    } // else if (kind == "distilled")
+    else {
+        return false;
+    } // else
+
+    if (e.thinkTime < 0 || lineup.size() >= 4) {
+        return false;
+    } // if (e.thinkTime < 0 || lineup.size() >= 4)
+
+    // The same specs share one entrant
+    for (i = 0; i < int(entrants.size()); ++i) {
+        if (entrants[i].name == spec) {
+            break;
+        } // if (entrants[i].name == spec)
+    } // for (i = 0; i < int(entrants.size()); ++i)
+
+    if (i == int(entrants.size())) {
+        entrants.push_back(e);
+    } // if (i == int(entrants.size()))
+
+    lineup.push_back(i);
+    return true;
+} // addSeat(const std::string&)
+
+/**
+ * Add a rule combination to play. When none is added, only the standard
+ * rules are played.
+ *
+ * @param name "std", "7-0", "stack" or "7-0+stack".
+ * @return Whether the name is recognized.
+ */
+bool Arena::addRules(const std::string& name) {
+    int rule;
+
+    for (rule = 0; rule < 4; ++rule) {
+        if (name == ruleName(rule)) {
+            rules.push_back(rule);
+            return true;
+        } // if (name == ruleName(rule))
+    } // for (rule = 0; rule < 4; ++rule)
+
+    return false;
+} // addRules(const std::string&)
+
+/**
+ * Set whether to play a drawn card at once when it is legal, under all
+ * rule combinations. Enabled by default, as it is in a new game.
+ *
+ * @param enabled Enable/Disable the force play rule.
+ */
+void Arena::setForcePlay(bool enabled) {
+    forcePlay = enabled;
+} // setForcePlay(bool)
+
+/**
+ * Set how many worker processes to play games. Each worker process
+ * plays its games in one thread. Ignored when worker processes are not
+ * supported (see Coordinator::isSupported()).
+ *
+ * @param processes How many worker processes, or 0 to play games by
+ *                  threads in this process (by default).
+ */
+void Arena::setProcesses(int processes) {
+    this->processes = processes > 0 ? processes : 0;
+} // setProcesses(int)
+
+/**
+ * Save checkpoints to the specified file, and resume from it if it was
+ * saved by a run with the same settings. The file is removed when the
+ * run is finished.
+ *
+ * @param path    Path of the checkpoint file.
+ * @param seconds Save a checkpoint at most once in this number of
+ *                seconds.
+ */
+void Arena::setCheckpoint(const std::string& path, int seconds) {
+    checkpoint = path;
+    checkpointSeconds = seconds > 0 ? seconds : 0;
+} // setCheckpoint(const std::string&, int)
+
+/**
+ * @param rule Rule combination, combined by RULE_* flags.
+ * @return Name of the rule combination.
+ */
+const char* Arena::ruleName(int rule) {
+    static const char* const NAMES[] = {
+        "std", "7-0", "stack", "7-0+stack"
+    }; // NAMES[]
+
+    return NAMES[rule & 3];
+} // ruleName(int)
+
+/**
+ * Add a tally to another tally.
+ *
+ * @param to   Out parameter. Add to this tally.
+ * @param from The tally to add.
+ */
+void Arena::add(Tally& to, const Tally& from) {
+    size_t i;
+
+    to.games += from.games;
+    to.unfinished += from.unfinished;
+    to.turns += from.turns;
+    for (i = 0; i < from.seats.size(); ++i) {
+        to.seats[i] += from.seats[i];
+        to.wins[i] += from.wins[i];
+    } // for (i = 0; i < from.seats.size(); ++i)
+
+    for (i = 0; i < from.pairs.size(); ++i) {
+        to.pairs[i] += from.pairs[i];
+        to.pairWins[i] += from.pairWins[i];
+    } // for (i = 0; i < from.pairs.size(); ++i)
+} // add(Tally&, const Tally&)
+
+/**
+ * Write a tally as binary data, to be read by load(std::istream&,
+ * Tally&) on the same machine.
+ *
+ * @param out   Output stream.
+ * @param tally The tally to write.
+ */
+void Arena::save(std::ostream& out, const Tally& tally) {
+    out.write((const char*)&tally.games, sizeof(tally.games));
+    out.write((const char*)&tally.unfinished, sizeof(tally.unfinished));
+    out.write((const char*)&tally.turns, sizeof(tally.turns));
+    out.write((const char*)tally.seats.data(),
+        tally.seats.size() * sizeof(long long));
+    out.write((const char*)tally.wins.data(),
+        tally.wins.size() * sizeof(long long));
+    out.write((const char*)tally.pairs.data(),
+        tally.pairs.size() * sizeof(long long));
+    out.write((const char*)tally.pairWins.data(),
+        tally.pairWins.size() * sizeof(long long));
+} // save(std::ostream&, const Tally&)
+
+/**
+ * Read a tally written by save(std::ostream&, const Tally&).
+ *
+ * @param in    Input stream.
+ * @param tally Out parameter. Pass an empty tally of the same size to
+ *              receive the tally.
+ * @return Whether the tally is read successfully.
+ */
+bool Arena::load(std::istream& in, Tally& tally) {
+    in.read((char*)&tally.games, sizeof(tally.games));
+    in.read((char*)&tally.unfinished, sizeof(tally.unfinished));
+    in.read((char*)&tally.turns, sizeof(tally.turns));
+    in.read((char*)tally.seats.data(),
+        tally.seats.size() * sizeof(long long));
+    in.read((char*)tally.wins.data(),
+        tally.wins.size() * sizeof(long long));
+    in.read((char*)tally.pairs.data(),
+        tally.pairs.size() * sizeof(long long));
+    in.read((char*)tally.pairWins.data(),
+        tally.pairWins.size() * sizeof(long long));
+
+    return !in.fail();
+} // load(std::istream&, Tally&)
+
+/**
+ * @param games How many games to play.
+ * @return Settings of a run, which must match when resuming from a
+ *         checkpoint.
+ */
+std::string Arena::describe(int games) {
+    size_t i;
+    std::ostringstream writer;
+
+    writer << "arena " << seed << " " << games << " " << SHARD_GAMES
+        << " " << forcePlay;
+    for (i = 0; i < lineup.size(); ++i) {
+        writer << " " << entrants[lineup[i]].name;
+    } // for (i = 0; i < lineup.size(); ++i)
+
+    for (i = 0; i < rules.size(); ++i) {
+        writer << " " << ruleName(rules[i]);
+    } // for (i = 0; i < rules.size(); ++i)
+
+    return writer.str();
+} // describe(int)
+
+/**
+ * Save a checkpoint.
+ *
+ * @param games How many games to play.
+ * @param done  How many shards are finished.
+ * @param total Merged tallies of finished shards, one for each rule
+ *              combination.
+ * @param stats Merged statistics of finished shards.
+ */
+void Arena::saveProgress(int games, int done, const std::vector<Tally>& total,
+                         Stats& stats) {
+    std::string settings = describe(games);
+    std::ostringstream writer;
+    unsigned length = unsigned(settings.size());
+
+    writer.write((const char*)&length, sizeof(length));
+    writer.write(settings.data(), settings.size());
+    writer.write((const char*)&done, sizeof(done));
+    for (const Tally& tally : total) {
+        save(writer, tally);
+    } // for (const Tally& tally : total)
+
+    stats.save(writer);
+    if (!Checkpoint::save(checkpoint, writer.str())) {
+        std::cerr << "Cannot save checkpoint: " << checkpoint << std::endl;
+    } // if (!Checkpoint::save(checkpoint, writer.str()))
+} // saveProgress(int, int, const std::vector<Tally>&, Stats&)
+
+/**
+ * Load the checkpoint saved by a run with the same settings.
+ *
+ * @param games How many games to play.
+ * @param total Out parameter. Pass empty tallies to receive the merged
+ *              tallies of finished shards.
+ * @param stats Out parameter. Pass an empty shard to receive the merged
+ *              statistics of finished shards.
+ * @return How many shards are finished, or 0 if there is no checkpoint
+ *         of the same settings.
+ */
+int Arena::loadProgress(int games, std::vector<Tally>& total, Stats& stats) {
+    int done;
+    bool ok;
+    unsigned length;
+    std::string data, settings = describe(games);
+
+    if (!Checkpoint::load(checkpoint, data)) {
+        return 0;
+    } // if (!Checkpoint::load(checkpoint, data))
+
+    std::istringstream reader(data);
+    std::vector<Tally> loaded(total);
+    Stats merged;
+    ok = reader.read((char*)&length, sizeof(length))
+        && length == settings.size();
+    if (ok) {
+        data.assign(length, '\0');
+        ok = reader.read(&data[0], length) && data == settings
+            && reader.read((char*)&done, sizeof(done));
+    } // if (ok)
+
+    for (Tally& tally : loaded) {
+        ok = ok && load(reader, tally);
+    } // for (Tally& tally : loaded)
+
+    if (!ok || !merged.load(reader)) {
+        return 0;
+    } // if (!ok || !merged.load(reader))
+
+    total.swap(loaded);
+    stats = merged;
+    return done;
+} // loadProgress(int, std::vector<Tally>&, Stats&)
+
+/**
+ * Play a game.
+ *
+ * @param g     Game number.
+ * @param tally Out parameter. Add the result to this tally.
+ * @param stats Out parameter. Record the game in this shard.
+ */
+void Arena::play(int g, std::vector<Tally>& tally, Stats& stats) {
+    int i, j, a, b, who, players, rotation, deal, rule;
+    int seatOf[4];
+
+    // Game g plays deal (g / players) with the seats rotated by
+    // (g % players), and deals take the rule combinations in turn
+    players = int(lineup.size());
+    rotation = g % players;
+    deal = g / players;
+    rule = deal % int(rules.size());
+    Tally& t = tally[rule];
+    Uno uno = Uno::newHeadlessInstance(seed + unsigned(deal));
+    uno.setPlayers(players);
+    uno.setForcePlay(forcePlay);
+    uno.setSevenZeroRule((rules[rule] & RULE_SEVEN_ZERO) != 0);
+    uno.setDraw2StackRule((rules[rule] & RULE_DRAW2_STACK) != 0);
+    for (i = 0; i < players; ++i) {
+        seatOf[SEATS[players == 4][i]] = lineup[(i + rotation) % players];
+    } // for (i = 0; i < players; ++i)
+
+    Simulator sim(&uno);
+    for (i = 0; i < players; ++i) {
+        const Entrant& e = entrants[seatOf[SEATS[players == 4][i]]];
+        sim.setAgent(SEATS[players == 4][i], agentOf(e.kind, e.thinkTime));
+    } // for (i = 0; i < players; ++i)
+
+    sim.start();
+    stats.begin(&uno);
+    while ((who = sim.getDecider()) >= 0 && sim.getTurns() < MAX_TURNS) {
+        // Difficulty and time budget also drive the shared decisions
+        // (wild colors, challenges and swap targets)
+        const Entrant& e = entrants[seatOf[who]];
+        uno.setDifficulty(e.kind < 0 ? Uno::LV_HARD : e.kind);
+        uno.setThinkTime(e.thinkTime);
+        sim.step();
+        stats.observe(&uno, sim.getPlays(), uno.getReshuffleCount());
+    } // while ((who = sim.getDecider()) >= 0 && ...)
+
+    stats.end(&uno, sim.getWinner(), sim.getTurns());
+
+    ++t.games;
+    t.turns += sim.getTurns();
+    for (i = 0; i < players; ++i) {
+        ++t.seats[seatOf[SEATS[players == 4][i]]];
+    } // for (i = 0; i < players; ++i)
+
+    who = sim.getWinner();
+    if (who < 0) {
+        ++t.unfinished;
+        return;
+    } // if (who < 0)
+
+    // The winner beats everyone else, except the same entrant
+    a = seatOf[who];
+    ++t.wins[a];
+    for (i = 0; i < players; ++i) {
+        b = seatOf[SEATS[players == 4][i]];
+        if (b != a) {
+            j = a * int(entrants.size()) + b;
+            ++t.pairs[j];
+            ++t.pairWins[j];
+            ++t.pairs[b * int(entrants.size()) + a];
+        } // if (b != a)
+    } // for (i = 0; i < players; ++i)
+} // play(int, std::vector<Tally>&, Stats&)
+
+/**
+ * Write a tally as JSON members.
+ *
+ * @param out   Output stream.
+ * @param tally The tally to write.
+ * @param elo   Whether to include Elo ratings.
+ */
+void Arena::write(std::ostream& out, const Tally& tally, bool elo) {
+    int i, j, k, n;
+    double p, q, z, mid, half, sum, info;
+    std::vector<double> gamma, next;
+
+    n = int(entrants.size());
+    out << "\"games\": " << tally.games
+        << ", \"unfinished\": " << tally.unfinished
+        << ", \"avgTurns\": " << (tally.games > 0
+            ? double(tally.turns) / tally.games : 0.0);
+    if (elo) {
+        // Fit Bradley-Terry strengths by the MM algorithm, with a virtual
+        // draw between each pair so that no strength becomes 0 or infinity
+        gamma.assign(n, 1.0);
+        next.resize(n);
+        for (k = 0; k < 1000; ++k) {
+            for (i = 0; i < n; ++i) {
+                p = 0.0;
+                q = 0.0;
+                for (j = 0; j < n; ++j) {
+                    if (j != i) {
+                        p += tally.pairWins[i * n + j] + 0.5;
+                        q += (tally.pairs[i * n + j] + 1.0)
+                            / (gamma[i] + gamma[j]);
+                    } // if (j != i)
+                } // for (j = 0; j < n; ++j)
+
+                next[i] = n > 1 ? p / q : 1.0;
+            } // for (i = 0; i < n; ++i)
+
+            // Average Elo rating is 0
+            sum = 0.0;
+            for (i = 0; i < n; ++i) {
+                sum += std::log(next[i]);
+            } // for (i = 0; i < n; ++i)
+
+            for (i = 0; i < n; ++i) {
+                gamma[i] = next[i] / std::exp(sum / n);
+            } // for (i = 0; i < n; ++i)
+        } // for (k = 0; k < 1000; ++k)
+    } // if (elo)
+
+    out << ", \"entrants\": [";
+    for (i = 0; i < n; ++i) {
+        // Wilson score interval of win rate
+        z = 1.96;
+        p = tally.seats[i] > 0 ? double(tally.wins[i]) / tally.seats[i] : 0.0;
+        q = double(tally.seats[i] > 0 ? tally.seats[i] : 1);
+        mid = (p + z * z / (2 * q)) / (1 + z * z / q);
+        half = z * std::sqrt(p * (1 - p) / q + z * z / (4 * q * q))
+            / (1 + z * z / q);
+        out << (i > 0 ? ", " : "")
+            << "{\"name\": \"" << entrants[i].name << "\""
+            << ", \"seatGames\": " << tally.seats[i]
+            << ", \"wins\": " << tally.wins[i]
+            << ", \"winRate\": " << p
+            << ", \"winRateLow\": " << (mid - half)
+            << ", \"winRateHigh\": " << (mid + half);
+        if (elo) {
+            // Standard error from the Fisher information
+            info = 0.0;
+            for (j = 0; j < n; ++j) {
+                if (j != i) {
+                    q = gamma[i] / (gamma[i] + gamma[j]);
+                    info += tally.pairs[i * n + j] * q * (1 - q);
+                } // if (j != i)
+            } // for (j = 0; j < n; ++j)
+
+            mid = 400.0 * std::log10(gamma[i]);
+            half = info > 0.0 ? z * 400.0 / std::log(10.0) / std::sqrt(info)
+                : 0.0;
+            out << ", \"elo\": " << mid
+                << ", \"eloLow\": " << (mid - half)
+                << ", \"eloHigh\": " << (mid + half);
+        } // if (elo)
+
+        out << "}";
+    } // for (i = 0; i < n; ++i)
+
+    out << "]";
+} // write(std::ostream&, const Tally&, bool)
+
+/**
+ * Play games and write the report as JSON.
+ *
+ * @param games How many games to play.
+ * @param out   Write the report to this stream.
+ * @return False if the number of seats is not 3 or 4.
+ */
+bool Arena::run(int games, std::ostream& out) {
+    int i, r, n, shards, done, block, first, last, begin, end;
+    double seconds;
+    Stats stats;
+    Tally resumed;
+    std::vector<Tally> total;
+    std::chrono::steady_clock::time_point start, lastSave;
+
+    if (lineup.size() < 3 || lineup.size() > 4) {
+        return false;
+    } // if (lineup.size() < 3 || lineup.size() > 4)
+
+    if (rules.empty()) {
+        rules.push_back(0);
+    } // if (rules.empty())
+
+    Latency::reset();
+    n = int(entrants.size());
+    Tally empty = { 0LL, 0LL, 0LL,
+        std::vector<long long>(n, 0LL), std::vector<long long>(n, 0LL),
+        std::vector<long long>(n * n, 0LL), std::vector<long long>(n * n, 0LL)
+    }; // Tally empty
+    total.assign(rules.size(), empty);
+    shards = (games + SHARD_GAMES - 1) / SHARD_GAMES;
+    done = checkpoint.empty() ? 0 : loadProgress(games, total, stats);
+    resumed = empty;
+    for (r = 0; r < int(rules.size()); ++r) {
+        add(resumed, total[r]);
+    } // for (r = 0; r < int(rules.size()); ++r)
+
+    start = lastSave = std::chrono::steady_clock::now();
+    auto due = [&] {
+        std::chrono::steady_clock::time_point now;
+
+        now = std::chrono::steady_clock::now();
+        if (now - lastSave < std::chrono::seconds(checkpointSeconds)) {
+            return false;
+        } // if (now - lastSave < std::chrono::seconds(...))
+
+        lastSave = now;
+        return true;
+    }; // due
+
+    if (processes > 0 && Coordinator::isSupported()) {
+        // Play shards in worker processes, and merge them in order
+        Coordinator coordinator(processes);
+        auto work = [&](int s) {
+            int g, k;
+            Stats shard;
+            std::vector<Tally> mine(rules.size(), empty);
+            std::ostringstream writer;
+
+            s += done;
+            for (g = s * SHARD_GAMES; g < games && g < (s + 1) * SHARD_GAMES;
+                 ++g) {
+                play(g, mine, shard);
+            } // for (g = s * SHARD_GAMES; g < games && ...; ++g)
+
+            for (k = 0; k < int(rules.size()); ++k) {
+                save(writer, mine[k]);
+            } // for (k = 0; k < int(rules.size()); ++k)
+
+            shard.save(writer);
+            return writer.str();
+        }; // work
+        auto merge = [&](int s, const std::string& data) {
+            int k;
+            Stats shard;
+            Tally part = empty;
+            std::istringstream reader(data);
+
+            for (k = 0; k < int(rules.size()); ++k) {
+                load(reader, part);
+                add(total[k], part);
+            } // for (k = 0; k < int(rules.size()); ++k)
+
+            shard.load(reader);
+            stats.merge(shard);
+            if (!checkpoint.empty() && done + s + 1 < shards && due()) {
+                saveProgress(games, done + s + 1, total, stats);
+            } // if (!checkpoint.empty() && done + s + 1 < shards && due())
+        }; // merge
+
+        if (!coordinator.run(shards - done, work, merge)) {
+            return false;
+        } // if (!coordinator.run(shards - done, work, merge))
+    } // if (processes > 0 && Coordinator::isSupported())
+    else {
+        // Play shards in blocks by threads, and save a checkpoint after a
+        // block when it is due
+        Scheduler scheduler(threads);
+        block = checkpoint.empty() ? shards : scheduler.getThreads() * 4;
+        for (first = done; first < shards; first = last) {
+            last = shards - first > block ? first + block : shards;
+            begin = first * SHARD_GAMES;
+            end = last * SHARD_GAMES < games ? last * SHARD_GAMES : games;
+            std::vector<std::vector<Tally>> mine(scheduler.getThreads(),
+                std::vector<Tally>(rules.size(), empty));
+            std::vector<Stats> parts(scheduler.getThreads());
+            scheduler.run(end - begin, 0, [&](int worker, int g) {
+                play(begin + g, mine[worker], parts[worker]);
+            }); // scheduler.run()
+
+            // Merge the results of all threads
+            for (i = 0; i < int(mine.size()); ++i) {
+                stats.merge(parts[i]);
+                for (r = 0; r < int(rules.size()); ++r) {
+                    add(total[r], mine[i][r]);
+                } // for (r = 0; r < int(rules.size()); ++r)
+            } // for (i = 0; i < int(mine.size()); ++i)
+
+            if (!checkpoint.empty() && last < shards && due()) {
+                saveProgress(games, last, total, stats);
+            } // if (!checkpoint.empty() && last < shards && due())
+        } // for (first = done; first < shards; first = last)
+    } // else
+
+    if (!checkpoint.empty()) {
+        Checkpoint::remove(checkpoint);
+    } // if (!checkpoint.empty())
+
+    seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    seconds = seconds > 1e-9 ? seconds : 1e-9;
+
+    // Sum up all rule combinations
+    Tally all = empty;
+    for (r = 0; r < int(rules.size()); ++r) {
+        add(all, total[r]);
+    } // for (r = 0; r < int(rules.size()); ++r)
+
+    out << "{\"seed\": " << seed
+        << ", \"players\": " << lineup.size()
+        << ", \"forcePlay\": " << (forcePlay ? "true" : "false")
+        << ", \"seats\": [";
+    for (i = 0; i < int(lineup.size()); ++i) {
+        out << (i > 0 ? ", " : "") << "\"" << entrants[lineup[i]].name << "\"";
+    } // for (i = 0; i < int(lineup.size()); ++i)
+
+    out << "], ";
+    write(out, all, true);
+    out << ", \"rules\": [";
+    for (r = 0; r < int(rules.size()); ++r) {
+        out << (r > 0 ? ", " : "")
+            << "{\"name\": \"" << ruleName(rules[r]) << "\", ";
+        write(out, total[r], false);
+        out << "}";
+    } // for (r = 0; r < int(rules.size()); ++r)
+
+    out << "], \"stats\": ";
+    stats.write(out);
+
+    // How this run is played, which does not change the results above.
+    // Throughput is of this run only, without the games resumed from the
+    // checkpoint, and so are the latency histograms.
+    out << ", \"run\": {\"threads\": " << threads
+        << ", \"processes\": " << processes
+        << ", \"resumedGames\": " << resumed.games
+        << ", \"seconds\": " << seconds
+        << ", \"gamesPerSecond\": " << ((all.games - resumed.games) / seconds)
+        << ", \"turnsPerSecond\": " << ((all.turns - resumed.turns) / seconds)
+        << ", \"latency\": ";
+    Latency::dump(out);
+    out << "}}" << std::endl;
+    return true;
+} // run(int, std::ostream&)
+
+// E.O.F
\ No newline at end of file
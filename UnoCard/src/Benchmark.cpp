@@ -0,0 +1,551 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <ostream>
+#include "include/Simulator.h"
+#include "include/Scheduler.h"
+#include "include/Benchmark.h"
+#include "include/Policy.h"
+#include "include/Player.h"
+#include "include/Agent.h"
+#include "include/Color.h"
+#include "include/Card.h"
+#include "include/Uno.h"
+#include "include/AI.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif // _WIN32
+
+/**
+ * How many heap allocations have been made. Only counted in the
+ * UnoCardBench program, which replaces the global operator new.
+ */
+std::atomic<long long> Benchmark::allocations(0LL);
+
+/**
+ * How many heap blocks have been freed. Only counted in the UnoCardBench
+ * program, which replaces the global operator delete.
+ */
+std::atomic<long long> Benchmark::frees(0LL);
+
+/**
+ * @return Peak resident memory of this process, in KiB.
+ */
+static long long peakMemory() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return (long long)(counters.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    // Bytes on macOS, KiB on Linux
+    return (long long)usage.ru_maxrss / 1024;
+#else
+    return (long long)usage.ru_maxrss;
+#endif // __APPLE__
+#endif // _WIN32
+} // peakMemory()
+
+/**
+ * Constructor.
+ *
+ * @param seed    Master seed of fixed states.
+ * @param seconds Minimum measuring time of each benchmark, in seconds.
+ */
+Benchmark::Benchmark(unsigned seed, double seconds) {
+    this->seed = seed;
+    this->seconds = seconds;
+    sink = 0LL;
+} // Benchmark(unsigned, double) (Class Constructor)
+
+/**
+ * Generate the fixed states. Do nothing if already generated.
+ */
+void Benchmark::prepare() {
+    int i, k, now;
+    Card* card;
+    unsigned s;
+    DefaultAgent agent;
+
+    if (!plays.empty()) {
+        return;
+    } // if (!plays.empty())
+
+    // Each game provides at most one state of each kind
+    for (s = seed; int(plays.size()) < FIXTURES
+        || int(reshuffles.size()) < FIXTURES; ++s) {
+        Uno uno = Uno::newHeadlessInstance(s);
+        uno.setPlayers(4);
+        uno.setDifficulty(Uno::LV_HARD);
+        uno.setSevenZeroRule(true);
+        Simulator sim(&uno);
+        sim.start();
+
+        // Take a play state at different stages of different games
+        k = int(s * 7U % 40U);
+        while (sim.getStatus() != Simulator::STAT_GAME_OVER
+            && sim.getTurns() < 1000) {
+            now = sim.getStatus();
+            if (now < Player::YOU || now > Player::COM3) {
+                sim.step(agent);
+                continue;
+            } // if (now < Player::YOU || now > Player::COM3)
+
+            if (sim.getTurns() >= k && int(plays.size()) < FIXTURES
+                && uno.legalCardsCount4NowPlayer() > 0) {
+                const std::vector<Card*>& hand = uno.getCurrPlayer()
+                    ->getHandCards();
+                for (i = 0; !uno.isLegalToPlay(hand[i]); ++i) {
+                    // Find the first legal card
+                } // for (i = 0; !uno.isLegalToPlay(hand[i]); ++i)
+
+                card = hand[i];
+                plays.push_back(uno);
+                playIndexes.push_back(i);
+                playColors.push_back(card->isWild() ? RED : card->color);
+                k = 1000;
+            } // if (sim.getTurns() >= k && ...)
+
+            if (uno.getDeckCount() == 1 && int(reshuffles.size()) < FIXTURES
+                && uno.getCurrPlayer()->getHandSize() < Uno::MAX_HOLD_CARDS) {
+                reshuffles.push_back(uno);
+                break;
+            } // if (uno.getDeckCount() == 1 && ...)
+
+            sim.step(agent);
+        } // while (sim.getStatus() != Simulator::STAT_GAME_OVER && ...)
+    } // for (s = seed; int(plays.size()) < FIXTURES || ...; ++s)
+} // prepare()
+
+/**
+ * Call a primitive on each state in turn, until the minimum measuring
+ * time is reached.
+ *
+ * @param states  The states.
+ * @param restore Whether to copy a fresh state before each call.
+ * @param op      The primitive, called as op(Uno& uno, int index),
+ *                where index is the index of the state.
+ * @return Nano seconds per call, including the cost of copying.
+ */
+template<class F>
+double Benchmark::measure(const std::vector<Uno>& states, bool restore,
+                          F op) {
+    int i, n;
+    long long calls;
+    std::chrono::duration<double, std::nano> elapsed;
+    std::chrono::steady_clock::time_point start;
+
+    work = states;
+    n = int(states.size());
+    calls = 0LL;
+    start = std::chrono::steady_clock::now();
+    do {
+        for (i = 0; i < n; ++i) {
+            if (restore) {
+                work[i] = states[i];
+            } // if (restore)
+
+            sink += op(work[i], i);
+        } // for (i = 0; i < n; ++i)
+
+        calls += n;
+        elapsed = std::chrono::steady_clock::now() - start;
+    } while (elapsed.count() < seconds * 1e9);
+
+    return elapsed.count() / double(calls);
+} // measure(const std::vector<Uno>&, bool, F)
+
+/**
+ * Run micro benchmarks, and write nano seconds per call of each
+ * primitive as JSON. The policy network (see Policy class) is also
+ * measured in inferences per second, one by one and in batches.
+ *
+ * @param out Output stream.
+ */
+void Benchmark::micro(std::ostream& out) {
+    int i, batched;
+    double copy;
+    Policy policy;
+    std::vector<const char*> names;
+    std::vector<double> nanos;
+    std::vector<float> features, scores;
+    static const int BATCH = 256;
+
+    prepare();
+
+    // Cost of copying a state, subtracted from changing primitives
+    copy = measure(plays, true, [](Uno&, int) {
+        return 0;
+    }); // copy = measure()
+
+    names.push_back("Uno::start");
+    nanos.push_back(measure(plays, true, [](Uno& uno, int) {
+        uno.start();
+        return uno.getDeckCount();
+    }) - copy); // nanos.push_back()
+
+    names.push_back("Uno::draw");
+    nanos.push_back(measure(plays, true, [](Uno& uno, int) {
+        return uno.draw(uno.getNow(), /* force */ true);
+    }) - copy); // nanos.push_back()
+
+    names.push_back("Uno::draw (reshuffle)");
+    nanos.push_back(measure(reshuffles, true, [](Uno& uno, int) {
+        return uno.draw(uno.getNow(), /* force */ true);
+    }) - copy); // nanos.push_back()
+
+    names.push_back("Uno::play");
+    nanos.push_back(measure(plays, true, [this](Uno& uno, int k) {
+        return uno.play(uno.getNow(), playIndexes[k], playColors[k])
+            != nullptr ? 1 : 0;
+    }) - copy); // nanos.push_back()
+
+    names.push_back("Uno::isLegalToPlay");
+    nanos.push_back(measure(plays, false, [](Uno& uno, int k) {
+        const std::vector<Card*>& hand = uno.getCurrPlayer()->getHandCards();
+        return uno.isLegalToPlay(hand[k % hand.size()]) ? 1 : 0;
+    })); // nanos.push_back()
+
+    names.push_back("Uno::legalCardsCount4NowPlayer");
+    nanos.push_back(measure(plays, false, [](Uno& uno, int) {
+        return uno.legalCardsCount4NowPlayer();
+    })); // nanos.push_back()
+
+    names.push_back("Uno::swap");
+    nanos.push_back(measure(plays, true, [](Uno& uno, int) {
+        uno.swap(uno.getNow(), uno.getNext());
+        return uno.getCurrPlayer()->getHandSize();
+    }) - copy); // nanos.push_back()
+
+    names.push_back("Uno::cycle");
+    nanos.push_back(measure(plays, true, [](Uno& uno, int) {
+        uno.cycle();
+        return uno.getCurrPlayer()->getHandSize();
+    }) - copy); // nanos.push_back()
+
+    names.push_back("Player::sort");
+    nanos.push_back(measure(plays, true, [](Uno& uno, int) {
+        // Hand cards of AI players are not sorted
+        uno.getPlayer(Player::COM1)->sort();
+        return uno.getPlayer(Player::COM1)->getHandSize();
+    }) - copy); // nanos.push_back()
+
+    names.push_back("Player::getHandScore");
+    nanos.push_back(measure(plays, false, [](Uno& uno, int) {
+        return uno.getCurrPlayer()->getHandScore();
+    })); // nanos.push_back()
+
+    names.push_back("AI::easyAI_bestCardIndex4NowPlayer");
+    nanos.push_back(measure(plays, false, [](Uno& uno, int) {
+        Color color[1];
+        return AI(&uno).easyAI_bestCardIndex4NowPlayer(color);
+    })); // nanos.push_back()
+
+    names.push_back("AI::hardAI_bestCardIndex4NowPlayer");
+    nanos.push_back(measure(plays, false, [](Uno& uno, int) {
+        Color color[1];
+        return AI(&uno).hardAI_bestCardIndex4NowPlayer(color);
+    })); // nanos.push_back()
+
+    names.push_back("AI::sevenZeroAI_bestCardIndex4NowPlayer");
+    nanos.push_back(measure(plays, false, [](Uno& uno, int) {
+        Color color[1];
+        return AI(&uno).sevenZeroAI_bestCardIndex4NowPlayer(color);
+    })); // nanos.push_back()
+
+    // The network with 128 hidden units, on the features of the fixed
+    // states, one by one and in batches. Results are per inference.
+    policy.randomize(128, seed);
+    features.resize(BATCH * Policy::FEATURE_COUNT);
+    scores.resize(BATCH * Policy::OUTPUT_COUNT);
+    for (i = 0; i < BATCH; ++i) {
+        Policy::extract(&plays[i % plays.size()],
+                        &features[i * Policy::FEATURE_COUNT]);
+    } // for (i = 0; i < BATCH; ++i)
+
+    names.push_back("Policy::evaluate");
+    nanos.push_back(measure(plays, false, [&](Uno&, int k) {
+        policy.evaluate(&features[k * Policy::FEATURE_COUNT], 1,
+                        scores.data());
+        return scores[0] > 0.0f ? 1 : 0;
+    })); // nanos.push_back()
+
+    names.push_back("Policy::evaluate (batch)");
+    batched = int(names.size()) - 1;
+    nanos.push_back(measure(plays, false, [&](Uno&, int) {
+        policy.evaluate(features.data(), BATCH, scores.data());
+        return scores[0] > 0.0f ? 1 : 0;
+    }) / BATCH); // nanos.push_back()
+
+    out << "{\"seed\": " << seed
+        << ", \"fixtures\": " << FIXTURES
+        << ", \"copyNanos\": " << copy
+        << ", \"results\": [";
+    for (i = 0; i < int(names.size()); ++i) {
+        // Changing primitives may be cheaper than the noise of copying
+        out << (i > 0 ? ",\n    " : "\n    ")
+            << "{\"name\": \"" << names[i] << "\""
+            << ", \"nanosPerCall\": " << (nanos[i] > 0.0 ? nanos[i] : 0.0);
+        if (i >= batched - 1) {
+            // Per inference of the policy network
+            out << ", \"inferencesPerSecond\": "
+                << (nanos[i] > 0.0 ? 1e9 / nanos[i] : 0.0);
+        } // if (i >= batched - 1)
+
+        out << "}";
+    } // for (i = 0; i < int(names.size()); ++i)
+
+    out << "\n]}" << std::endl;
+} // micro(std::ostream&)
+
+/**
+ * Run macro benchmarks, and write the results as JSON.
+ *
+ * @param games How many games to play with each combination.
+ * @param out   Output stream.
+ */
+void Benchmark::macro(int games, std::ostream& out) {
+    long long allocs;
+    double elapsed;
+    int i, j, level, pass, rules;
+    std::vector<long long> turns;
+    std::chrono::steady_clock::time_point start;
+    Scheduler single(1), all(0);
+    Scheduler* schedulers[2] = { &single, &all };
+    static const char* LEVELS[] = { "easy", "hard", "policy" };
+
+    out << "{\"seed\": " << seed
+        << ", \"games\": " << games
+        << ", \"cores\": " << all.getThreads()
+        << ", \"results\": [";
+    for (i = 0; i < 48; ++i) {
+        // Combination i: bit 0 ~ 3 are 4 players, no force play, 7-0 rule
+        // and +2 stack rule, and i / 16 is the difficulty
+        rules = i % 16;
+        level = i / 16;
+        for (pass = 0; pass < 2; ++pass) {
+            Scheduler& scheduler = *schedulers[pass];
+            turns.assign(scheduler.getThreads(), 0LL);
+            allocs = allocations.load();
+            start = std::chrono::steady_clock::now();
+            scheduler.run(games, 0, [&](int worker, int g) {
+                DefaultAgent agent;
+                Uno uno = Uno::newHeadlessInstance(seed + unsigned(g));
+                uno.setPlayers((rules & 1) != 0 ? 4 : 3);
+                uno.setForcePlay((rules & 2) == 0);
+                uno.setSevenZeroRule((rules & 4) != 0);
+                uno.setDraw2StackRule((rules & 8) != 0);
+                uno.setDifficulty(level);
+                Simulator sim(&uno);
+                sim.start();
+                sim.run(1000, agent);
+                turns[worker] += sim.getTurns();
+            }); // scheduler.run()
+
+            elapsed = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+            elapsed = elapsed > 1e-9 ? elapsed : 1e-9;
+            allocs = allocations.load() - allocs;
+            for (j = 1; j < scheduler.getThreads(); ++j) {
+                turns[0] += turns[j];
+            } // for (j = 1; j < scheduler.getThreads(); ++j)
+
+            out << (i + pass > 0 ? ",\n    " : "\n    ")
+                << "{\"players\": " << ((rules & 1) != 0 ? 4 : 3)
+                << ", \"forcePlay\": "
+                << ((rules & 2) == 0 ? "true" : "false")
+                << ", \"sevenZeroRule\": "
+                << ((rules & 4) != 0 ? "true" : "false")
+                << ", \"draw2StackRule\": "
+                << ((rules & 8) != 0 ? "true" : "false")
+                << ", \"difficulty\": \"" << LEVELS[level] << "\""
+                << ", \"threads\": " << scheduler.getThreads()
+                << ", \"gamesPerSecond\": " << (games / elapsed)
+                << ", \"turnsPerSecond\": " << (turns[0] / elapsed)
+                << ", \"allocationsPerGame\": "
+                << (double(allocs) / games) << "}";
+        } // for (pass = 0; pass < 2; ++pass)
+    } // for (i = 0; i < 48; ++i)
+
+    out << "\n], \"peakMemoryKiB\": " << peakMemory() << "}" << std::endl;
+} // macro(int, std::ostream&)
+
+/**
+ * Run heap instrumentation, and write allocations and frees per game
+ * (after setup), per action and per engine entry point as JSON.
+ *
+ * @param games How many games to play with each combination.
+ * @param out   Output stream.
+ * @return Whether every game performs zero allocations after setup.
+ */
+bool Benchmark::heap(int games, std::ostream& out) {
+    Color color[1];
+    bool steady;
+    int i, f, g, index, level, pass, rules;
+    long long mark, markFree, action, game, gameFree, actions;
+    long long setup, setupFree, total, totalFree, maxGame, maxAction;
+    long long calls[9], allocs[9], freed[9];
+    DefaultAgent agent;
+    static const char* LEVELS[] = { "easy", "hard", "policy" };
+    static const char* FUNCTIONS[] = {
+        "Agent::bestCardIndex", "Agent::bestColor",
+        "Agent::needToChallenge", "Agent::swapTarget",
+        "Simulator::play", "Simulator::draw", "Simulator::selectColor",
+        "Simulator::decideChallenge", "Simulator::swapWith"
+    }; // FUNCTIONS[]
+
+    // Charge the allocations and frees since the last mark to the
+    // specified entry point, and to the current action
+    mark = markFree = action = 0LL;
+    auto tally = [&](int f) {
+        long long a = allocations.load() - mark;
+        long long b = frees.load() - markFree;
+
+        ++calls[f];
+        allocs[f] += a;
+        freed[f] += b;
+        action += a;
+        mark += a;
+        markFree += b;
+    }; // tally()
+
+    steady = true;
+    out << "{\"seed\": " << seed
+        << ", \"games\": " << games
+        << ", \"results\": [";
+    for (i = 0; i < 48; ++i) {
+        // Combination i: bit 0 ~ 3 are 4 players, no force play, 7-0 rule
+        // and +2 stack rule, and i / 16 is the difficulty
+        rules = i % 16;
+        level = i / 16;
+        for (pass = 0; pass < 2; ++pass) {
+            // Only pass 1 is counted. Pass 0 warms up lazy initializations,
+            // e.g. Coverage sites registered in debug builds.
+            actions = setup = setupFree = total = totalFree = 0LL;
+            maxGame = maxAction = 0LL;
+            for (f = 0; f < 9; ++f) {
+                calls[f] = allocs[f] = freed[f] = 0LL;
+            } // for (f = 0; f < 9; ++f)
+
+            for (g = 0; g < games; ++g) {
+                mark = allocations.load();
+                markFree = frees.load();
+                Uno uno = Uno::newHeadlessInstance(seed + unsigned(g));
+                uno.setPlayers((rules & 1) != 0 ? 4 : 3);
+                uno.setForcePlay((rules & 2) == 0);
+                uno.setSevenZeroRule((rules & 4) != 0);
+                uno.setDraw2StackRule((rules & 8) != 0);
+                uno.setDifficulty(level);
+                Simulator sim(&uno);
+                sim.start();
+                setup += allocations.load() - mark;
+                setupFree += frees.load() - markFree;
+
+                // Steady state, everything after setup
+                game = 0LL;
+                gameFree = frees.load();
+                while (sim.getStatus() != Simulator::STAT_GAME_OVER
+                    && sim.getTurns() < 1000) {
+                    mark = allocations.load();
+                    markFree = frees.load();
+                    action = 0LL;
+                    switch (sim.getStatus()) {
+                    case Simulator::STAT_WILD_COLOR:
+                        color[0] = agent.bestColor(&uno);
+                        tally(1);
+                        sim.selectColor(color[0]);
+                        tally(6);
+                        break; // case Simulator::STAT_WILD_COLOR
+
+                    case Simulator::STAT_DOUBT_WILD4:
+                        index = agent.needToChallenge(&uno) ? 1 : 0;
+                        tally(2);
+                        sim.decideChallenge(index != 0);
+                        tally(7);
+                        break; // case Simulator::STAT_DOUBT_WILD4
+
+                    case Simulator::STAT_SEVEN_TARGET:
+                        index = agent.swapTarget(&uno);
+                        tally(3);
+                        sim.swapWith(index);
+                        tally(8);
+                        break; // case Simulator::STAT_SEVEN_TARGET
+
+                    default:
+                        index = agent.bestCardIndex(&uno, color);
+                        tally(0);
+                        if (index >= 0) {
+                            sim.play(index, color[0]);
+                            tally(4);
+                        } // if (index >= 0)
+                        else {
+                            sim.draw();
+                            tally(5);
+                        } // else
+                        break; // default
+                    } // switch (sim.getStatus())
+
+                    ++actions;
+                    game += action;
+                    maxAction = action > maxAction ? action : maxAction;
+                } // while (sim.getStatus() != Simulator::STAT_GAME_OVER && ...)
+
+                total += game;
+                totalFree += frees.load() - gameFree;
+                maxGame = game > maxGame ? game : maxGame;
+            } // for (g = 0; g < games; ++g)
+        } // for (pass = 0; pass < 2; ++pass)
+
+        steady = steady && maxGame == 0LL;
+        actions = actions > 0LL ? actions : 1LL;
+        out << (i > 0 ? ",\n    " : "\n    ")
+            << "{\"players\": " << ((rules & 1) != 0 ? 4 : 3)
+            << ", \"forcePlay\": " << ((rules & 2) == 0 ? "true" : "false")
+            << ", \"sevenZeroRule\": "
+            << ((rules & 4) != 0 ? "true" : "false")
+            << ", \"draw2StackRule\": "
+            << ((rules & 8) != 0 ? "true" : "false")
+            << ", \"difficulty\": \"" << LEVELS[level] << "\""
+            << ", \"setupAllocationsPerGame\": " << (double(setup) / games)
+            << ", \"setupFreesPerGame\": " << (double(setupFree) / games)
+            << ", \"allocationsPerGame\": " << (double(total) / games)
+            << ", \"freesPerGame\": " << (double(totalFree) / games)
+            << ", \"maxAllocationsPerGame\": " << maxGame
+            << ", \"allocationsPerAction\": "
+            << (double(total) / actions)
+            << ", \"maxAllocationsPerAction\": " << maxAction
+            << ", \"functions\": [";
+        for (f = 0; f < 9; ++f) {
+            out << (f > 0 ? ", " : "")
+                << "{\"name\": \"" << FUNCTIONS[f] << "\""
+                << ", \"calls\": " << calls[f]
+                << ", \"allocations\": " << allocs[f]
+                << ", \"frees\": " << freed[f] << "}";
+        } // for (f = 0; f < 9; ++f)
+
+        out << "]}";
+    } // for (i = 0; i < 48; ++i)
+
+    out << "\n], \"steadyState\": " << (steady ? "true" : "false")
+        << "}" << std::endl;
+    return steady;
+} // heap(int, std::ostream&)
+
+// E.O.F
\ No newline at end of file
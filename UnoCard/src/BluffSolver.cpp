@@ -0,0 +1,379 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include "include/BluffSolver.h"
+#include "include/Simulator.h"
+#include "include/Scheduler.h"
+#include "include/Content.h"
+#include "include/Player.h"
+#include "include/Agent.h"
+#include "include/Color.h"
+#include "include/Card.h"
+#include "include/Uno.h"
+#include "include/AI.h"
+
+/**
+ * Whether the current thread is measuring the chances, see isMeasuring().
+ */
+static thread_local bool tMeasuring = false;
+
+/**
+ * Typical hand size in each bucket, used by the payoffs.
+ */
+static const double BUCKET_SIZES[BluffSolver::SIZE_BUCKETS] = {
+    1.0, 2.0, 3.0, 4.5, 7.0, 11.0
+}; // BUCKET_SIZES[]
+
+/**
+ * Payoff of drawing cards.
+ *
+ * @param size  Hand size of the player who draws.
+ * @param count How many cards to draw.
+ * @return How much the hand size grows, ln((size + drawn) / size), where
+ *         drawn is limited by Uno::MAX_HOLD_CARDS.
+ */
+static double cost(double size, int count) {
+    double drawn = Uno::MAX_HOLD_CARDS - size;
+
+    drawn = drawn < count ? drawn : count;
+    drawn = drawn > 0.0 ? drawn : 0.0;
+    return std::log((size + drawn) / size);
+} // cost(double, int)
+
+/**
+ * Regret matching: strategy of a two-action information set.
+ *
+ * @param regret Cumulative regrets of both actions.
+ * @return Probability of action 1.
+ */
+static double match(const double regret[]) {
+    double sum = regret[0] + regret[1];
+
+    return sum > 0.0 ? regret[1] / sum : 0.5;
+} // match(const double[])
+
+/**
+ * @param size Hand size.
+ * @return Bucket of the hand size (0 ~ SIZE_BUCKETS - 1): 1, 2, 3,
+ *         4-5, 6-8, 9+ cards.
+ */
+int BluffSolver::bucketOf(int size) {
+    return size <= 3 ? (size > 1 ? size - 1 : 0)
+        : size <= 5 ? 3 : size <= 8 ? 4 : 5;
+} // bucketOf(int)
+
+/**
+ * @param sameColor True when the [wild +4] player changes the legal
+ *                  color to the same color, which shows that it holds
+ *                  this color.
+ * @param weakColor True when the previous color is the weak color of
+ *                  the [wild +4] player, i.e. it had to draw a card in
+ *                  this color before.
+ * @return EVIDENCE_STRONG, EVIDENCE_WEAK or EVIDENCE_NONE.
+ */
+int BluffSolver::evidenceOf(bool sameColor, bool weakColor) {
+    return sameColor ? EVIDENCE_STRONG
+        : weakColor ? EVIDENCE_WEAK : EVIDENCE_NONE;
+} // evidenceOf(bool, bool)
+
+/**
+ * Sample a mixed strategy in O(1), without changing the Uno runtime.
+ * The same decision in the same game state gets the same answer, so
+ * simulated games stay reproducible.
+ *
+ * @param chance Probability of true, in 1/255.
+ * @param uno    Provide the Uno runtime.
+ * @param salt   Tell different decisions in the same game state.
+ * @return True with the specified probability.
+ */
+bool BluffSolver::sample(int chance, Uno* uno, int salt) {
+    unsigned long long x;
+
+    // SplitMix64 finalizer over our random number generator
+    x = uno->getRandState() + (salt + 1) * 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return int((x >> 32) % 255ULL) < chance;
+} // sample(int, Uno*, int)
+
+/**
+ * @return True when the calling thread is measuring the chances. AI
+ *         then never bluffs, and challenges by the fixed rules of the
+ *         easy level, instead of using the solved tables.
+ */
+bool BluffSolver::isMeasuring() {
+    return tMeasuring;
+} // isMeasuring()
+
+/**
+ * Constructor.
+ *
+ * @param threads How many threads. Pass 0 to use all cores.
+ * @param seed    Base of random seeds.
+ */
+BluffSolver::BluffSolver(int threads, unsigned seed) {
+    if (threads <= 0) {
+        threads = int(std::thread::hardware_concurrency());
+    } // if (threads <= 0)
+
+    this->threads = threads > 0 ? threads : 1;
+    this->seed = seed;
+} // BluffSolver(int, unsigned) (Class Constructor)
+
+/**
+ * Measure the chances in hard AI self-play games, with the fixed rules
+ * (see isMeasuring()).
+ *
+ * @param games How many games to play.
+ */
+void BluffSolver::measure(int games) {
+    int i, j;
+    Scheduler scheduler(threads);
+    std::vector<long long> mySeen(scheduler.getThreads() * STATE_COUNT, 0LL);
+    std::vector<long long> myHolding(mySeen.size(), 0LL);
+
+    scheduler.run(games, 0, [&](int worker, int g) {
+        int k, size, state;
+        bool wd4, hold;
+        Color last, best;
+        HardAgent agent;
+
+        Uno uno = Uno::newHeadlessInstance(seed + unsigned(g));
+        uno.setPlayers(3 + g % 2);
+        uno.setDifficulty(Uno::LV_HARD);
+        Simulator sim(&uno);
+        sim.start();
+        tMeasuring = true;
+        while (sim.getStatus() != Simulator::STAT_GAME_OVER
+            && sim.getTurns() < 1000) {
+            // Every time someone holding a [wild +4] plays a card
+            Player* p = uno.getCurrPlayer();
+            const std::vector<Card*>& hand = p->getHandCards();
+            size = int(hand.size());
+            last = uno.lastColor();
+            if (sim.getStatus() >= Player::YOU
+                && sim.getStatus() <= Player::COM3
+                && size >= 2 && last != NONE) {
+                wd4 = hold = false;
+                for (k = 0; k < size; ++k) {
+                    wd4 = wd4 || hand.at(k)->content == WILD_DRAW4;
+                    hold = hold || (!hand.at(k)->isWild()
+                        && hand.at(k)->color == last);
+                } // for (k = 0; k < size; ++k)
+
+                if (wd4) {
+                    best = AI(&uno).calcBestColor4NowPlayer();
+                    state = (bucketOf(size - 1) * SIZE_BUCKETS
+                        + bucketOf(uno.getNextPlayer()->getHandSize()))
+                        * EVIDENCE_COUNT
+                        + evidenceOf(best == last,
+                                     p->getWeakColor() == last);
+                    ++mySeen[worker * STATE_COUNT + state];
+                    myHolding[worker * STATE_COUNT + state] += hold;
+                } // if (wd4)
+            } // if (sim.getStatus() >= Player::YOU && ...)
+
+            sim.step(agent);
+        } // while (sim.getStatus() != Simulator::STAT_GAME_OVER && ...)
+
+        tMeasuring = false;
+    }); // scheduler.run()
+
+    // Merge the results of all threads
+    for (j = 0; j < STATE_COUNT; ++j) {
+        seen[j] = holding[j] = 0LL;
+        for (i = 0; i < scheduler.getThreads(); ++i) {
+            seen[j] += mySeen[i * STATE_COUNT + j];
+            holding[j] += myHolding[i * STATE_COUNT + j];
+        } // for (i = 0; i < scheduler.getThreads(); ++i)
+    } // for (j = 0; j < STATE_COUNT; ++j)
+} // measure(int)
+
+/**
+ * Solve a public state by CFR+.
+ *
+ * @param state      Solve which public state.
+ * @param iterations How many CFR+ iterations.
+ */
+void BluffSolver::solve(int state, int iterations) {
+    int t, a;
+    double p, pass, caught, wrong, reachBluff, reachLegal;
+    double sBluff, sLegal, sChallenge, uPlay[2], uB[2], v;
+    double rBluff[2], rLegal[2], rChallenge[2];
+    double sumBluff, sumChallenge, weight;
+    double brA, brB;
+
+    // Chance of holding the previous color (Laplace smoothed), and the
+    // payoffs of the [wild +4] player: the next player accepts and draws
+    // 4 cards, the bluff is caught and the bluffer draws 4 cards, or the
+    // challenge fails and the challenger draws 6 cards
+    p = (holding[state] + 1.0) / (seen[state] + 2.0);
+    pass = cost(BUCKET_SIZES[state / EVIDENCE_COUNT % SIZE_BUCKETS], 4);
+    wrong = cost(BUCKET_SIZES[state / EVIDENCE_COUNT % SIZE_BUCKETS], 6);
+    caught = -cost(BUCKET_SIZES[state / EVIDENCE_COUNT / SIZE_BUCKETS], 4);
+
+    // Action 1: play the [wild +4] / challenge
+    rBluff[0] = rBluff[1] = rLegal[0] = rLegal[1] = 0.0;
+    rChallenge[0] = rChallenge[1] = 0.0;
+    sumBluff = sumChallenge = weight = 0.0;
+    for (t = 1; t <= iterations; ++t) {
+        sBluff = match(rBluff);
+        sLegal = match(rLegal);
+        sChallenge = match(rChallenge);
+
+        // The [wild +4] player, holding the previous color or not
+        uPlay[0] = (1.0 - sChallenge) * pass + sChallenge * caught;
+        uPlay[1] = (1.0 - sChallenge) * pass + sChallenge * wrong;
+        v = sBluff * uPlay[0];
+        rBluff[1] = std::fmax(0.0, rBluff[1] + p * (uPlay[0] - v));
+        rBluff[0] = std::fmax(0.0, rBluff[0] + p * (0.0 - v));
+        v = sLegal * uPlay[1];
+        rLegal[1] = std::fmax(0.0, rLegal[1] + (1.0 - p) * (uPlay[1] - v));
+        rLegal[0] = std::fmax(0.0, rLegal[0] + (1.0 - p) * (0.0 - v));
+
+        // The next player, who sees only the public state
+        reachBluff = p * sBluff;
+        reachLegal = (1.0 - p) * sLegal;
+        uB[0] = -(reachBluff + reachLegal) * pass;
+        uB[1] = -(reachBluff * caught + reachLegal * wrong);
+        v = (1.0 - sChallenge) * uB[0] + sChallenge * uB[1];
+        for (a = 0; a < 2; ++a) {
+            rChallenge[a] = std::fmax(0.0, rChallenge[a] + uB[a] - v);
+        } // for (a = 0; a < 2; ++a)
+
+        // Linear averaging, as CFR+ does
+        sumBluff += t * sBluff;
+        sumChallenge += t * sChallenge;
+        weight += t;
+    } // for (t = 1; t <= iterations; ++t)
+
+    bluff[state] = sumBluff / weight;
+    challenge[state] = sumChallenge / weight;
+
+    // Value of the average strategies (playing the [wild +4] is always
+    // right when holding no previous color), and the best responses
+    sChallenge = challenge[state];
+    uPlay[0] = (1.0 - sChallenge) * pass + sChallenge * caught;
+    uPlay[1] = (1.0 - sChallenge) * pass + sChallenge * wrong;
+    value[state] = p * bluff[state] * uPlay[0] + (1.0 - p) * uPlay[1];
+    brA = p * std::fmax(0.0, uPlay[0]) + (1.0 - p) * std::fmax(0.0, uPlay[1]);
+    brB = std::fmin(p * bluff[state] * pass + (1.0 - p) * pass,
+                    p * bluff[state] * caught + (1.0 - p) * wrong);
+    exploit[state] = brA - brB;
+} // solve(int, int)
+
+/**
+ * Run the solver.
+ *
+ * @param games      How many self-play games to measure the chances.
+ * @param iterations How many CFR+ iterations in each public state.
+ * @param path       Write the generated header to this file.
+ * @return Whether the header is written successfully.
+ */
+bool BluffSolver::run(int games, int iterations, const char* path) {
+    int i, a, b, e, state;
+    double worst;
+    std::ofstream writer;
+    static const char* const EVIDENCES[EVIDENCE_COUNT] = {
+        "none", "weak", "strong"
+    }; // EVIDENCES[]
+
+    measure(games);
+    Scheduler scheduler(threads);
+    scheduler.run(STATE_COUNT, 1, [&](int, int s) {
+        solve(s, iterations);
+    }); // scheduler.run()
+
+    worst = 0.0;
+    for (state = 0; state < STATE_COUNT; ++state) {
+        worst = std::fmax(worst, exploit[state]);
+    } // for (state = 0; state < STATE_COUNT; ++state)
+
+    std::cout << "worst exploitability: " << worst << std::endl;
+    writer.open(path);
+    if (writer.fail()) {
+        return false;
+    } // if (writer.fail())
+
+    writer << "/////////////////////////////////////////////////////////////"
+        "///////////////////\n//\n// Uno Card Game 4 PC\n"
+        "// Author: Hikari Toyama\n"
+        "// Compile Environment: Qt 5 with Qt Creator\n"
+        "// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.\n//\n"
+        "/////////////////////////////////////////////////////////////"
+        "///////////////////\n\n"
+        "// Generated by \"UnoCard --bluff\" (see BluffSolver class).\n"
+        "// Do not edit by hand. The chances are measured with the fixed\n"
+        "// rules (see BluffSolver::isMeasuring()), so the same command\n"
+        "// reproduces this file exactly, with any number of threads:\n"
+        "// UnoCard --bluff " << games << " " << iterations << " 0 " << seed
+        << " include/BluffStrategy.h\n"
+        "// Games: " << games << ", iterations: " << iterations
+        << ", seed: " << seed << ".\n"
+        "// Worst exploitability: " << worst << ".\n\n"
+        "#ifndef __BLUFFSTRATEGY_H_494649FDFA62B3C015120BCB9BE17613__\n"
+        "#define __BLUFFSTRATEGY_H_494649FDFA62B3C015120BCB9BE17613__\n\n"
+        "#include \"include/BluffSolver.h\"\n\n";
+    for (i = 0; i < 2; ++i) {
+        writer << (i == 0
+            ? "/**\n"
+            " * Probability (in 1/255) to play a [wild +4] while holding the"
+            "\n * current legal color, by [your hand size after playing it]"
+            "\n * [next player's hand size] [evidence], see BluffSolver.\n"
+            " */\n"
+            "static constexpr unsigned char BLUFF_PLAY"
+            : "\n/**\n"
+            " * Probability (in 1/255) to challenge a [wild +4], by [hand"
+            " size of\n * who played it] [your hand size] [evidence], see"
+            " BluffSolver.\n"
+            " */\n"
+            "static constexpr unsigned char BLUFF_CHALLENGE")
+            << "[BluffSolver::SIZE_BUCKETS]\n"
+            "    [BluffSolver::SIZE_BUCKETS]"
+            "[BluffSolver::EVIDENCE_COUNT] = {\n";
+        for (a = 0; a < SIZE_BUCKETS; ++a) {
+            writer << "    {\n";
+            for (b = 0; b < SIZE_BUCKETS; ++b) {
+                writer << "        {";
+                for (e = 0; e < EVIDENCE_COUNT; ++e) {
+                    state = (a * SIZE_BUCKETS + b) * EVIDENCE_COUNT + e;
+                    writer << " " << int(std::floor(255.0 * (i == 0
+                        ? bluff[state] : challenge[state]) + 0.5))
+                        << (e < EVIDENCE_COUNT - 1 ? "," : "");
+                } // for (e = 0; e < EVIDENCE_COUNT; ++e)
+
+                writer << " }" << (b < SIZE_BUCKETS - 1 ? "," : " ")
+                    << " // " << a << ", " << b << ": ";
+                for (e = 0; e < EVIDENCE_COUNT; ++e) {
+                    state = (a * SIZE_BUCKETS + b) * EVIDENCE_COUNT + e;
+                    writer << EVIDENCES[e] << " " << seen[state]
+                        << (e < EVIDENCE_COUNT - 1 ? ", " : " seen\n");
+                } // for (e = 0; e < EVIDENCE_COUNT; ++e)
+            } // for (b = 0; b < SIZE_BUCKETS; ++b)
+
+            writer << "    }" << (a < SIZE_BUCKETS - 1 ? "," : "") << "\n";
+        } // for (a = 0; a < SIZE_BUCKETS; ++a)
+
+        writer << (i == 0 ? "}; // BLUFF_PLAY[][][]\n"
+            : "}; // BLUFF_CHALLENGE[][][]\n");
+    } // for (i = 0; i < 2; ++i)
+
+    writer << "\n#endif // __BLUFFSTRATEGY_H_494649FDFA62B3C015120BCB9BE17613__"
+        "\n\n// E.O.F";
+    writer.close();
+    return !writer.fail();
+} // run(int, int, const char*)
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include "include/Checkpoint.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif // _WIN32
+
+/**
+ * Header of checkpoint files.
+ */
+static const char CHECKPOINT_HEADER[8] = {
+    'U', 'N', 'O', 'C', 'K', 'P', 'T', '1'
+}; // CHECKPOINT_HEADER[]
+
+/**
+ * @param data Provide some data.
+ * @return FNV-1a hash of the data.
+ */
+static uint64_t checksum(const std::string& data) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+
+    for (char c : data) {
+        h = (h ^ (unsigned char)c) * 0x100000001b3ULL;
+    } // for (char c : data)
+
+    return h;
+} // checksum(const std::string&)
+
+/**
+ * Save a checkpoint.
+ *
+ * @param path Path of the checkpoint file.
+ * @param data Data of the checkpoint.
+ * @return Whether the checkpoint is saved successfully.
+ */
+bool Checkpoint::save(const std::string& path, const std::string& data) {
+    bool ok;
+    FILE* file;
+    uint64_t length, sum;
+    std::string temp = path + ".tmp";
+
+    file = fopen(temp.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    } // if (file == nullptr)
+
+    length = data.size();
+    sum = checksum(data);
+    ok = fwrite(CHECKPOINT_HEADER, 8, 1, file) == 1
+        && fwrite(&length, sizeof(length), 1, file) == 1
+        && fwrite(&sum, sizeof(sum), 1, file) == 1
+        && (length == 0 || fwrite(data.data(), data.size(), 1, file) == 1)
+        && fflush(file) == 0;
+
+    // Make sure the data reaches the disk before the rename does
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(file)) == 0;
+#else
+    ok = ok && fsync(fileno(file)) == 0;
+#endif // _WIN32
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        std::remove(temp.c_str());
+        return false;
+    } // if (!ok)
+
+#ifdef _WIN32
+    // Windows cannot rename over an existing file
+    std::remove(path.c_str());
+#endif // _WIN32
+    return std::rename(temp.c_str(), path.c_str()) == 0;
+} // save(const std::string&, const std::string&)
+
+/**
+ * Load a checkpoint.
+ *
+ * @param path    Path of the checkpoint file.
+ * @param outData Out parameter. Receive the data of the checkpoint.
+ * @return False if there is no checkpoint, or it is damaged.
+ */
+bool Checkpoint::load(const std::string& path, std::string& outData) {
+    bool ok;
+    FILE* file;
+    char header[8];
+    uint64_t length, sum;
+
+    file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    } // if (file == nullptr)
+
+    ok = fread(header, 8, 1, file) == 1
+        && memcmp(header, CHECKPOINT_HEADER, 8) == 0
+        && fread(&length, sizeof(length), 1, file) == 1
+        && fread(&sum, sizeof(sum), 1, file) == 1
+        && length < (1ULL << 32);
+    if (ok) {
+        outData.resize(size_t(length));
+        ok = length == 0 || fread(&outData[0], outData.size(), 1, file) == 1;
+        ok = ok && checksum(outData) == sum;
+    } // if (ok)
+
+    fclose(file);
+    return ok;
+} // load(const std::string&, std::string&)
+
+/**
+ * Remove a checkpoint, after the run is finished.
+ *
+ * @param path Path of the checkpoint file.
+ */
+void Checkpoint::remove(const std::string& path) {
+    std::remove(path.c_str());
+} // remove(const std::string&)
+
+// E.O.F
\ No newline at end of file
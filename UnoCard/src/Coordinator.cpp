@@ -0,0 +1,345 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cerrno>
+#include <cstdint>
+#include <functional>
+#include "include/Coordinator.h"
+
+#ifndef _WIN32
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+
+/**
+ * A worker process, and the socket connected to it.
+ */
+struct Worker {
+    pid_t pid;
+    int fd;
+    int shard;
+}; // Worker Struct
+
+/**
+ * Write all bytes to a socket.
+ *
+ * @param fd    The socket.
+ * @param data  Bytes to write.
+ * @param count How many bytes.
+ * @return Whether all bytes are written.
+ */
+static bool writeFully(int fd, const char* data, size_t count) {
+    ssize_t n;
+
+    while (count > 0) {
+        n = write(fd, data, count);
+        if (n <= 0) {
+            return false;
+        } // if (n <= 0)
+
+        data += n;
+        count -= size_t(n);
+    } // while (count > 0)
+
+    return true;
+} // writeFully(int, const char*, size_t)
+
+/**
+ * Read the specified number of bytes from a socket.
+ *
+ * @param fd    The socket.
+ * @param data  Out parameter. Receive the bytes.
+ * @param count How many bytes.
+ * @return Whether all bytes are read, i.e. the socket is not closed.
+ */
+static bool readFully(int fd, char* data, size_t count) {
+    ssize_t n;
+
+    while (count > 0) {
+        n = read(fd, data, count);
+        if (n <= 0) {
+            return false;
+        } // if (n <= 0)
+
+        data += n;
+        count -= size_t(n);
+    } // while (count > 0)
+
+    return true;
+} // readFully(int, char*, size_t)
+
+/**
+ * Worker process entry. Receive shard numbers (int32), run them, and send
+ * back the results (int32 shard number, uint32 length and the data), until
+ * the socket is closed by the coordinator.
+ *
+ * @param fd   The socket connected to the coordinator.
+ * @param work Run a shard.
+ */
+static void serve(int fd, const std::function<std::string(int)>& work) {
+    int32_t shard;
+    uint32_t length;
+    std::string data;
+
+    while (readFully(fd, (char*)&shard, sizeof(shard))) {
+        data = work(int(shard));
+        length = uint32_t(data.size());
+        if (!writeFully(fd, (const char*)&shard, sizeof(shard))
+            || !writeFully(fd, (const char*)&length, sizeof(length))
+            || !writeFully(fd, data.data(), data.size())) {
+            break;
+        } // if (!writeFully(fd, (const char*)&shard, sizeof(shard)) || ...)
+    } // while (readFully(fd, (char*)&shard, sizeof(shard)))
+} // serve(int, const std::function<std::string(int)>&)
+
+/**
+ * Fork a worker process.
+ *
+ * @param workers All workers. Their sockets are closed in the new worker.
+ * @param work    Run a shard.
+ * @return The new worker, whose pid is -1 on failure.
+ */
+static Worker spawn(const std::vector<Worker>& workers,
+                    const std::function<std::string(int)>& work) {
+    int fds[2];
+    Worker w = { -1, -1, -1 };
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        return w;
+    } // if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+
+    w.pid = fork();
+    if (w.pid == 0) {
+        // Worker process. Exit without running the destructors of static
+        // objects, which belong to the coordinator.
+        close(fds[0]);
+        for (const Worker& other : workers) {
+            if (other.fd >= 0) {
+                close(other.fd);
+            } // if (other.fd >= 0)
+        } // for (const Worker& other : workers)
+
+        serve(fds[1], work);
+        _exit(0);
+    } // if (w.pid == 0)
+
+    close(fds[1]);
+    if (w.pid < 0) {
+        close(fds[0]);
+        return w;
+    } // if (w.pid < 0)
+
+    w.fd = fds[0];
+    return w;
+} // spawn(const std::vector<Worker>&, const std::function<...>&)
+
+/**
+ * Stop a worker process, and wait for it to exit.
+ *
+ * @param w    The worker.
+ * @param kill Whether to kill it, instead of letting it finish by itself.
+ */
+static void stop(Worker& w, bool kill) {
+    int status;
+
+    if (w.fd >= 0) {
+        close(w.fd);
+        w.fd = -1;
+    } // if (w.fd >= 0)
+
+    if (w.pid > 0) {
+        if (kill) {
+            ::kill(w.pid, SIGKILL);
+        } // if (kill)
+
+        while (waitpid(w.pid, &status, 0) < 0 && errno == EINTR) {
+            // Retry
+        } // while (waitpid(w.pid, &status, 0) < 0 && errno == EINTR)
+
+        w.pid = -1;
+    } // if (w.pid > 0)
+} // stop(Worker&, bool)
+#endif // _WIN32
+
+/**
+ * @return Whether worker processes are supported on this system.
+ */
+bool Coordinator::isSupported() {
+#ifndef _WIN32
+    return true;
+#else
+    return false;
+#endif // _WIN32
+} // isSupported()
+
+/**
+ * Constructor.
+ *
+ * @param processes How many worker processes. Pass 0 to use all cores.
+ */
+Coordinator::Coordinator(int processes) {
+    if (processes <= 0) {
+        processes = int(std::thread::hardware_concurrency());
+    } // if (processes <= 0)
+
+    this->processes = processes > 0 ? processes : 1;
+    restarts = 0;
+} // Coordinator(int) (Class Constructor)
+
+/**
+ * @return How many times workers have been replaced after a crash.
+ */
+int Coordinator::getRestarts() {
+    return restarts;
+} // getRestarts()
+
+/**
+ * Run shards 0 ~ shards - 1 in worker processes, and return when all of
+ * them are merged. Must be called when no other threads are running in
+ * this process, since workers are forked from it.
+ *
+ * @param shards How many shards.
+ * @param work   Run a shard in a worker process. Called with the shard
+ *               number, and returns the result as binary data.
+ * @param merge  Merge the result of a shard in this process. Called with
+ *               the shard number and its result, in the order of
+ *               shards.
+ * @return False if a shard fails MAX_FAILURES times, or worker
+ *         processes are not supported.
+ */
+bool Coordinator::run(int shards, const std::function<std::string(int)>& work,
+    const std::function<void(int, const std::string&)>& merge) {
+#ifndef _WIN32
+    int i, merged, count;
+    int32_t shard;
+    uint32_t length;
+    bool ok, failed;
+    std::deque<int> pending;
+    std::vector<Worker> workers;
+    std::vector<pollfd> polls;
+    std::vector<int> failures(shards > 0 ? shards : 0, 0);
+    std::vector<std::string> results(failures.size());
+    std::vector<bool> done(failures.size(), false);
+
+    // A dead worker must not kill us when we write to its socket
+    signal(SIGPIPE, SIG_IGN);
+    for (i = 0; i < shards; ++i) {
+        pending.push_back(i);
+    } // for (i = 0; i < shards; ++i)
+
+    count = processes < shards ? processes : shards;
+    for (i = 0; i < count; ++i) {
+        workers.push_back(spawn(workers, work));
+    } // for (i = 0; i < count; ++i)
+
+    merged = 0;
+    failed = false;
+    while (merged < shards && !failed) {
+        // Give pending shards to idle workers, and replace dead workers
+        polls.clear();
+        for (Worker& w : workers) {
+            if (w.pid < 0) {
+                ++restarts;
+                w = spawn(workers, work);
+                if (w.pid < 0) {
+                    failed = true;
+                    break;
+                } // if (w.pid < 0)
+            } // if (w.pid < 0)
+
+            if (w.shard < 0 && !pending.empty()) {
+                w.shard = pending.front();
+                pending.pop_front();
+                shard = int32_t(w.shard);
+                if (!writeFully(w.fd, (const char*)&shard, sizeof(shard))) {
+                    // The worker is dead. Count it as a failure of the
+                    // shard anyway, so that we never restart forever.
+                    if (++failures[w.shard] >= MAX_FAILURES) {
+                        failed = true;
+                    } // if (++failures[w.shard] >= MAX_FAILURES)
+
+                    pending.push_front(w.shard);
+                    w.shard = -1;
+                    stop(w, true);
+                    continue;
+                } // if (!writeFully(w.fd, (const char*)&shard, ...))
+            } // if (w.shard < 0 && !pending.empty())
+
+            if (w.shard >= 0) {
+                pollfd p = { w.fd, POLLIN, 0 };
+                polls.push_back(p);
+            } // if (w.shard >= 0)
+        } // for (Worker& w : workers)
+
+        if (failed || polls.empty()) {
+            continue;
+        } // if (failed || polls.empty())
+
+        if (poll(polls.data(), nfds_t(polls.size()), -1) < 0) {
+            continue;
+        } // if (poll(polls.data(), nfds_t(polls.size()), -1) < 0)
+
+        for (Worker& w : workers) {
+            for (const pollfd& p : polls) {
+                if (p.fd != w.fd || p.revents == 0) {
+                    continue;
+                } // if (p.fd != w.fd || p.revents == 0)
+
+                ok = readFully(w.fd, (char*)&shard, sizeof(shard))
+                    && int(shard) == w.shard
+                    && readFully(w.fd, (char*)&length, sizeof(length));
+                if (ok) {
+                    results[w.shard].resize(length);
+                    ok = length == 0 || readFully(w.fd,
+                        &results[w.shard][0], length);
+                } // if (ok)
+
+                if (ok) {
+                    done[w.shard] = true;
+                } // if (ok)
+                else {
+                    // The worker crashed in this shard. Retry it first.
+                    if (++failures[w.shard] >= MAX_FAILURES) {
+                        failed = true;
+                    } // if (++failures[w.shard] >= MAX_FAILURES)
+
+                    pending.push_front(w.shard);
+                    stop(w, true);
+                } // else
+
+                w.shard = -1;
+            } // for (const pollfd& p : polls)
+        } // for (Worker& w : workers)
+
+        // Merge finished shards in order
+        while (merged < shards && done[merged]) {
+            merge(merged, results[merged]);
+            std::string().swap(results[merged]);
+            ++merged;
+        } // while (merged < shards && done[merged])
+    } // while (merged < shards && !failed)
+
+    // Closing the sockets lets idle workers exit by themselves
+    for (Worker& w : workers) {
+        stop(w, w.shard >= 0);
+    } // for (Worker& w : workers)
+
+    return !failed;
+#else
+    return false;
+#endif // _WIN32
+} // run(int, const std::function<...>&, const std::function<...>&)
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,264 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <utility>
+#include <iomanip>
+#include <ostream>
+#include <algorithm>
+#include "include/Coverage.h"
+
+#ifdef UNO_COVERAGE
+
+/**
+ * Counters of all branches.
+ */
+struct Counters {
+    std::vector<long long> hits, finished, wins;
+
+    /**
+     * Make sure that there is a counter for the specified branch.
+     */
+    void grow(int site) {
+        if (site >= int(hits.size())) {
+            hits.resize(site + 1, 0LL);
+            finished.resize(site + 1, 0LL);
+            wins.resize(site + 1, 0LL);
+        } // if (site >= int(hits.size()))
+    } // grow(int)
+
+    /**
+     * Add other counters to this one, and clear the other one.
+     */
+    void take(Counters& other) {
+        for (int i = int(other.hits.size()) - 1; i >= 0; --i) {
+            grow(i);
+            hits[i] += other.hits[i];
+            finished[i] += other.finished[i];
+            wins[i] += other.wins[i];
+        } // for (int i = int(other.hits.size()) - 1; i >= 0; --i)
+
+        other.hits.clear();
+        other.finished.clear();
+        other.wins.clear();
+    } // take(Counters&)
+}; // Counters Struct
+
+/**
+ * Guards [sNames] and [sMerged].
+ */
+static std::mutex sMutex;
+
+/**
+ * Names of all branches, indexed by branch ID.
+ */
+static std::vector<std::string> sNames;
+
+/**
+ * Counters merged from all threads.
+ */
+static Counters sMerged;
+
+/**
+ * Counters of the calling thread, merged into [sMerged] when it exits.
+ */
+struct LocalCounters : Counters {
+    /**
+     * Branches taken in the games being recorded, (branch ID, who).
+     */
+    std::vector<std::pair<int, int> > pending;
+
+    /**
+     * How many games are being recorded.
+     */
+    int depth = 0;
+
+    ~LocalCounters() {
+        std::lock_guard<std::mutex> lock(sMutex);
+        sMerged.take(*this);
+    } // ~LocalCounters()
+}; // LocalCounters Struct
+
+static thread_local LocalCounters tLocal;
+
+/**
+ * Register a branch. Called once for each AI_BRANCH site.
+ *
+ * @param tag  Which decision tree, e.g. "hard".
+ * @param line Source line of the branch.
+ * @param expr Source text of the branch's answer.
+ * @return Branch ID.
+ */
+int Coverage::site(const char* tag, int line, const char* expr) {
+    std::lock_guard<std::mutex> lock(sMutex);
+    sNames.push_back(std::string(tag) + " L" + std::to_string(line)
+        + " " + expr);
+    return int(sNames.size()) - 1;
+} // site(const char*, int, const char*)
+
+/**
+ * Count a taken branch.
+ *
+ * @param site  Branch ID.
+ * @param who   Who took the branch.
+ * @param value Answer of the branch.
+ * @return value.
+ */
+int Coverage::hit(int site, int who, int value) {
+    LocalCounters& local = tLocal;
+
+    local.grow(site);
+    ++local.hits[site];
+    if (local.depth > 0) {
+        local.pending.push_back(std::make_pair(site, who));
+    } // if (local.depth > 0)
+
+    return value;
+} // hit(int, int, int)
+
+/**
+ * Start to record the taken branches of a game in the calling thread.
+ * Games can be nested (e.g. simulated games inside AI's thinking).
+ *
+ * @return A mark to pass to endGame(int, int).
+ */
+int Coverage::beginGame() {
+    LocalCounters& local = tLocal;
+
+    ++local.depth;
+    return int(local.pending.size());
+} // beginGame()
+
+/**
+ * Stop recording a game, and count the outcome of all branches taken
+ * since the matching beginGame().
+ *
+ * @param mark   Return value of the matching beginGame().
+ * @param winner Who won the game, or -1 when not finished.
+ */
+void Coverage::endGame(int mark, int winner) {
+    size_t i;
+    LocalCounters& local = tLocal;
+
+    if (winner >= 0) {
+        for (i = size_t(mark); i < local.pending.size(); ++i) {
+            // Counters may have been merged away during the game
+            local.grow(local.pending[i].first);
+            ++local.finished[local.pending[i].first];
+            if (local.pending[i].second == winner) {
+                ++local.wins[local.pending[i].first];
+            } // if (local.pending[i].second == winner)
+        } // for (i = size_t(mark); i < local.pending.size(); ++i)
+    } // if (winner >= 0)
+
+    local.pending.resize(size_t(mark));
+    --local.depth;
+} // endGame(int, int)
+
+/**
+ * Write a report of all threads' counters, ranked by frequency and by
+ * win contribution (wins more than the average win rate of all taken
+ * branches would expect).
+ *
+ * @param out Output stream.
+ */
+void Coverage::report(std::ostream& out) {
+    int i, n;
+    double rate;
+    long long hits, finished, wins;
+    std::vector<int> order;
+    std::vector<double> gain;
+    std::lock_guard<std::mutex> lock(sMutex);
+
+    sMerged.take(tLocal);
+    n = int(sMerged.hits.size());
+    hits = finished = wins = 0LL;
+    for (i = 0; i < n; ++i) {
+        hits += sMerged.hits[i];
+        finished += sMerged.finished[i];
+        wins += sMerged.wins[i];
+    } // for (i = 0; i < n; ++i)
+
+    rate = finished > 0 ? double(wins) / finished : 0.0;
+    gain.resize(n);
+    for (i = 0; i < n; ++i) {
+        gain[i] = sMerged.wins[i] - rate * sMerged.finished[i];
+        order.push_back(i);
+    } // for (i = 0; i < n; ++i)
+
+    out << "Branch coverage: " << hits << " hits, average win rate "
+        << rate << std::endl;
+    for (int pass = 0; pass < 2; ++pass) {
+        if (pass == 0) {
+            std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+                return sMerged.hits[a] > sMerged.hits[b];
+            }); // std::stable_sort(order.begin(), order.end(), ...)
+            out << std::endl << "By frequency:" << std::endl;
+        } // if (pass == 0)
+        else {
+            std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+                return gain[a] > gain[b];
+            }); // std::stable_sort(order.begin(), order.end(), ...)
+            out << std::endl << "By win contribution:" << std::endl;
+        } // else
+
+        out << std::setw(10) << "hits" << std::setw(8) << "share"
+            << std::setw(8) << "win%" << std::setw(10) << "gain"
+            << "  branch" << std::endl;
+        for (int k : order) {
+            out << std::setw(10) << sMerged.hits[k]
+                << std::setw(7) << std::fixed << std::setprecision(2)
+                << (hits > 0 ? 100.0 * sMerged.hits[k] / hits : 0.0) << "%"
+                << std::setw(7) << std::setprecision(1)
+                << (sMerged.finished[k] > 0
+                    ? 100.0 * sMerged.wins[k] / sMerged.finished[k] : 0.0)
+                << "%" << std::setw(10) << std::setprecision(1) << gain[k]
+                << "  " << sNames[k] << std::endl;
+        } // for (int k : order)
+    } // for (int pass = 0; pass < 2; ++pass)
+
+    out.unsetf(std::ios::fixed);
+    out << std::setprecision(6);
+} // report(std::ostream&)
+
+/**
+ * Clear the merged counters and the calling thread's counters.
+ */
+void Coverage::reset() {
+    std::lock_guard<std::mutex> lock(sMutex);
+
+    sMerged.take(tLocal);
+    sMerged.hits.assign(sMerged.hits.size(), 0LL);
+    sMerged.finished.assign(sMerged.finished.size(), 0LL);
+    sMerged.wins.assign(sMerged.wins.size(), 0LL);
+} // reset()
+
+#else
+
+/**
+ * Write a report of all threads' counters. Nothing is counted in release
+ * builds.
+ *
+ * @param out Output stream.
+ */
+void Coverage::report(std::ostream& out) {
+    out << "Branch coverage is not counted in release builds." << std::endl;
+} // report(std::ostream&)
+
+/**
+ * Clear the merged counters and the calling thread's counters.
+ */
+void Coverage::reset() {
+} // reset()
+
+#endif // UNO_COVERAGE
+
+// E.O.F
\ No newline at end of file
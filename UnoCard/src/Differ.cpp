@@ -0,0 +1,526 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <ostream>
+#include "include/Simulator.h"
+#include "include/Scheduler.h"
+#include "include/Lockstep.h"
+#include "include/Differ.h"
+#include "include/Player.h"
+#include "include/Agent.h"
+#include "include/Color.h"
+#include "include/Card.h"
+#include "include/Uno.h"
+#include "reference/Simulator.h"
+#include "reference/Player.h"
+#include "reference/AI.h"
+#include "reference/Uno.h"
+
+/**
+ * Static agent of the reference engine (see Agent class). Chooses the AI
+ * in the same way as reference::Simulator::bestCardIndex4NowPlayer().
+ */
+class ReferenceAgent {
+public:
+    int bestCardIndex(reference::Uno* uno, Color outColor[]) {
+        reference::AI ai(uno);
+
+        if (uno->isSevenZeroRule()) {
+            return ai.sevenZeroAI_bestCardIndex4NowPlayer(outColor);
+        } // if (uno->isSevenZeroRule())
+        else if (uno->getDifficulty() == Uno::LV_EASY) {
+            return ai.easyAI_bestCardIndex4NowPlayer(outColor);
+        } // else if (uno->getDifficulty() == Uno::LV_EASY)
+        else {
+            return ai.hardAI_bestCardIndex4NowPlayer(outColor);
+        } // else
+    } // bestCardIndex(reference::Uno*, Color[])
+
+    Color bestColor(reference::Uno* uno) {
+        return reference::AI(uno).calcBestColor4NowPlayer();
+    } // bestColor(reference::Uno*)
+
+    bool needToChallenge(reference::Uno* uno) {
+        return reference::AI(uno).needToChallenge();
+    } // needToChallenge(reference::Uno*)
+
+    int swapTarget(reference::Uno* uno) {
+        return reference::AI(uno).calcBestSwapTarget4NowPlayer();
+    } // swapTarget(reference::Uno*)
+}; // ReferenceAgent Class
+
+/**
+ * Let an agent make the pending decision, without applying it.
+ *
+ * @param uno    The engine.
+ * @param status Status of the engine's simulator.
+ * @param agent  The agent.
+ * @param action Receive the decision.
+ */
+template<class U, class A>
+static void decide(U* uno, int status, A& agent, Differ::Action& action) {
+    int index;
+    Card* card;
+    Color bestColor[1];
+
+    action.status = status;
+    action.color = NONE;
+    action.content = -1;
+    action.value = NONE;
+    switch (status) {
+    case Player::YOU:
+    case Player::COM1:
+    case Player::COM2:
+    case Player::COM3:
+        bestColor[0] = NONE;
+        index = agent.bestCardIndex(uno, bestColor);
+        if (index >= 0) {
+            card = uno->getCurrPlayer()->getHandCards().at(index);
+            action.color = card->color;
+            action.content = card->content;
+            action.value = card->isWild() ? bestColor[0] : NONE;
+        } // if (index >= 0)
+        break; // case Player::YOU, Player::COM1, ...
+
+    case Simulator::STAT_WILD_COLOR:
+        action.value = agent.bestColor(uno);
+        break; // case Simulator::STAT_WILD_COLOR
+
+    case Simulator::STAT_DOUBT_WILD4:
+        action.value = agent.needToChallenge(uno) ? 1 : 0;
+        break; // case Simulator::STAT_DOUBT_WILD4
+
+    case Simulator::STAT_SEVEN_TARGET:
+        action.value = agent.swapTarget(uno);
+        break; // case Simulator::STAT_SEVEN_TARGET
+
+    default:
+        break; // default
+    } // switch (status)
+} // decide(U*, int, A&, Differ::Action&)
+
+/**
+ * Apply a decision, made in the current status of the simulator.
+ *
+ * @param uno    The engine.
+ * @param sim    The engine's simulator.
+ * @param action The decision.
+ * @return False if the decision is not legal in the current state, and
+ *         nothing is applied.
+ */
+template<class U, class S>
+static bool apply(U* uno, S& sim, const Differ::Action& action) {
+    int i, size, now;
+    Card* card;
+
+    card = nullptr;
+    now = uno->getNow();
+    switch (action.status) {
+    case Player::YOU:
+    case Player::COM1:
+    case Player::COM2:
+    case Player::COM3:
+        if (action.content < 0) {
+            sim.draw();
+            return true;
+        } // if (action.content < 0)
+
+        // Play the first hand card of the same color and content
+        size = uno->getCurrPlayer()->getHandSize();
+        for (i = 0; i < size; ++i) {
+            card = uno->getCurrPlayer()->getHandCards().at(i);
+            if (card->color == action.color
+                && card->content == action.content) {
+                break;
+            } // if (card->color == action.color && ...)
+        } // for (i = 0; i < size; ++i)
+
+        if (i == size || !uno->isLegalToPlay(card)) {
+            return false;
+        } // if (i == size || !uno->isLegalToPlay(card))
+
+        sim.play(i, Color(action.value));
+        return true; // case Player::YOU, Player::COM1, ...
+
+    case Simulator::STAT_WILD_COLOR:
+        if (action.value <= NONE || action.value > YELLOW) {
+            return false;
+        } // if (action.value <= NONE || action.value > YELLOW)
+
+        sim.selectColor(Color(action.value));
+        return true; // case Simulator::STAT_WILD_COLOR
+
+    case Simulator::STAT_DOUBT_WILD4:
+        sim.decideChallenge(action.value != 0);
+        return true; // case Simulator::STAT_DOUBT_WILD4
+
+    case Simulator::STAT_SEVEN_TARGET:
+        if (action.value < Player::YOU || action.value > Player::COM3
+            || action.value == now || (uno->getPlayers() == 3
+            && action.value == Player::COM2)) {
+            return false;
+        } // if (action.value < Player::YOU || ...)
+
+        sim.swapWith(action.value);
+        return true; // case Simulator::STAT_SEVEN_TARGET
+
+    default:
+        return false; // default
+    } // switch (action.status)
+} // apply(U*, S&, const Differ::Action&)
+
+/**
+ * @return Whether two decisions are the same.
+ */
+static bool same(const Differ::Action& a, const Differ::Action& b) {
+    return a.status == b.status && a.color == b.color
+        && a.content == b.content && a.value == b.value;
+} // same(const Differ::Action&, const Differ::Action&)
+
+/**
+ * Constructor.
+ *
+ * @param threads How many threads. Pass 0 to use all cores.
+ */
+Differ::Differ(int threads) {
+    this->threads = threads;
+    setRules(4, Uno::LV_HARD, true, false, false);
+} // Differ(int) (Class Constructor)
+
+/**
+ * Set the rules of checked games. By default, 4 players, hard level,
+ * force play, and no 7-0 or +2 stack rules. Only the easy and hard
+ * levels can be checked, since the reference copy has no other AI.
+ */
+void Differ::setRules(int players, int difficulty, bool forcePlay,
+                      bool sevenZeroRule, bool draw2StackRule) {
+    this->players = players;
+    this->difficulty = difficulty;
+    this->forcePlay = forcePlay;
+    this->sevenZeroRule = sevenZeroRule;
+    this->draw2StackRule = draw2StackRule;
+} // setRules(int, int, bool, bool, bool)
+
+/**
+ * Play a game on both engines, and find the first divergence.
+ *
+ * @param seed    Seed of the game.
+ * @param actions Decisions to replay. When record is true, it is
+ *                cleared and receives the decisions made by AI.
+ * @param record  Let AI make all decisions instead of replaying.
+ * @return How many actions are applied before the engines diverge, or
+ *         -1 if they never diverge (or a replayed action cannot be
+ *         applied).
+ */
+int Differ::compare(unsigned seed, std::vector<Action>& actions,
+                    bool record) {
+    int k, status;
+    Action mine, theirs;
+    DefaultAgent agent;
+    ReferenceAgent referenceAgent;
+
+    Uno uno = Uno::newHeadlessInstance(seed);
+    uno.setPlayers(players);
+    uno.setDifficulty(difficulty);
+    uno.setForcePlay(forcePlay);
+    uno.setSevenZeroRule(sevenZeroRule);
+    uno.setDraw2StackRule(draw2StackRule);
+    Simulator sim(&uno);
+    sim.start();
+
+    reference::Uno ref = reference::Uno::newHeadlessInstance(seed);
+    ref.setPlayers(players);
+    ref.setDifficulty(difficulty);
+    ref.setForcePlay(forcePlay);
+    ref.setSevenZeroRule(sevenZeroRule);
+    ref.setDraw2StackRule(draw2StackRule);
+    reference::Simulator refSim(&ref);
+    refSim.start();
+
+    if (record) {
+        actions.clear();
+    } // if (record)
+
+    for (k = 0; ; ++k) {
+        status = sim.getStatus();
+        if (uno.getStateHash() != ref.getStateHash()
+            || status != refSim.getStatus()) {
+            return k;
+        } // if (uno.getStateHash() != ref.getStateHash() || ...)
+
+        if (status == Simulator::STAT_GAME_OVER
+            || sim.getTurns() >= MAX_TURNS) {
+            return -1;
+        } // if (status == Simulator::STAT_GAME_OVER || ...)
+
+        // AI decides on both engines even when replaying, since AI may
+        // consume random numbers
+        decide(&uno, status, agent, mine);
+        decide(&ref, status, referenceAgent, theirs);
+        if (!same(mine, theirs)) {
+            return k;
+        } // if (!same(mine, theirs))
+
+        if (record) {
+            actions.push_back(mine);
+        } // if (record)
+        else if (k >= int(actions.size())
+            || actions[k].status != status) {
+            return -1;
+        } // else if (k >= int(actions.size()) || ...)
+
+        if (!apply(&uno, sim, actions[k])) {
+            return -1;
+        } // if (!apply(&uno, sim, actions[k]))
+
+        if (!apply(&ref, refSim, actions[k])) {
+            return k + 1;
+        } // if (!apply(&ref, refSim, actions[k]))
+    } // for (k = 0; ; ++k)
+} // compare(unsigned, std::vector<Action>&, bool)
+
+/**
+ * Minimize a diverging action sequence by delta debugging.
+ *
+ * @param seed    Seed of the game.
+ * @param actions Provide a diverging action sequence, and receive the
+ *                minimized one.
+ */
+void Differ::minimize(unsigned seed, std::vector<Action>& actions) {
+    int k, n, size, chunk, start, end;
+    bool reduced;
+    std::vector<Action> candidate;
+
+    n = 2;
+    while (!actions.empty()) {
+        // Try to remove each of n chunks. A divergence observed earlier
+        // than the end of the candidate also truncates it.
+        size = int(actions.size());
+        n = n < size ? n : size;
+        chunk = (size + n - 1) / n;
+        reduced = false;
+        for (start = 0; start < size && !reduced; start += chunk) {
+            end = start + chunk < size ? start + chunk : size;
+            candidate.assign(actions.begin(), actions.begin() + start);
+            candidate.insert(candidate.end(),
+                             actions.begin() + end, actions.end());
+            k = compare(seed, candidate, /* record */ false);
+            if (k >= 0) {
+                candidate.resize(k);
+                actions.swap(candidate);
+                reduced = true;
+            } // if (k >= 0)
+        } // for (start = 0; start < size && !reduced; start += chunk)
+
+        if (reduced) {
+            n = n > 2 ? n - 1 : 2;
+        } // if (reduced)
+        else if (n >= size) {
+            break;
+        } // else if (n >= size)
+        else {
+            n = n * 2 < size ? n * 2 : size;
+        } // else
+    } // while (!actions.empty())
+} // minimize(unsigned, std::vector<Action>&)
+
+/**
+ * Check seeds firstSeed ~ firstSeed + count - 1, and write the result
+ * as JSON, with the minimized action sequence of the first divergence.
+ * Stop checking soon after a divergence is found.
+ *
+ * @param firstSeed The first seed to check.
+ * @param count     How many seeds to check.
+ * @param out       Output stream.
+ * @return Whether both engines are equivalent in all checked seeds.
+ */
+bool Differ::run(unsigned firstSeed, int count, std::ostream& out) {
+    int length;
+    size_t i;
+    unsigned seed;
+    double seconds;
+    std::vector<Action> actions;
+    std::atomic<int> first(count);
+    std::atomic<long long> checked(0LL), compared(0LL);
+    std::chrono::steady_clock::time_point start;
+    Scheduler scheduler(threads);
+    std::vector<std::vector<Action>> buffers(scheduler.getThreads());
+
+    start = std::chrono::steady_clock::now();
+    scheduler.run(count, 0, [&](int worker, int n) {
+        int k, smallest;
+
+        // Seeds after a known divergence are skipped, so that the smallest
+        // diverging seed is always found
+        if (n > first.load(std::memory_order_relaxed)) {
+            return;
+        } // if (n > first.load(std::memory_order_relaxed))
+
+        ++checked;
+        k = compare(firstSeed + unsigned(n), buffers[worker], true);
+        compared += k >= 0 ? k : int(buffers[worker].size());
+        if (k >= 0) {
+            smallest = first.load();
+            while (n < smallest
+                && !first.compare_exchange_weak(smallest, n)) {
+                // Retry with the updated smallest index
+            } // while (n < smallest && !first.compare_exchange_weak(...))
+        } // if (k >= 0)
+    }); // scheduler.run()
+
+    seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    seconds = seconds > 1e-9 ? seconds : 1e-9;
+    out << "{\"players\": " << players
+        << ", \"difficulty\": " << difficulty
+        << ", \"forcePlay\": " << (forcePlay ? "true" : "false")
+        << ", \"sevenZeroRule\": " << (sevenZeroRule ? "true" : "false")
+        << ", \"draw2StackRule\": " << (draw2StackRule ? "true" : "false")
+        << ", \"firstSeed\": " << firstSeed
+        << ", \"checked\": " << checked
+        << ", \"actions\": " << compared
+        << ", \"seconds\": " << seconds
+        << ", \"seedsPerSecond\": " << (checked / seconds)
+        << ", \"divergence\": ";
+    if (first.load() >= count) {
+        out << "null}";
+        return true;
+    } // if (first.load() >= count)
+
+    // Reproduce the smallest diverging seed, and minimize its actions
+    seed = firstSeed + unsigned(first.load());
+    length = compare(seed, actions, /* record */ true);
+    actions.resize(length);
+    minimize(seed, actions);
+    out << "{\"seed\": " << seed
+        << ", \"length\": " << length
+        << ", \"actions\": [";
+    for (i = 0; i < actions.size(); ++i) {
+        out << (i > 0 ? ", " : "")
+            << "{\"status\": " << actions[i].status
+            << ", \"color\": " << int(actions[i].color)
+            << ", \"content\": " << actions[i].content
+            << ", \"value\": " << actions[i].value << "}";
+    } // for (i = 0; i < actions.size(); ++i)
+
+    out << "]}}";
+    return false;
+} // run(unsigned, int, std::ostream&)
+
+/**
+ * Check seeds firstSeed ~ firstSeed + count - 1 on the batched easy AI
+ * (see Lockstep class) against Simulator with EasyAgent, and write the
+ * result as JSON. After every decision, the status, the number of turns
+ * and the hand sizes of each lane must equal those of the simulator
+ * playing the same seed. Only the current rules without 7-0 rule are
+ * checked, always in easy level.
+ *
+ * @param firstSeed The first seed to check.
+ * @param count     How many seeds to check.
+ * @param out       Output stream.
+ * @return Whether both engines are equivalent in all checked seeds.
+ */
+bool Differ::lockstep(unsigned firstSeed, int count, std::ostream& out) {
+    int batches;
+    double seconds;
+    std::atomic<int> first(count);
+    std::atomic<long long> compared(0LL);
+    std::chrono::steady_clock::time_point start;
+    Scheduler scheduler(threads);
+
+    start = std::chrono::steady_clock::now();
+    batches = (count + Lockstep::LANES - 1) / Lockstep::LANES;
+    scheduler.run(batches, 0, [&](int, int n) {
+        int lane, who, size, smallest, diverged;
+        bool running;
+        EasyAgent agent;
+        Lockstep batch;
+        std::vector<Uno> games;
+        std::vector<Simulator> sims;
+
+        // Both engines need a stable address of each Uno runtime
+        size = count - n * Lockstep::LANES;
+        size = size < Lockstep::LANES ? size : Lockstep::LANES;
+        games.reserve(size);
+        sims.reserve(size);
+        for (lane = 0; lane < size; ++lane) {
+            games.push_back(Uno::newHeadlessInstance(
+                firstSeed + unsigned(n * Lockstep::LANES + lane)));
+            games[lane].setPlayers(players);
+            games[lane].setDifficulty(Uno::LV_EASY);
+            games[lane].setForcePlay(forcePlay);
+            games[lane].setDraw2StackRule(draw2StackRule);
+            Simulator(&games[lane]).start();
+
+            // Take over from the same turn, as Lockstep::load() does
+            sims.push_back(Simulator(&games[lane]));
+            batch.load(lane, &games[lane]);
+        } // for (lane = 0; lane < size; ++lane)
+
+        diverged = count;
+        do {
+            running = batch.step(MAX_TURNS) > 0;
+            for (lane = 0; lane < size; ++lane) {
+                if (sims[lane].getStatus() != Simulator::STAT_GAME_OVER
+                    && sims[lane].getTurns() < MAX_TURNS) {
+                    sims[lane].step(agent);
+                    ++compared;
+                } // if (sims[lane].getStatus() != ... && ...)
+
+                if (batch.getStatus(lane) != sims[lane].getStatus()
+                    || batch.getTurns(lane) != sims[lane].getTurns()) {
+                    diverged = n * Lockstep::LANES + lane;
+                } // if (batch.getStatus(lane) != ... || ...)
+
+                for (who = 0; who < players; ++who) {
+                    if (batch.getHandSize(lane, who) != games[lane]
+                        .getPlayer(who)->getHandSize()) {
+                        diverged = n * Lockstep::LANES + lane;
+                    } // if (batch.getHandSize(lane, who) != ...)
+                } // for (who = 0; who < players; ++who)
+
+                if (diverged < count) {
+                    break;
+                } // if (diverged < count)
+            } // for (lane = 0; lane < size; ++lane)
+        } while (running && diverged == count);
+
+        smallest = first.load();
+        while (diverged < smallest
+            && !first.compare_exchange_weak(smallest, diverged)) {
+            // Retry with the updated smallest index
+        } // while (diverged < smallest && ...)
+    }); // scheduler.run()
+
+    seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    seconds = seconds > 1e-9 ? seconds : 1e-9;
+    out << "{\"lockstep\": true"
+        << ", \"players\": " << players
+        << ", \"forcePlay\": " << (forcePlay ? "true" : "false")
+        << ", \"draw2StackRule\": " << (draw2StackRule ? "true" : "false")
+        << ", \"firstSeed\": " << firstSeed
+        << ", \"checked\": " << count
+        << ", \"actions\": " << compared
+        << ", \"seconds\": " << seconds
+        << ", \"seedsPerSecond\": " << (count / seconds)
+        << ", \"divergence\": ";
+    if (first.load() >= count) {
+        out << "null}";
+        return true;
+    } // if (first.load() >= count)
+
+    out << "{\"seed\": " << (firstSeed + unsigned(first.load())) << "}}";
+    return false;
+} // lockstep(unsigned, int, std::ostream&)
+
+// E.O.F
\ No newline at end of file
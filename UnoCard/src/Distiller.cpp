@@ -0,0 +1,376 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include "include/Distiller.h"
+#include "include/Simulator.h"
+#include "include/Scheduler.h"
+#include "include/Content.h"
+#include "include/Player.h"
+#include "include/Agent.h"
+#include "include/Color.h"
+#include "include/Card.h"
+#include "include/Uno.h"
+#include "include/AI.h"
+
+/**
+ * Names of card kinds, used in the generated header.
+ */
+static const char* const KIND_NAMES[Distiller::KIND_COUNT] = {
+    "NUM", "REV", "SKIP", "DRAW2", "WILD", "WD4"
+}; // KIND_NAMES[]
+
+/**
+ * @param card Provide a card.
+ * @return Kind of the card, one of the KIND_* constants.
+ */
+int Distiller::kindOf(Card* card) {
+    switch (card->content) {
+    case REV:
+        return KIND_REV;
+
+    case SKIP:
+        return KIND_SKIP;
+
+    case DRAW2:
+        return KIND_DRAW2;
+
+    case WILD:
+        return KIND_WILD;
+
+    case WILD_DRAW4:
+        return KIND_WD4;
+
+    default: // number cards
+        return KIND_NUM;
+    } // switch (card->content)
+} // kindOf(Card*)
+
+/**
+ * @param uno       Provide the Uno runtime.
+ * @param bestColor Best color of current player.
+ * @return Cell of the position of current player (0 ~ CELL_COUNT - 1).
+ */
+int Distiller::cellOf(Uno* uno, Color bestColor) {
+    int yourSize, nextSize, prevSize, yours, next;
+
+    yourSize = uno->getCurrPlayer()->getHandSize();
+    nextSize = uno->getNextPlayer()->getHandSize();
+    prevSize = uno->getPrevPlayer()->getHandSize();
+    yours = yourSize <= 2 ? 0 : yourSize <= 4 ? 1 : yourSize <= 7 ? 2 : 3;
+    next = nextSize <= 1 ? 0 : nextSize <= 2 ? 1 : nextSize <= 4 ? 2 : 3;
+    return ((yours * 4 + next) * 2 + (prevSize > nextSize)) * 2
+        + (uno->lastColor() == bestColor);
+} // cellOf(Uno*, Color)
+
+/**
+ * Priority order of card kinds used by the easy AI in a cell. Used in
+ * cells where the search AI has made no choices, and to break ties.
+ *
+ * @param cell     Provide a cell.
+ * @param outOrder Out parameter. Pass an int array (length>=KIND_COUNT)
+ *                 to receive the order.
+ */
+void Distiller::defaultOrder(int cell, int outOrder[]) {
+    static const int NEXT_UNO[2][KIND_COUNT] = {
+        { KIND_DRAW2, KIND_SKIP, KIND_REV, KIND_WD4, KIND_WILD, KIND_NUM },
+        { KIND_DRAW2, KIND_SKIP, KIND_REV, KIND_NUM, KIND_WD4, KIND_WILD }
+    }; // NEXT_UNO[][]
+    static const int NORMAL[2][KIND_COUNT] = {
+        { KIND_NUM, KIND_SKIP, KIND_DRAW2, KIND_REV, KIND_WILD, KIND_WD4 },
+        { KIND_REV, KIND_NUM, KIND_SKIP, KIND_DRAW2, KIND_WILD, KIND_WD4 }
+    }; // NORMAL[][]
+    int i, sameColor, prevBigger, next;
+
+    sameColor = cell & 1;
+    prevBigger = (cell >> 1) & 1;
+    next = (cell >> 2) & 3;
+    for (i = 0; i < KIND_COUNT; ++i) {
+        outOrder[i] = next == 0 ? NEXT_UNO[sameColor][i]
+            : NORMAL[prevBigger][i];
+    } // for (i = 0; i < KIND_COUNT; ++i)
+} // defaultOrder(int, int[])
+
+/**
+ * Constructor.
+ *
+ * @param threads How many threads to run the search AI. Pass 0 to use
+ *                all cores.
+ * @param nodes   Node budget of the search AI in each position.
+ * @param seed    Base of random seeds.
+ */
+Distiller::Distiller(int threads, int nodes, unsigned seed) {
+    if (threads <= 0) {
+        threads = int(std::thread::hardware_concurrency());
+    } // if (threads <= 0)
+
+    this->threads = threads > 0 ? threads : 1;
+    this->nodes = nodes > 0 ? nodes : 1;
+    this->seed = seed;
+} // Distiller(int, int, unsigned) (Class Constructor)
+
+/**
+ * Sample a position, and let the search AI make its choice.
+ *
+ * @param index     Index of the position. Position i uses seed + i.
+ * @param outCell   Out parameter. Cell of the position.
+ * @param outLegal  Out parameter. Legal card kinds, as bits.
+ * @param outKind   Out parameter. Kind of the chosen card.
+ * @return Whether the position is useful, i.e. the player has at least
+ *         two legal kinds, and the search AI plays one of them.
+ */
+bool Distiller::sample(int index, int outCell[], int outLegal[],
+                       int outKind[]) {
+    int i, idx, legal, size;
+    Color color[1];
+    HardAgent agent;
+
+    // Play a hard AI self-play game to a random turn, and stop at the next
+    // time someone plays a card
+    Uno uno = Uno::newHeadlessInstance(seed + unsigned(index));
+    uno.setPlayers(3 + index % 2);
+    uno.setDifficulty(Uno::LV_HARD);
+    Simulator sim(&uno);
+    sim.start();
+    sim.run(index / 2 % 60, agent);
+    while (sim.getStatus() != Simulator::STAT_GAME_OVER
+        && (sim.getStatus() < Player::YOU
+        || sim.getStatus() > Player::COM3)) {
+        sim.step(agent);
+    } // while (sim.getStatus() != Simulator::STAT_GAME_OVER && ...)
+
+    if (sim.getStatus() == Simulator::STAT_GAME_OVER) {
+        return false;
+    } // if (sim.getStatus() == Simulator::STAT_GAME_OVER)
+
+    legal = 0;
+    const std::vector<Card*>& hand = uno.getCurrPlayer()->getHandCards();
+    size = int(hand.size());
+    for (i = 0; i < size; ++i) {
+        if (uno.isLegalToPlay(hand.at(i))) {
+            legal |= 1 << kindOf(hand.at(i));
+        } // if (uno.isLegalToPlay(hand.at(i)))
+    } // for (i = 0; i < size; ++i)
+
+    if (size < 2 || (legal & (legal - 1)) == 0) {
+        // Nothing to choose
+        return false;
+    } // if (size < 2 || (legal & (legal - 1)) == 0)
+
+    Uno game = uno;
+    game.setThinkNodes(nodes);
+    idx = AI(&game).searchAI_bestCardIndex4NowPlayer(color);
+    if (idx < 0) {
+        return false;
+    } // if (idx < 0)
+
+    outCell[0] = cellOf(&uno, AI(&uno).calcBestColor4NowPlayer());
+    outLegal[0] = legal;
+    outKind[0] = kindOf(hand.at(idx));
+    return true;
+} // sample(int, int[], int[], int[])
+
+/**
+ * Fit the priority order of a cell to the search AI's choices.
+ *
+ * @param cell Fit which cell.
+ */
+void Distiller::fit(int cell) {
+    int i, k, a, b, legal, best, rest;
+    long long score, bestScore, pref[KIND_COUNT][KIND_COUNT];
+    int defaults[KIND_COUNT];
+
+    // pref[a][b] counts how many times kind a is chosen while kind b is
+    // also legal
+    for (a = 0; a < KIND_COUNT; ++a) {
+        for (b = 0; b < KIND_COUNT; ++b) {
+            pref[a][b] = 0LL;
+        } // for (b = 0; b < KIND_COUNT; ++b)
+    } // for (a = 0; a < KIND_COUNT; ++a)
+
+    for (legal = 0; legal < 1 << KIND_COUNT; ++legal) {
+        for (a = 0; a < KIND_COUNT; ++a) {
+            for (b = 0; b < KIND_COUNT; ++b) {
+                if (b != a && (legal >> b & 1)) {
+                    pref[a][b] += hist[cell][legal][a];
+                } // if (b != a && (legal >> b & 1))
+            } // for (b = 0; b < KIND_COUNT; ++b)
+        } // for (a = 0; a < KIND_COUNT; ++a)
+    } // for (legal = 0; legal < 1 << KIND_COUNT; ++legal)
+
+    // Greedy ranking: each time take the kind which beats the rest most
+    // often. Ties keep the easy AI's order.
+    defaultOrder(cell, defaults);
+    rest = (1 << KIND_COUNT) - 1;
+    for (i = 0; i < KIND_COUNT; ++i) {
+        best = -1;
+        bestScore = 0LL;
+        for (k = 0; k < KIND_COUNT; ++k) {
+            a = defaults[k];
+            if (rest >> a & 1) {
+                score = 0LL;
+                for (b = 0; b < KIND_COUNT; ++b) {
+                    if (rest >> b & 1) {
+                        score += pref[a][b] - pref[b][a];
+                    } // if (rest >> b & 1)
+                } // for (b = 0; b < KIND_COUNT; ++b)
+
+                if (best < 0 || score > bestScore) {
+                    best = a;
+                    bestScore = score;
+                } // if (best < 0 || score > bestScore)
+            } // if (rest >> a & 1)
+        } // for (k = 0; k < KIND_COUNT; ++k)
+
+        order[cell][i] = best;
+        rest &= ~(1 << best);
+    } // for (i = 0; i < KIND_COUNT; ++i)
+} // fit(int)
+
+/**
+ * Count how many choices of the search AI are the same as the choices
+ * of the specified priority orders.
+ *
+ * @param orders Priority orders of card kinds in each cell.
+ * @return How many choices are the same.
+ */
+long long Distiller::agree(const int orders[][KIND_COUNT]) {
+    int cell, legal, i;
+    long long same = 0LL;
+
+    for (cell = 0; cell < CELL_COUNT; ++cell) {
+        for (legal = 1; legal < 1 << KIND_COUNT; ++legal) {
+            for (i = 0; !(legal >> orders[cell][i] & 1); ++i) {
+                // Find the first legal kind
+            } // for (i = 0; !(legal >> orders[cell][i] & 1); ++i)
+
+            same += hist[cell][legal][orders[cell][i]];
+        } // for (legal = 1; legal < 1 << KIND_COUNT; ++legal)
+    } // for (cell = 0; cell < CELL_COUNT; ++cell)
+
+    return same;
+} // agree(const int[][])
+
+/**
+ * Run the distiller.
+ *
+ * @param positions How many positions to sample.
+ * @param path      Write the generated header to this file.
+ * @return Whether the header is written successfully.
+ */
+bool Distiller::run(int positions, const char* path) {
+    int k, cell, legal;
+    long long total, same, sameEasy;
+    int defaults[CELL_COUNT][KIND_COUNT];
+    std::atomic<int> done(0);
+    std::ofstream writer;
+    std::mutex mutex;
+
+    for (cell = 0; cell < CELL_COUNT; ++cell) {
+        for (legal = 0; legal < 1 << KIND_COUNT; ++legal) {
+            for (k = 0; k < KIND_COUNT; ++k) {
+                hist[cell][legal][k] = 0LL;
+            } // for (k = 0; k < KIND_COUNT; ++k)
+        } // for (legal = 0; legal < 1 << KIND_COUNT; ++legal)
+    } // for (cell = 0; cell < CELL_COUNT; ++cell)
+
+    Scheduler scheduler(threads);
+    scheduler.run(positions, 0, [&](int, int n) {
+        int c[1], l[1], kind[1];
+
+        if (sample(n, c, l, kind)) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++hist[c[0]][l[0]][kind[0]];
+        } // if (sample(n, c, l, kind))
+
+        if (++done % 10000 == 0) {
+            std::cout << "sampled " << done << " / " << positions
+                << std::endl;
+        } // if (++done % 10000 == 0)
+    }); // scheduler.run()
+
+    total = 0LL;
+    for (cell = 0; cell < CELL_COUNT; ++cell) {
+        defaultOrder(cell, defaults[cell]);
+        fit(cell);
+        for (legal = 0; legal < 1 << KIND_COUNT; ++legal) {
+            for (k = 0; k < KIND_COUNT; ++k) {
+                total += hist[cell][legal][k];
+            } // for (k = 0; k < KIND_COUNT; ++k)
+        } // for (legal = 0; legal < 1 << KIND_COUNT; ++legal)
+    } // for (cell = 0; cell < CELL_COUNT; ++cell)
+
+    same = agree(order);
+    sameEasy = agree(defaults);
+    total = total > 0LL ? total : 1LL;
+    std::cout << "agreement with search AI: distilled "
+        << 100.0 * same / total << "%, easy "
+        << 100.0 * sameEasy / total << "%" << std::endl;
+
+    writer.open(path);
+    if (writer.fail()) {
+        return false;
+    } // if (writer.fail())
+
+    writer << "/////////////////////////////////////////////////////////////"
+        "///////////////////\n//\n// Uno Card Game 4 PC\n"
+        "// Author: Hikari Toyama\n"
+        "// Compile Environment: Qt 5 with Qt Creator\n"
+        "// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.\n//\n"
+        "/////////////////////////////////////////////////////////////"
+        "///////////////////\n\n"
+        "// Generated by \"UnoCard --distill\" (see Distiller class).\n"
+        "// Do not edit by hand. The same command reproduces this file\n"
+        "// exactly, with any number of threads:\n"
+        "// UnoCard --distill " << positions << " " << nodes << " 0 " << seed
+        << " include/Distilled.h\n"
+        "// Positions: " << positions << ", search nodes: " << nodes
+        << ", seed: " << seed << ".\n"
+        "// Agreement with search AI: " << 100.0 * same / total
+        << "% (easy AI: " << 100.0 * sameEasy / total << "%).\n\n"
+        "#ifndef __DISTILLED_H_494649FDFA62B3C015120BCB9BE17613__\n"
+        "#define __DISTILLED_H_494649FDFA62B3C015120BCB9BE17613__\n\n"
+        "#include \"include/Distiller.h\"\n\n"
+        "/**\n"
+        " * Priority order of card kinds (see Distiller::KIND_*) in each "
+        "cell (see\n"
+        " * Distiller::cellOf(Uno*, Color)). The first legal kind is "
+        "played.\n"
+        " */\n"
+        "static constexpr unsigned char DISTILLED_ORDER"
+        "[Distiller::CELL_COUNT]\n"
+        "    [Distiller::KIND_COUNT] = {\n";
+    for (cell = 0; cell < CELL_COUNT; ++cell) {
+        writer << "    {";
+        for (k = 0; k < KIND_COUNT; ++k) {
+            writer << " " << order[cell][k]
+                << (k < KIND_COUNT - 1 ? "," : "");
+        } // for (k = 0; k < KIND_COUNT; ++k)
+
+        writer << " }" << (cell < CELL_COUNT - 1 ? "," : " ") << " //";
+        for (k = 0; k < KIND_COUNT; ++k) {
+            writer << " " << KIND_NAMES[order[cell][k]];
+        } // for (k = 0; k < KIND_COUNT; ++k)
+
+        writer << "\n";
+    } // for (cell = 0; cell < CELL_COUNT; ++cell)
+
+    writer << "}; // DISTILLED_ORDER[][]\n\n"
+        "#endif // __DISTILLED_H_494649FDFA62B3C015120BCB9BE17613__\n\n"
+        "// E.O.F";
+    writer.close();
+    return !writer.fail();
+} // run(int, const char*)
+
+// E.O.F
\ No newline at end of file
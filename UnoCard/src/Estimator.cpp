@@ -0,0 +1,408 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <ostream>
+#include <unordered_map>
+#include "include/Simulator.h"
+#include "include/Estimator.h"
+#include "include/Lockstep.h"
+#include "include/Latency.h"
+#include "include/Player.h"
+#include "include/Uno.h"
+
+/**
+ * Race model of the lookup table: share of each kind of action card in the
+ * played cards (as in the deck), and how likely a player with n hand cards
+ * can play one of them (1 - MISS^n). MISS is fitted to the outcomes of
+ * hard AI self-play games.
+ */
+static const double SHARE_SKIP = 8.0 / 108.0;
+static const double SHARE_REV = 8.0 / 108.0;
+static const double SHARE_DRAW2 = 8.0 / 108.0;
+static const double SHARE_WD4 = 4.0 / 108.0;
+static const double MISS = 0.65;
+
+/**
+ * Constructor. Solves the lookup tables.
+ */
+Estimator::Estimator() : cancelled(false), version(0), root(0ULL) {
+    solve(3);
+    solve(4);
+} // Estimator() (Class Constructor)
+
+/**
+ * Solve the lookup table of the specified number of players.
+ *
+ * Table index is sum((a[j] - 1) * MAX_SIZE^j), where a[0] is current
+ * player's hand size (capped to MAX_SIZE), a[1] is the next player's, and
+ * so on in the action sequence. The n values at this index are the win
+ * probabilities of these players in the same order. So the direction is
+ * already included in the order, and one table serves all seats.
+ *
+ * @param players How many players in game, 3 or 4.
+ */
+void Estimator::solve(int players) {
+    int i, j, k, n, count, next;
+    int a[4], b[4];
+    double p, q, delta, value[4];
+    std::vector<float>& w = table[players - 3];
+
+    // Move a players' hand sizes to a table index after rotating r
+    // positions (r = 1 for the next player's turn, r = 2 for skipping the
+    // next player), or after reversing the action sequence (r = -1)
+    auto indexOf = [&](const int c[], int r) {
+        int index = 0;
+        for (int m = n - 1; m >= 0; --m) {
+            int from = r < 0 ? n - 1 - m : (m + r) % n;
+            index = index * MAX_SIZE + (c[from] - 1);
+        } // for (int m = n - 1; m >= 0; --m)
+        return index;
+    }; // indexOf()
+
+    // New position of the player at position k after the same move
+    auto moved = [&](int k, int r) {
+        return r < 0 ? n - 1 - k : (k - r + n) % n;
+    }; // moved()
+
+    n = players;
+    count = 1;
+    for (j = 0; j < n; ++j) {
+        count *= MAX_SIZE;
+    } // for (j = 0; j < n; ++j)
+
+    w.assign(size_t(count) * n, float(1.0 / n));
+    do {
+        delta = 0.0;
+        for (i = 0; i < count; ++i) {
+            for (j = 0, k = i; j < n; ++j, k /= MAX_SIZE) {
+                a[j] = k % MAX_SIZE + 1;
+            } // for (j = 0, k = i; j < n; ++j, k /= MAX_SIZE)
+
+            for (k = 0; k < n; ++k) {
+                value[k] = 0.0;
+            } // for (k = 0; k < n; ++k)
+
+            // Cannot play, draw a card
+            p = 1.0 - std::pow(MISS, a[0]);
+            for (j = 0; j < n; ++j) {
+                b[j] = a[j];
+            } // for (j = 0; j < n; ++j)
+
+            b[0] = std::min(a[0] + 1, MAX_SIZE);
+            next = indexOf(b, 1) * n;
+            for (k = 0; k < n; ++k) {
+                value[k] += (1.0 - p) * w[next + moved(k, 1)];
+            } // for (k = 0; k < n; ++k)
+
+            // Play a card
+            if (a[0] == 1) {
+                value[0] += p;
+            } // if (a[0] == 1)
+            else {
+                b[0] = a[0] - 1;
+                q = 1.0 - SHARE_SKIP - SHARE_REV - SHARE_DRAW2 - SHARE_WD4;
+                next = indexOf(b, 1) * n;
+                for (k = 0; k < n; ++k) {
+                    value[k] += p * q * w[next + moved(k, 1)];
+                } // for (k = 0; k < n; ++k)
+
+                next = indexOf(b, 2) * n;
+                for (k = 0; k < n; ++k) {
+                    value[k] += p * SHARE_SKIP * w[next + moved(k, 2)];
+                } // for (k = 0; k < n; ++k)
+
+                next = indexOf(b, -1) * n;
+                for (k = 0; k < n; ++k) {
+                    value[k] += p * SHARE_REV * w[next + moved(k, -1)];
+                } // for (k = 0; k < n; ++k)
+
+                b[1] = std::min(a[1] + 2, MAX_SIZE);
+                next = indexOf(b, 2) * n;
+                for (k = 0; k < n; ++k) {
+                    value[k] += p * SHARE_DRAW2 * w[next + moved(k, 2)];
+                } // for (k = 0; k < n; ++k)
+
+                b[1] = std::min(a[1] + 4, MAX_SIZE);
+                next = indexOf(b, 2) * n;
+                for (k = 0; k < n; ++k) {
+                    value[k] += p * SHARE_WD4 * w[next + moved(k, 2)];
+                } // for (k = 0; k < n; ++k)
+            } // else
+
+            // Update in place (Gauss-Seidel), which converges faster
+            for (k = 0; k < n; ++k) {
+                delta = std::max(delta, std::fabs(value[k] - w[i * n + k]));
+                w[i * n + k] = float(value[k]);
+            } // for (k = 0; k < n; ++k)
+        } // for (i = 0; i < count; ++i)
+    } while (delta > 1e-6);
+} // solve(int)
+
+/**
+ * Look up the table value of the current game state, without cache or
+ * simulation.
+ *
+ * @param uno Provide the Uno runtime.
+ * @param out Out parameter. Win probabilities, indexed by Player::YOU,
+ *            Player::COM1, Player::COM2, Player::COM3. The value of the
+ *            absent player in 3-player games is 0.
+ */
+void Estimator::lookup(Uno* uno, double out[]) {
+    int j, n, index, size, seat[4];
+
+    n = uno->getPlayers();
+    out[0] = out[1] = out[2] = out[3] = 0.0;
+    seat[0] = uno->getNow();
+    for (j = 1; j < n; ++j) {
+        seat[j] = (seat[j - 1] + uno->getDirection()) % 4;
+        if (n == 3 && seat[j] == Player::COM2) {
+            seat[j] = (seat[j] + uno->getDirection()) % 4;
+        } // if (n == 3 && seat[j] == Player::COM2)
+    } // for (j = 1; j < n; ++j)
+
+    index = 0;
+    for (j = n - 1; j >= 0; --j) {
+        size = uno->getPlayer(seat[j])->getHandSize();
+        if (size == 0) {
+            // Game over
+            out[seat[j]] = 1.0;
+            return;
+        } // if (size == 0)
+
+        index = index * MAX_SIZE + std::min(size, int(MAX_SIZE)) - 1;
+    } // for (j = n - 1; j >= 0; --j)
+
+    for (j = 0; j < n; ++j) {
+        out[seat[j]] = table[n - 3][index * n + j];
+    } // for (j = 0; j < n; ++j)
+} // lookup(Uno*, double[])
+
+/**
+ * Estimate everyone's win probability in the current game state. When
+ * the state is new, its simulation starts in background, and the
+ * simulation of the previous state stops.
+ *
+ * @param uno  Provide the Uno runtime.
+ * @param view Simulate games from whose view. Must be one of the
+ *             following: Player::YOU, Player::COM1, Player::COM2,
+ *             Player::COM3.
+ * @param out  Out parameter. See lookup(Uno*, double[]).
+ * @return How many simulated games are included in the estimate.
+ */
+long long Estimator::estimate(Uno* uno, int view, double out[]) {
+    int i;
+    Entry entry;
+    bool over;
+    unsigned long long key;
+
+    key = (uno->getStateHash() ^ (view + 1) * 0x9e3779b97f4a7c15ULL) | 1ULL;
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        for (i = 0; i < 4; ++i) {
+            out[i] = (it->second.prior[i] * PRIOR_GAMES
+                + it->second.wins[i]) / (PRIOR_GAMES + it->second.games);
+        } // for (i = 0; i < 4; ++i)
+
+        return it->second.games;
+    } // if (it != cache.end())
+
+    lock.unlock();
+    lookup(uno, out);
+    over = false;
+    for (i = 0; i < 4; ++i) {
+        entry.prior[i] = out[i];
+        entry.wins[i] = 0LL;
+        over = over || out[i] == 1.0;
+    } // for (i = 0; i < 4; ++i)
+
+    entry.games = 0LL;
+    lock.lock();
+    if (cache.size() >= size_t(MAX_CACHE)) {
+        cache.clear();
+    } // if (cache.size() >= size_t(MAX_CACHE))
+
+    cache[key] = entry;
+    lock.unlock();
+
+    if (!over && key != root) {
+        cancel();
+        root = key;
+        cancelled = false;
+        thread = std::thread(&Estimator::run, this, *uno, view, key);
+    } // if (!over && key != root)
+
+    return 0LL;
+} // estimate(Uno*, int, double[])
+
+/**
+ * Write everyone's win probability from your view as a line of log.
+ *
+ * @param uno Provide the Uno runtime.
+ * @param out Output stream.
+ */
+void Estimator::log(Uno* uno, std::ostream& out) {
+    int i;
+    long long games;
+    double chance[4];
+    static const char* const NAMES[] = { "YOU", "WEST", "NORTH", "EAST" };
+
+    games = estimate(uno, Player::YOU, chance);
+    out << "Win chance (" << games << " games):";
+    for (i = Player::YOU; i <= Player::COM3; ++i) {
+        if (uno->getPlayers() == 4 || i != Player::COM2) {
+            out << " " << NAMES[i] << " "
+                << int(chance[i] * 100.0 + 0.5) << "%";
+        } // if (uno->getPlayers() == 4 || i != Player::COM2)
+    } // for (i = Player::YOU; i <= Player::COM3; ++i)
+
+    out << std::endl;
+} // log(Uno*, std::ostream&)
+
+/**
+ * @return A number that changes each time an estimate changes. Compare
+ *         it with the value got last time to know when to repaint.
+ */
+int Estimator::getVersion() {
+    return version;
+} // getVersion()
+
+/**
+ * Worker thread entry.
+ *
+ * @param game A copy of the Uno runtime.
+ * @param view Simulate games from whose view.
+ * @param key  Cache key of the game state.
+ */
+void Estimator::run(Uno game, int view, unsigned long long key) {
+    int g, i, winner;
+    long long wins[4], games;
+    Latency::Mute mute; // Simulated games are not decisions at a table
+
+    game.setThinkTime(0);
+    game.setThinkNodes(0);
+    wins[0] = wins[1] = wins[2] = wins[3] = games = 0LL;
+    if (Lockstep::isSupported(&game)) {
+        // Play LANES games at once, with the same results
+        Lockstep batch;
+        for (g = 0; g < MAX_GAMES; g += Lockstep::LANES) {
+            for (i = 0; i < Lockstep::LANES; ++i) {
+                Uno copy = game;
+                copy.setRandState(key + (g + i) * 0x9e3779b97f4a7c15ULL);
+                copy.redeal(view);
+                batch.load(i, &copy);
+            } // for (i = 0; i < Lockstep::LANES; ++i)
+
+            // Check the cancel flag every few steps
+            do {
+                if (cancelled) {
+                    return;
+                } // if (cancelled)
+
+                for (i = 0; i < 7; ++i) {
+                    batch.step(MAX_TURNS);
+                } // for (i = 0; i < 7; ++i)
+            } while (batch.step(MAX_TURNS) > 0);
+
+            for (i = 0; i < Lockstep::LANES; ++i) {
+                winner = batch.getWinner(i);
+                if (winner >= 0) {
+                    ++wins[winner];
+                    ++games;
+                } // if (winner >= 0)
+            } // for (i = 0; i < Lockstep::LANES; ++i)
+
+            if (!publish(key, wins, games)) {
+                return;
+            } // if (!publish(key, wins, games))
+        } // for (g = 0; g < MAX_GAMES; g += Lockstep::LANES)
+
+        return;
+    } // if (Lockstep::isSupported(&game))
+
+    for (g = 0; g < MAX_GAMES; ++g) {
+        Uno copy = game;
+        copy.setRandState(key + g * 0x9e3779b97f4a7c15ULL);
+        copy.redeal(view);
+        Simulator sim(&copy);
+
+        // Check the cancel flag every few turns
+        do {
+            if (cancelled) {
+                return;
+            } // if (cancelled)
+
+            sim.run(sim.getTurns() + 8);
+        } while (sim.getStatus() != Simulator::STAT_GAME_OVER
+            && sim.getTurns() < MAX_TURNS);
+
+        winner = sim.getWinner();
+        if (winner >= 0) {
+            ++wins[winner];
+            ++games;
+        } // if (winner >= 0)
+
+        if ((g % 16 == 15 || g == MAX_GAMES - 1)
+            && !publish(key, wins, games)) {
+            return;
+        } // if ((g % 16 == 15 || g == MAX_GAMES - 1) && ...)
+    } // for (g = 0; g < MAX_GAMES; ++g)
+} // run(Uno, int, unsigned long long)
+
+/**
+ * Publish the results so far.
+ *
+ * @param key   Cache key of the game state.
+ * @param wins  How many games each player won.
+ * @param games How many games have a winner.
+ * @return False if the cache entry has been thrown away, so the worker
+ *         thread should stop.
+ */
+bool Estimator::publish(unsigned long long key, const long long wins[],
+                        long long games) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = cache.find(key);
+    if (it == cache.end()) {
+        return false;
+    } // if (it == cache.end())
+
+    for (int i = 0; i < 4; ++i) {
+        it->second.wins[i] = wins[i];
+    } // for (int i = 0; i < 4; ++i)
+
+    it->second.games = games;
+    ++version;
+    return true;
+} // publish(unsigned long long, const long long[], long long)
+
+/**
+ * Stop the background simulation.
+ */
+void Estimator::cancel() {
+    cancelled = true;
+    if (thread.joinable()) {
+        thread.join();
+    } // if (thread.joinable())
+
+    root = 0ULL;
+} // cancel()
+
+/**
+ * Destructor.
+ */
+Estimator::~Estimator() {
+    cancel();
+} // ~Estimator() (Class Destructor)
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,253 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include "include/Transposition.h"
+#include "include/Simulator.h"
+#include "include/Hinter.h"
+#include "include/Latency.h"
+#include "include/Player.h"
+#include "include/Color.h"
+#include "include/Card.h"
+#include "include/Uno.h"
+
+/**
+ * Constructor.
+ */
+Hinter::Hinter() : cancelled(false), hint(-1), version(0), root(0ULL) {
+} // Hinter() (Class Constructor)
+
+/**
+ * Start to search in background. Call this function when you are
+ * thinking in your turn. Calling it again with the same game state
+ * does nothing.
+ *
+ * @param uno Provide the Uno runtime.
+ */
+void Hinter::start(Uno* uno) {
+    unsigned long long hash = uno->getStateHash();
+
+    if (hash != root) {
+        cancel();
+        root = hash;
+        cancelled = false;
+        thread = std::thread(&Hinter::run, this, *uno);
+    } // if (hash != root)
+} // start(Uno*)
+
+/**
+ * Stop the background search and throw away the hint.
+ */
+void Hinter::cancel() {
+    cancelled = true;
+    if (thread.joinable()) {
+        thread.join();
+    } // if (thread.joinable())
+
+    if (hint.exchange(-1) >= 0) {
+        ++version;
+    } // if (hint.exchange(-1) >= 0)
+
+    root = 0ULL;
+} // cancel()
+
+/**
+ * Get the current hint. Never blocks.
+ *
+ * @param uno      Provide the Uno runtime.
+ * @param outIndex Out parameter. Index of the hinted card to play, or a
+ *                 negative number that means to draw a card.
+ * @param outColor Out parameter. When the hinted card is a wild card,
+ *                 outColor[0] becomes the following legal color to
+ *                 change. Otherwise it becomes NONE.
+ * @return Whether a hint for the current game state is available.
+ */
+bool Hinter::getHint(Uno* uno, int* outIndex, Color outColor[]) {
+    int packed = hint;
+
+    if (packed < 0 || root == 0ULL || uno->getStateHash() != root) {
+        return false;
+    } // if (packed < 0 || root == 0ULL || ...)
+
+    *outIndex = packed / 8 - 1;
+    outColor[0] = Color(packed % 8);
+    return true;
+} // getHint(Uno*, int*, Color[])
+
+/**
+ * @return A number that changes each time the hint changes. Compare it
+ *         with the value got last time to know when to repaint.
+ */
+int Hinter::getVersion() {
+    return version;
+} // getVersion()
+
+/**
+ * Publish a new hint.
+ *
+ * @param index Play which card, or -1 to draw a card.
+ * @param color Following legal color when playing a wild card.
+ */
+void Hinter::publish(int index, Color color) {
+    int packed = (index + 1) * 8 + color;
+
+    if (hint.exchange(packed) != packed) {
+        ++version;
+    } // if (hint.exchange(packed) != packed)
+} // publish(int, Color)
+
+/**
+ * Worker thread entry.
+ *
+ * @param game A copy of the Uno runtime in your turn.
+ */
+void Hinter::run(Uno game) {
+    struct Branch {
+        int index;
+        Color color;
+        int better, worse;
+    }; // Branch Struct
+
+    static const Color COLORS[] = { RED, BLUE, GREEN, YELLOW };
+    Card* card;
+    bool won, won0;
+    double score, bestScore;
+    unsigned long long key, seed;
+    std::vector<Branch> branches;
+    int i, k, n, me, size, best, idxBest, winner[1];
+    Transposition* table = Transposition::getInstance();
+    Color bestColor[1];
+    Latency::Mute mute; // Simulated games are not decisions at a table
+
+    me = game.getNow();
+    seed = game.getStateHash();
+    game.setThinkTime(0);
+    game.setThinkNodes(0);
+
+    // Start with the answer of the fixed strategies
+    Uno first = game;
+    idxBest = Simulator(&first).bestCardIndex4NowPlayer(bestColor);
+    const std::vector<Card*>& hand = game.getCurrPlayer()->getHandCards();
+    size = int(hand.size());
+    if (idxBest < 0 || !hand.at(idxBest)->isWild()) {
+        bestColor[0] = NONE;
+    } // if (idxBest < 0 || !hand.at(idxBest)->isWild())
+
+    publish(idxBest, bestColor[0]);
+
+    // List all legal actions, the same cards only once
+    for (i = 0; i < size; ++i) {
+        card = hand.at(i);
+        if (!game.isLegalToPlay(card) || (i > 0 && hand.at(i - 1) == card)) {
+            continue;
+        } // if (!game.isLegalToPlay(card) || ...)
+
+        if (card->isWild() && size > 1) {
+            for (Color color : COLORS) {
+                branches.push_back(Branch{ i, color, 0, 0 });
+            } // for (Color color : COLORS)
+        } // if (card->isWild() && size > 1)
+        else {
+            branches.push_back(Branch{ i, NONE, 0, 0 });
+        } // else
+    } // for (i = 0; i < size; ++i)
+
+    branches.push_back(Branch{ -1, NONE, 0, 0 });
+
+    // Move the answer of the fixed strategies to the front
+    for (k = 0; k < int(branches.size()); ++k) {
+        Branch& b = branches[k];
+        if (idxBest < 0
+            ? b.index < 0
+            : b.index >= 0
+            && hand.at(b.index) == hand.at(idxBest)
+            && (b.color == NONE || b.color == bestColor[0])) {
+            std::swap(branches[0], branches[k]);
+            break;
+        } // if (idxBest < 0 ? ... : ...)
+    } // for (k = 0; k < int(branches.size()); ++k)
+
+    // Simulate games round by round, the same way as
+    // AI::searchAI_bestCardIndex4NowPlayer(Color[]) does
+    won0 = false;
+    best = 0;
+    n = int(branches.size()) * MAX_ROUNDS;
+    for (i = 0; i < n && branches.size() > 1; ++i) {
+        k = i % int(branches.size());
+        Branch& b = branches[k];
+        Uno copy = game;
+        copy.setRandState(seed + i / branches.size() * 0x9e3779b97f4a7c15ULL);
+        copy.redeal(me);
+        Simulator sim(&copy);
+        if (b.index >= 0) {
+            sim.play(b.index, b.color);
+        } // if (b.index >= 0)
+        else {
+            sim.draw();
+        } // else
+
+        // Other searches may have played this game already
+        key = Transposition::keyOf(&copy, sim.getStatus(), sim.getTurns());
+        if (!table->probe(key, winner)) {
+            // Check the cancel flag every few turns
+            do {
+                if (cancelled) {
+                    return;
+                } // if (cancelled)
+
+                sim.run(sim.getTurns() + 8);
+            } while (sim.getStatus() != Simulator::STAT_GAME_OVER
+                && sim.getTurns() < MAX_TURNS);
+
+            winner[0] = sim.getWinner();
+            table->store(key, winner[0], sim.getTurns());
+        } // if (!table->probe(key, winner))
+
+        won = winner[0] == me;
+        if (k == 0) {
+            won0 = won;
+        } // if (k == 0)
+        else if (won && !won0) {
+            ++b.better;
+        } // else if (won && !won0)
+        else if (!won && won0) {
+            ++b.worse;
+        } // else if (!won && won0)
+
+        if (k == int(branches.size()) - 1) {
+            // End of a round. Another branch replaces the answer of the
+            // fixed strategies only when it wins significantly more often
+            // in these paired games (two-sigma sign test).
+            bestScore = 0.0;
+            for (k = 1, best = 0; k < int(branches.size()); ++k) {
+                score = branches[k].better - branches[k].worse;
+                if (score > bestScore && score > 2.0
+                    * std::sqrt(branches[k].better + branches[k].worse)) {
+                    bestScore = score;
+                    best = k;
+                } // if (score > bestScore && ...)
+            } // for (k = 1, best = 0; k < int(branches.size()); ++k)
+
+            publish(branches[best].index, branches[best].color);
+        } // if (k == int(branches.size()) - 1)
+    } // for (i = 0; i < n && branches.size() > 1; ++i)
+} // run(Uno)
+
+/**
+ * Destructor.
+ */
+Hinter::~Hinter() {
+    cancel();
+} // ~Hinter() (Class Destructor)
+
+// E.O.F
\ No newline at end of file
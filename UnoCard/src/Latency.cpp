@@ -0,0 +1,306 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <mutex>
+#include <chrono>
+#include <cstring>
+#include <ostream>
+#include "include/Latency.h"
+
+/**
+ * Histogram buckets, counts and max values.
+ */
+struct Histograms {
+    long long buckets[Latency::ENTRY_COUNT][Latency::LEVEL_COUNT]
+        [Latency::BUCKET_COUNT];
+    long long counts[Latency::ENTRY_COUNT][Latency::LEVEL_COUNT];
+    long long max[Latency::ENTRY_COUNT][Latency::LEVEL_COUNT];
+
+    /**
+     * Add other histograms to this one, and clear the other one.
+     */
+    void take(Histograms& other) {
+        int i, j, k;
+
+        for (i = 0; i < Latency::ENTRY_COUNT; ++i) {
+            for (j = 0; j < Latency::LEVEL_COUNT; ++j) {
+                for (k = 0; k < Latency::BUCKET_COUNT; ++k) {
+                    buckets[i][j][k] += other.buckets[i][j][k];
+                } // for (k = 0; k < Latency::BUCKET_COUNT; ++k)
+
+                counts[i][j] += other.counts[i][j];
+                if (other.max[i][j] > max[i][j]) {
+                    max[i][j] = other.max[i][j];
+                } // if (other.max[i][j] > max[i][j])
+            } // for (j = 0; j < Latency::LEVEL_COUNT; ++j)
+        } // for (i = 0; i < Latency::ENTRY_COUNT; ++i)
+
+        memset(&other, 0, sizeof(Histograms));
+    } // take(Histograms&)
+}; // Histograms Struct
+
+/**
+ * Guards [sMerged].
+ */
+static std::mutex sMutex;
+
+/**
+ * Histograms merged from all threads.
+ */
+static Histograms sMerged;
+
+/**
+ * Histograms of the calling thread, merged into [sMerged] when it exits.
+ */
+struct LocalHistograms {
+    /**
+     * Allocated when the thread records its first latency, so that
+     * threads that never record cost no memory.
+     */
+    Histograms* data = nullptr;
+
+    /**
+     * How many Timer and Mute scopes are open.
+     */
+    int depth = 0;
+
+    ~LocalHistograms() {
+        if (data != nullptr) {
+            std::lock_guard<std::mutex> lock(sMutex);
+            sMerged.take(*data);
+            delete data;
+        } // if (data != nullptr)
+    } // ~LocalHistograms()
+}; // LocalHistograms Struct
+
+static thread_local LocalHistograms tLocal;
+
+/**
+ * @param nanos A latency in nano seconds.
+ * @return Index of the bucket that counts the specified latency.
+ */
+static int bucketOf(long long nanos) {
+    int shift;
+
+    if (nanos < 16) {
+        return nanos < 0 ? 0 : int(nanos);
+    } // if (nanos < 16)
+
+    // Keep the highest 5 bits, i.e. 16 buckets per power of 2
+    for (shift = 0; (nanos >> shift) >= 32; ++shift);
+    return (shift + 1) * 16 + int(nanos >> shift) - 16;
+} // bucketOf(long long)
+
+/**
+ * @param bucket Index of a bucket.
+ * @return The max latency counted by the specified bucket.
+ */
+static long long boundOf(int bucket) {
+    int shift;
+
+    if (bucket < 16) {
+        return bucket;
+    } // if (bucket < 16)
+
+    shift = bucket / 16 - 1;
+    return ((16LL + bucket % 16 + 1) << shift) - 1;
+} // boundOf(int)
+
+/**
+ * Constructor.
+ *
+ * @param entry AI entry point.
+ * @param level Current difficulty.
+ */
+Latency::Timer::Timer(int entry, int level) : entry(entry), level(level) {
+    top = tLocal.depth++ == 0;
+    if (top) {
+        start = std::chrono::steady_clock::now();
+    } // if (top)
+} // Timer(int, int) (Class Constructor)
+
+/**
+ * Destructor.
+ */
+Latency::Timer::~Timer() {
+    --tLocal.depth;
+    if (top) {
+        record(entry, level,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    } // if (top)
+} // ~Timer() (Class Destructor)
+
+/**
+ * Constructor.
+ */
+Latency::Mute::Mute() {
+    ++tLocal.depth;
+} // Mute() (Class Constructor)
+
+/**
+ * Destructor.
+ */
+Latency::Mute::~Mute() {
+    --tLocal.depth;
+} // ~Mute() (Class Destructor)
+
+/**
+ * Record a latency in the calling thread's histograms.
+ *
+ * @param entry AI entry point.
+ * @param level Current difficulty.
+ * @param nanos Latency in nano seconds.
+ */
+void Latency::record(int entry, int level, long long nanos) {
+    Histograms* data;
+
+    if (entry < 0 || entry >= ENTRY_COUNT
+        || level < 0 || level >= LEVEL_COUNT) {
+        return;
+    } // if (entry < 0 || entry >= ENTRY_COUNT || ...)
+
+    if (tLocal.data == nullptr) {
+        tLocal.data = new Histograms();
+    } // if (tLocal.data == nullptr)
+
+    data = tLocal.data;
+    ++data->buckets[entry][level][bucketOf(nanos)];
+    ++data->counts[entry][level];
+    if (nanos > data->max[entry][level]) {
+        data->max[entry][level] = nanos;
+    } // if (nanos > data->max[entry][level])
+} // record(int, int, long long)
+
+/**
+ * Merge the calling thread's histograms. Call with [sMutex] locked.
+ *
+ * @return The merged histograms.
+ */
+static Histograms& merged() {
+    if (tLocal.data != nullptr) {
+        sMerged.take(*tLocal.data);
+    } // if (tLocal.data != nullptr)
+
+    return sMerged;
+} // merged()
+
+/**
+ * @param h     Histograms.
+ * @param entry AI entry point.
+ * @param level Difficulty.
+ * @param q     Quantile, in range [0, 1].
+ * @return The latency that q of all recorded latencies do not exceed.
+ */
+static long long percentileOf(const Histograms& h, int entry, int level,
+                              double q) {
+    int i;
+    long long rank, seen, max;
+
+    rank = (long long)(q * h.counts[entry][level] + 0.5);
+    rank = rank < 1 ? 1 : rank;
+    seen = 0LL;
+    max = h.max[entry][level];
+    for (i = 0; i < Latency::BUCKET_COUNT; ++i) {
+        seen += h.buckets[entry][level][i];
+        if (seen >= rank) {
+            // Never exceed the exact max value
+            return boundOf(i) < max ? boundOf(i) : max;
+        } // if (seen >= rank)
+    } // for (i = 0; i < Latency::BUCKET_COUNT; ++i)
+
+    return max;
+} // percentileOf(const Histograms&, int, int, double)
+
+/**
+ * @param entry AI entry point.
+ * @param level Difficulty.
+ * @return How many latencies are recorded, by the exited threads and
+ *         by the calling thread.
+ */
+long long Latency::getCount(int entry, int level) {
+    std::lock_guard<std::mutex> lock(sMutex);
+    return merged().counts[entry][level];
+} // getCount(int, int)
+
+/**
+ * @param entry AI entry point.
+ * @param level Difficulty.
+ * @param q     Quantile, in range [0, 1], e.g. 0.99 for p99.
+ * @return The latency (in nano seconds) that q of all recorded
+ *         latencies do not exceed, rounded up to its bucket's bound.
+ *         Or 0 if nothing is recorded.
+ */
+long long Latency::getPercentile(int entry, int level, double q) {
+    std::lock_guard<std::mutex> lock(sMutex);
+    return percentileOf(merged(), entry, level, q);
+} // getPercentile(int, int, double)
+
+/**
+ * @param entry AI entry point.
+ * @param level Difficulty.
+ * @return The max latency in nano seconds, or 0 if nothing is recorded.
+ */
+long long Latency::getMax(int entry, int level) {
+    std::lock_guard<std::mutex> lock(sMutex);
+    return merged().max[entry][level];
+} // getMax(int, int)
+
+/**
+ * Write p50, p99 and max of all non-empty histograms as a JSON array,
+ * recorded by the exited threads and by the calling thread.
+ *
+ * @param out Output stream.
+ */
+void Latency::dump(std::ostream& out) {
+    int i, j;
+    bool first = true;
+    static const char* const ENTRIES[ENTRY_COUNT] = {
+        "calcBestColor4NowPlayer", "calcBestSwapTarget4NowPlayer",
+        "needToChallenge", "easyAI_bestCardIndex4NowPlayer",
+        "hardAI_bestCardIndex4NowPlayer",
+        "sevenZeroAI_bestCardIndex4NowPlayer",
+        "policyAI_bestCardIndex4NowPlayer",
+        "searchAI_bestCardIndex4NowPlayer",
+        "distilledAI_bestCardIndex4NowPlayer"
+    }; // ENTRIES[]
+    static const char* const LEVELS[LEVEL_COUNT] = {
+        "easy", "hard", "policy"
+    }; // LEVELS[]
+    std::lock_guard<std::mutex> lock(sMutex);
+    const Histograms& h = merged();
+
+    out << "[";
+    for (i = 0; i < ENTRY_COUNT; ++i) {
+        for (j = 0; j < LEVEL_COUNT; ++j) {
+            if (h.counts[i][j] > 0) {
+                out << (first ? "" : ", ")
+                    << "{\"entry\": \"" << ENTRIES[i] << "\""
+                    << ", \"level\": \"" << LEVELS[j] << "\""
+                    << ", \"count\": " << h.counts[i][j]
+                    << ", \"p50Nanos\": " << percentileOf(h, i, j, 0.50)
+                    << ", \"p99Nanos\": " << percentileOf(h, i, j, 0.99)
+                    << ", \"maxNanos\": " << h.max[i][j] << "}";
+                first = false;
+            } // if (h.counts[i][j] > 0)
+        } // for (j = 0; j < LEVEL_COUNT; ++j)
+    } // for (i = 0; i < ENTRY_COUNT; ++i)
+
+    out << "]";
+} // dump(std::ostream&)
+
+/**
+ * Clear the merged histograms and the calling thread's histograms.
+ */
+void Latency::reset() {
+    std::lock_guard<std::mutex> lock(sMutex);
+    memset(&merged(), 0, sizeof(Histograms));
+} // reset()
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,946 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include "include/Simulator.h"
+#include "include/Lockstep.h"
+#include "include/Content.h"
+#include "include/Player.h"
+#include "include/Color.h"
+#include "include/Card.h"
+#include "include/Uno.h"
+#include "include/AI.h"
+
+#if defined(__AVX2__)
+#define LOCKSTEP_AVX2 1
+#include <immintrin.h>
+#endif // defined(__AVX2__)
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif // _MSC_VER
+
+/**
+ * Card ID of an empty hand slot. Its legality bit is never set.
+ */
+static const unsigned char EMPTY_ID = 63;
+
+/**
+ * Color and content of an empty hand slot. Equals to no color or content.
+ */
+static const unsigned char EMPTY_ATTR = 0x7f;
+
+/**
+ * @param id Card ID.
+ * @return Color of the card.
+ */
+static inline unsigned char colorOf(int id) {
+    return (unsigned char)(id < 52 ? id / 13 + 1 : NONE);
+} // colorOf(int)
+
+/**
+ * @param id Card ID.
+ * @return Content of the card.
+ */
+static inline unsigned char contentOf(int id) {
+    return (unsigned char)(id < 52 ? id % 13 : id - 39);
+} // contentOf(int)
+
+/**
+ * @param x A non-zero value.
+ * @return Index of the lowest set bit.
+ */
+static inline int lowestBit(unsigned x) {
+#ifdef _MSC_VER
+    unsigned long i;
+    _BitScanForward(&i, x);
+    return int(i);
+#else
+    return __builtin_ctz(x);
+#endif // _MSC_VER
+} // lowestBit(unsigned)
+
+/**
+ * @param x A non-zero value.
+ * @return Index of the highest set bit.
+ */
+static inline int highestBit(unsigned x) {
+#ifdef _MSC_VER
+    unsigned long i;
+    _BitScanReverse(&i, x);
+    return int(i);
+#else
+    return 31 - __builtin_clz(x);
+#endif // _MSC_VER
+} // highestBit(unsigned)
+
+/**
+ * @param x Any value.
+ * @return How many bits are set.
+ */
+static inline int popCount(unsigned x) {
+#ifdef _MSC_VER
+    return int(__popcnt(x));
+#else
+    return __builtin_popcount(x);
+#endif // _MSC_VER
+} // popCount(unsigned)
+
+/**
+ * Pick a card of a kind in the same way as the EASY AI strategies do: the
+ * last one in the best color, or the first one if none is in that color.
+ *
+ * @param kind Legal cards of the kind.
+ * @param best Cards in the best color.
+ * @return Index of the picked card, or -1 if none.
+ */
+static inline int pick(unsigned kind, unsigned best) {
+    return kind == 0 ? -1
+        : (kind & best) != 0 ? highestBit(kind & best)
+        : lowestBit(kind);
+} // pick(unsigned, unsigned)
+
+/**
+ * @param card Provide a card.
+ * @return Card ID of the card, see Card::id.
+ */
+static inline int idOf(Card* card) {
+    return card->isWild()
+        ? 39 + card->content
+        : 13 * (card->color - 1) + card->content;
+} // idOf(Card*)
+
+/**
+ * Remove a card from a hand row, and shift the following cards forward.
+ */
+static inline void eraseAt(unsigned char* ids,
+                           unsigned char* colors,
+                           unsigned char* contents,
+                           int size, int index) {
+    for (int i = index; i < size - 1; ++i) {
+        ids[i] = ids[i + 1];
+        colors[i] = colors[i + 1];
+        contents[i] = contents[i + 1];
+    } // for (int i = index; i < size - 1; ++i)
+
+    ids[size - 1] = EMPTY_ID;
+    colors[size - 1] = contents[size - 1] = EMPTY_ATTR;
+} // eraseAt(unsigned char*, unsigned char*, unsigned char*, int, int)
+
+/**
+ * Insert a card into a hand row, and shift the following cards backward.
+ */
+static inline void insertAt(unsigned char* ids,
+                            unsigned char* colors,
+                            unsigned char* contents,
+                            int size, int index, int id) {
+    for (int i = size; i > index; --i) {
+        ids[i] = ids[i - 1];
+        colors[i] = colors[i - 1];
+        contents[i] = contents[i - 1];
+    } // for (int i = size; i > index; --i)
+
+    ids[index] = (unsigned char)id;
+    colors[index] = colorOf(id);
+    contents[index] = contentOf(id);
+} // insertAt(unsigned char*, unsigned char*, unsigned char*, int, int, int)
+
+/**
+ * Constructor. All lanes are empty (game over).
+ */
+Lockstep::Lockstep() {
+    for (int lane = 0; lane < LANES; ++lane) {
+        clear(lane);
+    } // for (int lane = 0; lane < LANES; ++lane)
+} // Lockstep() (Class Constructor)
+
+/**
+ * @param uno Provide the Uno runtime.
+ * @return Whether the game in the provided Uno runtime can be played
+ *         by us, i.e. easy difficulty, not in 7-0 rule, and AI has no
+ *         budgets.
+ */
+bool Lockstep::isSupported(Uno* uno) {
+    return uno->getDifficulty() == Uno::LV_EASY
+        && !uno->isSevenZeroRule()
+        && uno->getThinkTime() <= 0
+        && uno->getThinkNodes() <= 0;
+} // isSupported(Uno*)
+
+/**
+ * Load a game in process into a lane. The lane takes over the game
+ * from the turn of uno->getNow(), in the same way as the constructor
+ * Simulator(Uno*) does. The Uno runtime is not changed.
+ *
+ * @param lane Load into which lane (0 ~ LANES - 1).
+ * @param uno  Provide the Uno runtime. Must be supported, see
+ *             isSupported(Uno*).
+ */
+void Lockstep::load(int lane, Uno* uno) {
+    int i, who, size;
+
+    if (!isSupported(uno)) {
+        throw "Lockstep supports only easy games without 7-0 or budgets";
+    } // if (!isSupported(uno))
+
+    for (who = Player::YOU; who <= Player::COM3; ++who) {
+        Player& p = uno->player[who];
+        size = int(p.handCards.size());
+        for (i = 0; i < 16; ++i) {
+            int id = i < size ? idOf(p.handCards[i]) : -1;
+            hand[lane][who][i] = id < 0 ? EMPTY_ID : (unsigned char)id;
+            handColor[lane][who][i] = id < 0 ? EMPTY_ATTR : colorOf(id);
+            handContent[lane][who][i] = id < 0 ? EMPTY_ATTR : contentOf(id);
+        } // for (i = 0; i < 16; ++i)
+
+        handSize[lane][who] = size;
+        strongCount[lane][who] = p.strongCount;
+        strongColor[lane][who] = p.strongColor;
+        weakColor[lane][who] = p.weakColor;
+        params[lane][who] = uno->aiParams[who] != nullptr
+            ? uno->aiParams[who]
+            : AI::DEFAULT_PARAMS;
+    } // for (who = Player::YOU; who <= Player::COM3; ++who)
+
+    deckSize[lane] = int(uno->deck.size());
+    for (i = 0; i < deckSize[lane]; ++i) {
+        deck[lane][i] = (unsigned char)idOf(uno->deck[i]);
+    } // for (i = 0; i < deckSize[lane]; ++i)
+
+    usedSize[lane] = int(uno->used.size());
+    for (i = 0; i < usedSize[lane]; ++i) {
+        used[lane][i] = (unsigned char)idOf(uno->used[i]);
+    } // for (i = 0; i < usedSize[lane]; ++i)
+
+    recentSize[lane] = int(uno->recent.size());
+    for (i = 0; i < recentSize[lane]; ++i) {
+        recent[lane][i] = (unsigned char)idOf(uno->recent[i]);
+        recentColor[lane][i] = (unsigned char)uno->recentColors[i];
+    } // for (i = 0; i < recentSize[lane]; ++i)
+
+    legality[lane] = (unsigned long long)uno->legality;
+    randState[lane] = uno->randState;
+    now[lane] = uno->now;
+    players[lane] = uno->players;
+    direction[lane] = uno->direction;
+    draw2StackCount[lane] = uno->draw2StackCount;
+    forcePlay[lane] = uno->forcePlay;
+    draw2StackRule[lane] = uno->draw2StackRule;
+    status[lane] = recentSize[lane] == 0
+        ? Simulator::STAT_GAME_OVER
+        : now[lane];
+    winner[lane] = -1;
+    turns[lane] = 0;
+    selectedIdx[lane] = -1;
+} // load(int, Uno*)
+
+/**
+ * Empty a lane, so that it makes no more decisions.
+ *
+ * @param lane Empty which lane (0 ~ LANES - 1).
+ */
+void Lockstep::clear(int lane) {
+    for (int who = Player::YOU; who <= Player::COM3; ++who) {
+        for (int i = 0; i < 16; ++i) {
+            hand[lane][who][i] = EMPTY_ID;
+            handColor[lane][who][i] = handContent[lane][who][i] = EMPTY_ATTR;
+        } // for (int i = 0; i < 16; ++i)
+
+        handSize[lane][who] = 0;
+    } // for (int who = Player::YOU; who <= Player::COM3; ++who)
+
+    legality[lane] = 0ULL;
+    now[lane] = Player::YOU;
+    status[lane] = Simulator::STAT_GAME_OVER;
+    winner[lane] = -1;
+    turns[lane] = 0;
+    selectedIdx[lane] = -1;
+} // clear(int)
+
+/**
+ * Compute the masks of all lanes.
+ *
+ * @param out Out parameter. Masks of each lane.
+ */
+void Lockstep::scan(Masks out[]) {
+#if LOCKSTEP_AVX2
+    // Two lanes per register, one in each 128-bit half. The legality bit
+    // of each card is looked up by two byte shuffles: the byte of the
+    // legality binary (ID / 8), then the bit in that byte (ID % 8).
+    const __m256i seven = _mm256_set1_epi8(7);
+    const __m256i bits = _mm256_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,
+        1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+
+    for (int lane = 0; lane < LANES; lane += 2) {
+        int a = now[lane], b = now[lane + 1];
+        __m256i ids = _mm256_inserti128_si256(_mm256_castsi128_si256(
+            _mm_loadu_si128((const __m128i*)hand[lane][a])),
+            _mm_loadu_si128((const __m128i*)hand[lane + 1][b]), 1);
+        __m256i colors = _mm256_inserti128_si256(_mm256_castsi128_si256(
+            _mm_loadu_si128((const __m128i*)handColor[lane][a])),
+            _mm_loadu_si128((const __m128i*)handColor[lane + 1][b]), 1);
+        __m256i contents = _mm256_inserti128_si256(_mm256_castsi128_si256(
+            _mm_loadu_si128((const __m128i*)handContent[lane][a])),
+            _mm_loadu_si128((const __m128i*)handContent[lane + 1][b]), 1);
+        __m256i table = _mm256_set_epi64x(
+            0LL, (long long)legality[lane + 1], 0LL, (long long)legality[lane]);
+        __m256i byteIdx = _mm256_and_si256(_mm256_srli_epi16(ids, 3), seven);
+        __m256i bit = _mm256_shuffle_epi8(bits, _mm256_and_si256(ids, seven));
+        __m256i hit = _mm256_and_si256(
+            _mm256_shuffle_epi8(table, byteIdx), bit);
+        unsigned legal = unsigned(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(hit, bit)));
+
+        // Bit masks of a byte comparison, low half for lane, high half
+        // for lane + 1
+        auto eq = [&](const __m256i& v, int x) {
+            return unsigned(_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(v, _mm256_set1_epi8(char(x)))));
+        }; // eq()
+
+        unsigned color[5];
+        for (int c = NONE; c <= YELLOW; ++c) {
+            color[c] = eq(colors, c);
+        } // for (int c = NONE; c <= YELLOW; ++c)
+
+        unsigned num = unsigned(_mm256_movemask_epi8(
+            _mm256_cmpgt_epi8(_mm256_set1_epi8(DRAW2), contents)));
+        unsigned num0 = eq(contents, NUM0);
+        unsigned draw2 = eq(contents, DRAW2);
+        unsigned skip = eq(contents, SKIP);
+        unsigned rev = eq(contents, REV);
+        unsigned wild = eq(contents, WILD);
+        unsigned wd4 = eq(contents, WILD_DRAW4);
+        for (int k = 0; k < 2; ++k) {
+            Masks& m = out[lane + k];
+            int shift = 16 * k;
+            m.legal = (legal >> shift) & 0xffffU;
+            for (int c = NONE; c <= YELLOW; ++c) {
+                m.color[c] = (color[c] >> shift) & 0xffffU;
+            } // for (int c = NONE; c <= YELLOW; ++c)
+
+            m.num = (num >> shift) & 0xffffU;
+            m.zeroRev = ((num0 | rev) >> shift) & 0xffffU;
+            m.skipDraw2 = ((skip | draw2) >> shift) & 0xffffU;
+            m.draw2 = (draw2 >> shift) & 0xffffU;
+            m.skip = (skip >> shift) & 0xffffU;
+            m.rev = (rev >> shift) & 0xffffU;
+            m.wild = (wild >> shift) & 0xffffU;
+            m.wd4 = (wd4 >> shift) & 0xffffU;
+        } // for (int k = 0; k < 2; ++k)
+    } // for (int lane = 0; lane < LANES; lane += 2)
+#else
+    for (int lane = 0; lane < LANES; ++lane) {
+        int who = now[lane];
+        Masks& m = out[lane];
+        std::memset(&m, 0, sizeof(Masks));
+        for (int i = 0; i < handSize[lane][who]; ++i) {
+            unsigned bit = 1U << i;
+            int id = hand[lane][who][i];
+            if (((legality[lane] >> id) & 0x01ULL) != 0ULL) {
+                m.legal |= bit;
+            } // if (((legality[lane] >> id) & 0x01ULL) != 0ULL)
+
+            m.color[handColor[lane][who][i]] |= bit;
+            switch (handContent[lane][who][i]) {
+            case DRAW2:
+                m.draw2 |= bit;
+                m.skipDraw2 |= bit;
+                break; // case DRAW2
+
+            case SKIP:
+                m.skip |= bit;
+                m.skipDraw2 |= bit;
+                break; // case SKIP
+
+            case REV:
+                m.rev |= bit;
+                m.zeroRev |= bit;
+                break; // case REV
+
+            case WILD:
+                m.wild |= bit;
+                break; // case WILD
+
+            case WILD_DRAW4:
+                m.wd4 |= bit;
+                break; // case WILD_DRAW4
+
+            case NUM0:
+                m.zeroRev |= bit;
+                // fall through
+
+            default:
+                m.num |= bit;
+                break; // default
+            } // switch (handContent[lane][who][i])
+        } // for (int i = 0; i < handSize[lane][who]; ++i)
+    } // for (int lane = 0; lane < LANES; ++lane)
+#endif // LOCKSTEP_AVX2
+} // scan(Masks[])
+
+/**
+ * Our own random number generator, see Uno::rand().
+ */
+int Lockstep::rand(int lane) {
+    randState[lane] = randState[lane] * 6364136223846793005ULL
+        + 1442695040888963407ULL;
+    return int(randState[lane] >> 33);
+} // rand(int)
+
+/**
+ * See Uno::getNext().
+ */
+int Lockstep::getNext(int lane) {
+    int next = (now[lane] + direction[lane]) % 4;
+    if (players[lane] == 3 && next == Player::COM2) {
+        next = (next + direction[lane]) % 4;
+    } // if (players[lane] == 3 && next == Player::COM2)
+
+    return next;
+} // getNext(int)
+
+/**
+ * See Uno::getOppo().
+ */
+int Lockstep::getOppo(int lane) {
+    int oppo = (getNext(lane) + direction[lane]) % 4;
+    if (players[lane] == 3 && oppo == Player::COM2) {
+        oppo = (oppo + direction[lane]) % 4;
+    } // if (players[lane] == 3 && oppo == Player::COM2)
+
+    return oppo;
+} // getOppo(int)
+
+/**
+ * See Uno::getPrev().
+ */
+int Lockstep::getPrev(int lane) {
+    int prev = (4 + now[lane] - direction[lane]) % 4;
+    if (players[lane] == 3 && prev == Player::COM2) {
+        prev = (4 + prev - direction[lane]) % 4;
+    } // if (players[lane] == 3 && prev == Player::COM2)
+
+    return prev;
+} // getPrev(int)
+
+/**
+ * Update the legality binary from the last played card, see Uno::play().
+ */
+void Lockstep::updateLegality(int lane) {
+    int id = recent[lane][recentSize[lane] - 1];
+    int last = recentColor[lane][recentSize[lane] - 1];
+
+    legality[lane] = draw2StackCount[lane] > 0
+        ? (0x8004002001ULL << DRAW2)
+        : id >= 52
+        ? 0x30000000000000ULL
+        | (0x1fffULL << 13 * (last - 1))
+        : 0x30000000000000ULL
+        | (0x1fffULL << 13 * (last - 1))
+        | (0x8004002001ULL << contentOf(id));
+} // updateLegality(int)
+
+/**
+ * See AI::calcBestColor4NowPlayer().
+ */
+Color Lockstep::calcBestColor(int lane, const Masks& m) {
+    Color bestColor;
+    int next, oppo, prev;
+    Color nextWeak, nextStrong;
+    Color oppoWeak, oppoStrong;
+    Color prevWeak, prevStrong;
+    bool nextIsUno, oppoIsUno, prevIsUno;
+
+    next = getNext(lane);
+    oppo = getOppo(lane);
+    prev = getPrev(lane);
+    nextIsUno = handSize[lane][next] == 1;
+    oppoIsUno = handSize[lane][oppo] == 1;
+    prevIsUno = handSize[lane][prev] == 1;
+    nextWeak = weakColor[lane][next];
+    oppoWeak = weakColor[lane][oppo];
+    prevWeak = weakColor[lane][prev];
+    if (nextIsUno && nextWeak != NONE) {
+        bestColor = nextWeak;
+    } // if (nextIsUno && nextWeak != NONE)
+    else if (oppoIsUno && oppoWeak != NONE) {
+        bestColor = oppoWeak;
+    } // else if (oppoIsUno && oppoWeak != NONE)
+    else if (prevIsUno && prevWeak != NONE) {
+        bestColor = prevWeak;
+    } // else if (prevIsUno && prevWeak != NONE)
+    else {
+        int score[] = { 0, 0, 0, 0, 0 };
+        const int* param = params[lane][now[lane]];
+
+        // Hand popcounts instead of a loop over the hand cards
+        for (int c = RED; c <= YELLOW; ++c) {
+            score[c] = param[AI::PARAM_ZERO_REV_WORTH]
+                * popCount(m.color[c] & m.zeroRev)
+                + param[AI::PARAM_SKIP_DRAW2_WORTH]
+                * popCount(m.color[c] & m.skipDraw2)
+                + param[AI::PARAM_NUM_WORTH]
+                * popCount(m.color[c] & m.num & ~m.zeroRev);
+        } // for (int c = RED; c <= YELLOW; ++c)
+
+        bestColor = NONE;
+        for (int c = RED; c <= YELLOW; ++c) {
+            if (score[c] > score[bestColor]) {
+                bestColor = Color(c);
+            } // if (score[c] > score[bestColor])
+        } // for (int c = RED; c <= YELLOW; ++c)
+
+        if (bestColor == NONE) {
+            bestColor
+                = prevWeak != NONE ? prevWeak
+                : oppoWeak != NONE ? oppoWeak
+                : nextWeak != NONE ? nextWeak : RED;
+        } // if (bestColor == NONE)
+    } // else
+
+    nextStrong = strongColor[lane][next];
+    oppoStrong = strongColor[lane][oppo];
+    prevStrong = strongColor[lane][prev];
+    if ((nextIsUno && bestColor == nextStrong)
+        || (oppoIsUno && bestColor == oppoStrong)
+        || (prevIsUno && bestColor == prevStrong)) {
+        Color allowed[4];
+        int count = 0;
+
+        for (int c = RED; c <= YELLOW; ++c) {
+            if ((!nextIsUno || c != nextStrong)
+                && (!oppoIsUno || c != oppoStrong)
+                && (!prevIsUno || c != prevStrong)) {
+                allowed[count++] = Color(c);
+            } // if ((!nextIsUno || c != nextStrong) && ...)
+        } // for (int c = RED; c <= YELLOW; ++c)
+
+        bestColor = allowed[rand(lane) % count];
+    } // if (nextIsUno && bestColor == nextStrong || ...)
+
+    return bestColor;
+} // calcBestColor(int, const Masks&)
+
+/**
+ * See AI::easyAI_bestCardIndex4NowPlayer(Color[]).
+ */
+int Lockstep::easyAI(int lane, const Masks& m, Color outColor[]) {
+    int idxBest, nextSize, prevSize;
+    Color bestColor, lastColor;
+    int idxNum, idxRev, idxSkip, idxDraw2, idxWild, idxWD4;
+    int who = now[lane];
+
+    if (handSize[lane][who] == 1) {
+        // Only one card remained. Play it when it's legal.
+        outColor[0] = Color(handColor[lane][who][0]);
+        return (m.legal & 0x01U) != 0U ? 0 : -1;
+    } // if (handSize[lane][who] == 1)
+
+    idxBest = -1;
+    lastColor = Color(recentColor[lane][recentSize[lane] - 1]);
+    bestColor = calcBestColor(lane, m);
+    idxNum = pick(m.legal & m.num, m.color[bestColor]);
+    idxRev = pick(m.legal & m.rev, m.color[bestColor]);
+    idxSkip = pick(m.legal & m.skip, m.color[bestColor]);
+    idxDraw2 = pick(m.legal & m.draw2, m.color[bestColor]);
+    idxWild = (m.legal & m.wild) != 0U ? highestBit(m.legal & m.wild) : -1;
+    idxWD4 = (m.legal & m.wd4) != 0U ? highestBit(m.legal & m.wd4) : -1;
+
+    // Decision tree
+    nextSize = handSize[lane][getNext(lane)];
+    if (nextSize == 1) {
+        if (idxDraw2 >= 0)
+            idxBest = idxDraw2;
+        else if (idxSkip >= 0)
+            idxBest = idxSkip;
+        else if (idxRev >= 0)
+            idxBest = idxRev;
+        else if (idxWD4 >= 0 && lastColor != bestColor)
+            idxBest = idxWD4;
+        else if (idxWild >= 0 && lastColor != bestColor)
+            idxBest = idxWild;
+        else if (idxNum >= 0)
+            idxBest = idxNum;
+    } // if (nextSize == 1)
+    else {
+        prevSize = handSize[lane][getPrev(lane)];
+        if (idxRev >= 0 && prevSize > nextSize)
+            idxBest = idxRev;
+        else if (idxNum >= 0)
+            idxBest = idxNum;
+        else if (idxSkip >= 0)
+            idxBest = idxSkip;
+        else if (idxDraw2 >= 0)
+            idxBest = idxDraw2;
+        else if (idxRev >= 0 && prevSize > 1)
+            idxBest = idxRev;
+        else if (idxWild >= 0)
+            idxBest = idxWild;
+        else if (idxWD4 >= 0)
+            idxBest = idxWD4;
+    } // else
+
+    outColor[0] = bestColor;
+    return idxBest;
+} // easyAI(int, const Masks&, Color[])
+
+/**
+ * See AI::needToChallenge().
+ */
+bool Lockstep::needToChallenge(int lane) {
+    int next = getNext(lane);
+    int size = handSize[lane][next];
+    const int* param = params[lane][next];
+
+    return size == 1
+        || size >= Uno::MAX_HOLD_CARDS - param[AI::PARAM_CHALLENGE_MARGIN]
+        || recentColor[lane][recentSize[lane] - 1]
+        == recentColor[lane][recentSize[lane] - 2];
+} // needToChallenge(int)
+
+/**
+ * See Uno::draw(int, bool).
+ */
+int Lockstep::unoDraw(int lane, int who, bool force) {
+    int i, id, index, size;
+
+    i = -1;
+    if (draw2StackCount[lane] > 0) {
+        --draw2StackCount[lane];
+    } // if (draw2StackCount[lane] > 0)
+    else if (!force) {
+        // Draw a card by player itself, register weak color
+        weakColor[lane][who]
+            = Color(recentColor[lane][recentSize[lane] - 1]);
+        if (weakColor[lane][who] == strongColor[lane][who]) {
+            strongColor[lane][who] = NONE;
+        } // if (weakColor[lane][who] == strongColor[lane][who])
+    } // else if (!force)
+
+    size = handSize[lane][who];
+    if (size < Uno::MAX_HOLD_CARDS) {
+        id = deck[lane][--deckSize[lane]];
+        i = size;
+        if (who == Player::YOU) {
+            // Keep your hand cards sorted (upper bound)
+            i = 0;
+            while (i < size && hand[lane][who][i] <= id) {
+                ++i;
+            } // while (i < size && hand[lane][who][i] <= id)
+        } // if (who == Player::YOU)
+
+        insertAt(hand[lane][who], handColor[lane][who],
+                 handContent[lane][who], size, i, id);
+        ++handSize[lane][who];
+        if (deckSize[lane] == 0) {
+            // Re-use the used cards when there are no more cards in deck
+            size = usedSize[lane];
+            while (size > 0) {
+                index = rand(lane) % size--;
+                deck[lane][deckSize[lane]++] = used[lane][index];
+                std::memmove(used[lane] + index, used[lane] + index + 1,
+                             size - index);
+            } // while (size > 0)
+
+            usedSize[lane] = 0;
+        } // if (deckSize[lane] == 0)
+    } // if (size < Uno::MAX_HOLD_CARDS)
+    else {
+        draw2StackCount[lane] = 0;
+    } // else
+
+    if (draw2StackCount[lane] == 0) {
+        updateLegality(lane);
+    } // if (draw2StackCount[lane] == 0)
+
+    return i;
+} // unoDraw(int, int, bool)
+
+/**
+ * See Simulator::draw(int, bool).
+ */
+void Lockstep::draw(int lane, int count, bool force) {
+    int i, index, drawn, who, c;
+
+    c = draw2StackCount[lane];
+    if (c > 0) {
+        count = c;
+        force = true;
+    } // if (c > 0)
+
+    index = drawn = -1;
+    who = now[lane];
+    selectedIdx[lane] = -1;
+    for (i = 0; i < count; ++i) {
+        index = unoDraw(lane, who, force);
+        if (index >= 0) {
+            drawn = hand[lane][who][index];
+        } // if (index >= 0)
+        else {
+            break;
+        } // else
+    } // for (i = 0; i < count; ++i)
+
+    if (count == 1 &&
+        drawn >= 0 &&
+        forcePlay[lane] &&
+        ((legality[lane] >> drawn) & 0x01ULL) != 0ULL) {
+        if (drawn < 52) {
+            play(lane, index, NONE);
+        } // if (drawn < 52)
+        else {
+            selectedIdx[lane] = index;
+            status[lane] = Simulator::STAT_WILD_COLOR;
+        } // else
+    } // if (count == 1 && ...)
+    else {
+        ++turns[lane];
+        status[lane] = now[lane] = getNext(lane);
+    } // else
+} // draw(int, int, bool)
+
+/**
+ * See Simulator::play(int, Color) and Uno::play(int, int, Color).
+ */
+void Lockstep::play(int lane, int index, Color color) {
+    int id, who, size, content;
+
+    who = now[lane];
+    size = handSize[lane][who];
+    if (index < 0 || index >= size) {
+        return;
+    } // if (index < 0 || index >= size)
+
+    id = hand[lane][who][index];
+    if (id >= 52 && color == NONE && size > 1) {
+        // Need to specify the following legal color at first
+        selectedIdx[lane] = index;
+        status[lane] = Simulator::STAT_WILD_COLOR;
+        return;
+    } // if (id >= 52 && color == NONE && size > 1)
+
+    eraseAt(hand[lane][who], handColor[lane][who],
+            handContent[lane][who], size, index);
+    --handSize[lane][who];
+    content = contentOf(id);
+    if (id >= 52) {
+        strongColor[lane][who] = color;
+        strongCount[lane][who] = 1 + size / 3;
+        if (color == weakColor[lane][who]) {
+            weakColor[lane][who] = NONE;
+        } // if (color == weakColor[lane][who])
+    } // if (id >= 52)
+    else if (colorOf(id) == strongColor[lane][who]) {
+        if (--strongCount[lane][who] == 0) {
+            strongColor[lane][who] = NONE;
+        } // if (--strongCount[lane][who] == 0)
+    } // else if (colorOf(id) == strongColor[lane][who])
+    else if (strongCount[lane][who] > size - 1) {
+        strongCount[lane][who] = size - 1;
+    } // else if (strongCount[lane][who] > size - 1)
+
+    if (content == DRAW2 && draw2StackRule[lane]) {
+        draw2StackCount[lane] += 2;
+    } // if (content == DRAW2 && draw2StackRule[lane])
+
+    recent[lane][recentSize[lane]] = (unsigned char)id;
+    recentColor[lane][recentSize[lane]]
+        = (unsigned char)(id >= 52 ? Color(color) : Color(colorOf(id)));
+    if (++recentSize[lane] > 5) {
+        used[lane][usedSize[lane]++] = recent[lane][0];
+        std::memmove(recent[lane], recent[lane] + 1, 5);
+        std::memmove(recentColor[lane], recentColor[lane] + 1, 5);
+        recentSize[lane] = 5;
+    } // if (++recentSize[lane] > 5)
+
+    selectedIdx[lane] = -1;
+    ++turns[lane];
+    if (size == 1) {
+        // The player in action becomes winner
+        winner[lane] = who;
+        status[lane] = Simulator::STAT_GAME_OVER;
+        return;
+    } // if (size == 1)
+
+    updateLegality(lane);
+    switch (content) {
+    case DRAW2:
+        status[lane] = now[lane] = getNext(lane);
+        if (!draw2StackRule[lane]) {
+            draw(lane, 2, /* force */ true);
+        } // if (!draw2StackRule[lane])
+        break; // case DRAW2
+
+    case SKIP:
+        now[lane] = getNext(lane);
+        status[lane] = now[lane] = getNext(lane);
+        break; // case SKIP
+
+    case REV:
+        direction[lane] = 4 - direction[lane];
+        status[lane] = now[lane] = getNext(lane);
+        break; // case REV
+
+    case WILD_DRAW4:
+        status[lane] = Simulator::STAT_DOUBT_WILD4;
+        break; // case WILD_DRAW4
+
+    default:
+        status[lane] = now[lane] = getNext(lane);
+        break; // default
+    } // switch (content)
+} // play(int, int, Color)
+
+/**
+ * See Simulator::decideChallenge(bool) and Uno::challenge(int).
+ */
+void Lockstep::decideChallenge(int lane, bool challenge, const Masks& m) {
+    int i, j, who, size;
+    bool result;
+
+    if (!challenge) {
+        now[lane] = getNext(lane);
+        draw(lane, 4, /* force */ true);
+        return;
+    } // if (!challenge)
+
+    who = now[lane];
+    result = m.color[recentColor[lane][recentSize[lane] - 2]] != 0U;
+    if (who != Player::YOU) {
+        // Challenged hand cards are sorted when shown
+        unsigned char* ids = hand[lane][who];
+        size = handSize[lane][who];
+        for (i = 1; i < size; ++i) {
+            unsigned char id = ids[i];
+            for (j = i; j > 0 && ids[j - 1] > id; --j) {
+                ids[j] = ids[j - 1];
+            } // for (j = i; j > 0 && ids[j - 1] > id; --j)
+
+            ids[j] = id;
+        } // for (i = 1; i < size; ++i)
+
+        for (i = 0; i < size; ++i) {
+            handColor[lane][who][i] = colorOf(ids[i]);
+            handContent[lane][who][i] = contentOf(ids[i]);
+        } // for (i = 0; i < size; ++i)
+    } // if (who != Player::YOU)
+
+    if (result) {
+        // Challenge success, who played [wild +4] draws 4 cards
+        draw(lane, 4, /* force */ true);
+    } // if (result)
+    else {
+        // Challenge failure, challenger draws 6 cards
+        now[lane] = getNext(lane);
+        draw(lane, 6, /* force */ true);
+    } // else
+} // decideChallenge(int, bool, const Masks&)
+
+/**
+ * Let every lane make its pending decision, unless its game is over or
+ * the specified number of actions happened in its game.
+ *
+ * @param maxTurns Lanes stop when getTurns(int) reaches this value.
+ * @return How many lanes are still running.
+ */
+int Lockstep::step(int maxTurns) {
+    int lane, idxBest, running;
+    Color bestColor[1];
+    Masks masks[LANES];
+
+    scan(masks);
+    running = 0;
+    for (lane = 0; lane < LANES; ++lane) {
+        if (status[lane] == Simulator::STAT_GAME_OVER
+            || turns[lane] >= maxTurns) {
+            continue;
+        } // if (status[lane] == Simulator::STAT_GAME_OVER || ...)
+
+        switch (status[lane]) {
+        case Simulator::STAT_WILD_COLOR:
+            bestColor[0] = calcBestColor(lane, masks[lane]);
+            if (bestColor[0] != NONE) {
+                play(lane, selectedIdx[lane], bestColor[0]);
+            } // if (bestColor[0] != NONE)
+            break; // case Simulator::STAT_WILD_COLOR
+
+        case Simulator::STAT_DOUBT_WILD4:
+            decideChallenge(lane, needToChallenge(lane), masks[lane]);
+            break; // case Simulator::STAT_DOUBT_WILD4
+
+        default:
+            idxBest = easyAI(lane, masks[lane], bestColor);
+            if (idxBest >= 0) {
+                play(lane, idxBest, bestColor[0]);
+            } // if (idxBest >= 0)
+            else {
+                draw(lane, 1, /* force */ false);
+            } // else
+            break; // default
+        } // switch (status[lane])
+
+        if (status[lane] != Simulator::STAT_GAME_OVER
+            && turns[lane] < maxTurns) {
+            ++running;
+        } // if (status[lane] != Simulator::STAT_GAME_OVER && ...)
+    } // for (lane = 0; lane < LANES; ++lane)
+
+    return running;
+} // step(int)
+
+/**
+ * Step all lanes until every lane stops.
+ *
+ * @param maxTurns Lanes stop when getTurns(int) reaches this value.
+ */
+void Lockstep::run(int maxTurns) {
+    int running;
+
+    do {
+        running = step(maxTurns);
+    } while (running > 0);
+} // run(int)
+
+/**
+ * @param lane Which lane.
+ * @return Current status of the lane, see Simulator::getStatus().
+ */
+int Lockstep::getStatus(int lane) {
+    return status[lane];
+} // getStatus(int)
+
+/**
+ * @param lane Which lane.
+ * @return Who won the game in the lane, or -1 when game is not over.
+ */
+int Lockstep::getWinner(int lane) {
+    return winner[lane];
+} // getWinner(int)
+
+/**
+ * @param lane Which lane.
+ * @return How many actions (plays and passes) happened in the lane.
+ */
+int Lockstep::getTurns(int lane) {
+    return turns[lane];
+} // getTurns(int)
+
+/**
+ * @param lane Which lane.
+ * @param who  Whose hand. Must be one of the following: Player::YOU,
+ *             Player::COM1, Player::COM2, Player::COM3.
+ * @return How many cards in the specified player's hand.
+ */
+int Lockstep::getHandSize(int lane, int who) {
+    return handSize[lane][who];
+} // getHandSize(int, int)
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,435 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <random>
+#include <vector>
+#include <fstream>
+#include "include/Policy.h"
+#include "include/Content.h"
+#include "include/Player.h"
+#include "include/Color.h"
+#include "include/Card.h"
+#include "include/Uno.h"
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#define POLICY_AVX2 1
+#include <immintrin.h>
+#endif // defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+
+/**
+ * Default path of weight file.
+ */
+const char* const Policy::DEFAULT_PATH = "UnoCard.policy";
+
+/**
+ * Maximum length of an input vector of denseTile(), i.e. the maximum hidden
+ * layer size of weight files.
+ */
+static const int MAX_INPUTS = 4096;
+
+/**
+ * Zero inputs, in place of the missing vectors of a partial tile.
+ */
+static const float ZEROS[MAX_INPUTS] = {};
+
+/**
+ * Hidden layer outputs of the current thread, TILE vectors at most. Grown
+ * on demand, so evaluating in a loop allocates nothing after the first call.
+ */
+static thread_local std::vector<float> tHidden;
+
+/**
+ * Compute one dense layer: out = act(b + sum(in[i] * w[i])), where w[i]
+ * is the i-th row of w (length == outCount). Inputs equal to 0 are skipped,
+ * which makes the layer much cheaper on our sparse feature vectors and on
+ * the hidden layer after ReLU.
+ *
+ * @param in       Input vector.
+ * @param inCount  Length of input vector.
+ * @param w        Weight matrix, inCount rows, outCount columns.
+ * @param b        Bias vector, length == outCount.
+ * @param outCount Length of output vector. Must be a multiple of 8.
+ * @param relu     Whether to apply ReLU on outputs.
+ * @param out      Out parameter. Receives the output vector.
+ */
+static void dense(const float* in, int inCount, const float* w,
+                  const float* b, int outCount, bool relu, float* out) {
+    int i, j;
+
+#if POLICY_AVX2
+    __m256 x, zero = _mm256_setzero_ps();
+
+    // Four accumulators (32 outputs) stay in registers for all inputs
+    for (j = 0; j + 32 <= outCount; j += 32) {
+        __m256 a0 = _mm256_loadu_ps(b + j);
+        __m256 a1 = _mm256_loadu_ps(b + j + 8);
+        __m256 a2 = _mm256_loadu_ps(b + j + 16);
+        __m256 a3 = _mm256_loadu_ps(b + j + 24);
+        for (i = 0; i < inCount; ++i) {
+            if (in[i] != 0.0f) {
+                const float* row = w + i * outCount + j;
+                x = _mm256_set1_ps(in[i]);
+                a0 = _mm256_fmadd_ps(x, _mm256_loadu_ps(row), a0);
+                a1 = _mm256_fmadd_ps(x, _mm256_loadu_ps(row + 8), a1);
+                a2 = _mm256_fmadd_ps(x, _mm256_loadu_ps(row + 16), a2);
+                a3 = _mm256_fmadd_ps(x, _mm256_loadu_ps(row + 24), a3);
+            } // if (in[i] != 0.0f)
+        } // for (i = 0; i < inCount; ++i)
+
+        if (relu) {
+            a0 = _mm256_max_ps(a0, zero);
+            a1 = _mm256_max_ps(a1, zero);
+            a2 = _mm256_max_ps(a2, zero);
+            a3 = _mm256_max_ps(a3, zero);
+        } // if (relu)
+
+        _mm256_storeu_ps(out + j, a0);
+        _mm256_storeu_ps(out + j + 8, a1);
+        _mm256_storeu_ps(out + j + 16, a2);
+        _mm256_storeu_ps(out + j + 24, a3);
+    } // for (j = 0; j + 32 <= outCount; j += 32)
+
+    // The rest outputs, 8 at a time
+    for (; j < outCount; j += 8) {
+        __m256 a = _mm256_loadu_ps(b + j);
+        for (i = 0; i < inCount; ++i) {
+            if (in[i] != 0.0f) {
+                x = _mm256_set1_ps(in[i]);
+                a = _mm256_fmadd_ps(x, _mm256_loadu_ps(w + i * outCount + j), a);
+            } // if (in[i] != 0.0f)
+        } // for (i = 0; i < inCount; ++i)
+
+        _mm256_storeu_ps(out + j, relu ? _mm256_max_ps(a, zero) : a);
+    } // for (; j < outCount; j += 8)
+#else
+    for (j = 0; j < outCount; ++j) {
+        out[j] = b[j];
+    } // for (j = 0; j < outCount; ++j)
+
+    for (i = 0; i < inCount; ++i) {
+        if (in[i] != 0.0f) {
+            const float* row = w + i * outCount;
+            for (j = 0; j < outCount; ++j) {
+                out[j] += in[i] * row[j];
+            } // for (j = 0; j < outCount; ++j)
+        } // if (in[i] != 0.0f)
+    } // for (i = 0; i < inCount; ++i)
+
+    if (relu) {
+        for (j = 0; j < outCount; ++j) {
+            out[j] = out[j] > 0.0f ? out[j] : 0.0f;
+        } // for (j = 0; j < outCount; ++j)
+    } // if (relu)
+#endif // POLICY_AVX2
+} // dense(const float*, int, const float*, const float*, int, bool, float*)
+
+/**
+ * Compute one dense layer on a tile of input vectors, in the same way as
+ * dense(). Each row segment is loaded once, and applied to every vector
+ * of the tile. Only the rows used by any vector are visited. Every output
+ * adds the same non-zero products in the same order as dense() does, so
+ * the results do not depend on the tile size.
+ *
+ * @param in       Input vectors, n * inCount floats.
+ * @param n        How many vectors in the tile (2 ~ Policy::TILE).
+ * @param inCount  Length of each input vector.
+ * @param w        Weight matrix, inCount rows, outCount columns.
+ * @param b        Bias vector, length == outCount.
+ * @param outCount Length of each output vector. Must be a multiple of 8.
+ * @param relu     Whether to apply ReLU on outputs.
+ * @param out      Out parameter. Receives n * outCount floats.
+ */
+static void denseTile(const float* in, int n, int inCount, const float* w,
+                      const float* b, int outCount, bool relu,
+                      float* out) {
+    int s;
+    const float* v[Policy::TILE];
+
+    // Input vectors, and zeros in place of the missing ones of a partial
+    // tile (adding a zero product never changes an output)
+    for (s = 0; s < Policy::TILE; ++s) {
+        v[s] = s < n ? in + s * inCount : ZEROS;
+    } // for (s = 0; s < Policy::TILE; ++s)
+
+#if POLICY_AVX2
+    int i, j, k, count;
+    int index[MAX_INPUTS];
+    __m256 row, zero = _mm256_setzero_ps();
+    __m256 acc[Policy::TILE];
+    static_assert(Policy::TILE == 8, "One accumulator for each vector");
+
+    // Rows used by any vector of the tile
+    count = 0;
+    for (i = 0; i < inCount; ++i) {
+        for (s = 0; s < n && v[s][i] == 0.0f; ++s) {
+            // Find a non-zero input
+        } // for (s = 0; s < n && v[s][i] == 0.0f; ++s)
+
+        if (s < n) {
+            index[count++] = i;
+        } // if (s < n)
+    } // for (i = 0; i < inCount; ++i)
+
+    // One accumulator (8 outputs) of each vector stays in registers
+    for (j = 0; j < outCount; j += 8) {
+        __m256 a0 = _mm256_loadu_ps(b + j);
+        __m256 a1 = a0, a2 = a0, a3 = a0, a4 = a0, a5 = a0, a6 = a0;
+        __m256 a7 = a0;
+        for (k = 0; k < count; ++k) {
+            i = index[k];
+            row = _mm256_loadu_ps(w + i * outCount + j);
+            a0 = _mm256_fmadd_ps(_mm256_set1_ps(v[0][i]), row, a0);
+            a1 = _mm256_fmadd_ps(_mm256_set1_ps(v[1][i]), row, a1);
+            a2 = _mm256_fmadd_ps(_mm256_set1_ps(v[2][i]), row, a2);
+            a3 = _mm256_fmadd_ps(_mm256_set1_ps(v[3][i]), row, a3);
+            a4 = _mm256_fmadd_ps(_mm256_set1_ps(v[4][i]), row, a4);
+            a5 = _mm256_fmadd_ps(_mm256_set1_ps(v[5][i]), row, a5);
+            a6 = _mm256_fmadd_ps(_mm256_set1_ps(v[6][i]), row, a6);
+            a7 = _mm256_fmadd_ps(_mm256_set1_ps(v[7][i]), row, a7);
+        } // for (k = 0; k < count; ++k)
+
+        acc[0] = a0;
+        acc[1] = a1;
+        acc[2] = a2;
+        acc[3] = a3;
+        acc[4] = a4;
+        acc[5] = a5;
+        acc[6] = a6;
+        acc[7] = a7;
+        for (s = 0; s < n; ++s) {
+            _mm256_storeu_ps(out + s * outCount + j,
+                             relu ? _mm256_max_ps(acc[s], zero) : acc[s]);
+        } // for (s = 0; s < n; ++s)
+    } // for (j = 0; j < outCount; j += 8)
+#else
+    // The scalar loops are bound by arithmetic rather than by loading
+    // weights, so sharing the rows does not pay off
+    for (s = 0; s < n; ++s) {
+        dense(v[s], inCount, w, b, outCount, relu, out + s * outCount);
+    } // for (s = 0; s < n; ++s)
+#endif // POLICY_AVX2
+} // denseTile(const float*, int, int, const float*, const float*, ...)
+
+/**
+ * Constructor. Create a network without weights. The game shares the
+ * network of getInstance(), other instances are for benchmarks.
+ */
+Policy::Policy() : hidden(0) {
+} // Policy() (Class Constructor)
+
+/**
+ * Get the shared instance. Weights are loaded from DEFAULT_PATH when
+ * this function is called for the first time.
+ *
+ * @return Reference of our singleton.
+ */
+Policy* Policy::getInstance() {
+    static Policy instance;
+    static bool loaded = instance.load(DEFAULT_PATH);
+
+    (void)loaded;
+    return &instance;
+} // getInstance()
+
+/**
+ * @param card Provide a card.
+ * @return Card ID of the specified card, in range [0, 54).
+ */
+int Policy::idOf(Card* card) {
+    return card->isWild() ? 39 + card->content
+        : 13 * (card->color - 1) + card->content;
+} // idOf(Card*)
+
+/**
+ * Extract the feature vector of current player's view.
+ *
+ * @param uno Provide the Uno runtime.
+ * @param out Out parameter. Pass a float array (length>=FEATURE_COUNT)
+ *            to receive the feature vector.
+ */
+void Policy::extract(Uno* uno, float out[]) {
+    int i;
+    Card* top;
+    Color color;
+    Player* next = uno->getNextPlayer();
+    Player* prev = uno->getPrevPlayer();
+    Player* curr = uno->getCurrPlayer();
+
+    for (i = 0; i < FEATURE_COUNT; ++i) {
+        out[i] = 0.0f;
+    } // for (i = 0; i < FEATURE_COUNT; ++i)
+
+    for (Card* card : curr->getHandCards()) {
+        out[idOf(card)] += 1.0f;
+    } // for (Card* card : curr->getHandCards())
+
+    out[54] = float(next->getHandSize()) / Uno::MAX_HOLD_CARDS;
+    if (uno->getPlayers() == 4) {
+        out[55] = float(uno->getOppoPlayer()->getHandSize())
+            / Uno::MAX_HOLD_CARDS;
+    } // if (uno->getPlayers() == 4)
+
+    out[56] = float(prev->getHandSize()) / Uno::MAX_HOLD_CARDS;
+    out[57] = float(curr->getHandSize()) / Uno::MAX_HOLD_CARDS;
+    if ((color = next->getStrongColor()) != NONE) {
+        out[58 + color - 1] = 1.0f;
+    } // if ((color = next->getStrongColor()) != NONE)
+
+    if ((color = next->getWeakColor()) != NONE) {
+        out[62 + color - 1] = 1.0f;
+    } // if ((color = next->getWeakColor()) != NONE)
+
+    if ((color = prev->getStrongColor()) != NONE) {
+        out[66 + color - 1] = 1.0f;
+    } // if ((color = prev->getStrongColor()) != NONE)
+
+    if ((color = prev->getWeakColor()) != NONE) {
+        out[70 + color - 1] = 1.0f;
+    } // if ((color = prev->getWeakColor()) != NONE)
+
+    if ((color = uno->lastColor()) != NONE) {
+        out[74 + color - 1] = 1.0f;
+    } // if ((color = uno->lastColor()) != NONE)
+
+    if (!uno->getRecent().empty()) {
+        top = uno->getRecent().back();
+        out[78 + top->content] = 1.0f;
+    } // if (!uno->getRecent().empty())
+
+    out[93] = uno->getDirection() == Uno::DIR_LEFT ? 1.0f : -1.0f;
+    out[94] = float(uno->getDraw2StackCount()) / Uno::MAX_HOLD_CARDS;
+    out[95] = uno->isSevenZeroRule() ? 1.0f : 0.0f;
+    out[96] = uno->isDraw2StackRule() ? 1.0f : 0.0f;
+    out[97] = uno->getPlayers() == 4 ? 1.0f : 0.0f;
+} // extract(Uno*, float[])
+
+/**
+ * Load weights from file. On failure, the current weights are kept.
+ *
+ * @param path Path of the weight file.
+ * @return Whether the file is loaded successfully.
+ */
+bool Policy::load(const char* path) {
+    int header[4];
+    std::ifstream reader;
+    std::vector<float> v1, c1, v2, c2;
+
+    reader.open(path, std::ios::in | std::ios::binary);
+    if (reader.fail()) {
+        return false;
+    } // if (reader.fail())
+
+    reader.read((char*)header, sizeof(header));
+    if (reader.fail()
+        || header[0] != MAGIC
+        || header[1] != FEATURE_COUNT
+        || header[2] <= 0 || header[2] % 8 != 0 || header[2] > MAX_INPUTS
+        || header[3] != OUTPUT_COUNT) {
+        return false;
+    } // if (reader.fail() || ...)
+
+    v1.resize(FEATURE_COUNT * header[2]);
+    c1.resize(header[2]);
+    v2.resize(header[2] * OUTPUT_COUNT);
+    c2.resize(OUTPUT_COUNT);
+    reader.read((char*)v1.data(), v1.size() * sizeof(float));
+    reader.read((char*)c1.data(), c1.size() * sizeof(float));
+    reader.read((char*)v2.data(), v2.size() * sizeof(float));
+    reader.read((char*)c2.data(), c2.size() * sizeof(float));
+    if (reader.fail()) {
+        return false;
+    } // if (reader.fail())
+
+    hidden = header[2];
+    w1.swap(v1);
+    b1.swap(c1);
+    w2.swap(v2);
+    b2.swap(c2);
+    return true;
+} // load(const char*)
+
+/**
+ * Replace the weights by small pseudo-random ones, for benchmarks.
+ *
+ * @param hidden Hidden layer size. Must be a positive multiple of 8.
+ * @param seed   Random seed. The same seed gives the same weights.
+ */
+void Policy::randomize(int hidden, unsigned seed) {
+    size_t i;
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<float> weight(-0.1f, 0.1f);
+
+    w1.resize(FEATURE_COUNT * hidden);
+    b1.resize(hidden);
+    w2.resize(hidden * OUTPUT_COUNT);
+    b2.resize(OUTPUT_COUNT);
+    for (i = 0; i < w1.size(); ++i) {
+        w1[i] = weight(engine);
+    } // for (i = 0; i < w1.size(); ++i)
+
+    for (i = 0; i < b1.size(); ++i) {
+        b1[i] = weight(engine);
+    } // for (i = 0; i < b1.size(); ++i)
+
+    for (i = 0; i < w2.size(); ++i) {
+        w2[i] = weight(engine);
+    } // for (i = 0; i < w2.size(); ++i)
+
+    for (i = 0; i < b2.size(); ++i) {
+        b2[i] = weight(engine);
+    } // for (i = 0; i < b2.size(); ++i)
+
+    this->hidden = hidden;
+} // randomize(int, unsigned)
+
+/**
+ * @return Whether any weights are loaded.
+ */
+bool Policy::isLoaded() {
+    return hidden > 0;
+} // isLoaded()
+
+/**
+ * Evaluate a batch of feature vectors, TILE vectors in each pass over
+ * the weights, so a batch costs much less than evaluating its vectors
+ * one by one. The results are the same in both ways. Must not be
+ * called before any weights are loaded. Thread-safe as long as no one
+ * loads new weights at the same time. Each thread reuses its own
+ * buffer of hidden layer outputs, so no allocation happens after the
+ * first call.
+ *
+ * @param features Feature vectors, count * FEATURE_COUNT floats.
+ * @param count    How many feature vectors.
+ * @param out      Out parameter. Receives count * OUTPUT_COUNT floats.
+ */
+void Policy::evaluate(const float* features, int count, float* out) {
+    int i, n;
+
+    if (int(tHidden.size()) < TILE * hidden) {
+        tHidden.resize(TILE * hidden);
+    } // if (int(tHidden.size()) < TILE * hidden)
+
+    for (i = 0; i < count; i += n) {
+        n = count - i < TILE ? count - i : TILE;
+        if (n == 1) {
+            dense(features + i * FEATURE_COUNT, FEATURE_COUNT, w1.data(),
+                  b1.data(), hidden, true, tHidden.data());
+            dense(tHidden.data(), hidden, w2.data(), b2.data(),
+                  OUTPUT_COUNT, false, out + i * OUTPUT_COUNT);
+        } // if (n == 1)
+        else {
+            denseTile(features + i * FEATURE_COUNT, n, FEATURE_COUNT,
+                      w1.data(), b1.data(), hidden, true, tHidden.data());
+            denseTile(tHidden.data(), n, hidden, w2.data(), b2.data(),
+                      OUTPUT_COUNT, false, out + i * OUTPUT_COUNT);
+        } // else
+    } // for (i = 0; i < count; i += n)
+} // evaluate(const float*, int, float*)
+
+// E.O.F
\ No newline at end of file
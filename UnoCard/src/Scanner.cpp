@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <algorithm>
+#include "include/Simulator.h"
+#include "include/Scheduler.h"
+#include "include/Content.h"
+#include "include/Scanner.h"
+#include "include/Player.h"
+#include "include/Agent.h"
+#include "include/Card.h"
+#include "include/Uno.h"
+
+/**
+ * Built-in predicate: the start card is a [+2].
+ */
+static int startDraw2(const std::vector<Scanner::Event>& log) {
+    return log[0].content == DRAW2 ? Scanner::MATCH : Scanner::MISS;
+} // startDraw2(const std::vector<Scanner::Event>&)
+
+/**
+ * Built-in predicate: a hand swap (7-0 rule) happens within 3 actions.
+ */
+static int swap3(const std::vector<Scanner::Event>& log) {
+    const Scanner::Event& e = log.back();
+
+    return e.swap ? Scanner::MATCH
+        : e.turn >= 3 ? Scanner::MISS : Scanner::PENDING;
+} // swap3(const std::vector<Scanner::Event>&)
+
+/**
+ * Built-in predicate: someone holds Uno::MAX_HOLD_CARDS cards.
+ */
+static int maxHold(const std::vector<Scanner::Event>& log) {
+    return log.back().maxHand >= Uno::MAX_HOLD_CARDS
+        ? Scanner::MATCH : Scanner::PENDING;
+} // maxHold(const std::vector<Scanner::Event>&)
+
+/**
+ * Built-in predicate: 4 stacked [+2] cards (+2 stack rule).
+ */
+static int stack4(const std::vector<Scanner::Event>& log) {
+    return log.back().stack >= 8 ? Scanner::MATCH : Scanner::PENDING;
+} // stack4(const std::vector<Scanner::Event>&)
+
+/**
+ * Get a built-in predicate by name:
+ * "start-draw2": the start card is a [+2].
+ * "swap3":       a hand swap (7-0 rule) happens within 3 actions.
+ * "max-hold":    someone holds Uno::MAX_HOLD_CARDS cards.
+ * "stack4":      4 stacked [+2] cards (+2 stack rule).
+ *
+ * @param name Name of the predicate.
+ * @return The predicate, or nullptr if the name is unknown.
+ */
+Scanner::Predicate Scanner::predicateOf(const std::string& name) {
+    return name == "start-draw2" ? startDraw2
+        : name == "swap3" ? swap3
+        : name == "max-hold" ? maxHold
+        : name == "stack4" ? stack4
+        : nullptr;
+} // predicateOf(const std::string&)
+
+/**
+ * Constructor.
+ *
+ * @param threads How many threads. Pass 0 to use all cores.
+ */
+Scanner::Scanner(int threads) {
+    this->threads = threads;
+    setRules(4, Uno::LV_HARD, true, false, false);
+    scanned = 0LL;
+} // Scanner(int) (Class Constructor)
+
+/**
+ * Set the rules of scanned games. By default, 4 players, hard level,
+ * force play, and no 7-0 or +2 stack rules.
+ */
+void Scanner::setRules(int players, int difficulty, bool forcePlay,
+                       bool sevenZeroRule, bool draw2StackRule) {
+    this->players = players;
+    this->difficulty = difficulty;
+    this->forcePlay = forcePlay;
+    this->sevenZeroRule = sevenZeroRule;
+    this->draw2StackRule = draw2StackRule;
+} // setRules(int, int, bool, bool, bool)
+
+/**
+ * Play a game until the predicate decides.
+ *
+ * @param predicate The predicate.
+ * @param seed      Seed of the game.
+ * @param log       Provide a buffer for the game log.
+ * @return Whether the game matches.
+ */
+bool Scanner::test(Predicate predicate, unsigned seed,
+                   std::vector<Event>& log) {
+    int i, result, plays, size;
+    Event e;
+    Card* card;
+    DefaultAgent agent;
+
+    Uno uno = Uno::newHeadlessInstance(seed);
+    uno.setPlayers(players);
+    uno.setDifficulty(difficulty);
+    uno.setForcePlay(forcePlay);
+    uno.setSevenZeroRule(sevenZeroRule);
+    uno.setDraw2StackRule(draw2StackRule);
+    Simulator sim(&uno);
+    sim.start();
+
+    // The start of the game
+    log.clear();
+    e.turn = 0;
+    e.who = -1;
+    e.content = uno.getRecent().back()->content;
+    e.swap = false;
+    e.stack = 0;
+    e.maxHand = 7;
+    log.push_back(e);
+    result = predicate(log);
+    plays = sim.getPlays();
+    while (result == PENDING && sim.getDecider() >= 0
+        && sim.getTurns() < 1000) {
+        e.turn = sim.getTurns() + 1;
+        e.who = sim.getDecider();
+        sim.step(agent);
+
+        // A card is played when the play count grows
+        e.content = -1;
+        e.swap = false;
+        if (sim.getPlays() > plays) {
+            card = uno.getRecent().back();
+            e.content = card->content;
+            e.swap = sevenZeroRule
+                && (card->content == NUM7 || card->content == NUM0);
+        } // if (sim.getPlays() > plays)
+
+        plays = sim.getPlays();
+        e.stack = uno.getDraw2StackCount();
+        e.maxHand = 0;
+        for (i = Player::YOU; i <= Player::COM3; ++i) {
+            size = uno.getPlayer(i)->getHandSize();
+            e.maxHand = size > e.maxHand ? size : e.maxHand;
+        } // for (i = Player::YOU; i <= Player::COM3; ++i)
+
+        log.push_back(e);
+        result = predicate(log);
+    } // while (result == PENDING && sim.getDecider() >= 0 && ...)
+
+    return result == MATCH;
+} // test(Predicate, unsigned, std::vector<Event>&)
+
+/**
+ * Scan seeds firstSeed ~ firstSeed + count - 1.
+ *
+ * @param predicate The predicate.
+ * @param firstSeed The first seed to scan.
+ * @param count     How many seeds to scan.
+ * @param limit     Stop scanning after this number of matches.
+ * @return Matching seeds, in ascending order. When the scan is stopped
+ *         by the limit, they may not be the smallest matching seeds.
+ */
+std::vector<unsigned> Scanner::run(Predicate predicate, unsigned firstSeed,
+                                   int count, int limit) {
+    size_t i;
+    std::vector<unsigned> seeds;
+    std::atomic<int> found(0);
+    std::atomic<long long> played(0LL);
+    Scheduler scheduler(threads);
+    std::vector<std::vector<unsigned>> mine(scheduler.getThreads());
+    std::vector<std::vector<Event>> logs(scheduler.getThreads());
+
+    scheduler.run(count, 0, [&](int worker, int n) {
+        // Skip the remaining seeds quickly after the limit is reached
+        if (found.load(std::memory_order_relaxed) >= limit) {
+            return;
+        } // if (found.load(std::memory_order_relaxed) >= limit)
+
+        ++played;
+        if (test(predicate, firstSeed + unsigned(n), logs[worker])) {
+            mine[worker].push_back(firstSeed + unsigned(n));
+            ++found;
+        } // if (test(predicate, firstSeed + unsigned(n), logs[worker]))
+    }); // scheduler.run()
+
+    for (i = 0; i < mine.size(); ++i) {
+        seeds.insert(seeds.end(), mine[i].begin(), mine[i].end());
+    } // for (i = 0; i < mine.size(); ++i)
+
+    std::sort(seeds.begin(), seeds.end());
+    if (int(seeds.size()) > limit) {
+        seeds.resize(limit > 0 ? limit : 0);
+    } // if (int(seeds.size()) > limit)
+
+    scanned = played;
+    return seeds;
+} // run(Predicate, unsigned, int, int)
+
+/**
+ * Scan seeds, and write the matching seeds and the scanning speed as
+ * JSON.
+ *
+ * @param name      Name of a built-in predicate, see predicateOf(const
+ *                  std::string&).
+ * @param firstSeed The first seed to scan.
+ * @param count     How many seeds to scan.
+ * @param limit     Stop scanning after this number of matches.
+ * @param out       Output stream.
+ * @return False if the predicate name is unknown.
+ */
+bool Scanner::run(const std::string& name, unsigned firstSeed, int count,
+                  int limit, std::ostream& out) {
+    size_t i;
+    double seconds;
+    std::vector<unsigned> seeds;
+    std::chrono::steady_clock::time_point start;
+    Predicate predicate = predicateOf(name);
+
+    if (predicate == nullptr) {
+        return false;
+    } // if (predicate == nullptr)
+
+    start = std::chrono::steady_clock::now();
+    seeds = run(predicate, firstSeed, count, limit);
+    seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    seconds = seconds > 1e-9 ? seconds : 1e-9;
+    out << "{\"predicate\": \"" << name << "\""
+        << ", \"firstSeed\": " << firstSeed
+        << ", \"scanned\": " << scanned
+        << ", \"seconds\": " << seconds
+        << ", \"seedsPerSecond\": " << (scanned / seconds)
+        << ", \"seeds\": [";
+    for (i = 0; i < seeds.size(); ++i) {
+        out << (i > 0 ? ", " : "") << seeds[i];
+    } // for (i = 0; i < seeds.size(); ++i)
+
+    out << "]}" << std::endl;
+    return true;
+} // run(const std::string&, unsigned, int, int, std::ostream&)
+
+// E.O.F
\ No newline at end of file
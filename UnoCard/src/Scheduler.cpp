@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <functional>
+#include "include/Scheduler.h"
+
+/**
+ * Constructor.
+ *
+ * @param threads How many threads. Pass 0 to use all cores.
+ */
+Scheduler::Scheduler(int threads) : steals(0LL) {
+    if (threads <= 0) {
+        threads = int(std::thread::hardware_concurrency());
+    } // if (threads <= 0)
+
+    this->threads = threads > 0 ? threads : 1;
+    deques = nullptr;
+    workers = 0;
+} // Scheduler(int) (Class Constructor)
+
+/**
+ * @return How many threads.
+ */
+int Scheduler::getThreads() {
+    return threads;
+} // getThreads()
+
+/**
+ * @return How many times jobs have been stolen in all runs.
+ */
+long long Scheduler::getSteals() {
+    return steals;
+} // getSteals()
+
+/**
+ * Take a chunk of jobs for a thread, from its own deque, or stolen from
+ * another thread's deque.
+ *
+ * @param worker   Take jobs for which thread.
+ * @param chunk    Take at most how many jobs.
+ * @param outFirst Out parameter. Pass an int array (length>=1) to
+ *                 receive the first job number taken.
+ * @param outLast  Out parameter. Pass an int array (length>=1) to
+ *                 receive the last job number taken plus 1.
+ * @return False if there are no jobs left.
+ */
+bool Scheduler::take(int worker, int chunk, int outFirst[], int outLast[]) {
+    int i, begin, end;
+    Deque& mine = deques[worker];
+
+    {
+        std::lock_guard<std::mutex> lock(mine.mutex);
+        if (mine.begin < mine.end) {
+            outFirst[0] = mine.begin;
+            outLast[0] = mine.end - mine.begin > chunk
+                ? mine.begin + chunk : mine.end;
+            mine.begin = outLast[0];
+            return true;
+        } // if (mine.begin < mine.end)
+    }
+
+    // Steal the back half (rounded up) of the first non-empty deque, take
+    // a chunk of it, and keep the rest in our own deque. Jobs on the way
+    // are never lost: they are held by the stealing thread, which will run
+    // them, even when another thread finds all deques empty meanwhile.
+    for (i = 1; i < workers; ++i) {
+        Deque& victim = deques[(worker + i) % workers];
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.begin >= victim.end) {
+                continue;
+            } // if (victim.begin >= victim.end)
+
+            begin = victim.begin + (victim.end - victim.begin) / 2;
+            end = victim.end;
+            victim.end = begin;
+        }
+
+        ++steals;
+        outFirst[0] = begin;
+        outLast[0] = end - begin > chunk ? begin + chunk : end;
+        std::lock_guard<std::mutex> lock(mine.mutex);
+        mine.begin = outLast[0];
+        mine.end = end;
+        return true;
+    } // for (i = 1; i < workers; ++i)
+
+    return false;
+} // take(int, int, int[], int[])
+
+/**
+ * Run jobs 0 ~ count - 1 on all threads, and return when all of them
+ * are done. The calling thread is thread 0. Not re-entrant.
+ *
+ * @param count How many jobs.
+ * @param chunk Take at most how many jobs at a time. Pass 0 to choose
+ *              automatically.
+ * @param job   Run a job. Called with the thread number (0 ~
+ *              getThreads() - 1) and the job number, so that each
+ *              thread can keep its own results without locking.
+ */
+void Scheduler::run(int count, int chunk,
+                    const std::function<void(int, int)>& job) {
+    int i;
+    std::vector<std::thread> pool;
+
+    if (count <= 0) {
+        return;
+    } // if (count <= 0)
+
+    // Small chunks near the end of a run come from stealing halves, so
+    // the automatic chunk only needs to keep deque locking rare
+    workers = threads < count ? threads : count;
+    if (chunk <= 0) {
+        chunk = count / (workers * 16);
+    } // if (chunk <= 0)
+
+    chunk = chunk > 1 ? chunk : 1;
+    deques = new Deque[workers];
+    for (i = 0; i < workers; ++i) {
+        deques[i].begin = int((long long)count * i / workers);
+        deques[i].end = int((long long)count * (i + 1) / workers);
+    } // for (i = 0; i < workers; ++i)
+
+    auto work = [&](int worker) {
+        int g, first[1], last[1];
+
+        while (take(worker, chunk, first, last)) {
+            for (g = first[0]; g < last[0]; ++g) {
+                job(worker, g);
+            } // for (g = first[0]; g < last[0]; ++g)
+        } // while (take(worker, chunk, first, last))
+    }; // work
+
+    for (i = 1; i < workers; ++i) {
+        pool.push_back(std::thread(work, i));
+    } // for (i = 1; i < workers; ++i)
+
+    work(0);
+    for (std::thread& t : pool) {
+        t.join();
+    } // for (std::thread& t : pool)
+
+    delete[] deques;
+    deques = nullptr;
+    workers = 0;
+} // run(int, int, const std::function<void(int, int)>&)
+
+// E.O.F
\ No newline at end of file
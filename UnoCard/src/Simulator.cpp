@@ -0,0 +1,401 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "include/Simulator.h"
+#include "include/Content.h"
+#include "include/Player.h"
+#include "include/Agent.h"
+#include "include/Color.h"
+#include "include/Card.h"
+#include "include/Uno.h"
+
+/**
+ * Constructor. When a game is already in process in the provided Uno
+ * runtime, we take over it from the turn of uno->getNow().
+ *
+ * @param uno Provide the Uno runtime.
+ */
+Simulator::Simulator(Uno* uno) : uno(uno) {
+    agents[0] = agents[1] = agents[2] = agents[3] = nullptr;
+    winner = -1;
+    turns = 0;
+    plays = 0;
+    selectedIdx = -1;
+    status = uno->getRecent().empty() ? STAT_GAME_OVER : uno->getNow();
+#ifdef UNO_COVERAGE
+    coverageMark = Coverage::beginGame();
+#endif // UNO_COVERAGE
+} // Simulator(Uno*) (Class Constructor)
+
+/**
+ * Constructor. Take over a game in process in the provided Uno runtime,
+ * from a pending decision other than playing a card, i.e. right after
+ * the player uno->getNow() played a [wild +4] or a [7].
+ *
+ * @param uno    Provide the Uno runtime.
+ * @param status STAT_DOUBT_WILD4 or STAT_SEVEN_TARGET.
+ */
+Simulator::Simulator(Uno* uno, int status) : Simulator(uno) {
+    if (status == STAT_DOUBT_WILD4 || status == STAT_SEVEN_TARGET) {
+        this->status = status;
+    } // if (status == STAT_DOUBT_WILD4 || status == STAT_SEVEN_TARGET)
+} // Simulator(Uno*, int) (Class Constructor)
+
+/**
+ * Start a new game in our Uno runtime, and resolve the start card.
+ */
+void Simulator::start() {
+#ifdef UNO_COVERAGE
+    if (coverageMark >= 0) {
+        Coverage::endGame(coverageMark, -1);
+    } // if (coverageMark >= 0)
+
+    coverageMark = Coverage::beginGame();
+#endif // UNO_COVERAGE
+    uno->start();
+    winner = -1;
+    turns = 0;
+    plays = 0;
+    selectedIdx = -1;
+    status = uno->getNow();
+    switch (uno->getRecent().at(0)->content) {
+    case DRAW2:
+        // If starting with a [+2], let dealer draw 2 cards.
+        draw(2, /* force */ true);
+        break; // case DRAW2
+
+    case SKIP:
+        // If starting with a [skip], skip dealer's turn.
+        status = uno->switchNow();
+        break; // case SKIP
+
+    case REV:
+        // If starting with a [reverse], change the action
+        // sequence to COUNTER CLOCKWISE.
+        uno->switchDirection();
+        break; // case REV
+
+    default:
+        break; // default
+    } // switch (uno->getRecent().at(0)->content)
+} // start()
+
+/**
+ * @return Current status. Player::YOU, Player::COM1, Player::COM2,
+ *         Player::COM3, or one of the STAT_* constants.
+ */
+int Simulator::getStatus() {
+    return status;
+} // getStatus()
+
+/**
+ * @return Who needs to make the pending decision, or -1 when game over.
+ */
+int Simulator::getDecider() {
+    switch (status) {
+    case STAT_GAME_OVER:
+        return -1; // case STAT_GAME_OVER
+
+    case STAT_DOUBT_WILD4:
+        return uno->getNext(); // case STAT_DOUBT_WILD4
+
+    default:
+        return uno->getNow(); // default
+    } // switch (status)
+} // getDecider()
+
+/**
+ * @return Who won the game, or -1 when game is not over yet.
+ */
+int Simulator::getWinner() {
+    return winner;
+} // getWinner()
+
+/**
+ * @return How many actions (plays and passes) happened in this game.
+ */
+int Simulator::getTurns() {
+    return turns;
+} // getTurns()
+
+/**
+ * @return How many cards are played in this game. Unlike counting the
+ *         used cards, this is not confused by a reshuffle in the same
+ *         action.
+ */
+int Simulator::getPlays() {
+    return plays;
+} // getPlays()
+
+/**
+ * Let AI calculate the best card to play for current player, in the
+ * same way as the game UI does (by AI budgets, 7-0 rule and difficulty).
+ *
+ * @param outColor Out parameter, see AI::easyAI_bestCardIndex4NowPlayer.
+ * @return Index of the best card to play, or a negative number that
+ *         means to draw a card.
+ */
+int Simulator::bestCardIndex4NowPlayer(Color outColor[]) {
+    return DefaultAgent().bestCardIndex(uno, outColor);
+} // bestCardIndex4NowPlayer(Color[])
+
+/**
+ * Set the agent of a player.
+ *
+ * @param who   Set whose agent. Must be one of the following:
+ *              Player::YOU, Player::COM1, Player::COM2, Player::COM3
+ * @param agent The agent, or nullptr to use the built-in DefaultAgent.
+ *              Not owned by us, so keep it alive as long as we are.
+ */
+void Simulator::setAgent(int who, Agent* agent) {
+    agents[who] = agent;
+} // setAgent(int, Agent*)
+
+/**
+ * Let the agent of the decider make the pending decision.
+ */
+void Simulator::step() {
+    int who = getDecider();
+    DefaultAgent builtIn;
+
+    if (who < 0) {
+        return;
+    } // if (who < 0)
+    else if (agents[who] != nullptr) {
+        step(*agents[who]);
+    } // else if (agents[who] != nullptr)
+    else {
+        step(builtIn);
+    } // else
+} // step()
+
+/**
+ * Let the agents make all decisions until game over, or until the
+ * specified number of actions happened in this game.
+ *
+ * @param maxTurns Stop when getTurns() reaches this value.
+ * @return Who won the game, or -1 when stopped by maxTurns.
+ */
+int Simulator::run(int maxTurns) {
+    while (status != STAT_GAME_OVER && turns < maxTurns) {
+        step();
+    } // while (status != STAT_GAME_OVER && turns < maxTurns)
+
+    return winner;
+} // run(int)
+
+/**
+ * The player in action plays a card.
+ *
+ * @param index Play which card. Pass the corresponding card's index of the
+ *              player's hand cards.
+ * @param color Available when the card to play is a wild card. Pass the
+ *              specified following legal color, or NONE to turn into the
+ *              STAT_WILD_COLOR status.
+ */
+void Simulator::play(int index, Color color) {
+    Card* card;
+    int now, size;
+
+    now = uno->getNow();
+    size = uno->getCurrPlayer()->getHandSize();
+    if (index < 0 || index >= size) {
+        return;
+    } // if (index < 0 || index >= size)
+
+    card = uno->getCurrPlayer()->getHandCards().at(index);
+    if (card->isWild() && color == NONE && size > 1) {
+        // Need to specify the following legal color at first
+        selectedIdx = index;
+        status = STAT_WILD_COLOR;
+        return;
+    } // if (card->isWild() && color == NONE && size > 1)
+
+    card = uno->play(now, index, color);
+    selectedIdx = -1;
+    ++turns;
+    ++plays;
+    if (size == 1) {
+        // The player in action becomes winner when it played the
+        // final card in its hand successfully
+        winner = now;
+        status = STAT_GAME_OVER;
+#ifdef UNO_COVERAGE
+        Coverage::endGame(coverageMark, winner);
+        coverageMark = -1;
+#endif // UNO_COVERAGE
+        return;
+    } // if (size == 1)
+
+    // When the played card is an action card or a wild card,
+    // do the necessary things according to the game rule
+    switch (card->content) {
+    case DRAW2:
+        status = uno->switchNow();
+        if (!uno->isDraw2StackRule()) {
+            draw(2, /* force */ true);
+        } // if (!uno->isDraw2StackRule())
+        break; // case DRAW2
+
+    case SKIP:
+        uno->switchNow();
+        status = uno->switchNow();
+        break; // case SKIP
+
+    case REV:
+        uno->switchDirection();
+        status = uno->switchNow();
+        break; // case REV
+
+    case WILD:
+        status = uno->switchNow();
+        break; // case WILD
+
+    case WILD_DRAW4:
+        status = STAT_DOUBT_WILD4;
+        break; // case WILD_DRAW4
+
+    case NUM7:
+        if (uno->isSevenZeroRule()) {
+            status = STAT_SEVEN_TARGET;
+            break; // case NUM7
+        } // if (uno->isSevenZeroRule())
+        // else fall through
+
+    case NUM0:
+        if (uno->isSevenZeroRule()) {
+            uno->cycle();
+            status = uno->switchNow();
+            break; // case NUM0
+        } // if (uno->isSevenZeroRule())
+        // else fall through
+
+    default:
+        status = uno->switchNow();
+        break; // default
+    } // switch (card->content)
+} // play(int, Color)
+
+/**
+ * The player in action draws a card by itself (or draws all stacked
+ * cards in +2 stack rule).
+ */
+void Simulator::draw() {
+    draw(1, /* force */ false);
+} // draw()
+
+/**
+ * The player in action draws one or more cards.
+ */
+void Simulator::draw(int count, bool force) {
+    Card* drawn;
+    int i, index, c, now;
+
+    c = uno->getDraw2StackCount();
+    if (c > 0) {
+        count = c;
+        force = true;
+    } // if (c > 0)
+
+    index = -1;
+    drawn = nullptr;
+    now = uno->getNow();
+    selectedIdx = -1;
+    for (i = 0; i < count; ++i) {
+        index = uno->draw(now, force);
+        if (index >= 0) {
+            drawn = uno->getCurrPlayer()->getHandCards().at(index);
+        } // if (index >= 0)
+        else {
+            break;
+        } // else
+    } // for (i = 0; i < count; ++i)
+
+    if (count == 1 &&
+        drawn != nullptr &&
+        uno->isForcePlay() &&
+        uno->isLegalToPlay(drawn)) {
+        // Player drew one card by itself, the drawn card
+        // can be played immediately if it's legal to play
+        if (!drawn->isWild()) {
+            play(index);
+        } // if (!drawn->isWild())
+        else {
+            selectedIdx = index;
+            status = STAT_WILD_COLOR;
+        } // else
+    } // if (count == 1 && ...)
+    else {
+        ++turns;
+        status = uno->switchNow();
+    } // else
+} // draw(int, bool)
+
+/**
+ * In STAT_WILD_COLOR status, specify the following legal color.
+ *
+ * @param color Specify the following legal color.
+ */
+void Simulator::selectColor(Color color) {
+    if (status == STAT_WILD_COLOR && color != NONE) {
+        play(selectedIdx, color);
+    } // if (status == STAT_WILD_COLOR && color != NONE)
+} // selectColor(Color)
+
+/**
+ * In STAT_DOUBT_WILD4 status, decide whether to challenge.
+ * Next player does not challenge: next player draw 4 cards;
+ * Challenge success: current player draw 4 cards;
+ * Challenge failure: next player draw 6 cards.
+ *
+ * @param challenge Pass true to challenge the [wild +4] card.
+ */
+void Simulator::decideChallenge(bool challenge) {
+    if (status == STAT_DOUBT_WILD4) {
+        if (!challenge) {
+            uno->switchNow();
+            draw(4, /* force */ true);
+        } // if (!challenge)
+        else if (uno->challenge(uno->getNow())) {
+            // Challenge success, who played [wild +4] draws 4 cards
+            draw(4, /* force */ true);
+        } // else if (uno->challenge(uno->getNow()))
+        else {
+            // Challenge failure, challenger draws 6 cards
+            uno->switchNow();
+            draw(6, /* force */ true);
+        } // else
+    } // if (status == STAT_DOUBT_WILD4)
+} // decideChallenge(bool)
+
+/**
+ * In STAT_SEVEN_TARGET status, swap hand cards with another player.
+ *
+ * @param whom Swap with whom. Must be one of the following:
+ *             Player::YOU, Player::COM1, Player::COM2, Player::COM3
+ */
+void Simulator::swapWith(int whom) {
+    if (status == STAT_SEVEN_TARGET) {
+        uno->swap(uno->getNow(), whom);
+        status = uno->switchNow();
+    } // if (status == STAT_SEVEN_TARGET)
+} // swapWith(int)
+
+#ifdef UNO_COVERAGE
+/**
+ * Destructor.
+ */
+Simulator::~Simulator() {
+    if (coverageMark >= 0) {
+        Coverage::endGame(coverageMark, -1);
+    } // if (coverageMark >= 0)
+} // ~Simulator() (Class Destructor)
+#endif // UNO_COVERAGE
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "include/Speculator.h"
+#include "include/Simulator.h"
+#include "include/Content.h"
+#include "include/Latency.h"
+#include "include/Player.h"
+#include "include/Color.h"
+#include "include/Card.h"
+#include "include/Uno.h"
+
+/**
+ * Constructor.
+ */
+Speculator::Speculator() : cancelled(false), root(0ULL) {
+} // Speculator() (Class Constructor)
+
+/**
+ * Start to speculate in background. Call this function when you are
+ * thinking in your turn. Calling it again with the same game state
+ * does nothing.
+ *
+ * @param uno Provide the Uno runtime.
+ */
+void Speculator::start(Uno* uno) {
+    unsigned long long hash = uno->getStateHash();
+
+    if (hash != root) {
+        cancel();
+        root = hash;
+        cancelled = false;
+        thread = std::thread(&Speculator::run, this, *uno);
+    } // if (hash != root)
+} // start(Uno*)
+
+/**
+ * Stop the background speculation and throw away all results.
+ */
+void Speculator::cancel() {
+    cancelled = true;
+    if (thread.joinable()) {
+        thread.join();
+    } // if (thread.joinable())
+
+    std::lock_guard<std::mutex> lock(mutex);
+    replies.clear();
+    root = 0ULL;
+} // cancel()
+
+/**
+ * Fetch the precomputed reply for current player, if any. On success,
+ * the random number generator of the Uno runtime is also moved forward,
+ * as if the reply was calculated just now, and all other replies are
+ * thrown away.
+ *
+ * @param uno      Provide the Uno runtime.
+ * @param outIndex Out parameter. Index of the best card to play, or a
+ *                 negative number that means to draw a card.
+ * @param outColor Out parameter. See AI::easyAI_bestCardIndex4NowPlayer.
+ * @return Whether a precomputed reply is found.
+ */
+bool Speculator::fetch(Uno* uno, int* outIndex, Color outColor[]) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (replies.empty()) {
+        return false;
+    } // if (replies.empty())
+
+    auto it = replies.find(uno->getStateHash());
+    if (it == replies.end()) {
+        return false;
+    } // if (it == replies.end())
+
+    *outIndex = it->second.index;
+    outColor[0] = it->second.color;
+    uno->setRandState(it->second.randState);
+    cancelled = true;
+    replies.clear();
+    return true;
+} // fetch(Uno*, int*, Color[])
+
+/**
+ * Worker thread entry.
+ *
+ * @param game A copy of the Uno runtime in your turn.
+ */
+void Speculator::run(Uno game) {
+    int i, size, who;
+    std::vector<Card*> hand;
+    Latency::Mute mute; // Simulated games are not decisions at a table
+
+    hand = game.getCurrPlayer()->getHandCards();
+    size = int(hand.size());
+    for (i = 0; i < size && !cancelled; ++i) {
+        Card* card = hand.at(i);
+        if (!game.isLegalToPlay(card) || (i > 0 && hand.at(i - 1) == card)) {
+            // Illegal card, or the same as the previous one
+            continue;
+        } // if (!game.isLegalToPlay(card) || ...)
+
+        if (card->isWild() && size > 1) {
+            // One branch for each following legal color
+            branch(game, i, RED, -1);
+            branch(game, i, BLUE, -1);
+            branch(game, i, GREEN, -1);
+            branch(game, i, YELLOW, -1);
+        } // if (card->isWild() && size > 1)
+        else if (card->content == NUM7 && game.isSevenZeroRule()) {
+            // One branch for each swap target
+            for (who = Player::YOU; who <= Player::COM3; ++who) {
+                if (who != game.getNow() &&
+                    (game.getPlayers() == 4 || who != Player::COM2)) {
+                    branch(game, i, NONE, who);
+                } // if (who != game.getNow() && ...)
+            } // for (who = Player::YOU; who <= Player::COM3; ++who)
+        } // else if (card->content == NUM7 && game.isSevenZeroRule())
+        else {
+            branch(game, i, NONE, -1);
+        } // else
+    } // for (i = 0; i < size && !cancelled; ++i)
+
+    // And the branch of drawing a card
+    branch(game, -1, NONE, -1);
+} // run(Uno)
+
+/**
+ * Apply one of your actions to a copy of the game, resolve it until an
+ * AI player's turn, then calculate and store that AI player's reply.
+ *
+ * @param game   A copy of the Uno runtime in your turn.
+ * @param index  Play which card, or -1 to draw a card.
+ * @param color  Following legal color when playing a wild card.
+ * @param target Swap target when playing a seven card in 7-0 rule.
+ */
+void Speculator::branch(Uno game, int index, Color color, int target) {
+    Reply reply;
+    int who, status;
+    Simulator sim(&game);
+    unsigned long long hash;
+
+    if (cancelled) {
+        return;
+    } // if (cancelled)
+
+    if (index >= 0) {
+        sim.play(index, color);
+    } // if (index >= 0)
+    else {
+        sim.draw();
+    } // else
+
+    if (target >= 0) {
+        sim.swapWith(target);
+    } // if (target >= 0)
+
+    // Let AI players resolve the following decisions (e.g. whether to
+    // challenge your [wild +4]), until an AI player's turn comes
+    for (;;) {
+        who = sim.getDecider();
+        status = sim.getStatus();
+        if (who < 0 || who == Player::YOU || cancelled) {
+            // Game over, or you need to make another decision
+            return;
+        } // if (who < 0 || who == Player::YOU || cancelled)
+        else if (status == who) {
+            break;
+        } // else if (status == who)
+
+        sim.step();
+    } // for (;;)
+
+    hash = game.getStateHash();
+    reply.index = sim.bestCardIndex4NowPlayer(&reply.color);
+    reply.randState = game.getRandState();
+    std::lock_guard<std::mutex> lock(mutex);
+    replies[hash] = reply;
+} // branch(Uno, int, Color, int)
+
+/**
+ * Destructor.
+ */
+Speculator::~Speculator() {
+    cancel();
+} // ~Speculator() (Class Destructor)
+
+// E.O.F
\ No newline at end of file
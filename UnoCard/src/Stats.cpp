@@ -0,0 +1,229 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <istream>
+#include <ostream>
+#include "include/Player.h"
+#include "include/Stats.h"
+#include "include/Card.h"
+#include "include/Uno.h"
+
+/**
+ * Constructor. Create an empty shard.
+ */
+Stats::Stats() {
+    int i, j;
+
+    games = unfinished = reshuffles = 0LL;
+    for (i = 0; i < 4; ++i) {
+        seats[i] = wins[i] = 0LL;
+    } // for (i = 0; i < 4; ++i)
+
+    for (i = 0; i < SCORE_BUCKETS; ++i) {
+        scores[i] = 0LL;
+    } // for (i = 0; i < SCORE_BUCKETS; ++i)
+
+    for (i = 0; i < LENGTH_BUCKETS; ++i) {
+        lengths[i] = 0LL;
+    } // for (i = 0; i < LENGTH_BUCKETS; ++i)
+
+    for (i = 0; i < 5; ++i) {
+        for (j = 0; j < 15; ++j) {
+            plays[i][j] = 0LL;
+        } // for (j = 0; j < 15; ++j)
+    } // for (i = 0; i < 5; ++i)
+
+    reshuffleCount = 0;
+    playCount = 0;
+} // Stats() (Class Constructor)
+
+/**
+ * Start recording a game. Call it after the game is started.
+ *
+ * @param uno Provide the Uno runtime.
+ */
+void Stats::begin(Uno* uno) {
+    reshuffleCount = uno->getReshuffleCount();
+    playCount = 0;
+} // begin(Uno*)
+
+/**
+ * Record what happened in the last action. Call it after every action.
+ *
+ * @param uno        Provide the Uno runtime.
+ * @param played     How many cards are played in the game so far, see
+ *                   Simulator::getPlays().
+ * @param reshuffled How many times the used cards are reshuffled into
+ *                   the deck in the game so far, see
+ *                   Uno::getReshuffleCount().
+ */
+void Stats::observe(Uno* uno, int played, int reshuffled) {
+    if (played > playCount) {
+        // A card is played, and it is the most recent one
+        Card* card = uno->getRecent().back();
+        ++plays[card->color][card->content];
+    } // if (played > playCount)
+
+    reshuffles += reshuffled - reshuffleCount;
+    reshuffleCount = reshuffled;
+    playCount = played;
+} // observe(Uno*, int, int)
+
+/**
+ * Finish recording a game.
+ *
+ * @param uno    Provide the Uno runtime.
+ * @param winner Who won the game, or -1 if the game is unfinished.
+ * @param turns  How many actions happened in the game.
+ */
+void Stats::end(Uno* uno, int winner, int turns) {
+    int i, score;
+
+    ++games;
+    ++lengths[turns / LENGTH_STEP < LENGTH_BUCKETS
+        ? turns / LENGTH_STEP : LENGTH_BUCKETS - 1];
+    for (i = Player::YOU; i <= Player::COM3; ++i) {
+        if (i != Player::COM2 || uno->getPlayers() == 4) {
+            ++seats[i];
+        } // if (i != Player::COM2 || uno->getPlayers() == 4)
+    } // for (i = Player::YOU; i <= Player::COM3; ++i)
+
+    if (winner < 0) {
+        ++unfinished;
+        return;
+    } // if (winner < 0)
+
+    ++wins[winner];
+    for (i = Player::YOU; i <= Player::COM3; ++i) {
+        if (i != winner && (i != Player::COM2 || uno->getPlayers() == 4)) {
+            score = uno->getPlayer(i)->getHandScore() / SCORE_STEP;
+            ++scores[score < SCORE_BUCKETS ? score : SCORE_BUCKETS - 1];
+        } // if (i != winner && (i != Player::COM2 || ...))
+    } // for (i = Player::YOU; i <= Player::COM3; ++i)
+} // end(Uno*, int, int)
+
+/**
+ * Add another shard's records to this shard.
+ *
+ * @param that The shard to merge.
+ */
+void Stats::merge(const Stats& that) {
+    int i, j;
+
+    games += that.games;
+    unfinished += that.unfinished;
+    reshuffles += that.reshuffles;
+    for (i = 0; i < 4; ++i) {
+        seats[i] += that.seats[i];
+        wins[i] += that.wins[i];
+    } // for (i = 0; i < 4; ++i)
+
+    for (i = 0; i < SCORE_BUCKETS; ++i) {
+        scores[i] += that.scores[i];
+    } // for (i = 0; i < SCORE_BUCKETS; ++i)
+
+    for (i = 0; i < LENGTH_BUCKETS; ++i) {
+        lengths[i] += that.lengths[i];
+    } // for (i = 0; i < LENGTH_BUCKETS; ++i)
+
+    for (i = 0; i < 5; ++i) {
+        for (j = 0; j < 15; ++j) {
+            plays[i][j] += that.plays[i][j];
+        } // for (j = 0; j < 15; ++j)
+    } // for (i = 0; i < 5; ++i)
+} // merge(const Stats&)
+
+/**
+ * Write the records as binary data, to be read by load(std::istream&)
+ * on the same machine.
+ *
+ * @param out Output stream.
+ */
+void Stats::save(std::ostream& out) {
+    out.write((const char*)&games, sizeof(games));
+    out.write((const char*)&unfinished, sizeof(unfinished));
+    out.write((const char*)&reshuffles, sizeof(reshuffles));
+    out.write((const char*)seats, sizeof(seats));
+    out.write((const char*)wins, sizeof(wins));
+    out.write((const char*)scores, sizeof(scores));
+    out.write((const char*)lengths, sizeof(lengths));
+    out.write((const char*)plays, sizeof(plays));
+} // save(std::ostream&)
+
+/**
+ * Read the records written by save(std::ostream&), replacing current
+ * records.
+ *
+ * @param in Input stream.
+ * @return Whether the records are read successfully.
+ */
+bool Stats::load(std::istream& in) {
+    in.read((char*)&games, sizeof(games));
+    in.read((char*)&unfinished, sizeof(unfinished));
+    in.read((char*)&reshuffles, sizeof(reshuffles));
+    in.read((char*)seats, sizeof(seats));
+    in.read((char*)wins, sizeof(wins));
+    in.read((char*)scores, sizeof(scores));
+    in.read((char*)lengths, sizeof(lengths));
+    in.read((char*)plays, sizeof(plays));
+    return !in.fail();
+} // load(std::istream&)
+
+/**
+ * Write the records as a JSON object.
+ *
+ * @param out Output stream.
+ */
+void Stats::write(std::ostream& out) {
+    int i, j;
+    static const char* const CONTENTS[15] = {
+        "NUM0", "NUM1", "NUM2", "NUM3", "NUM4",
+        "NUM5", "NUM6", "NUM7", "NUM8", "NUM9",
+        "DRAW2", "SKIP", "REV", "WILD", "WILD_DRAW4"
+    }; // CONTENTS[]
+
+    out << "{\"games\": " << games
+        << ", \"unfinished\": " << unfinished
+        << ", \"reshuffles\": " << reshuffles
+        << ", \"seatGames\": [";
+    for (i = 0; i < 4; ++i) {
+        out << (i > 0 ? ", " : "") << seats[i];
+    } // for (i = 0; i < 4; ++i)
+
+    out << "], \"seatWins\": [";
+    for (i = 0; i < 4; ++i) {
+        out << (i > 0 ? ", " : "") << wins[i];
+    } // for (i = 0; i < 4; ++i)
+
+    out << "], \"scoreStep\": " << SCORE_STEP << ", \"handScores\": [";
+    for (i = 0; i < SCORE_BUCKETS; ++i) {
+        out << (i > 0 ? ", " : "") << scores[i];
+    } // for (i = 0; i < SCORE_BUCKETS; ++i)
+
+    out << "], \"lengthStep\": " << LENGTH_STEP << ", \"lengths\": [";
+    for (i = 0; i < LENGTH_BUCKETS; ++i) {
+        out << (i > 0 ? ", " : "") << lengths[i];
+    } // for (i = 0; i < LENGTH_BUCKETS; ++i)
+
+    // Plays of each content, by color NONE (wild cards), RED, BLUE, GREEN,
+    // YELLOW
+    out << "], \"cardPlays\": {";
+    for (j = 0; j < 15; ++j) {
+        out << (j > 0 ? ", " : "") << "\"" << CONTENTS[j] << "\": [";
+        for (i = 0; i < 5; ++i) {
+            out << (i > 0 ? ", " : "") << plays[i][j];
+        } // for (i = 0; i < 5; ++i)
+
+        out << "]";
+    } // for (j = 0; j < 15; ++j)
+
+    out << "}}";
+} // write(std::ostream&)
+
+// E.O.F
\ No newline at end of file
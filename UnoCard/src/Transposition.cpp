@@ -0,0 +1,212 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <new>
+#include <atomic>
+#include <string>
+#include <cstdint>
+#include <fstream>
+#include "include/Transposition.h"
+#include "include/Uno.h"
+
+/**
+ * Size of the shared table in mega bytes, see getInstance().
+ */
+std::atomic<int> Transposition::sharedSize(Transposition::DEFAULT_SIZE);
+
+/**
+ * Configure the size of the shared table. Must be called before the
+ * first call of getInstance(), otherwise it takes no effect.
+ *
+ * @param megaBytes Size in mega bytes, at least 1.
+ */
+void Transposition::setSharedSize(int megaBytes) {
+    sharedSize = megaBytes > 1 ? megaBytes : 1;
+} // setSharedSize(int)
+
+/**
+ * Load the size of the shared table from a config file. Each line of
+ * the file is like "name value". The line "transpositionSize n" sets
+ * the size to n mega bytes, see setSharedSize(int). Other lines are
+ * ignored.
+ *
+ * @param path Path of the config file.
+ * @return Whether the size is loaded successfully.
+ */
+bool Transposition::loadSharedSize(const char* path) {
+    int value;
+    std::string name;
+    std::ifstream reader;
+
+    reader.open(path);
+    if (reader.fail()) {
+        return false;
+    } // if (reader.fail())
+
+    while (reader >> name >> value) {
+        if (name == "transpositionSize") {
+            setSharedSize(value);
+            return true;
+        } // if (name == "transpositionSize")
+    } // while (reader >> name >> value)
+
+    return false;
+} // loadSharedSize(const char*)
+
+/**
+ * The first call allocates and clears the table, so the program calls
+ * it at startup, before any timed search.
+ *
+ * @return Reference of the table shared by all search AIs.
+ */
+Transposition* Transposition::getInstance() {
+    static Transposition instance(sharedSize);
+    return &instance;
+} // getInstance()
+
+/**
+ * Compute the key of a simulated game.
+ *
+ * @param uno    The Uno runtime where the simulated game starts.
+ * @param status Current status of its Simulator.
+ * @param turns  How many actions already happened in its Simulator.
+ * @return Key of the simulated game, never 0.
+ */
+unsigned long long Transposition::keyOf(Uno* uno, int status, int turns) {
+    unsigned long long h = uno->getStateHash();
+
+    h = (h ^ (unsigned long long)status) * 0x100000001b3ULL;
+    h = (h ^ (unsigned long long)turns) * 0x100000001b3ULL;
+    return h | 1ULL;
+} // keyOf(Uno*, int, int)
+
+/**
+ * Constructor. Create an empty table.
+ *
+ * @param megaBytes Size in mega bytes, at least 1. Rounded down to a
+ *                  power of 2.
+ */
+Transposition::Transposition(int megaBytes) {
+    unsigned long long i, count, bytes;
+
+    bytes = (unsigned long long)(megaBytes > 1 ? megaBytes : 1) << 20;
+    count = 1ULL;
+    while (count * 2ULL * sizeof(Bucket) <= bytes) {
+        count *= 2ULL;
+    } // while (count * 2ULL * sizeof(Bucket) <= bytes)
+
+    mask = count - 1ULL;
+
+    // Align the buckets to cache lines by hand, since operator new does
+    // not respect over-aligned types before C++17
+    memory = new char[count * sizeof(Bucket) + sizeof(Bucket)];
+    buckets = reinterpret_cast<Bucket*>((reinterpret_cast<uintptr_t>(memory)
+        + sizeof(Bucket) - 1) / sizeof(Bucket) * sizeof(Bucket));
+    for (i = 0ULL; i < count; ++i) {
+        new(buckets + i) Bucket();
+    } // for (i = 0ULL; i < count; ++i)
+
+    clear();
+} // Transposition(int) (Class Constructor)
+
+/**
+ * Look up a simulated game.
+ *
+ * @param key       Key of the simulated game, see keyOf(Uno*, int, int).
+ * @param outWinner Out parameter. Pass an int array (length>=1) to
+ *                  receive the stored winner (-1 means no winner in
+ *                  time).
+ * @return Whether the simulated game is found.
+ */
+bool Transposition::probe(unsigned long long key, int outWinner[]) {
+    int i;
+    unsigned long long data;
+    Bucket& bucket = buckets[key & mask];
+
+    for (i = 0; i < SLOTS; ++i) {
+        data = bucket.data[i].load(std::memory_order_relaxed);
+        if ((bucket.check[i].load(std::memory_order_relaxed) ^ data) == key) {
+            outWinner[0] = int(data & 0xffULL) - 1;
+            return true;
+        } // if ((bucket.check[i].load(std::memory_order_relaxed) ^ ...)
+    } // for (i = 0; i < SLOTS; ++i)
+
+    return false;
+} // probe(unsigned long long, int[])
+
+/**
+ * Store the result of a simulated game.
+ *
+ * @param key    Key of the simulated game, see keyOf(Uno*, int, int).
+ * @param winner Who won the simulated game, or -1 if no one.
+ * @param depth  How many actions the simulated game took.
+ */
+void Transposition::store(unsigned long long key, int winner, int depth) {
+    int i, victim;
+    unsigned long long data, old, minDepth;
+    Bucket& bucket = buckets[key & mask];
+
+    // Overwrite the same key, otherwise the shallowest entry
+    victim = 0;
+    minDepth = ~0ULL;
+    for (i = 0; i < SLOTS; ++i) {
+        old = bucket.data[i].load(std::memory_order_relaxed);
+        if ((bucket.check[i].load(std::memory_order_relaxed) ^ old) == key) {
+            victim = i;
+            break;
+        } // if ((bucket.check[i].load(std::memory_order_relaxed) ^ ...)
+
+        if ((old >> 8) < minDepth) {
+            minDepth = old >> 8;
+            victim = i;
+        } // if ((old >> 8) < minDepth)
+    } // for (i = 0; i < SLOTS; ++i)
+
+    depth = depth < 0xffff ? depth : 0xffff;
+    data = (unsigned long long)depth << 8 | (unsigned long long)(winner + 1);
+    bucket.data[victim].store(data, std::memory_order_relaxed);
+    bucket.check[victim].store(key ^ data, std::memory_order_relaxed);
+} // store(unsigned long long, int, int)
+
+/**
+ * Remove all entries. Not safe when other threads are using the table.
+ */
+void Transposition::clear() {
+    int i;
+    unsigned long long k;
+
+    for (k = 0ULL; k <= mask; ++k) {
+        for (i = 0; i < SLOTS; ++i) {
+            buckets[k].check[i].store(0ULL, std::memory_order_relaxed);
+            buckets[k].data[i].store(0ULL, std::memory_order_relaxed);
+        } // for (i = 0; i < SLOTS; ++i)
+    } // for (k = 0ULL; k <= mask; ++k)
+} // clear()
+
+/**
+ * @return How many entries the table can hold.
+ */
+long long Transposition::getCapacity() {
+    return (long long)(mask + 1ULL) * SLOTS;
+} // getCapacity()
+
+/**
+ * Destructor.
+ */
+Transposition::~Transposition() {
+    unsigned long long k;
+
+    for (k = 0ULL; k <= mask; ++k) {
+        buckets[k].~Bucket();
+    } // for (k = 0ULL; k <= mask; ++k)
+
+    delete[] memory;
+} // ~Transposition() (Class Destructor)
+
+// E.O.F
\ No newline at end of file
@@ -0,0 +1,357 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <thread>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include "include/Checkpoint.h"
+#include "include/Simulator.h"
+#include "include/Scheduler.h"
+#include "include/Player.h"
+#include "include/Tuner.h"
+#include "include/Uno.h"
+#include "include/AI.h"
+
+/**
+ * Lower bounds of AI parameters.
+ */
+const int Tuner::PARAM_MIN[AI::PARAM_COUNT] = {
+    0, // PARAM_ZERO_REV_WORTH
+    0, // PARAM_NUM_WORTH
+    0, // PARAM_SKIP_DRAW2_WORTH
+    0, // PARAM_CHALLENGE_MARGIN
+    1, // PARAM_ATTACK_SIZE
+    1, // PARAM_REVERSE_SIZE
+    1, // PARAM_SAVE_SIZE
+    0  // PARAM_NUM_FIRST
+}; // PARAM_MIN[]
+
+/**
+ * Upper bounds of AI parameters.
+ */
+const int Tuner::PARAM_MAX[AI::PARAM_COUNT] = {
+    10, // PARAM_ZERO_REV_WORTH
+    10, // PARAM_NUM_WORTH
+    10, // PARAM_SKIP_DRAW2_WORTH
+    13, // PARAM_CHALLENGE_MARGIN
+    13, // PARAM_ATTACK_SIZE
+    13, // PARAM_REVERSE_SIZE
+    13, // PARAM_SAVE_SIZE
+    1   // PARAM_NUM_FIRST
+}; // PARAM_MAX[]
+
+/**
+ * Constructor.
+ *
+ * @param threads How many threads to play games. Pass 0 to use all cores.
+ * @param games   How many games to play for each candidate in each
+ *                iteration. The validation of the best parameters plays
+ *                4 times as many games.
+ * @param seed    Base of random seeds.
+ */
+Tuner::Tuner(int threads, int games, unsigned seed) {
+    if (threads <= 0) {
+        threads = int(std::thread::hardware_concurrency());
+    } // if (threads <= 0)
+
+    this->threads = threads > 0 ? threads : 1;
+    this->games = games > 0 ? games : 1;
+    this->seed = seed;
+    players = 3;
+    difficulty = Uno::LV_HARD;
+    sevenZeroRule = draw2StackRule = false;
+    setStartParams(AI::DEFAULT_PARAMS);
+} // Tuner(int, int, unsigned) (Class Constructor)
+
+/**
+ * Set the game rules to tune for. By default, 3 players, hard level,
+ * and no special rules.
+ */
+void Tuner::setRules(int players, int difficulty,
+                     bool sevenZeroRule, bool draw2StackRule) {
+    this->players = players;
+    this->difficulty = difficulty;
+    this->sevenZeroRule = sevenZeroRule;
+    this->draw2StackRule = draw2StackRule;
+} // setRules(int, int, bool, bool)
+
+/**
+ * Start tuning from the specified parameters, instead of the default ones.
+ *
+ * @param params AI parameters (length == AI::PARAM_COUNT).
+ */
+void Tuner::setStartParams(const int params[]) {
+    for (int i = 0; i < AI::PARAM_COUNT; ++i) {
+        theta[i] = double(params[i] - PARAM_MIN[i])
+            / (PARAM_MAX[i] - PARAM_MIN[i]);
+        best[i] = params[i];
+    } // for (int i = 0; i < AI::PARAM_COUNT; ++i)
+
+    bestRate = -1.0;
+} // setStartParams(const int[])
+
+/**
+ * Save the optimizer state to the specified file after every iteration,
+ * and resume from it if it was saved by a run with the same settings.
+ * The file is removed when the run is finished.
+ *
+ * @param path Path of the checkpoint file.
+ */
+void Tuner::setCheckpoint(const std::string& path) {
+    checkpoint = path;
+} // setCheckpoint(const std::string&)
+
+/**
+ * @param iterations How many SPSA iterations.
+ * @return Settings of a run, which must match when resuming from a
+ *         checkpoint.
+ */
+std::string Tuner::describe(int iterations) {
+    std::ostringstream writer;
+
+    writer << "tuner " << seed << " " << games << " " << iterations
+        << " " << players << " " << difficulty << " " << sevenZeroRule
+        << " " << draw2StackRule;
+    return writer.str();
+} // describe(int)
+
+/**
+ * Save the optimizer state to the checkpoint file.
+ *
+ * @param iterations How many SPSA iterations.
+ * @param done       How many iterations are finished.
+ * @param bits       State of the perturbation random generator.
+ */
+void Tuner::saveProgress(int iterations, int done, unsigned bits) {
+    std::string settings = describe(iterations);
+    std::ostringstream writer;
+    unsigned length = unsigned(settings.size());
+
+    writer.write((const char*)&length, sizeof(length));
+    writer.write(settings.data(), settings.size());
+    writer.write((const char*)&done, sizeof(done));
+    writer.write((const char*)&bits, sizeof(bits));
+    writer.write((const char*)theta, sizeof(theta));
+    writer.write((const char*)best, sizeof(best));
+    writer.write((const char*)&bestRate, sizeof(bestRate));
+    if (!Checkpoint::save(checkpoint, writer.str())) {
+        std::cerr << "Cannot save checkpoint: " << checkpoint << std::endl;
+    } // if (!Checkpoint::save(checkpoint, writer.str()))
+} // saveProgress(int, int, unsigned)
+
+/**
+ * Load the optimizer state saved by a run with the same settings.
+ *
+ * @param iterations How many SPSA iterations.
+ * @param outBits    Out parameter. Pass an unsigned array (length>=1)
+ *                   to receive the state of the perturbation random
+ *                   generator.
+ * @return How many iterations are finished, or 0 if there is no
+ *         checkpoint of the same settings.
+ */
+int Tuner::loadProgress(int iterations, unsigned outBits[]) {
+    int done;
+    bool ok;
+    unsigned length, bits;
+    double u[AI::PARAM_COUNT], rate;
+    int params[AI::PARAM_COUNT];
+    std::string data, settings = describe(iterations);
+
+    if (!Checkpoint::load(checkpoint, data)) {
+        return 0;
+    } // if (!Checkpoint::load(checkpoint, data))
+
+    std::istringstream reader(data);
+    ok = reader.read((char*)&length, sizeof(length))
+        && length == settings.size();
+    if (ok) {
+        data.assign(length, '\0');
+        ok = reader.read(&data[0], length) && data == settings
+            && reader.read((char*)&done, sizeof(done))
+            && reader.read((char*)&bits, sizeof(bits))
+            && reader.read((char*)u, sizeof(u))
+            && reader.read((char*)params, sizeof(params))
+            && reader.read((char*)&rate, sizeof(rate));
+    } // if (ok)
+
+    if (!ok) {
+        return 0;
+    } // if (!ok)
+
+    for (int i = 0; i < AI::PARAM_COUNT; ++i) {
+        theta[i] = u[i];
+        best[i] = params[i];
+    } // for (int i = 0; i < AI::PARAM_COUNT; ++i)
+
+    bestRate = rate;
+    outBits[0] = bits;
+    return done;
+} // loadProgress(int, unsigned[])
+
+/**
+ * Convert normalized parameters to AI parameters.
+ *
+ * @param u         Normalized parameters.
+ * @param outParams Out parameter, receives the AI parameters.
+ */
+void Tuner::denormalize(const double u[], int outParams[]) {
+    for (int i = 0; i < AI::PARAM_COUNT; ++i) {
+        int range = PARAM_MAX[i] - PARAM_MIN[i];
+        int value = PARAM_MIN[i] + int(std::floor(u[i] * range + 0.5));
+        outParams[i] = value < PARAM_MIN[i] ? PARAM_MIN[i]
+            : value > PARAM_MAX[i] ? PARAM_MAX[i] : value;
+    } // for (int i = 0; i < AI::PARAM_COUNT; ++i)
+} // denormalize(const double[], int[])
+
+/**
+ * Let the specified parameters play against the default parameters.
+ *
+ * @param params    AI parameters to evaluate.
+ * @param firstSeed Seed of the first game. Game i uses firstSeed + i.
+ * @param count     How many games to play.
+ * @return Winning rate of the specified parameters.
+ */
+double Tuner::evaluate(const int params[], unsigned firstSeed, int count) {
+    int i, wins;
+    static const int SEATS[2][4] = {
+        { Player::YOU, Player::COM1, Player::COM3, -1 },
+        { Player::YOU, Player::COM1, Player::COM2, Player::COM3 }
+    }; // SEATS[][]
+
+    Scheduler scheduler(threads);
+    std::vector<int> mine(scheduler.getThreads(), 0);
+    scheduler.run(count, 0, [&](int worker, int g) {
+        int who;
+
+        // The tuned AI takes every seat in turn
+        Uno uno = Uno::newHeadlessInstance(firstSeed + unsigned(g));
+        uno.setPlayers(players);
+        uno.setDifficulty(difficulty);
+        uno.setSevenZeroRule(sevenZeroRule);
+        uno.setDraw2StackRule(draw2StackRule);
+        who = SEATS[players == 4][g % players];
+        uno.setAIParams(who, params);
+
+        Simulator sim(&uno);
+        sim.start();
+        if (sim.run(1000) == who) {
+            ++mine[worker];
+        } // if (sim.run(1000) == who)
+    }); // scheduler.run()
+
+    wins = 0;
+    for (i = 0; i < int(mine.size()); ++i) {
+        wins += mine[i];
+    } // for (i = 0; i < int(mine.size()); ++i)
+
+    return double(wins) / count;
+} // evaluate(const int[], unsigned, int)
+
+/**
+ * Run the tuner.
+ *
+ * @param iterations How many SPSA iterations.
+ * @param path       When not nullptr, save the best parameters found so
+ *                   far to this file whenever they are improved.
+ */
+void Tuner::run(int iterations, const char* path) {
+    int i, k, range;
+    double ak, ck, rate, ratePlus, rateMinus;
+    double step[AI::PARAM_COUNT], uPlus[AI::PARAM_COUNT];
+    double uMinus[AI::PARAM_COUNT];
+    int plus[AI::PARAM_COUNT], minus[AI::PARAM_COUNT];
+    unsigned first, validSeed, bits[1] = { seed };
+
+    // Validation games use fixed seeds, so that all candidates are
+    // compared on the same games
+    validSeed = seed ^ 0x5a5a5a5aU;
+    k = checkpoint.empty() ? 0 : loadProgress(iterations, bits);
+    if (k > 0) {
+        std::cout << "resume: iteration " << k << std::endl;
+    } // if (k > 0)
+
+    if (bestRate < 0.0) {
+        bestRate = evaluate(best, validSeed, 4 * games);
+        std::cout << "start: " << bestRate << std::endl;
+    } // if (bestRate < 0.0)
+
+    for (; k < iterations; ++k) {
+        // Standard SPSA gain sequences
+        ak = 0.2 / std::pow(k + 1 + 10.0, 0.602);
+        ck = 0.1 / std::pow(k + 1.0, 0.101);
+        for (i = 0; i < AI::PARAM_COUNT; ++i) {
+            // Perturb by at least 1 after rounding
+            range = PARAM_MAX[i] - PARAM_MIN[i];
+            bits[0] = bits[0] * 1103515245U + 12345U;
+            step[i] = std::ceil(ck * range) / range;
+            step[i] = (bits[0] & 0x10000U) ? step[i] : -step[i];
+            uPlus[i] = theta[i] + step[i];
+            uMinus[i] = theta[i] - step[i];
+        } // for (i = 0; i < AI::PARAM_COUNT; ++i)
+
+        // Both candidates play the same games
+        denormalize(uPlus, plus);
+        denormalize(uMinus, minus);
+        first = seed + unsigned(k) * unsigned(games);
+        ratePlus = evaluate(plus, first, games);
+        rateMinus = evaluate(minus, first, games);
+        for (i = 0; i < AI::PARAM_COUNT; ++i) {
+            theta[i] += ak * (ratePlus - rateMinus) / (2.0 * step[i]);
+            theta[i] = theta[i] < 0.0 ? 0.0 : theta[i] > 1.0 ? 1.0 : theta[i];
+        } // for (i = 0; i < AI::PARAM_COUNT; ++i)
+
+        // Validate current parameters every 10 iterations
+        if (k % 10 == 9 || k == iterations - 1) {
+            denormalize(theta, plus);
+            rate = evaluate(plus, validSeed, 4 * games);
+            std::cout << "iteration " << (k + 1) << ": " << rate;
+            if (rate > bestRate) {
+                bestRate = rate;
+                for (i = 0; i < AI::PARAM_COUNT; ++i) {
+                    best[i] = plus[i];
+                } // for (i = 0; i < AI::PARAM_COUNT; ++i)
+
+                std::cout << " (best)";
+                if (path != nullptr) {
+                    AI::saveParams(path, best);
+                } // if (path != nullptr)
+            } // if (rate > bestRate)
+
+            std::cout << std::endl;
+        } // if (k % 10 == 9 || k == iterations - 1)
+
+        if (!checkpoint.empty() && k + 1 < iterations) {
+            saveProgress(iterations, k + 1, bits[0]);
+        } // if (!checkpoint.empty() && k + 1 < iterations)
+    } // for (; k < iterations; ++k)
+
+    if (!checkpoint.empty()) {
+        Checkpoint::remove(checkpoint);
+    } // if (!checkpoint.empty())
+} // run(int, const char*)
+
+/**
+ * @return The best parameters found so far.
+ */
+const int* Tuner::getBestParams() {
+    return best;
+} // getBestParams()
+
+/**
+ * @return Winning rate of the best parameters found so far, against the
+ *         default parameters, in validation games.
+ */
+double Tuner::getBestRate() {
+    return bestRate;
+} // getBestRate()
+
+// E.O.F
\ No newline at end of file
@@ -12,16 +12,19 @@
 #include <vector>
 #include <cstdlib>
 #include <QString>
+#include <utility>
 #include <iostream>
 #include "include/Uno.h"
 #include "include/Card.h"
 #include "include/Color.h"
 #include "include/Player.h"
 #include "include/Content.h"
+#include "include/AI.h"
 
 #define MASK_I_TO_END(i) (0xffffffffU << (i))
 #define MASK_BEGIN_TO_I(i) (~(0xffffffffU << (i)))
 #define MASK_ALL(u, p) MASK_BEGIN_TO_I((u)->getPlayer(p)->getHandSize())
+#define HASH_MIX(h, v) (((h) ^ (unsigned long long)(v)) * 0x100000001b3ULL)
 
 static const QString A[] = {
     "k", "r", "b", "g", "y"
@@ -42,6 +45,7 @@ static const char* BROKEN_IMAGE_RESOURCES_EXCEPTION =
 Uno::Uno(unsigned seed) {
     QImage br, dk;
     int i, done, total;
+    static std::vector<Card> cards;
 
     // Preparations
     done = 0;
@@ -100,7 +104,7 @@ Uno::Uno(unsigned seed) {
             dk.load("resource/dark_" + A[a] + B[b] + ".png") &&
             dk.width() == 121 && dk.height() == 181) {
             done += 2;
-            table.push_back(Card(br, dk, a, b));
+            cards.push_back(Card(br, dk, a, b));
             std::cout << "Loading... (" << 100 * done / total << "%)" << std::endl;
         } // if (br.load("resource/front_" + A[a] + B[b] + ".png") && ...)
         else {
@@ -110,8 +114,9 @@ Uno::Uno(unsigned seed) {
     } // for (i = 0; i < 54; ++i)
 
     // Load colored wild & wild +4 image resources
-    wildImage[0] = table.at(39 + WILD).image;
-    wildDraw4Image[0] = table.at(39 + WILD_DRAW4).image;
+    table = &cards;
+    wildImage[0] = table->at(39 + WILD).image;
+    wildDraw4Image[0] = table->at(39 + WILD_DRAW4).image;
     for (i = 1; i < 5; ++i) {
         if (br.load("resource/front_" + A[i] + B[WILD] + ".png") &&
             br.width() == 121 && br.height() == 181 &&
@@ -134,17 +139,55 @@ Uno::Uno(unsigned seed) {
     } // if (seed == 0U)
 
     std::cout << "Random seed is " << seed << std::endl;
-    srand(seed);
+    init(seed);
+} // Uno(unsigned) (Class Constructor)
+
+/**
+ * Headless constructor. Load no resources, and use the shared headless
+ * card table.
+ */
+Uno::Uno(std::vector<Card>* table, unsigned seed) {
+    if (seed == 0U) {
+        seed = unsigned(time(nullptr));
+    } // if (seed == 0U)
 
-    // Initialize other members
+    this->table = table;
+    init(seed);
+} // Uno(std::vector<Card>*, unsigned) (Class Constructor)
+
+/**
+ * Initialize members, except resources and card table.
+ */
+void Uno::init(unsigned seed) {
+    randState = seed;
     players = 3;
     legality = 0;
     now = rand() % 4;
     forcePlay = true;
     difficulty = LV_EASY;
-    draw2StackCount = direction = 0;
+    thinkTime = thinkNodes = 0;
+    draw2StackCount = direction = reshuffles = 0;
     draw2StackRule = sevenZeroRule = false;
-} // Uno(unsigned) (Class Constructor)
+    aiParams[0] = aiParams[1] = aiParams[2] = aiParams[3] = nullptr;
+} // init(unsigned)
+
+/**
+ * @return The card table shared by all headless runtimes.
+ */
+std::vector<Card>* Uno::getHeadlessTable() {
+    static std::vector<Card> cards = [] {
+        std::vector<Card> v;
+        for (int i = 0; i < 54; ++i) {
+            Color a = i < 52 ? Color(i / 13 + 1) : Color(0);
+            Content b = i < 52 ? Content(i % 13) : Content(i - 39);
+            v.push_back(Card(QImage(), QImage(), a, b));
+        } // for (int i = 0; i < 54; ++i)
+
+        return v;
+    }(); // cards
+
+    return &cards;
+} // getHeadlessTable()
 
 /**
  * @return Reference of our singleton.
@@ -154,6 +197,96 @@ Uno* Uno::getInstance(unsigned seed) {
     return &instance;
 } // getInstance(unsigned)
 
+/**
+ * Create a headless runtime. A headless runtime loads no image resources
+ * and prints no messages, so it can be created without a QApplication.
+ * Every runtime owns its random number generator, so runtimes can run in
+ * different threads, and each game is reproducible from its seed.
+ *
+ * @param seed Random seed. Pass 0 to generate one from current time.
+ * @return The new runtime.
+ */
+Uno Uno::newHeadlessInstance(unsigned seed) {
+    return Uno(getHeadlessTable(), seed);
+} // newHeadlessInstance(unsigned)
+
+/**
+ * Our own random number generator, works like std::rand().
+ *
+ * @return A pseudo-random integer between 0 and 0x7fffffff.
+ */
+int Uno::rand() {
+    randState = randState * 6364136223846793005ULL + 1442695040888963407ULL;
+    return int(randState >> 33);
+} // rand()
+
+/**
+ * @return Current state of our random number generator.
+ */
+unsigned long long Uno::getRandState() {
+    return randState;
+} // getRandState()
+
+/**
+ * Restore the state of our random number generator.
+ *
+ * @param state Value got from getRandState().
+ */
+void Uno::setRandState(unsigned long long state) {
+    randState = state;
+} // setRandState(unsigned long long)
+
+/**
+ * Calculate a 64-bit hash value of the whole game state, including card
+ * deck, everyone's hand cards, and our random number generator. Two
+ * runtimes with equal hash values behave the same from now on.
+ *
+ * @return Hash value of current game state.
+ */
+unsigned long long Uno::getStateHash() {
+    int i, j;
+    unsigned long long h = 0xcbf29ce484222325ULL;
+
+    h = HASH_MIX(h, randState);
+    h = HASH_MIX(h, now);
+    h = HASH_MIX(h, players);
+    h = HASH_MIX(h, direction);
+    h = HASH_MIX(h, difficulty);
+    h = HASH_MIX(h, thinkTime);
+    h = HASH_MIX(h, thinkNodes);
+    for (i = Player::YOU; i <= Player::COM3; ++i) {
+        h = HASH_MIX(h, -1);
+        for (j = 0; aiParams[i] != nullptr && j < AI::PARAM_COUNT; ++j) {
+            h = HASH_MIX(h, aiParams[i][j]);
+        } // for (j = 0; aiParams[i] != nullptr && j < AI::PARAM_COUNT; ++j)
+    } // for (i = Player::YOU; i <= Player::COM3; ++i)
+
+    h = HASH_MIX(h, forcePlay);
+    h = HASH_MIX(h, sevenZeroRule);
+    h = HASH_MIX(h, draw2StackRule);
+    h = HASH_MIX(h, draw2StackCount);
+    h = HASH_MIX(h, legality);
+    for (Card* card : deck) h = HASH_MIX(h, card->id);
+    h = HASH_MIX(h, -1);
+    for (Card* card : used) h = HASH_MIX(h, card->id);
+    h = HASH_MIX(h, -1);
+    for (Card* card : recent) h = HASH_MIX(h, card->id);
+    h = HASH_MIX(h, -1);
+    for (Color color : recentColors) h = HASH_MIX(h, color);
+    for (i = Player::YOU; i <= Player::COM3; ++i) {
+        Player& p = player[i];
+        h = HASH_MIX(h, -1);
+        for (Card* card : p.handCards) h = HASH_MIX(h, card->id);
+        h = HASH_MIX(h, p.strongColor);
+        h = HASH_MIX(h, p.weakColor);
+        h = HASH_MIX(h, p.strongCount);
+        h = HASH_MIX(h, p.open);
+        h = HASH_MIX(h, p.recent == nullptr ? -1 : p.recent->id);
+    } // for (i = Player::YOU; i <= Player::COM3; ++i)
+
+    return h;
+} // getStateHash()
+
 /**
  * @return Card back image resource.
  */
@@ -335,7 +468,14 @@ void Uno::switchDirection() {
 } // switchDirection()
 
 /**
- * @return Current difficulty (LV_EASY / LV_HARD).
+ * @return Current action sequence (DIR_LEFT / DIR_RIGHT).
+ */
+int Uno::getDirection() {
+    return direction;
+} // getDirection()
+
+/**
+ * @return Current difficulty (LV_EASY / LV_HARD / LV_POLICY).
  */
 int Uno::getDifficulty() {
     return difficulty;
@@ -345,14 +485,78 @@ int Uno::getDifficulty() {
  * Set game difficulty.
  *
  * @param difficulty Pass target difficulty value.
- *                   Only LV_EASY and LV_HARD are available.
+ *                   Only LV_EASY, LV_HARD and LV_POLICY are available.
  */
 void Uno::setDifficulty(int difficulty) {
-    if (difficulty == LV_EASY || difficulty == LV_HARD) {
+    if (difficulty == LV_EASY || difficulty == LV_HARD
+        || difficulty == LV_POLICY) {
         this->difficulty = difficulty;
-    } // if (difficulty == LV_EASY || difficulty == LV_HARD)
+    } // if (difficulty == LV_EASY || ...)
 } // setDifficulty(int)
 
+/**
+ * @return Time budget of anytime AI in milli seconds, or 0 if none.
+ */
+int Uno::getThinkTime() {
+    return thinkTime;
+} // getThinkTime()
+
+/**
+ * Set the time budget of anytime AI. When either the time budget or the
+ * node budget is set, AI players search for the best card to play until
+ * the budget runs out, instead of using the fixed difficulty strategies.
+ * See AI::searchAI_bestCardIndex4NowPlayer(Color[]).
+ *
+ * @param millis Time budget per action, or 0 to disable it.
+ */
+void Uno::setThinkTime(int millis) {
+    thinkTime = millis > 0 ? millis : 0;
+} // setThinkTime(int)
+
+/**
+ * @return Node budget of anytime AI, or 0 if none.
+ */
+int Uno::getThinkNodes() {
+    return thinkNodes;
+} // getThinkNodes()
+
+/**
+ * Set the node budget of anytime AI, i.e. how many simulated games at
+ * most AI can play in one action. Unlike time budget, the result of a
+ * node budget is reproducible, and does not depend on CPU load.
+ *
+ * @param nodes Node budget per action, or 0 to disable it.
+ */
+void Uno::setThinkNodes(int nodes) {
+    thinkNodes = nodes > 0 ? nodes : 0;
+} // setThinkNodes(int)
+
+/**
+ * @param who Get whose AI parameters. Must be one of the following:
+ *            Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+ * @return AI parameters of the specified player, or nullptr if the
+ *         player uses the default ones. See AI::PARAM_COUNT.
+ */
+const int* Uno::getAIParams(int who) {
+    return who >= Player::YOU && who <= Player::COM3 ? aiParams[who] : nullptr;
+} // getAIParams(int)
+
+/**
+ * Let the specified player's AI use the provided parameters, instead of
+ * the default ones. The array is NOT copied, so keep it alive as long as
+ * this runtime and its copies are still working.
+ *
+ * @param who    Set whose AI parameters. Must be one of the following:
+ *               Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+ * @param params AI parameters (length == AI::PARAM_COUNT), or nullptr
+ *               to use the default ones.
+ */
+void Uno::setAIParams(int who, const int params[]) {
+    if (who >= Player::YOU && who <= Player::COM3) {
+        aiParams[who] = params;
+    } // if (who >= Player::YOU && who <= Player::COM3)
+} // setAIParams(int, const int[])
+
 /**
  * @return This value tells that what's the next step
  *         after you drew a playable card in your action.
@@ -427,11 +631,11 @@ int Uno::getDraw2StackCount() {
  */
 Card* Uno::findCard(Color color, Content content) {
     return color == NONE && content == WILD
-        ? &table.at(39 + WILD)
+        ? &table->at(39 + WILD)
         : color == NONE && content == WILD_DRAW4
-        ? &table.at(39 + WILD_DRAW4)
+        ? &table->at(39 + WILD_DRAW4)
         : color != NONE && content != WILD && content != WILD_DRAW4
-        ? &table.at(13 * (color - 1) + content)
+        ? &table->at(13 * (color - 1) + content)
         : nullptr;
 } // findCard(Color, Content)
 
@@ -449,6 +653,14 @@ int Uno::getUsedCount() {
     return int((used.size() + recent.size()));
 } // getUsedCount()
 
+/**
+ * @return How many times the used cards are reshuffled into the deck
+ *         in the current game.
+ */
+int Uno::getReshuffleCount() {
+    return reshuffles;
+} // getReshuffleCount()
+
 /**
  * @return Recent played cards.
  */
@@ -491,22 +703,33 @@ void Uno::start() {
     // In +2 stack rule, reset the stack counter
     draw2StackCount = 0;
 
+    // Reset the reshuffle counter
+    reshuffles = 0;
+
     // Clear card deck, used card deck, recent played cards,
     // everyone's hand cards, and everyone's strong/weak colors
+    // Also reserve the max size of every pile, so that the game never
+    // allocates memory after the start (108 cards in total, and at most 6
+    // recent played cards)
     deck.clear();
     used.clear();
     recent.clear();
     recentColors.clear();
+    deck.reserve(108);
+    used.reserve(108);
+    recent.reserve(6);
+    recentColors.reserve(6);
     for (i = Player::YOU; i <= Player::COM3; ++i) {
         player[i].open = 0x00;
         player[i].handCards.clear();
+        player[i].handCards.reserve(MAX_HOLD_CARDS);
         player[i].weakColor = NONE;
         player[i].strongColor = NONE;
     } // for (i = Player::YOU; i <= Player::COM3; ++i)
 
     // Generate a temporary sequenced card deck
     for (i = 0; i < 54; ++i) {
-        card = &table.at(i);
+        card = &table->at(i);
         switch (card->content) {
         case WILD:
         case WILD_DRAW4:
@@ -630,6 +853,10 @@ int Uno::draw(int who, bool force) {
             if (deck.empty()) {
                 // Re-use the used cards when there are no more cards in deck
                 size = int(used.size());
+                if (size > 0) {
+                    ++reshuffles;
+                } // if (size > 0)
+
                 while (size > 0) {
                     index = rand() % size--;
                     deck.push_back(used.at(index));
@@ -819,9 +1046,11 @@ bool Uno::challenge(int whom) {
  *          Cannot exchange with yourself.
  */
 void Uno::swap(int a, int b) {
-    Player store = player[a];
-    player[a] = player[b];
-    player[b] = store;
+    if (a != b) {
+        // Exchange without copying hand cards
+        std::swap(player[a], player[b]);
+    } // if (a != b)
+
     if (a == Player::YOU || b == Player::YOU) {
         player[Player::YOU].sort();
         player[Player::YOU].open = MASK_ALL(this, Player::YOU);
@@ -834,13 +1063,79 @@ void Uno::swap(int a, int b) {
  */
 void Uno::cycle() {
     int curr = now, next = getNext(), oppo = getOppo(), prev = getPrev();
-    Player store = player[curr];
-    player[curr] = player[prev];
-    player[prev] = player[oppo];
-    player[oppo] = player[next];
-    player[next] = store;
+
+    // Rotate by exchanging, without copying hand cards. When only 3
+    // players in game, oppo == prev, and the middle exchange is skipped.
+    std::swap(player[curr], player[prev]);
+    if (oppo != prev) {
+        std::swap(player[prev], player[oppo]);
+    } // if (oppo != prev)
+
+    std::swap(player[oppo], player[next]);
     player[Player::YOU].sort();
     player[Player::YOU].open = MASK_ALL(this, Player::YOU);
 } // cycle()
 
+/**
+ * Shuffle all cards unknown to the specified player, i.e. the card deck
+ * and the other players' hand cards, then deal them again. Everyone keeps
+ * the same amount of hand cards. Call this function on a copy of runtime
+ * before simulating the rest of game, so that the simulation does not
+ * peek at the others' hand cards. When the specified player is you, the
+ * cards you have seen (see Player::isOpen(int)) are kept in place.
+ *
+ * @param who Redeal from whose view. Must be one of the following:
+ *            Player::YOU, Player::COM1, Player::COM2, Player::COM3.
+ */
+void Uno::redeal(int who) {
+    Card* card;
+    int i, j, size, count[4];
+    std::vector<Card*> pool(deck);
+
+    // Collect unknown cards
+    for (i = Player::YOU; i <= Player::COM3; ++i) {
+        Player& p = player[i];
+        count[i] = int(p.handCards.size());
+        if (i == who) {
+            continue;
+        } // if (i == who)
+
+        std::vector<Card*> kept;
+        for (j = 0; j < count[i]; ++j) {
+            if (who == Player::YOU && p.isOpen(j)) {
+                kept.push_back(p.handCards[j]);
+            } // if (who == Player::YOU && p.isOpen(j))
+            else {
+                pool.push_back(p.handCards[j]);
+            } // else
+        } // for (j = 0; j < count[i]; ++j)
+
+        p.handCards = kept;
+        p.open = MASK_BEGIN_TO_I(kept.size());
+    } // for (i = Player::YOU; i <= Player::COM3; ++i)
+
+    // Shuffle them
+    size = int(pool.size());
+    while (size > 0) {
+        i = rand() % size--;
+        card = pool[i]; pool[i] = pool[size]; pool[size] = card;
+    } // while (size > 0)
+
+    // Deal them again, and the rest becomes the new card deck
+    for (i = Player::YOU; i <= Player::COM3; ++i) {
+        Player& p = player[i];
+        while (int(p.handCards.size()) < count[i]) {
+            p.handCards.push_back(pool.back());
+            pool.pop_back();
+        } // while (int(p.handCards.size()) < count[i])
+    } // for (i = Player::YOU; i <= Player::COM3; ++i)
+
+    if (who != Player::YOU) {
+        player[Player::YOU].sort();
+        player[Player::YOU].open = MASK_ALL(this, Player::YOU);
+    } // if (who != Player::YOU)
+
+    deck = pool;
+} // redeal(int)
+
 // E.O.F
\ No newline at end of file
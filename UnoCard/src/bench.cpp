@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Uno Card Game 4 PC
+// Author: Hikari Toyama
+// Compile Environment: Qt 5 with Qt Creator
+// COPYRIGHT HIKARI TOYAMA, 1992-2022. ALL RIGHTS RESERVED.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <new>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "include/Benchmark.h"
+#include "include/Differ.h"
+#include "include/Uno.h"
+
+/**
+ * Replace the global operator new and delete, to count heap allocations
+ * and frees of the whole program in Benchmark::allocations and
+ * Benchmark::frees.
+ */
+void* operator new(std::size_t size) {
+    void* p = malloc(size > 0 ? size : 1);
+
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    } // if (p == nullptr)
+
+    Benchmark::allocations.fetch_add(1LL, std::memory_order_relaxed);
+    return p;
+} // new(std::size_t)
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+} // new[](std::size_t)
+
+void operator delete(void* p) noexcept {
+    if (p != nullptr) {
+        Benchmark::frees.fetch_add(1LL, std::memory_order_relaxed);
+        free(p);
+    } // if (p != nullptr)
+} // delete(void*)
+
+void operator delete[](void* p) noexcept {
+    operator delete(p);
+} // delete[](void*)
+
+/**
+ * Defines the entry point for the benchmark program (see Benchmark.pro).
+ * Run "UnoCardBench [options]" to run micro benchmarks of the headless
+ * engine, and print the results as JSON (see Benchmark class). Options are:
+ *   --macro        Run macro benchmarks (complete AI games) instead.
+ *   --heap         Run heap instrumentation instead, counting allocations
+ *                  and frees per game, action and engine entry point.
+ *                  Exit with 3 when any game allocates after setup.
+ *   --diff         Check the equivalence between the headless engine and
+ *                  its frozen reference copy (see Differ class) instead,
+ *                  with every combination of rules and the easy / hard
+ *                  levels, and check the batched easy AI (see Lockstep
+ *                  class) against EasyAgent with every combination of
+ *                  rules without 7-0 rule. Exit with 2 when any
+ *                  divergence is found.
+ *   --seeds n      How many seeds to check with each combination of rules
+ *                  in --diff mode (100000 by default).
+ *   --games n      How many games to play with each combination of rules
+ *                  in macro benchmarks and heap instrumentation (2000 by
+ *                  default).
+ *   --seconds s    Minimum measuring time of each benchmark (0.2 by
+ *                  default).
+ *   --seed n       Master seed of fixed states (1 by default). Only
+ *                  results of the same seed are comparable. In --diff
+ *                  mode, the first seed to check.
+ *   --output path  Write the results to a file instead of stdout.
+ */
+int main(int argc, char* argv[]) {
+    int i, games, seeds;
+    bool macro, heap, diff, equivalent;
+    unsigned seed;
+    double seconds;
+    std::ofstream writer;
+    const char* output;
+
+    macro = heap = diff = false;
+    games = 2000;
+    seeds = 100000;
+    seconds = 0.2;
+    seed = 1U;
+    output = nullptr;
+    for (i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--macro") == 0) {
+            macro = true;
+        } // if (strcmp(argv[i], "--macro") == 0)
+        else if (strcmp(argv[i], "--heap") == 0) {
+            heap = true;
+        } // else if (strcmp(argv[i], "--heap") == 0)
+        else if (strcmp(argv[i], "--diff") == 0) {
+            diff = true;
+        } // else if (strcmp(argv[i], "--diff") == 0)
+        else if (i + 1 >= argc) {
+            break;
+        } // else if (i + 1 >= argc)
+        else if (strcmp(argv[i], "--games") == 0) {
+            games = atoi(argv[++i]);
+        } // else if (strcmp(argv[i], "--games") == 0)
+        else if (strcmp(argv[i], "--seeds") == 0) {
+            seeds = atoi(argv[++i]);
+        } // else if (strcmp(argv[i], "--seeds") == 0)
+        else if (strcmp(argv[i], "--seconds") == 0) {
+            seconds = atof(argv[++i]);
+        } // else if (strcmp(argv[i], "--seconds") == 0)
+        else if (strcmp(argv[i], "--seed") == 0) {
+            seed = unsigned(atoi(argv[++i]));
+        } // else if (strcmp(argv[i], "--seed") == 0)
+        else if (strcmp(argv[i], "--output") == 0) {
+            output = argv[++i];
+        } // else if (strcmp(argv[i], "--output") == 0)
+        else {
+            break;
+        } // else
+    } // for (i = 1; i < argc; ++i)
+
+    if (i < argc || games <= 0 || seeds <= 0) {
+        std::cerr << "Bad option: " << (i < argc ? argv[i] : "")
+            << std::endl;
+        return 1;
+    } // if (i < argc || games <= 0 || seeds <= 0)
+
+    if (output != nullptr) {
+        writer.open(output);
+        if (writer.fail()) {
+            std::cerr << "Cannot write: " << output << std::endl;
+            return 1;
+        } // if (writer.fail())
+    } // if (output != nullptr)
+
+    if (diff) {
+        // Bit 0: 3 players; bit 1: no force play; bit 2: 7-0 rule;
+        // bit 3: +2 stack rule; bit 4: easy level
+        std::ostream& out = output != nullptr ? writer : std::cout;
+        Differ differ(0);
+        equivalent = true;
+        out << "[";
+        for (i = 0; i < 32; ++i) {
+            differ.setRules(i & 1 ? 3 : 4,
+                            i & 16 ? Uno::LV_EASY : Uno::LV_HARD,
+                            !(i & 2), (i & 4) != 0, (i & 8) != 0);
+            out << (i > 0 ? ",\n " : "");
+            equivalent = differ.run(seed, seeds, out) && equivalent;
+            if ((i & 16) && !(i & 4)) {
+                out << ",\n ";
+                equivalent = differ.lockstep(seed, seeds, out)
+                    && equivalent;
+            } // if ((i & 16) && !(i & 4))
+
+            out.flush();
+        } // for (i = 0; i < 32; ++i)
+
+        out << "]" << std::endl;
+        return equivalent ? 0 : 2;
+    } // if (diff)
+
+    Benchmark benchmark(seed, seconds);
+    if (heap) {
+        return benchmark.heap(games, output != nullptr ? writer : std::cout)
+            ? 0 : 3;
+    } // if (heap)
+    else if (macro) {
+        benchmark.macro(games, output != nullptr ? writer : std::cout);
+    } // else if (macro)
+    else {
+        benchmark.micro(output != nullptr ? writer : std::cout);
+    } // else
+
+    return 0;
+} // main(int, char*[])
+
+// E.O.F
\ No newline at end of file
@@ -16,9 +16,12 @@
 #include <QColor>
 #include <QImage>
 #include <QTimer>
+#include <chrono>
+#include <future>
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
+#include <iostream>
 #include <QString>
 #include <QPainter>
 #include <QFileInfo>
@@ -29,9 +32,19 @@
 #include <QApplication>
 #include <QMediaPlayer>
 #include <QMediaPlaylist>
+#include "include/Transposition.h"
 #include "include/SoundPool.h"
+#include "include/Speculator.h"
+#include "include/BluffSolver.h"
+#include "include/Distiller.h"
+#include "include/Scanner.h"
 #include "include/Content.h"
+#include "include/Tuner.h"
+#include "include/Coverage.h"
+#include "include/Latency.h"
+#include "include/Arena.h"
 #include "include/Player.h"
+#include "include/Agent.h"
 #include "include/Color.h"
 #include "include/main.h"
 #include "include/i18n.h"
@@ -74,10 +87,10 @@ static int CLOSED_FLAG = 0x00000000;
  * Triggered when application starts.
  */
 Main::Main(int argc, char* argv[], QWidget* parent) : QWidget(parent) {
-    int i, hash;
+    int i, n, hash;
     QString bgmPath;
     std::ifstream reader;
-    int dw[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    int dw[10] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
     char header[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
 
     // Preparations
@@ -96,9 +109,19 @@ Main::Main(int argc, char* argv[], QWidget* parent) : QWidget(parent) {
         sUno = Uno::getInstance();
     } // else
 
+    if (AI::loadParams("UnoCard.params", sAIParams)) {
+        // Using AI parameters in UnoCard.params file (see Tuner class)
+        for (i = Player::YOU; i <= Player::COM3; ++i) {
+            sUno->setAIParams(i, sAIParams);
+        } // for (i = Player::YOU; i <= Player::COM3; ++i)
+    } // if (AI::loadParams("UnoCard.params", sAIParams))
+
     sScore = 0;
-    sAI = AI::getInstance();
+    sAgent = new AgentAdapter<DefaultAgent>;
     sSoundPool = new SoundPool;
+    sSpeculator = new Speculator;
+    sHinter = new Hinter;
+    sEstimator = new Estimator;
     sMediaPlay = new QMediaPlayer;
     sMediaList = new QMediaPlaylist;
     bgmPath = QFileInfo("resource/bgm.mp3").absoluteFilePath();
@@ -112,14 +135,16 @@ Main::Main(int argc, char* argv[], QWidget* parent) : QWidget(parent) {
         reader.seekg(0, std::ios::end);
         i = int(reader.tellg());
         reader.seekg(0, std::ios::beg);
-        if (i == 8 + 9 * sizeof(int)) {
+        // Files written by older versions have no AI think time (dw[8])
+        n = (i - 8) / int(sizeof(int));
+        if (i == 8 + n * int(sizeof(int)) && (n == 9 || n == 10)) {
             reader.read(header, 8);
-            reader.read((char*)dw, 9 * sizeof(int));
-            for (hash = 0, i = 0; i < 8; ++i) {
+            reader.read((char*)dw, n * sizeof(int));
+            for (hash = 0, i = 0; i < n - 1; ++i) {
                 hash = 31 * hash + dw[i];
-            } // for (hash = 0, i = 0; i < 8; ++i)
+            } // for (hash = 0, i = 0; i < n - 1; ++i)
 
-            if (strcmp(header, FILE_HEADER) == 0 && hash == dw[8]) {
+            if (strcmp(header, FILE_HEADER) == 0 && hash == dw[n - 1]) {
                 // File verification success
                 if (dw[0] > 9999) dw[0] = 9999;
                 else if (dw[0] < -999) dw[0] = -999;
@@ -131,14 +156,18 @@ Main::Main(int argc, char* argv[], QWidget* parent) : QWidget(parent) {
                 sUno->setDraw2StackRule(dw[5] != 0);
                 sSoundPool->setEnabled(dw[6] != 0);
                 sMediaPlay->setVolume(dw[7]);
-            } // if (strcmp(header, FILE_HEADER) == 0 && hash == dw[8])
-        } // if (i == 8 + 9 * sizeof(int))
+                sUno->setThinkTime(n == 10 ? dw[8] : 0);
+            } // if (strcmp(header, FILE_HEADER) == 0 && hash == dw[n - 1])
+        } // if (i == 8 + n * int(sizeof(int)) && (n == 9 || n == 10))
 
         reader.close();
     } // if (!reader.fail())
 
     sAuto = false;
+    sHint = true;
     sHideFlag = 0x00;
+    sHintVersion = 0;
+    sEstimateVersion = 0;
     sSelectedIdx = -1;
     sAIRunning = false;
     sWinner = Player::YOU;
@@ -157,12 +186,16 @@ Main::Main(int argc, char* argv[], QWidget* parent) : QWidget(parent) {
     ui->setupUi(this);
     sMediaPlay->play();
     setStatus(STAT_WELCOME);
+    startTimer(100); // poll the hint engine, see timerEvent(QTimerEvent*)
 } // Main(int, char*[], QWidget*) (Class Constructor)
 
 /**
- * AI Strategies (Difficulty: EASY).
+ * AI players' turn (and your turn in auto mode). Cards are chosen by our
+ * agent (see DefaultAgent class). When AI has a time budget or a node
+ * budget, AI thinks in a sub thread, so that our UI keeps responding
+ * meanwhile.
  */
-void Main::easyAI() {
+void Main::agentAI() {
     int idxBest;
     Color bestColor[1];
 
@@ -173,7 +206,11 @@ void Main::easyAI() {
             || sStatus == Player::COM3
             || (sStatus == Player::YOU && sAuto)) {
             setStatus(STAT_IDLE); // block mouse click events when idle
-            idxBest = sAI->easyAI_bestCardIndex4NowPlayer(bestColor);
+            if (!sSpeculator->fetch(sUno, &idxBest, bestColor)) {
+                idxBest = decideAI([&] {
+                    return sAgent->bestCardIndex(sUno, bestColor);
+                }); // idxBest = decideAI([&] { ... })
+            } // if (!sSpeculator->fetch(sUno, &idxBest, bestColor))
             if (idxBest >= 0) {
                 // Found an appropriate card to play
                 play(idxBest, bestColor[0]);
@@ -186,65 +223,7 @@ void Main::easyAI() {
 
         sAIRunning = false;
     } // if (!sAIRunning)
-} // easyAI()
-
-/**
- * AI Strategies (Difficulty: HARD).
- */
-void Main::hardAI() {
-    int idxBest;
-    Color bestColor[1];
-
-    if (!sAIRunning) {
-        sAIRunning = true;
-        while (sStatus == Player::COM1
-            || sStatus == Player::COM2
-            || sStatus == Player::COM3
-            || (sStatus == Player::YOU && sAuto)) {
-            setStatus(STAT_IDLE); // block mouse click events when idle
-            idxBest = sAI->hardAI_bestCardIndex4NowPlayer(bestColor);
-            if (idxBest >= 0) {
-                // Found an appropriate card to play
-                play(idxBest, bestColor[0]);
-            } // if (idxBest >= 0)
-            else {
-                // No appropriate cards to play, or no card to play
-                draw();
-            } // else
-        } // while (sStatus == Player::COM1 || ...)
-
-        sAIRunning = false;
-    } // if (!sAIRunning)
-} // hardAI()
-
-/**
- * Special AI strategies in 7-0 rule.
- */
-void Main::sevenZeroAI() {
-    int idxBest;
-    Color bestColor[1];
-
-    if (!sAIRunning) {
-        sAIRunning = true;
-        while (sStatus == Player::COM1
-            || sStatus == Player::COM2
-            || sStatus == Player::COM3
-            || (sStatus == Player::YOU && sAuto)) {
-            setStatus(STAT_IDLE); // block mouse click events when idle
-            idxBest = sAI->sevenZeroAI_bestCardIndex4NowPlayer(bestColor);
-            if (idxBest >= 0) {
-                // Found an appropriate card to play
-                play(idxBest, bestColor[0]);
-            } // if (idxBest >= 0)
-            else {
-                // No appropriate cards to play, or no card to play
-                draw();
-            } // else
-        } // while (sStatus == Player::COM1 || ...)
-
-        sAIRunning = false;
-    } // if (!sAIRunning)
-} // sevenZeroAI()
+} // agentAI()
 
 /**
  * Let our UI wait the number of specified milli seconds.
@@ -258,6 +237,29 @@ void Main::threadWait(int millis) {
     loop.exec();
 } // threadWait(int)
 
+/**
+ * Make an AI decision other than playing a card. When AI has a time budget
+ * or a node budget, the decision is made by rollouts in a sub thread, so
+ * that our UI keeps responding meanwhile.
+ *
+ * @param decide The decision to make.
+ * @return Result of the decision.
+ */
+int Main::decideAI(std::function<int()> decide) {
+    if (sUno->getThinkTime() <= 0 && sUno->getThinkNodes() <= 0) {
+        return decide();
+    } // if (sUno->getThinkTime() <= 0 && sUno->getThinkNodes() <= 0)
+
+    setStatus(STAT_IDLE); // block mouse click events when idle
+    auto task = std::async(std::launch::async, decide);
+    while (task.wait_for(std::chrono::milliseconds(0))
+        != std::future_status::ready) {
+        threadWait(10);
+    } // while (task.wait_for(...) != std::future_status::ready)
+
+    return task.get();
+} // decideAI(std::function<int()>)
+
 /**
  * Change the value of global variable [sStatus]
  * and do the following operations when necessary.
@@ -313,21 +315,22 @@ void Main::setStatus(int status) {
     case Player::YOU:
         // Your turn, select a hand card to play, or draw a card
         if (sAuto) {
-            if (sUno->isSevenZeroRule()) {
-                sevenZeroAI();
-            } // if (sUno->isSevenZeroRule())
-            else if (sUno->getDifficulty() == Uno::LV_EASY) {
-                easyAI();
-            } // else if (sUno->getDifficulty() == Uno::LV_EASY)
-            else {
-                hardAI();
-            } // else
+            agentAI();
         } // if (sAuto)
         else if (sUno->legalCardsCount4NowPlayer() == 0) {
             draw();
         } // else if (sUno->legalCardsCount4NowPlayer() == 0)
         else {
             auto hand = sUno->getPlayer(Player::YOU)->getHandCards();
+            if (hand.size() > 1) {
+                // Precompute AI replies while you are thinking
+                sSpeculator->start(sUno);
+                if (sHint) {
+                    // And search for the best action for you
+                    sHinter->start(sUno);
+                } // if (sHint)
+            } // if (hand.size() > 1)
+
             if (hand.size() == 1) {
                 play(0);
             } // if (hand.size() == 1)
@@ -355,9 +358,9 @@ void Main::setStatus(int status) {
     case STAT_DOUBT_WILD4:
         if (sAuto || sUno->getNext() != Player::YOU) {
             // Challenge or not is decided by AI
-            if (sAI->needToChallenge()) {
+            if (decideAI([this] { return int(sAgent->needToChallenge(sUno)); })) {
                 onChallenge();
-            } // if (sAI->needToChallenge())
+            } // if (decideAI([this] { ... }))
             else {
                 sUno->switchNow();
                 draw(4, /* force */ true);
@@ -374,7 +377,9 @@ void Main::setStatus(int status) {
         // must swap hand cards with another player immediately.
         if (sAuto || sUno->getNow() != Player::YOU) {
             // Seven-card is played by AI. Select target automatically.
-            swapWith(sAI->calcBestSwapTarget4NowPlayer());
+            swapWith(decideAI([this] {
+                return sAgent->swapTarget(sUno);
+            })); // swapWith(decideAI([this] { ... }))
         } // if (sAuto || sUno->getNow() != Player::YOU)
         else {
             // Seven-card is played by you. Select target manually.
@@ -386,15 +391,7 @@ void Main::setStatus(int status) {
     case Player::COM2:
     case Player::COM3:
         // AI players' turn
-        if (sUno->isSevenZeroRule()) {
-            sevenZeroAI();
-        } // if (sUno->isSevenZeroRule())
-        else if (sUno->getDifficulty() == Uno::LV_EASY) {
-            easyAI();
-        } // else if (sUno->getDifficulty() == Uno::LV_EASY)
-        else {
-            hardAI();
-        } // else
+        agentAI();
         break; // case Player::COM1, Player::COM2, Player::COM3
 
     case STAT_GAME_OVER:
@@ -445,6 +442,15 @@ void Main::refreshScreen(const QString& message) {
     sPainter->drawText(1260 - width, 700, i18n->btn_auto());
     if (sAuto) sPainter->setPen(PEN_WHITE);
 
+    // Right-bottom corner: <HINT> button
+    // Shows only when not configuring game options
+    if (!sAdjustOptions) {
+        if (sHint) sPainter->setPen(PEN_YELLOW);
+        width = sPainter->fontMetrics().width(i18n->btn_hint());
+        sPainter->drawText(1110 - width, 700, i18n->btn_hint());
+        if (sHint) sPainter->setPen(PEN_WHITE);
+    } // if (!sAdjustOptions)
+
     // Left-bottom corner: <OPTIONS> button
     // Shows only when game is not in process
     if (status == STAT_WELCOME || status == STAT_GAME_OVER) {
@@ -518,6 +524,18 @@ void Main::refreshScreen(const QString& message) {
             sUno->findCard(YELLOW, NUM4)->darkImg;
         sPainter->drawImage(970, 250, image);
 
+        // [AI think time] option: off / 50ms / 200ms / 1s
+        sPainter->drawText(60, 490, i18n->label_thinkTime());
+        sPainter->setPen(sUno->getThinkTime() == 0 ? PEN_RED : PEN_WHITE);
+        sPainter->drawText(790, 490, i18n->btn_off());
+        sPainter->setPen(sUno->getThinkTime() == 50 ? PEN_GREEN : PEN_WHITE);
+        sPainter->drawText(910, 490, i18n->btn_thinkTime(50));
+        sPainter->setPen(sUno->getThinkTime() == 200 ? PEN_GREEN : PEN_WHITE);
+        sPainter->drawText(1030, 490, i18n->btn_thinkTime(200));
+        sPainter->setPen(sUno->getThinkTime() == 1000 ? PEN_GREEN : PEN_WHITE);
+        sPainter->drawText(1150, 490, i18n->btn_thinkTime(1000));
+        sPainter->setPen(PEN_WHITE);
+
         // Rule settings
         // Force play switch
         sPainter->drawText(60, 540, i18n->label_forcePlay());
@@ -596,6 +614,22 @@ void Main::refreshScreen(const QString& message) {
         info = i18n->label_remain_used(remain, used);
         sPainter->drawText(20, 42, info);
 
+        // Left-top corner: everyone's win chance (see Estimator class)
+        if (status != STAT_GAME_OVER) {
+            double chance[4];
+
+            info = "";
+            sEstimator->estimate(sUno, Player::YOU, chance);
+            for (i = Player::YOU; i <= Player::COM3; ++i) {
+                if (sUno->getPlayers() == 4 || i != Player::COM2) {
+                    info += i18n->label_winChance(i, qRound(100 * chance[i]));
+                    info += "  ";
+                } // if (sUno->getPlayers() == 4 || i != Player::COM2)
+            } // for (i = Player::YOU; i <= Player::COM3; ++i)
+
+            sPainter->drawText(20, 84, info);
+        } // if (status != STAT_GAME_OVER)
+
         // Left-center: Hand cards of Player West (COM1)
         if (status == STAT_GAME_OVER && sWinner == Player::COM1) {
             // Played all hand cards, it's winner
@@ -684,8 +718,15 @@ void Main::refreshScreen(const QString& message) {
         } // if (status == STAT_GAME_OVER && sWinner == Player::YOU)
         else if ((sHideFlag & 0x01) == 0x00) {
             // Show your all hand cards
+            int hintIdx = -1;
+            Color hintColor[1] = { NONE };
             auto hand = sUno->getPlayer(Player::YOU)->getHandCards();
             size = int(hand.size());
+            if (!sHint || sAuto || status != Player::YOU
+                || !sHinter->getHint(sUno, &hintIdx, hintColor)) {
+                hintIdx = size;
+            } // if (!sHint || sAuto || status != Player::YOU || ...)
+
             for (i = 0; i < size; ++i) {
                 Card* card = hand.at(i);
                 image = status == STAT_GAME_OVER
@@ -698,6 +739,34 @@ void Main::refreshScreen(const QString& message) {
                 ); // drawImage(int, int, QImage&)
             } // for (i = 0; i < size; ++i)
 
+            if (hintIdx < size) {
+                // Frame the hinted card (or the card deck when the hint
+                // is to draw a card), in the hinted color for wild cards
+                QPen pen(hintColor[0] == RED ? BRUSH_RED.color()
+                    : hintColor[0] == BLUE ? BRUSH_BLUE.color()
+                    : hintColor[0] == GREEN ? BRUSH_GREEN.color()
+                    : BRUSH_YELLOW.color());
+                pen.setWidth(4);
+                sPainter->setPen(pen);
+                sPainter->setBrush(Qt::NoBrush);
+                if (hintIdx < 0) {
+                    image = sUno->getBackImage();
+                    sPainter->drawRect(338, 270,
+                                       image.width(), image.height());
+                } // if (hintIdx < 0)
+                else {
+                    image = hand.at(hintIdx)->image;
+                    sPainter->drawRect(
+                        /* x      */ (1205 - 45 * size + 90 * hintIdx) / 2,
+                        /* y      */ hintIdx == sSelectedIdx ? 500 : 520,
+                        /* width  */ image.width(),
+                        /* height */ image.height()
+                    ); // drawRect(int, int, int, int)
+                } // else
+
+                sPainter->setPen(PEN_WHITE);
+            } // if (hintIdx < size)
+
             if (size == 1) {
                 // Show "UNO" warning when only one card in hand
                 sPainter->setPen(PEN_YELLOW);
@@ -897,6 +966,7 @@ void Main::play(int index, Color color) {
     int c, now, size, recentSize, next;
 
     setStatus(STAT_IDLE); // block mouse click events when idle
+    sEstimator->log(sUno, std::clog);
     now = sUno->getNow();
     size = sUno->getCurrPlayer()->getHandSize();
     card = sUno->play(now, index, color);
@@ -1043,6 +1113,7 @@ void Main::draw(int count, bool force) {
     int i, index, c, now, size;
 
     setStatus(STAT_IDLE); // block mouse click events when idle
+    sEstimator->log(sUno, std::clog);
     c = sUno->getDraw2StackCount();
     if (c > 0) {
         count = c;
@@ -1113,7 +1184,7 @@ void Main::draw(int count, bool force) {
             play(index);
         } // if (!drawn->isWild())
         else if (sAuto || now != Player::YOU) {
-            play(index, sAI->calcBestColor4NowPlayer());
+            play(index, sAgent->bestColor(sUno));
         } // else if (sAuto || now != Player::YOU)
         else {
             // Store index value as global value. This value
@@ -1218,6 +1289,9 @@ void Main::onChallenge() {
  * Triggered when a mouse press event occurred. Called by system.
  */
 void Main::mousePressEvent(QMouseEvent* event) {
+    // Stop the hint engine at once, so that it never delays your action.
+    // It restarts by itself if you are still thinking in your turn.
+    sHinter->cancel();
     if (event->button() == Qt::LeftButton) {
         // Only response to left-click events, and ignore the others
         int x = event->x();
@@ -1269,6 +1343,28 @@ void Main::mousePressEvent(QMouseEvent* event) {
                     setStatus(sStatus);
                 } // else if (970 <= x && x <= 1090)
             } // else if (270 <= y && y <= 450)
+            else if (469 <= y && y <= 490) {
+                if (800 <= x && x <= 906) {
+                    // AI think time, <OFF> button
+                    sUno->setThinkTime(0);
+                    setStatus(sStatus);
+                } // if (800 <= x && x <= 906)
+                else if (920 <= x && x <= 1020) {
+                    // AI think time, 50 ms
+                    sUno->setThinkTime(50);
+                    setStatus(sStatus);
+                } // else if (920 <= x && x <= 1020)
+                else if (1040 <= x && x <= 1140) {
+                    // AI think time, 200 ms
+                    sUno->setThinkTime(200);
+                    setStatus(sStatus);
+                } // else if (1040 <= x && x <= 1140)
+                else if (1160 <= x && x <= 1230) {
+                    // AI think time, 1 s
+                    sUno->setThinkTime(1000);
+                    setStatus(sStatus);
+                } // else if (1160 <= x && x <= 1230)
+            } // else if (469 <= y && y <= 490)
             else if (519 <= y && y <= 540) {
                 if (800 <= x && x <= 927) {
                     // Force play, <KEEP> button
@@ -1325,6 +1421,12 @@ void Main::mousePressEvent(QMouseEvent* event) {
             sAuto = !sAuto;
             setStatus(sStatus == STAT_WILD_COLOR ? Player::YOU : sStatus);
         } // else if (679 <= y && y <= 700 && 1130 <= x && x <= 1260)
+        else if (679 <= y && y <= 700 && 980 <= x && x <= 1110) {
+            // <HINT> button
+            // Show or hide the best action for you, found in background
+            sHint = !sHint;
+            setStatus(sStatus);
+        } // else if (679 <= y && y <= 700 && 980 <= x && x <= 1110)
         else switch (sStatus) {
         case STAT_WELCOME:
             if (270 <= y && y <= 450) {
@@ -1469,6 +1571,24 @@ void Main::closeEvent(QCloseEvent*) {
     sMediaPlay->stop();
 } // closeEvent(QCloseEvent*)
 
+/**
+ * Triggered every 100 milli seconds. When you are thinking in your turn,
+ * repaint the screen if the hint for you or the win chances have changed,
+ * and restart the hint engine if it has been cancelled by a mouse click.
+ */
+void Main::timerEvent(QTimerEvent*) {
+    int hint = sHinter->getVersion();
+    int estimate = sEstimator->getVersion();
+
+    if (hint != sHintVersion || estimate != sEstimateVersion) {
+        sHintVersion = hint;
+        sEstimateVersion = estimate;
+        if (!sAuto && sStatus == Player::YOU) {
+            setStatus(sStatus);
+        } // if (!sAuto && sStatus == Player::YOU)
+    } // if (hint != sHintVersion || estimate != sEstimateVersion)
+} // timerEvent(QTimerEvent*)
+
 /**
  * Triggered when application finishes.
  */
@@ -1476,6 +1596,10 @@ Main::~Main() {
     int i;
     std::ofstream writer;
 
+    delete sEstimator;
+    delete sAgent;
+    delete sHinter;
+    delete sSpeculator;
     delete ui;
     delete sPainter;
     for (i = 3; i >= 0; --i) {
@@ -1485,7 +1609,7 @@ Main::~Main() {
     writer.open("UnoCard.stat", std::ios::out | std::ios::binary);
     if (!writer.fail()) {
         // Store statistics data to file
-        int dw[9];
+        int dw[10];
 
         dw[0] = sScore;
         dw[1] = sUno->getPlayers();
@@ -1495,12 +1619,20 @@ Main::~Main() {
         dw[5] = sUno->isDraw2StackRule() ? 1 : 0;
         dw[6] = sSoundPool->isEnabled() ? 1 : 0;
         dw[7] = sMediaPlay->volume();
-        for (dw[8] = 0, i = 0; i < 8; ++i) {
-            dw[8] = 31 * dw[8] + dw[i];
-        } // for (dw[8] = 0, i = 0; i < 8; ++i)
+        dw[8] = sUno->getThinkTime();
+        for (dw[9] = 0, i = 0; i < 9; ++i) {
+            dw[9] = 31 * dw[9] + dw[i];
+        } // for (dw[9] = 0, i = 0; i < 9; ++i)
 
         writer.write(FILE_HEADER, 8);
-        writer.write((char*)dw, 9 * sizeof(int));
+        writer.write((char*)dw, 10 * sizeof(int));
+        writer.close();
+    } // if (!writer.fail())
+
+    writer.open("UnoCard.latency.json", std::ios::out);
+    if (!writer.fail()) {
+        // Store latency histograms of AI entry points in this session
+        Latency::dump(writer);
         writer.close();
     } // if (!writer.fail())
 
@@ -1511,8 +1643,288 @@ Main::~Main() {
 
 /**
  * Defines the entry point for the console application.
+ * Run "UnoCard --batch [options]" to play AI games in console, without the
+ * game window and assets, and print the aggregate results as JSON (see
+ * Arena class). Options are:
+ *   --games n      How many games to play (1000 by default).
+ *   --threads n    How many threads (all cores by default).
+ *   --processes n  Play games in n worker processes instead of threads,
+ *                  see Arena::setProcesses(int).
+ *   --players n    3 or 4 players (4 by default).
+ *   --ai list      Comma separated AI of each seat, in the order of YOU,
+ *                  COM1, [COM2,] COM3, e.g. hard,easy,easy,hard:50. Seats
+ *                  without an AI in the list use the last one ("hard" by
+ *                  default).
+ *   --seed n       Master seed (1 by default).
+ *   --no-force-play, --seven-zero, --stack
+ *                  Rule flags, see Uno::setForcePlay(bool),
+ *                  Uno::setSevenZeroRule(bool) and
+ *                  Uno::setDraw2StackRule(bool).
+ *   --output path  Write the results to a file instead of stdout.
+ *   --checkpoint path
+ *                  Save the progress to a checkpoint file from time to
+ *                  time, and resume from it when run again with the same
+ *                  options, see Arena::setCheckpoint(const std::string&,
+ *                  int).
+ * Run "UnoCard --tune [iterations] [games] [threads] [seed] [checkpoint]" to
+ * tune AI parameters in console (see Tuner class). The result is saved to
+ * the UnoCard.params file, and will be used by the game. When a checkpoint
+ * file is specified, the tuner saves its state to it after each iteration,
+ * and resumes from it when run again with the same arguments.
+ * Run "UnoCard --distill [positions] [nodes] [threads] [seed] [output]" to
+ * distill the anytime AI into a generated header (see Distiller class).
+ * Copy the output over include/Distilled.h and rebuild to use it.
+ * Run "UnoCard --bluff [games] [iterations] [threads] [seed] [output]" to
+ * solve the [wild +4] bluff game (see BluffSolver class) in the same way,
+ * whose output replaces include/BluffStrategy.h.
+ * Run "UnoCard --scan predicate [seeds] [limit] [threads] [first] [rules]
+ * [players]" to find seeds whose games produce a specific situation, e.g.
+ * start-draw2, swap3 (with 7-0 rules), max-hold or stack4 (with stack
+ * rules), see Scanner class. Run "UnoCard [seed]" to replay a found seed.
+ * The size of the transposition table (see Transposition class) can be
+ * configured by a line "transpositionSize [mega bytes]" in the
+ * UnoCard.cfg file.
  */
 int main(int argc, char* argv[]) {
+    // Size of the transposition table shared by the search AIs
+    Transposition::loadSharedSize("UnoCard.cfg");
+
+    // Allocate and clear the table now, not inside the first timed search
+    Transposition::getInstance();
+
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0) {
+        // --batch [--games n] [--threads n] [--processes n] [--players n]
+        // [--ai list] [--seed n] [--no-force-play] [--seven-zero] [--stack]
+        // [--output path] [--checkpoint path]
+        int i, games, threads, processes, players;
+        unsigned seed;
+        bool forcePlay, sevenZero, stack;
+        std::string list, spec, rules;
+        std::ofstream writer;
+        size_t begin, end;
+        const char* output;
+        const char* checkpoint;
+
+        games = 1000;
+        threads = 0;
+        processes = 0;
+        players = 4;
+        seed = 1U;
+        forcePlay = true;
+        sevenZero = false;
+        stack = false;
+        list = "hard";
+        output = nullptr;
+        checkpoint = nullptr;
+        for (i = 2; i < argc; ++i) {
+            if (strcmp(argv[i], "--no-force-play") == 0) {
+                forcePlay = false;
+            } // if (strcmp(argv[i], "--no-force-play") == 0)
+            else if (strcmp(argv[i], "--seven-zero") == 0) {
+                sevenZero = true;
+            } // else if (strcmp(argv[i], "--seven-zero") == 0)
+            else if (strcmp(argv[i], "--stack") == 0) {
+                stack = true;
+            } // else if (strcmp(argv[i], "--stack") == 0)
+            else if (i + 1 >= argc) {
+                break;
+            } // else if (i + 1 >= argc)
+            else if (strcmp(argv[i], "--games") == 0) {
+                games = atoi(argv[++i]);
+            } // else if (strcmp(argv[i], "--games") == 0)
+            else if (strcmp(argv[i], "--threads") == 0) {
+                threads = atoi(argv[++i]);
+            } // else if (strcmp(argv[i], "--threads") == 0)
+            else if (strcmp(argv[i], "--processes") == 0) {
+                processes = atoi(argv[++i]);
+            } // else if (strcmp(argv[i], "--processes") == 0)
+            else if (strcmp(argv[i], "--players") == 0) {
+                players = atoi(argv[++i]);
+            } // else if (strcmp(argv[i], "--players") == 0)
+            else if (strcmp(argv[i], "--ai") == 0) {
+                list = argv[++i];
+            } // else if (strcmp(argv[i], "--ai") == 0)
+            else if (strcmp(argv[i], "--seed") == 0) {
+                seed = unsigned(atoi(argv[++i]));
+            } // else if (strcmp(argv[i], "--seed") == 0)
+            else if (strcmp(argv[i], "--output") == 0) {
+                output = argv[++i];
+            } // else if (strcmp(argv[i], "--output") == 0)
+            else if (strcmp(argv[i], "--checkpoint") == 0) {
+                checkpoint = argv[++i];
+            } // else if (strcmp(argv[i], "--checkpoint") == 0)
+            else {
+                break;
+            } // else
+        } // for (i = 2; i < argc; ++i)
+
+        if (i < argc || games <= 0 || players < 3 || players > 4) {
+            std::cerr << "Bad option: " << (i < argc ? argv[i] : "")
+                << std::endl;
+            return 1;
+        } // if (i < argc || games <= 0 || players < 3 || players > 4)
+
+        Arena arena(threads, seed);
+        for (begin = 0, i = 0; i < players; ++i) {
+            // Seats without an AI in the list use the last one
+            if (begin <= list.size()) {
+                end = list.find(',', begin);
+                end = end == std::string::npos ? list.size() : end;
+                spec = list.substr(begin, end - begin);
+                begin = end + 1;
+            } // if (begin <= list.size())
+
+            if (!arena.addSeat(spec)) {
+                std::cerr << "Unknown AI: " << spec << std::endl;
+                return 1;
+            } // if (!arena.addSeat(spec))
+        } // for (begin = 0, i = 0; i < players; ++i)
+
+        rules = sevenZero ? (stack ? "7-0+stack" : "7-0")
+            : (stack ? "stack" : "std");
+        arena.addRules(rules);
+        arena.setForcePlay(forcePlay);
+        arena.setProcesses(processes);
+        if (checkpoint != nullptr) {
+            arena.setCheckpoint(checkpoint);
+        } // if (checkpoint != nullptr)
+
+        if (output != nullptr) {
+            writer.open(output);
+            if (writer.fail()) {
+                std::cerr << "Cannot write: " << output << std::endl;
+                return 1;
+            } // if (writer.fail())
+        } // if (output != nullptr)
+
+        if (!arena.run(games, output != nullptr ? writer : std::cout)) {
+            std::cerr << "Worker processes keep crashing." << std::endl;
+            return 1;
+        } // if (!arena.run(games, output != nullptr ? writer : std::cout))
+
+        return 0;
+    } // if (argc > 1 && strcmp(argv[1], "--batch") == 0)
+
+    if (argc > 2 && strcmp(argv[1], "--arena") == 0) {
+        // --arena seats [games] [threads] [seed] [rules] [output], where
+        // seats and rules are comma separated, e.g. hard,hard,easy 7-0,std
+        std::string list;
+        std::ofstream writer;
+        size_t begin, end;
+        Arena arena(
+            /* threads */ argc > 4 ? atoi(argv[4]) : 0,
+            /* seed    */ argc > 5 ? unsigned(atoi(argv[5])) : 1U
+        ); // Arena arena()
+
+        list = argv[2];
+        for (begin = 0; begin <= list.size(); begin = end + 1) {
+            end = list.find(',', begin);
+            end = end == std::string::npos ? list.size() : end;
+            if (!arena.addSeat(list.substr(begin, end - begin))) {
+                std::cerr << "Unknown seat: " << list << std::endl;
+                return 1;
+            } // if (!arena.addSeat(list.substr(begin, end - begin)))
+        } // for (begin = 0; begin <= list.size(); begin = end + 1)
+
+        list = argc > 6 ? argv[6] : "std";
+        for (begin = 0; begin <= list.size(); begin = end + 1) {
+            end = list.find(',', begin);
+            end = end == std::string::npos ? list.size() : end;
+            if (!arena.addRules(list.substr(begin, end - begin))) {
+                std::cerr << "Unknown rules: " << list << std::endl;
+                return 1;
+            } // if (!arena.addRules(list.substr(begin, end - begin)))
+        } // for (begin = 0; begin <= list.size(); begin = end + 1)
+
+        if (argc > 7) {
+            writer.open(argv[7]);
+            if (writer.fail()) {
+                std::cerr << "Cannot write: " << argv[7] << std::endl;
+                return 1;
+            } // if (writer.fail())
+        } // if (argc > 7)
+
+        if (!arena.run(argc > 3 ? atoi(argv[3]) : 1000,
+                       argc > 7 ? writer : std::cout)) {
+            std::cerr << "3 or 4 seats are required." << std::endl;
+            return 1;
+        } // if (!arena.run(argc > 3 ? atoi(argv[3]) : 1000, ...))
+
+#ifdef UNO_COVERAGE
+        // Branch coverage of AI decision trees
+        Coverage::report(std::cerr);
+#endif // UNO_COVERAGE
+
+        return 0;
+    } // if (argc > 2 && strcmp(argv[1], "--arena") == 0)
+
+    if (argc > 1 && strcmp(argv[1], "--tune") == 0) {
+        Tuner tuner(
+            /* threads */ argc > 4 ? atoi(argv[4]) : 0,
+            /* games   */ argc > 3 ? atoi(argv[3]) : 2000,
+            /* seed    */ argc > 5 ? unsigned(atoi(argv[5])) : 1U
+        ); // Tuner tuner()
+        if (argc > 6) {
+            tuner.setCheckpoint(argv[6]);
+        } // if (argc > 6)
+
+        tuner.run(argc > 2 ? atoi(argv[2]) : 100, "UnoCard.params");
+        return 0;
+    } // if (argc > 1 && strcmp(argv[1], "--tune") == 0)
+
+    if (argc > 1 && strcmp(argv[1], "--distill") == 0) {
+        // --distill [positions] [nodes] [threads] [seed] [output]
+        Distiller distiller(
+            /* threads */ argc > 4 ? atoi(argv[4]) : 0,
+            /* nodes   */ argc > 3 ? atoi(argv[3]) : 400,
+            /* seed    */ argc > 5 ? unsigned(atoi(argv[5])) : 1U
+        ); // Distiller distiller()
+        return distiller.run(argc > 2 ? atoi(argv[2]) : 1000000,
+            argc > 6 ? argv[6] : "Distilled.h") ? 0 : 1;
+    } // if (argc > 1 && strcmp(argv[1], "--distill") == 0)
+
+    if (argc > 1 && strcmp(argv[1], "--bluff") == 0) {
+        // --bluff [games] [iterations] [threads] [seed] [output]
+        BluffSolver solver(
+            /* threads */ argc > 4 ? atoi(argv[4]) : 0,
+            /* seed    */ argc > 5 ? unsigned(atoi(argv[5])) : 1U
+        ); // BluffSolver solver()
+        return solver.run(argc > 2 ? atoi(argv[2]) : 100000,
+            argc > 3 ? atoi(argv[3]) : 100000,
+            argc > 6 ? argv[6] : "BluffStrategy.h") ? 0 : 1;
+    } // if (argc > 1 && strcmp(argv[1], "--bluff") == 0)
+
+    if (argc > 2 && strcmp(argv[1], "--scan") == 0) {
+        // --scan predicate [seeds] [limit] [threads] [first] [rules]
+        // [players], where rules is one of std, 7-0, stack and 7-0+stack
+        std::string rules = argc > 7 ? argv[7] : "std";
+        Scanner scanner(/* threads */ argc > 5 ? atoi(argv[5]) : 0);
+
+        if (rules != "std" && rules != "7-0" && rules != "stack"
+            && rules != "7-0+stack") {
+            std::cerr << "Unknown rules: " << rules << std::endl;
+            return 1;
+        } // if (rules != "std" && rules != "7-0" && ...)
+
+        scanner.setRules(
+            /* players        */ argc > 8 ? atoi(argv[8]) : 4,
+            /* difficulty     */ Uno::LV_HARD,
+            /* forcePlay      */ true,
+            /* sevenZeroRule  */ rules.find("7-0") != std::string::npos,
+            /* draw2StackRule */ rules.find("stack") != std::string::npos
+        ); // scanner.setRules()
+        if (!scanner.run(argv[2],
+                         /* first */ argc > 6 ? unsigned(atoi(argv[6])) : 1U,
+                         /* seeds */ argc > 3 ? atoi(argv[3]) : 1000000,
+                         /* limit */ argc > 4 ? atoi(argv[4]) : 10,
+                         std::cout)) {
+            std::cerr << "Unknown predicate: " << argv[2] << std::endl;
+            return 1;
+        } // if (!scanner.run(argv[2], ...))
+
+        return 0;
+    } // if (argc > 2 && strcmp(argv[1], "--scan") == 0)
+
     QApplication app(argc, argv);
     Main window(argc, argv);
 